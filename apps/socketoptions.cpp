@@ -22,6 +22,13 @@ extern const std::map<std::string, int> enummap_transtype = {
     { "file", SRTT_FILE }
 };
 
+extern const std::map<std::string, int> enummap_pacingmode = {
+    { "wait", SRT_PACING_WAIT },
+    { "timerfd", SRT_PACING_TIMERFD },
+    { "hybrid", SRT_PACING_HYBRID },
+    { "spin", SRT_PACING_SPIN }
+};
+
 
 const char* const SocketOption::mode_names[3] = {
     "listener", "caller", "rendezvous"
@@ -207,6 +207,7 @@ inline bool SocketOption::apply(Object socket, std::string value) const
 }
 
 extern const std::map<std::string, int> enummap_transtype;
+extern const std::map<std::string, int> enummap_pacingmode;
 
 namespace {
 const SocketOption srt_options [] {
@@ -219,6 +220,13 @@ const SocketOption srt_options [] {
     { "fc", 0, SRTO_FC, SocketOption::PRE, SocketOption::INT, nullptr},
     { "sndbuf", 0, SRTO_SNDBUF, SocketOption::PRE, SocketOption::INT, nullptr},
     { "rcvbuf", 0, SRTO_RCVBUF, SocketOption::PRE, SocketOption::INT, nullptr},
+    { "udprcvbatch", 0, SRTO_UDP_RCVBATCH, SocketOption::PRE, SocketOption::INT, nullptr},
+    { "rcvworkers", 0, SRTO_RCVWORKERS, SocketOption::PRE, SocketOption::INT, nullptr},
+    { "cryptoworkers", 0, SRTO_CRYPTOWORKERS, SocketOption::PRE, SocketOption::INT, nullptr},
+    { "acceptworkers", 0, SRTO_ACCEPTWORKERS, SocketOption::PRE, SocketOption::INT, nullptr},
+    { "pacingmode", 0, SRTO_PACINGMODE, SocketOption::PRE, SocketOption::ENUM, &enummap_pacingmode },
+    { "pacingspin", 0, SRTO_PACINGSPIN, SocketOption::PRE, SocketOption::INT, nullptr},
+    { "udpsndbatch", 0, SRTO_UDP_SNDBATCH, SocketOption::PRE, SocketOption::INT, nullptr},
     // linger option is handled outside of the common loop, therefore commented out.
     //{ "linger", 0, SRTO_LINGER, SocketOption::PRE, SocketOption::INT, nullptr},
     { "ipttl", 0, SRTO_IPTTL, SocketOption::PRE, SocketOption::INT, nullptr},
@@ -254,6 +262,8 @@ const SocketOption srt_options [] {
 #ifdef SRT_ENABLE_BINDTODEVICE
     { "bindtodevice", 0, SRTO_BINDTODEVICE, SocketOption::PRE, SocketOption::STRING, nullptr},
 #endif
+    { "pacingtrain", 0, SRTO_PACINGTRAIN, SocketOption::PRE, SocketOption::INT, nullptr },
+    { "inductionrate", 0, SRTO_INDUCTIONRATE, SocketOption::PRE, SocketOption::INT, nullptr },
     { "retransmitalgo", 0, SRTO_RETRANSMITALGO, SocketOption::PRE, SocketOption::INT, nullptr }
 #ifdef ENABLE_AEAD_API_PREVIEW
     ,{ "cryptomode", 0, SRTO_CRYPTOMODE, SocketOption::PRE, SocketOption::INT, nullptr }
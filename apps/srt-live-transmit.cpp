@@ -135,6 +135,7 @@ struct LiveTransmitConfig
     set<srt_logging::LogFA> logfas;
     bool log_internal;
     string logfile;
+    bool log_binary = false;
     int bw_report = 0;
     bool srctime = false;
     size_t buffering = 10;
@@ -182,6 +183,7 @@ int parse_args(LiveTransmitConfig &cfg, int argc, char** argv)
         o_logfa         = { "lfa", "logfa" },
         o_log_internal  = { "loginternal"},
         o_logfile       = { "logfile" },
+        o_logbinary     = { "logbinary" },
         o_quiet         = { "q", "quiet" },
         o_verbose       = { "v", "verbose" },
         o_help          = { "h", "help" },
@@ -203,6 +205,7 @@ int parse_args(LiveTransmitConfig &cfg, int argc, char** argv)
         { o_logfa,        OptionScheme::ARG_ONE },
         { o_log_internal, OptionScheme::ARG_NONE },
         { o_logfile,      OptionScheme::ARG_ONE },
+        { o_logbinary,    OptionScheme::ARG_NONE },
         { o_quiet,        OptionScheme::ARG_NONE },
         { o_verbose,      OptionScheme::ARG_NONE },
         { o_help,         OptionScheme::ARG_VAR },
@@ -288,6 +291,7 @@ int parse_args(LiveTransmitConfig &cfg, int argc, char** argv)
         PrintOptionHelp(o_logfa,     "<fas>", "log functional area (see '-h logging' for more info)");
         //PrintOptionHelp(o_log_internal, "", "use internal logger");
         PrintOptionHelp(o_logfile, "<filename="">", "write logs to file");
+        PrintOptionHelp(o_logbinary, "", "write logs to file in binary format (see srt-log-decode)");
         PrintOptionHelp(o_quiet, "", "quiet mode (default off)");
         PrintOptionHelp(o_verbose,   "", "verbose mode (default off)");
         cerr << "\n";
@@ -343,6 +347,7 @@ int parse_args(LiveTransmitConfig &cfg, int argc, char** argv)
     cfg.logfas       = SrtParseLogFA(Option<OutString>(params, "", o_logfa));
     cfg.log_internal = OptionPresent(params, o_log_internal);
     cfg.logfile      = Option<OutString>(params, o_logfile);
+    cfg.log_binary   = OptionPresent(params, o_logbinary);
     cfg.quiet        = OptionPresent(params, o_quiet);
     
     if (OptionPresent(params, o_verbose))
@@ -421,7 +426,7 @@ int main(int argc, char** argv)
     }
     else if (!cfg.logfile.empty())
     {
-        logfile_stream.open(cfg.logfile.c_str());
+        logfile_stream.open(cfg.logfile.c_str(), cfg.log_binary ? ios::out | ios::binary : ios::out);
         if (!logfile_stream)
         {
             cerr << "ERROR: Can't open '" << cfg.logfile.c_str() << "' for writing - fallback to cerr\n";
@@ -429,6 +434,8 @@ int main(int argc, char** argv)
         else
         {
             srt::setlogstream(logfile_stream);
+            if (cfg.log_binary)
+                srt_setlogflags(SRT_LOGF_BINARY);
         }
     }
 
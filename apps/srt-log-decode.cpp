@@ -0,0 +1,270 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+// Decoder of the binary SRT log (SRT_LOGF_BINARY) into the text lines,
+// as they would be written by the library with the text log.
+//
+// Usage: srt-log-decode [-location] [<file>]
+// Reads from the standard input if no file is given.
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "logging_binary.h"
+
+using namespace std;
+using namespace srt_logging::binlog;
+
+struct Site
+{
+    string prefix;
+    string file;
+    uint32_t line;
+    string function;
+};
+
+// Reads the values from the record payload.
+class RecordReader
+{
+    const string& m_data;
+    size_t m_pos;
+
+public:
+    RecordReader(const string& data) : m_data(data), m_pos(0) {}
+
+    bool atEnd() const { return m_pos >= m_data.size(); }
+
+    template <class T>
+    bool get(T& w_value)
+    {
+        if (m_data.size() - m_pos < sizeof w_value)
+            return false;
+        memcpy(&w_value, m_data.data() + m_pos, sizeof w_value);
+        m_pos += sizeof w_value;
+        return true;
+    }
+
+    bool getString(string& w_value)
+    {
+        uint32_t len;
+        if (!get(len) || m_data.size() - m_pos < len)
+            return false;
+        w_value.assign(m_data, m_pos, len);
+        m_pos += len;
+        return true;
+    }
+};
+
+static bool readHeader(istream& in)
+{
+    char magic[sizeof MAGIC];
+    uint32_t bom;
+    if (!in.read(magic, sizeof magic) || memcmp(magic, MAGIC, sizeof magic) != 0)
+    {
+        cerr << "ERROR: not a binary SRT log\n";
+        return false;
+    }
+    if (!in.read((char*)&bom, sizeof bom) || bom != BYTE_ORDER_MARK)
+    {
+        cerr << "ERROR: the log was written with a different byte order\n";
+        return false;
+    }
+    return true;
+}
+
+static string formatTime(int64_t time_us)
+{
+    if (time_us == 0)
+        return string();
+
+    const time_t tt = time_t(time_us / 1000000);
+    char buf[64];
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &tt);
+#else
+    localtime_r(&tt, &tm);
+#endif
+    ostringstream os;
+    if (strftime(buf, sizeof buf, "%X.", &tm))
+        os << buf << setw(6) << setfill('0') << (time_us % 1000000);
+    return os.str();
+}
+
+static bool formatArgs(RecordReader& rd, ostream& out)
+{
+    static ios_base& (* const manips[])(ios_base&) = {
+        dec, hex, oct, boolalpha, noboolalpha, fixed,
+        scientific, showbase, noshowbase, uppercase, nouppercase};
+
+    while (!rd.atEnd())
+    {
+        char type = 0;
+        if (!rd.get(type))
+            return false;
+
+        switch (type)
+        {
+        case ARG_INT32:  { int32_t v;  if (!rd.get(v)) return false; out << v; break; }
+        case ARG_INT64:  { int64_t v;  if (!rd.get(v)) return false; out << v; break; }
+        case ARG_UINT32: { uint32_t v; if (!rd.get(v)) return false; out << v; break; }
+        case ARG_UINT64: { uint64_t v; if (!rd.get(v)) return false; out << v; break; }
+        case ARG_DOUBLE: { double v;   if (!rd.get(v)) return false; out << v; break; }
+        case ARG_CHAR:   { char v;     if (!rd.get(v)) return false; out << v; break; }
+        case ARG_BOOL:   { uint8_t v;  if (!rd.get(v)) return false; out << (v != 0); break; }
+        case ARG_STRING: { string v;   if (!rd.getString(v)) return false; out << v; break; }
+        case ARG_MANIP:
+        {
+            uint8_t v;
+            if (!rd.get(v))
+                return false;
+            if (v < sizeof manips / sizeof manips[0])
+                out << manips[v];
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool location = false;
+    const char* filename = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        if (arg == "-location" || arg == "-l")
+            location = true;
+        else if (arg[0] == '-' && arg.size() > 1)
+        {
+            cerr << "Usage: " << argv[0] << " [-location] [<file>]\n";
+            return 2;
+        }
+        else
+            filename = argv[i];
+    }
+
+    ifstream file;
+    if (filename)
+    {
+        file.open(filename, ios::in | ios::binary);
+        if (!file)
+        {
+            cerr << "ERROR: can't open '" << filename << "'\n";
+            return 1;
+        }
+    }
+    istream& in = filename ? file : cin;
+
+    if (!readHeader(in))
+        return 1;
+
+    uint32_t magic_head;
+    memcpy(&magic_head, MAGIC, sizeof magic_head);
+
+    map<uint32_t, Site> sites;
+    string data;
+    for (;;)
+    {
+        uint32_t len;
+        if (!in.read((char*)&len, sizeof len))
+            break;
+
+        // The header is repeated when the log stream was set again.
+        if (len == magic_head)
+        {
+            char rest[sizeof MAGIC - sizeof len];
+            uint32_t bom;
+            if (!in.read(rest, sizeof rest) || memcmp(rest, MAGIC + sizeof len, sizeof rest) != 0
+                || !in.read((char*)&bom, sizeof bom) || bom != BYTE_ORDER_MARK)
+            {
+                cerr << "ERROR: malformed log header\n";
+                return 1;
+            }
+            sites.clear();
+            continue;
+        }
+
+        data.resize(len);
+        if (len == 0 || !in.read(&data[0], len))
+        {
+            cerr << "ERROR: truncated log record\n";
+            return 1;
+        }
+
+        RecordReader rd(data);
+        char type = 0;
+        rd.get(type);
+        bool ok = true;
+        if (type == REC_SITE)
+        {
+            uint32_t id = 0;
+            uint8_t level;
+            Site s;
+            ok = rd.get(id) && rd.get(level) && rd.getString(s.prefix) && rd.getString(s.file)
+                && rd.get(s.line) && rd.getString(s.function);
+            if (ok)
+                sites[id] = s;
+        }
+        else if (type == REC_LINE)
+        {
+            uint32_t id = 0;
+            int64_t time_us = 0;
+            string thread;
+            ok = rd.get(id) && rd.get(time_us) && rd.getString(thread);
+            map<uint32_t, Site>::iterator si = sites.find(id);
+            if (ok && si == sites.end())
+            {
+                cerr << "ERROR: log line of unknown site " << id << "\n";
+                ok = false;
+            }
+
+            if (ok)
+            {
+                const Site& s = si->second;
+                ostringstream os;
+                os << formatTime(time_us);
+                if (!thread.empty())
+                    os << "/" << thread;
+                os << s.prefix << ": ";
+                if (location)
+                    os << "[" << s.file << ":" << s.line << " " << s.function << "] ";
+                ok = formatArgs(rd, os);
+                cout << os.str() << "\n";
+            }
+        }
+        else if (type == REC_TEXT)
+        {
+            uint8_t level;
+            string line;
+            ok = rd.get(level) && rd.getString(line);
+            if (ok)
+                cout << line;
+        }
+
+        if (!ok)
+        {
+            cerr << "ERROR: malformed log record\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -225,6 +225,33 @@ public:
         output << "{\"bandwidth\":" << mbpsBandwidth << '}' << endl;
         return output.str();
     }
+
+    string WriteMuxStats(const SRT_MUXSTATS& mux) override
+    {
+        std::ostringstream output;
+        output << "{" << quotekey("mux") << "{"
+            << quotekey("id") << mux.muxID << ","
+            << quotekey("port") << mux.muxPort << ","
+            << quotekey("send") << "{"
+            << quotekey("iterations") << mux.sndIterations << ","
+            << quotekey("wakeups") << mux.sndWakeups << ","
+            << quotekey("packets") << mux.pktSent << ","
+            << quotekey("calls") << mux.sndCalls << ","
+            << quotekey("batchMax") << mux.pktSendBatchMax << ","
+            << quotekey("usPackData") << mux.usPackData << ","
+            << quotekey("listLength") << mux.sndListLength << "},"
+            << quotekey("recv") << "{"
+            << quotekey("iterations") << mux.rcvIterations << ","
+            << quotekey("packets") << mux.pktRecv << ","
+            << quotekey("calls") << mux.rcvCalls << ","
+            << quotekey("syscalls") << mux.rcvSyscalls << ","
+            << quotekey("batchMax") << mux.pktRecvBatchMax << ","
+            << quotekey("usProcessData") << mux.usProcessData << ","
+            << quotekey("usCheckTimers") << mux.usCheckTimers << ","
+            << quotekey("unitsFree") << mux.rcvUnitsFree << ","
+            << quotekey("unitsTotal") << mux.rcvUnitsTotal << "}}}" << endl;
+        return output.str();
+    }
 };
 
 class SrtStatsCsv : public SrtStatsWriter
@@ -305,6 +332,24 @@ public:
         return output.str();
     } 
 
+    string WriteMuxStats(const SRT_MUXSTATS& mux) override
+    {
+        // Packets per wake-up of the sender worker, and per system call of the receiver worker
+        const double snd_per_wakeup = mux.sndWakeups ? double(mux.pktSent) / mux.sndWakeups : 0;
+        const double rcv_per_call   = mux.rcvCalls ? double(mux.pktRecv) / mux.rcvCalls : 0;
+
+        std::ostringstream output;
+        output << "======= SRT MUX: id=" << mux.muxID << " port=" << mux.muxPort << endl;
+        output << "ITERATIONS  SEND: " << setw(11) << mux.sndIterations      << "  RECEIVE:    " << setw(11) << mux.rcvIterations        << endl;
+        output << "PACKETS     SENT: " << setw(11) << mux.pktSent            << "  RECEIVED:   " << setw(11) << mux.pktRecv              << endl;
+        output << "SYSCALLS    SEND: " << setw(11) << mux.sndCalls           << "  RECEIVE:    " << setw(11) << mux.rcvSyscalls          << endl;
+        output << "PKT/WAKEUP  SEND: " << setw(11) << snd_per_wakeup         << "  PKT/CALL:   " << setw(11) << rcv_per_call             << endl;
+        output << "BATCH MAX   SEND: " << setw(11) << mux.pktSendBatchMax    << "  RECEIVE:    " << setw(11) << mux.pktRecvBatchMax      << endl;
+        output << "TIME US     PACK: " << setw(11) << mux.usPackData         << "  PROCESS:    " << setw(11) << mux.usProcessData        << "  TIMERS: " << setw(11) << mux.usCheckTimers << endl;
+        output << "QUEUE   SND LIST: " << setw(11) << mux.sndListLength      << "  RCV UNITS:  " << setw(11) << mux.rcvUnitsFree << "/" << mux.rcvUnitsTotal << endl;
+        return output.str();
+    }
+
     string WriteBandwidth(double mbpsBandwidth) override 
     {
         std::ostringstream output;
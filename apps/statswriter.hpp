@@ -73,6 +73,8 @@ class SrtStatsWriter
 public:
     virtual std::string WriteStats(int sid, const CBytePerfMon& mon) = 0;
     virtual std::string WriteBandwidth(double mbpsBandwidth) = 0;
+    // Statistics of the multiplexer workers (srt_muxstats), if supported by the format.
+    virtual std::string WriteMuxStats(const SRT_MUXSTATS&) { return std::string(); }
     virtual ~SrtStatsWriter() {}
 
     // Only if HAS_PUT_TIME. Specified in the imp file.
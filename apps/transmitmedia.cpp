@@ -558,7 +558,12 @@ int SrtSource::Read(size_t chunk, MediaPacket& pkt, ostream &out_stats)
             if (need_bw_report)
                 cerr << transmit_stats_writer->WriteBandwidth(perf.mbpsBandwidth) << std::flush;
             if (need_stats_report)
+            {
                 out_stats << transmit_stats_writer->WriteStats(m_sock, perf) << std::flush;
+                SRT_MUXSTATS mux;
+                if (srt_muxstats(m_sock, &mux) == 0)
+                    out_stats << transmit_stats_writer->WriteMuxStats(mux) << std::flush;
+            }
         }
     }
     ++counter;
@@ -607,7 +612,12 @@ int SrtTarget::Write(const char* data, size_t size, int64_t src_time, ostream &o
             if (need_bw_report)
                 cerr << transmit_stats_writer->WriteBandwidth(perf.mbpsBandwidth) << std::flush;
             if (need_stats_report)
+            {
                 out_stats << transmit_stats_writer->WriteStats(m_sock, perf) << std::flush;
+                SRT_MUXSTATS mux;
+                if (srt_muxstats(m_sock, &mux) == 0)
+                    out_stats << transmit_stats_writer->WriteMuxStats(mux) << std::flush;
+            }
         }
     }
     ++counter;
@@ -48,6 +48,7 @@ set cmake_options {
     enable-static "Should libsrt be built as a static library (default: ON)"
     enable-relative-libpath "Should applications contain relative library paths, like ../lib (default: OFF)"
     enable-getnameinfo "In-logs sockaddr-to-string should do rev-dns (default: OFF)"
+    enable-hugepages "Back the packet buffer slabs with huge pages where available (default: OFF)"
     enable-unittests "Enable Unit Tests (will download Google UT) (default: OFF)"
     enable-encryption "Should encryption features be enabled (default: ON)"
     enable-c++-deps "Extra library dependencies in srt.pc for C language (default: ON)"
@@ -115,6 +115,22 @@ int  HaiCrypt_Rx_Data(HaiCrypt_Handle hhc, unsigned char *pfx, unsigned char *da
 /// @return returns 1 if AES GCM is supported, 0 otherwise.
 int  HaiCrypt_IsAESGCM_Supported(void);
 
+/* Cache of the KEKs derived from the passphrase (PBKDF2), shared by all the sessions,
+ * so that the KEK of the same passphrase and salt is derived only once.
+ */
+typedef struct {
+        /* Copy the cached KEK of kek_len bytes into kek and return 0, or return -1 if not cached */
+        int  (*lookup)(const char *pwd, size_t pwd_len, const unsigned char *salt, size_t salt_len,
+                       unsigned char *kek, size_t kek_len);
+        void (*store)(const char *pwd, size_t pwd_len, const unsigned char *salt, size_t salt_len,
+                      const unsigned char *kek, size_t kek_len);
+}HaiCrypt_KekCache;
+
+/// @brief Set the KEK cache used by all the sessions (NULL: derive the KEK every time).
+/// To be called before any session is created; the cache must remain valid until the last
+/// session is closed and its functions must be thread-safe.
+void HaiCrypt_SetKekCache(const HaiCrypt_KekCache *cache);
+
 /* Status values */
 
 #define HAICRYPT_ERROR -1
@@ -26,6 +26,13 @@ written by
 #include <string.h>				/* memcpy */
 #include "hcrypt.h"
 
+static const HaiCrypt_KekCache *hcrypt_KekCache = NULL;
+
+void HaiCrypt_SetKekCache(const HaiCrypt_KekCache *cache)
+{
+	hcrypt_KekCache = cache;
+}
+
 int hcryptCtx_SetSecret(hcrypt_Session *crypto, hcrypt_Ctx *ctx, const HaiCrypt_Secret *secret)
 {
 	int iret;
@@ -73,15 +80,23 @@ int hcryptCtx_GenSecret(hcrypt_Session *crypto, hcrypt_Ctx *ctx)
 		? HAICRYPT_PBKDF2_SALT_LEN 
 		: ctx->salt_len);
 	int iret = 0;
+	unsigned char *pbkdf_salt = &ctx->salt[ctx->salt_len - pbkdf_salt_len];
 	(void)crypto;
 
-	iret = crypto->cryspr->km_pbkdf2(crypto->cryspr_cb, ctx->cfg.pwd, ctx->cfg.pwd_len,
-		&ctx->salt[ctx->salt_len - pbkdf_salt_len], pbkdf_salt_len, 
-		HAICRYPT_PBKDF2_ITER_CNT, kek_len, kek);
+	/* The same passphrase and salt derive the same KEK (e.g. cloned RX/TX contexts) */
+	if (hcrypt_KekCache && 0 == hcrypt_KekCache->lookup(ctx->cfg.pwd, ctx->cfg.pwd_len,
+			pbkdf_salt, pbkdf_salt_len, kek, kek_len)) {
+		HCRYPT_LOG(LOG_DEBUG, "%s", "kek found in cache\n");
+	} else {
+		iret = crypto->cryspr->km_pbkdf2(crypto->cryspr_cb, ctx->cfg.pwd, ctx->cfg.pwd_len,
+			pbkdf_salt, pbkdf_salt_len, HAICRYPT_PBKDF2_ITER_CNT, kek_len, kek);
 
-	if(iret) {
-		HCRYPT_LOG(LOG_ERR, "km_pbkdf2() failed (rc=%d)\n", iret);
-		return(-1);
+		if(iret) {
+			HCRYPT_LOG(LOG_ERR, "km_pbkdf2() failed (rc=%d)\n", iret);
+			return(-1);
+		}
+		if (hcrypt_KekCache)
+			hcrypt_KekCache->store(ctx->cfg.pwd, ctx->cfg.pwd_len, pbkdf_salt, pbkdf_salt_len, kek, kek_len);
 	}
 	HCRYPT_PRINTKEY(ctx->cfg.pwd, ctx->cfg.pwd_len, "pwd");
 	HCRYPT_PRINTKEY(kek, kek_len, "kek");
@@ -132,6 +132,14 @@ void srt::CUDTSocket::setClosed()
 {
     m_Status = SRTS_CLOSED;
 
+#if ENABLE_BONDING
+    // The socket is no longer dispatched (see CUDTUnited::locateSocket_LOCKED),
+    // so the group has to check its members before the next sending or receiving.
+    CUDTGroup* pg = m_GroupOf;
+    if (pg)
+        pg->invalidateMembers();
+#endif
+
     // a socket will not be immediately removed when it is closed
     // in order to prevent other methods from accessing invalid address
     // a timer is started and the socket will be removed after approximately
@@ -376,6 +384,7 @@ int srt::CUDTUnited::cleanup()
 
     stopGarbageCollector();
     closeAllSockets();
+    m_TsbPdScheduler.stop();
     return 0;
 }
 
@@ -2274,6 +2283,29 @@ void srt::CUDTUnited::getsockname(const SRTSOCKET u, sockaddr* pw_name, int* pw_
     *pw_namelen = len;
 }
 
+void srt::CUDTUnited::muxstats(const SRTSOCKET u, SRT_MUXSTATS* pw_stats)
+{
+    if (!pw_stats)
+        throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+    // The multiplexer is only deleted with this lock held.
+    ScopedLock cg(m_GlobControlLock);
+
+    CUDTSocket* s = locateSocket_LOCKED(u);
+    if (!s)
+        throw CUDTException(MJ_NOTSUP, MN_SIDINVAL, 0);
+
+    CMultiplexer* mux = map_getp(m_mMultiplexer, s->m_iMuxID);
+    if (!mux)
+        throw CUDTException(MJ_NOTSUP, MN_ISUNBOUND, 0);
+
+    memset(pw_stats, 0, sizeof *pw_stats);
+    pw_stats->muxID   = mux->m_iID;
+    pw_stats->muxPort = mux->m_iPort;
+    mux->m_pSndQueue->getWorkerStats(*pw_stats);
+    mux->m_pRcvQueue->getWorkerStats(*pw_stats);
+}
+
 int srt::CUDTUnited::select(UDT::UDSET* readfds, UDT::UDSET* writefds, UDT::UDSET* exceptfds, const timeval* timeout)
 {
     const steady_clock::time_point entertime = steady_clock::now();
@@ -2481,12 +2513,26 @@ int srt::CUDTUnited::epoll_add_usock(const int eid, const SRTSOCKET u, const int
 }
 
 // NOTE: WILL LOCK (serially):
-// - CEPoll::m_EPollLock
+// - CEPoll lock of the EID shard
 // - CUDT::m_RecvLock
+// - CUDTSocket::m_AcceptLock (listener only)
 int srt::CUDTUnited::epoll_add_usock_INTERNAL(const int eid, CUDTSocket* s, const int* events)
 {
     int ret = m_EPoll.update_usock(eid, s->m_SocketID, events);
     s->core().addEPoll(eid);
+
+    // Connections queued for accept before the subscription have
+    // signalled the readiness only to the EIDs subscribed so far.
+    if (s->core().m_bListening)
+    {
+        ScopedLock accept_lock(s->m_AcceptLock);
+        if (!s->m_QueuedSockets.empty())
+        {
+            set<int> eids;
+            eids.insert(eid);
+            m_EPoll.update_events(s->m_SocketID, eids, SRT_EPOLL_ACCEPT, true);
+        }
+    }
     return ret;
 }
 
@@ -2880,7 +2926,7 @@ void srt::CUDTUnited::removeSocket(const SRTSOCKET u)
     // threads. If that's the case, SKIP IT THIS TIME. The
     // socket will be checked next time the GC rollover starts.
     CSNode* sn = s->core().m_pSNode;
-    if (sn && sn->m_iHeapLoc != -1)
+    if (sn && (sn->m_iHeapLoc != -1 || sn->m_bReady))
         return;
 
     CRNode* rn = s->core().m_pRNode;
@@ -3335,10 +3381,11 @@ void srt::CUDTUnited::updateMux(CUDTSocket* s, const sockaddr_any& reqaddr, cons
         }
 
         m.m_pTimer    = new CTimer;
+        m.m_pTimer->setPacing(CTimer::EPacing(m.m_mcfg.iPacingMode), m.m_mcfg.iPacingSpin);
         m.m_pSndQueue = new CSndQueue;
-        m.m_pSndQueue->init(m.m_pChannel, m.m_pTimer);
+        m.m_pSndQueue->init(m.m_pChannel, m.m_pTimer, s->core().maxPayloadSize(), m.m_mcfg.iCryptoWorkers);
         m.m_pRcvQueue = new CRcvQueue;
-        m.m_pRcvQueue->init(128, s->core().maxPayloadSize(), m.m_iIPversion, 1024, m.m_pChannel, m.m_pTimer);
+        m.m_pRcvQueue->init(128, s->core().maxPayloadSize(), m.m_iIPversion, 1024, m.m_mcfg.iRcvWorkers, m.m_mcfg.iAcceptWorkers, m.m_pChannel, m.m_pTimer);
 
         // Rewrite the port here, as it might be only known upon return
         // from CChannel::open.
@@ -3480,7 +3527,21 @@ int srt::CUDT::startup()
 
 int srt::CUDT::cleanup()
 {
-    return uglobal().cleanup();
+    const int res = uglobal().cleanup();
+
+    // Write the log lines still queued by SRT_LOGF_ASYNC, while
+    // the application's log stream or handler is still there.
+    srt_logger_config.async.stop();
+    return res;
+}
+
+int srt::CUDT::setTsbPdThreads(int nthreads)
+{
+    if (nthreads < 0 || nthreads > CTsbPdScheduler::MAX_THREADS)
+        return APIError(MJ_NOTSUP, MN_INVAL, 0);
+
+    uglobal().tsbpdScheduler().setThreads(nthreads);
+    return 0;
 }
 
 SRTSOCKET srt::CUDT::socket()
@@ -3872,6 +3933,24 @@ int srt::CUDT::getsockname(SRTSOCKET u, sockaddr* name, int* namelen)
     }
 }
 
+int srt::CUDT::muxstats(SRTSOCKET u, SRT_MUXSTATS* stats)
+{
+    try
+    {
+        uglobal().muxstats(u, stats);
+        return 0;
+    }
+    catch (const CUDTException& e)
+    {
+        return APIError(e);
+    }
+    catch (const std::exception& ee)
+    {
+        LOGC(aclog.Fatal, log << "muxstats: UNEXPECTED EXCEPTION: " << typeid(ee).name() << ": " << ee.what());
+        return APIError(MJ_UNKNOWN, MN_NONE, 0);
+    }
+}
+
 int srt::CUDT::getsockopt(SRTSOCKET u, int, SRT_SOCKOPT optname, void* pw_optval, int* pw_optlen)
 {
     if (!pw_optval || !pw_optlen)
@@ -3982,6 +4061,36 @@ int srt::CUDT::sendmsg2(SRTSOCKET u, const char* buf, int len, SRT_MSGCTRL& w_m)
     }
 }
 
+int srt::CUDT::sendmsgFill(SRTSOCKET u, int len, srt_send_fill_fn* fill, void* opaque, SRT_MSGCTRL& w_m)
+{
+    try
+    {
+#if ENABLE_BONDING
+        if (u & SRTGROUP_MASK)
+        {
+            // The group sender keeps its own copy of the payload for the member links.
+            LOGC(aclog.Error, log << "sendmsg_fill: not supported for groups");
+            return APIError(MJ_NOTSUP, MN_INVAL, 0);
+        }
+#endif
+
+        return uglobal().locateSocket(u, CUDTUnited::ERH_THROW)->core().sendmsgFill(len, fill, opaque, (w_m));
+    }
+    catch (const CUDTException& e)
+    {
+        return APIError(e);
+    }
+    catch (bad_alloc&)
+    {
+        return APIError(MJ_SYSTEMRES, MN_MEMORY, 0);
+    }
+    catch (const std::exception& ee)
+    {
+        LOGC(aclog.Fatal, log << "sendmsg_fill: UNEXPECTED EXCEPTION: " << typeid(ee).name() << ": " << ee.what());
+        return APIError(MJ_UNKNOWN, MN_NONE, 0);
+    }
+}
+
 int srt::CUDT::recv(SRTSOCKET u, char* buf, int len, int)
 {
     SRT_MSGCTRL mctrl = srt_msgctrl_default;
@@ -4022,6 +4131,32 @@ int srt::CUDT::recvmsg2(SRTSOCKET u, char* buf, int len, SRT_MSGCTRL& w_m)
     }
 }
 
+int srt::CUDT::recvmsgView(SRTSOCKET u, srt_recv_view_fn* view, void* opaque, SRT_MSGCTRL& w_m)
+{
+    try
+    {
+#if ENABLE_BONDING
+        if (u & SRTGROUP_MASK)
+        {
+            // The group receiver delivers the payload through its own buffer.
+            LOGC(aclog.Error, log << "recvmsg_view: not supported for groups");
+            return APIError(MJ_NOTSUP, MN_INVAL, 0);
+        }
+#endif
+
+        return uglobal().locateSocket(u, CUDTUnited::ERH_THROW)->core().recvmsgView(view, opaque, (w_m));
+    }
+    catch (const CUDTException& e)
+    {
+        return APIError(e);
+    }
+    catch (const std::exception& ee)
+    {
+        LOGC(aclog.Fatal, log << "recvmsg_view: UNEXPECTED EXCEPTION: " << typeid(ee).name() << ": " << ee.what());
+        return APIError(MJ_UNKNOWN, MN_NONE, 0);
+    }
+}
+
 int64_t srt::CUDT::sendfile(SRTSOCKET u, fstream& ifs, int64_t& offset, int64_t size, int block)
 {
     try
@@ -4061,6 +4196,57 @@ int64_t srt::CUDT::recvfile(SRTSOCKET u, fstream& ofs, int64_t& offset, int64_t
     }
 }
 
+#ifndef _WIN32
+int64_t srt::CUDT::sendfile(SRTSOCKET u, int fd, int64_t& offset, int64_t size, int block)
+{
+    try
+    {
+        CUDT& udt = uglobal().locateSocket(u, CUDTUnited::ERH_THROW)->core();
+        return udt.sendfile(fd, offset, size, block);
+    }
+    catch (const CUDTException& e)
+    {
+        return APIError(e);
+    }
+    catch (bad_alloc&)
+    {
+        return APIError(MJ_SYSTEMRES, MN_MEMORY, 0);
+    }
+    catch (const std::exception& ee)
+    {
+        LOGC(aclog.Fatal, log << "sendfile: UNEXPECTED EXCEPTION: " << typeid(ee).name() << ": " << ee.what());
+        return APIError(MJ_UNKNOWN, MN_NONE, 0);
+    }
+}
+
+int64_t srt::CUDT::recvfile(SRTSOCKET u, int fd, int64_t& offset, int64_t size, int block)
+{
+    try
+    {
+        return uglobal().locateSocket(u, CUDTUnited::ERH_THROW)->core().recvfile(fd, offset, size, block);
+    }
+    catch (const CUDTException& e)
+    {
+        return APIError(e);
+    }
+    catch (const std::exception& ee)
+    {
+        LOGC(aclog.Fatal, log << "recvfile: UNEXPECTED EXCEPTION: " << typeid(ee).name() << ": " << ee.what());
+        return APIError(MJ_UNKNOWN, MN_NONE, 0);
+    }
+}
+#else
+int64_t srt::CUDT::sendfile(SRTSOCKET, int, int64_t&, int64_t, int)
+{
+    return APIError(MJ_NOTSUP, MN_NONE, 0);
+}
+
+int64_t srt::CUDT::recvfile(SRTSOCKET, int, int64_t&, int64_t, int)
+{
+    return APIError(MJ_NOTSUP, MN_NONE, 0);
+}
+#endif
+
 int srt::CUDT::select(int, UDT::UDSET* readfds, UDT::UDSET* writefds, UDT::UDSET* exceptfds, const timeval* timeout)
 {
     if ((!readfds) && (!writefds) && (!exceptfds))
@@ -4784,12 +4970,14 @@ void resetlogfa(const int* fara, size_t fara_size)
 
 void setlogstream(std::ostream& stream)
 {
+    ScopedLock og(srt_logger_config.output_mutex);
     ScopedLock gg(srt_logger_config.mutex);
     srt_logger_config.log_stream = &stream;
 }
 
 void setloghandler(void* opaque, SRT_LOG_HANDLER_FN* handler)
 {
+    ScopedLock og(srt_logger_config.output_mutex);
     ScopedLock gg(srt_logger_config.mutex);
     srt_logger_config.loghandler_opaque = opaque;
     srt_logger_config.loghandler_fn     = handler;
@@ -4801,6 +4989,11 @@ void setlogflags(int flags)
     srt_logger_config.flags = flags;
 }
 
+int64_t getlogdropped()
+{
+    return srt_logger_config.async.dropped();
+}
+
 SRT_API bool setstreamid(SRTSOCKET u, const std::string& sid)
 {
     return CUDT::setstreamid(u, sid);
@@ -64,6 +64,7 @@ modified by
 #include "epoll.h"
 #include "handshake.h"
 #include "core.h"
+#include "tsbpd_sched.h"
 #if ENABLE_BONDING
 #include "group.h"
 #endif
@@ -312,6 +313,7 @@ public:
     int  close(CUDTSocket* s);
     void getpeername(const SRTSOCKET u, sockaddr* name, int* namelen);
     void getsockname(const SRTSOCKET u, sockaddr* name, int* namelen);
+    void muxstats(const SRTSOCKET u, SRT_MUXSTATS* stats);
     int  select(UDT::UDSET* readfds, UDT::UDSET* writefds, UDT::UDSET* exceptfds, const timeval* timeout);
     int  selectEx(const std::vector<SRTSOCKET>& fds,
                   std::vector<SRTSOCKET>*       readfds,
@@ -373,6 +375,8 @@ public:
 
     CEPoll& epoll_ref() { return m_EPoll; }
 
+    CTsbPdScheduler& tsbpdScheduler() { return m_TsbPdScheduler; }
+
 private:
     /// Generates a new socket ID. This function starts from a randomly
     /// generated value (at initialization time) and goes backward with
@@ -419,8 +423,6 @@ private:
         m_PeerRec; // record sockets from peers to avoid repeated connection request, int64_t = (socker_id << 30) + isn
 
 private:
-    friend struct FLookupSocketWithEvent_LOCKED;
-
     CUDTSocket* locateSocket(SRTSOCKET u, ErrorHandling erh = ERH_RETURN);
     // This function does the same as locateSocket, except that:
     // - lock on m_GlobControlLock is expected (so that you don't unlock between finding and using)
@@ -563,6 +565,8 @@ private:
 
     CEPoll m_EPoll; // handling epoll data structures and events
 
+    CTsbPdScheduler m_TsbPdScheduler; // TSBPD threads shared by the sockets (srt_set_tsbpd_threads)
+
 private:
     CUDTUnited(const CUDTUnited&);
     CUDTUnited& operator=(const CUDTUnited&);
@@ -175,6 +175,29 @@ public:
 #endif
   }
 
+  /// @brief Performs an atomic addition.
+  /// @returns The old value of the atomic object.
+  T fetch_add(T i) {
+#if defined(ATOMIC_USE_SRT_SYNC_MUTEX) && (ATOMIC_USE_SRT_SYNC_MUTEX == 1)
+    ScopedLock lg_(mutex_);
+    const T t = value_;
+    value_ += i;
+    return t;
+#elif defined(ATOMIC_USE_GCC_INTRINSICS)
+    return __atomic_fetch_add(&value_, i, __ATOMIC_SEQ_CST);
+#elif defined(ATOMIC_USE_MSVC_INTRINSICS)
+    T old_val;
+    do {
+      old_val = value_;
+    } while (msvc::interlocked<T>::compare_exchange(&value_, old_val + i, old_val) != old_val);
+    return old_val;
+#elif defined(ATOMIC_USE_CPP11_ATOMIC)
+    return value_.fetch_add(i);
+#else
+    #error "Implement Me."
+#endif
+  }
+
   T operator|=(T i) {
 #if defined(ATOMIC_USE_SRT_SYNC_MUTEX) && (ATOMIC_USE_SRT_SYNC_MUTEX == 1)
     ScopedLock lg_(mutex_);
@@ -45,6 +45,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cmath>
 #include <limits>
+#ifndef _WIN32
+#include <sys/uio.h>
+#include <cerrno>
+#endif
 #include "buffer_rcv.h"
 #include "logging.h"
 
@@ -390,7 +394,46 @@ int CRcvBuffer::dropMessage(int32_t seqnolo, int32_t seqnohi, int32_t msgno, Dro
     return iDropCnt;
 }
 
+namespace {
+    /// @brief Writes bytes to file stream.
+    /// @param data pointer to data to write.
+    /// @param len the number of bytes to write
+    /// @param dst_offset ignored
+    /// @param arg a void pointer to the fstream to write to.
+    /// @return true on success, false on failure
+    bool writeBytesToFile(char* data, int len, int dst_offset SRT_ATR_UNUSED, void* arg)
+    {
+        fstream* pofs = reinterpret_cast<fstream*>(arg);
+        pofs->write(data, len);
+        return !pofs->fail();
+    }
+
+    /// @brief Copies bytes to the destination buffer.
+    /// @param data pointer to data to copy.
+    /// @param len the number of bytes to copy
+    /// @param dst_offset offset in destination buffer
+    /// @param arg A pointer to the destination buffer
+    /// @return true on success, false on failure
+    bool copyBytesToBuf(char* data, int len, int dst_offset, void* arg)
+    {
+        char* dst = reinterpret_cast<char*>(arg) + dst_offset;
+        memcpy(dst, data, len);
+        return true;
+    }
+
+    /// @brief Passes the bytes already written elsewhere.
+    bool skipBytes(char*, int, int, void*)
+    {
+        return true;
+    }
+}
+
 int CRcvBuffer::readMessage(char* data, size_t len, SRT_MSGCTRL* msgctrl)
+{
+    return readMessageTo(len, copyBytesToBuf, reinterpret_cast<void*>(data), msgctrl);
+}
+
+int CRcvBuffer::readMessageTo(size_t len, copy_to_dst_f funcCopyToDst, void* arg, SRT_MSGCTRL* msgctrl)
 {
     const bool canReadInOrder = hasReadableInorderPkts();
     if (!canReadInOrder && m_iFirstReadableOutOfOrder < 0)
@@ -405,7 +448,7 @@ int CRcvBuffer::readMessage(char* data, size_t len, SRT_MSGCTRL* msgctrl)
     IF_RCVBUF_DEBUG(scoped_log.ss << "CRcvBuffer::readMessage. m_iStartSeqNo " << m_iStartSeqNo << " m_iStartPos " << m_iStartPos << " readPos " << readPos);
 
     size_t remain = len;
-    char* dst = data;
+    int    dst_offset = 0;
     int    pkts_read = 0;
     int    bytes_extracted = 0; // The total number of bytes extracted from the buffer.
     const bool updateStartPos = (readPos == m_iStartPos); // Indicates if the m_iStartPos can be changed
@@ -424,9 +467,9 @@ int CRcvBuffer::readMessage(char* data, size_t len, SRT_MSGCTRL* msgctrl)
 
         // unitsize can be zero
         const size_t unitsize = std::min(remain, pktsize);
-        memcpy(dst, packet.m_pcData, unitsize);
+        funcCopyToDst(packet.m_pcData, (int)unitsize, dst_offset, arg);
         remain -= unitsize;
-        dst += unitsize;
+        dst_offset += (int)unitsize;
 
         ++pkts_read;
         bytes_extracted += (int) pktsize;
@@ -486,45 +529,15 @@ int CRcvBuffer::readMessage(char* data, size_t len, SRT_MSGCTRL* msgctrl)
         // incase readable inorder packets are all read out.
         updateFirstReadableOutOfOrder();
 
-    const int bytes_read = int(dst - data);
+    const int bytes_read = dst_offset;
     if (bytes_read < bytes_extracted)
     {
         LOGC(rbuflog.Error, log << "readMessage: small dst buffer, copied only " << bytes_read << "/" << bytes_extracted << " bytes.");
     }
 
-    IF_RCVBUF_DEBUG(scoped_log.ss << " pldi64 " << *reinterpret_cast<uint64_t*>(data));
-
     return bytes_read;
 }
 
-namespace {
-    /// @brief Writes bytes to file stream.
-    /// @param data pointer to data to write.
-    /// @param len the number of bytes to write
-    /// @param dst_offset ignored
-    /// @param arg a void pointer to the fstream to write to.
-    /// @return true on success, false on failure
-    bool writeBytesToFile(char* data, int len, int dst_offset SRT_ATR_UNUSED, void* arg)
-    {
-        fstream* pofs = reinterpret_cast<fstream*>(arg);
-        pofs->write(data, len);
-        return !pofs->fail();
-    }
-
-    /// @brief Copies bytes to the destination buffer.
-    /// @param data pointer to data to copy.
-    /// @param len the number of bytes to copy
-    /// @param dst_offset offset in destination buffer
-    /// @param arg A pointer to the destination buffer
-    /// @return true on success, false on failure
-    bool copyBytesToBuf(char* data, int len, int dst_offset, void* arg)
-    {
-        char* dst = reinterpret_cast<char*>(arg) + dst_offset;
-        memcpy(dst, data, len);
-        return true;
-    }
-}
-
 int CRcvBuffer::readBufferTo(int len, copy_to_dst_f funcCopyToDst, void* arg)
 {
     int p = m_iStartPos;
@@ -611,6 +624,66 @@ int CRcvBuffer::readBufferToFile(fstream& ofs, int len)
     return readBufferTo(len, writeBytesToFile, reinterpret_cast<void*>(&ofs));
 }
 
+#ifndef _WIN32
+int CRcvBuffer::readBufferToFd(int fd, int64_t offset, int len)
+{
+    // Units written by a single call. The limit for the
+    // number of iovec entries is at least 1024 (IOV_MAX).
+    static const int MAX_IOV = 256;
+    struct iovec     iov[MAX_IOV];
+
+    int  iBytesWritten = 0;
+    bool bError        = false;
+    int  p             = m_iStartPos;
+    int notch         = m_iNotch;
+    while (iBytesWritten < len && p != m_iFirstNonreadPos)
+    {
+        int iovcnt = 0;
+        int batch  = 0;
+        for (; iovcnt < MAX_IOV && p != m_iFirstNonreadPos && iBytesWritten + batch < len; p = incPos(p))
+        {
+            if (!m_entries[p].pUnit)
+            {
+                LOGC(rbuflog.Error, log << "readBufferToFd: IPE: NULL unit found in file transmission");
+                return -1;
+            }
+
+            const CPacket& pkt      = packetAt(p);
+            const int      unitsize = std::min((int)pkt.getLength() - notch, len - iBytesWritten - batch);
+            iov[iovcnt].iov_base    = pkt.m_pcData + notch;
+            iov[iovcnt].iov_len     = unitsize;
+            ++iovcnt;
+            batch += unitsize;
+            notch = 0;
+        }
+
+        ssize_t res;
+        do
+            res = ::pwritev(fd, iov, iovcnt, offset + iBytesWritten);
+        while (res == -1 && errno == EINTR);
+
+        if (res <= 0)
+        {
+            LOGC(rbuflog.Error, log << "readBufferToFd: pwritev failed, errno=" << errno);
+            bError = true;
+            break;
+        }
+
+        // Release the units written. A short write leaves the rest
+        // in the buffer, with m_iNotch pointing to the first byte not written.
+        readBufferTo(int(res), skipBytes, NULL);
+        iBytesWritten += int(res);
+        if (res < batch)
+            break;
+
+        p     = m_iStartPos;
+        notch = m_iNotch;
+    }
+
+    return (bError && iBytesWritten == 0) ? -1 : iBytesWritten;
+}
+#endif
+
 bool CRcvBuffer::hasAvailablePackets() const
 {
     return hasReadableInorderPkts() || (m_numOutOfOrderPackets > 0 && m_iFirstReadableOutOfOrder != -1);
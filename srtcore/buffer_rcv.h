@@ -109,6 +109,21 @@ public:
     ///         -1 on failure.
     int readMessage(char* data, size_t len, SRT_MSGCTRL* msgctrl = NULL);
 
+    typedef bool copy_to_dst_f(char* data, int len, int dst_offset, void* arg);
+
+    /// Read the whole message from one or several packets, passing the payload
+    /// of every packet to @a funcCopyToDst before its unit is released.
+    /// The result of @a funcCopyToDst is ignored, as the message is read out anyway.
+    ///
+    /// @param [in] len maximum number of bytes to pass.
+    /// @param [in] funcCopyToDst function receiving the payload of each packet.
+    /// @param [in] arg the last argument passed to @a funcCopyToDst.
+    /// @param [in,out] message control data
+    ///
+    /// @return actual number of bytes passed to @a funcCopyToDst.
+    ///          0 if nothing to read.
+    int readMessageTo(size_t len, copy_to_dst_f funcCopyToDst, void* arg, SRT_MSGCTRL* msgctrl = NULL);
+
     /// Read acknowledged data into a user buffer.
     /// @param [in, out] dst pointer to the target user buffer.
     /// @param [in] len length of user buffer.
@@ -121,6 +136,16 @@ public:
     /// @return size of data read. -1 on error.
     int readBufferToFile(std::fstream& ofs, int len);
 
+#ifndef _WIN32
+    /// Write acknowledged data directly into file at the given offset,
+    /// with the units gathered in a single pwritev() call where possible.
+    /// @param [in] fd file descriptor.
+    /// @param [in] offset file offset to write the data at.
+    /// @param [in] len expected length of data to write into the file.
+    /// @return size of data written. -1 on error.
+    int readBufferToFd(int fd, int64_t offset, int len);
+#endif
+
 public:
     /// Get the starting position of the buffer as a packet sequence number.
     int getStartSeqNo() const { return m_iStartSeqNo; }
@@ -304,8 +329,6 @@ private:
     int  scanNotInOrderMessageRight(int startPos, int msgNo) const;
     int  scanNotInOrderMessageLeft(int startPos, int msgNo) const;
 
-    typedef bool copy_to_dst_f(char* data, int len, int dst_offset, void* arg);
-
     /// Read acknowledged data directly into file.
     /// @param [in] ofs C++ file stream.
     /// @param [in] len expected length of data to write into the file.
@@ -64,13 +64,58 @@ using namespace std;
 using namespace srt_logging;
 using namespace sync;
 
+CSndSharedPayload::CSndSharedPayload(CPacketSlotPool& pool, char* slot, int len)
+    : m_Pool(pool)
+    , m_pcData(slot)
+    , m_iLength(len)
+    , m_iRefCount(1)
+{
+}
+
+CSndSharedPayload* CSndSharedPayload::create(const char* data, int len)
+{
+    if (len <= 0 || len > SRT_LIVE_MAX_PLSIZE)
+        return NULL;
+
+    // The same pool as the sender buffers with the default payload size.
+    CPacketSlotPool& pool = CPacketSlotPool::instance(SRT_LIVE_MAX_PLSIZE);
+    char*            slot = NULL;
+    if (!pool.allocate(&slot, 1))
+        return NULL;
+
+    CSndSharedPayload* payload = NULL;
+    try
+    {
+        payload = new CSndSharedPayload(pool, slot, len);
+    }
+    catch (...)
+    {
+        pool.release(&slot, 1);
+        return NULL;
+    }
+
+    memcpy((slot), data, len);
+    return payload;
+}
+
+void CSndSharedPayload::release()
+{
+    if (--m_iRefCount == 0)
+    {
+        m_Pool.release(&m_pcData, 1);
+        delete this;
+    }
+}
+
 CSndBuffer::CSndBuffer(int ip_family, int size, int maxpld, int authtag)
     : m_BufLock()
     , m_pBlock(NULL)
     , m_pFirstBlock(NULL)
     , m_pCurrBlock(NULL)
     , m_pLastBlock(NULL)
-    , m_pBuffer(NULL)
+    , m_pEncBlock(NULL)
+    , m_SlotPool(CPacketSlotPool::instance(maxpld))
+    , m_iIncSize(size)
     , m_iNextMsgNo(1)
     , m_iSize(size)
     , m_iBlockLen(maxpld)
@@ -79,22 +124,21 @@ CSndBuffer::CSndBuffer(int ip_family, int size, int maxpld, int authtag)
     , m_iBytesCount(0)
     , m_rateEstimator(ip_family)
 {
-    // initial physical buffer of "size"
-    m_pBuffer           = new Buffer;
-    m_pBuffer->m_pcData = new char[m_iSize * m_iBlockLen];
-    m_pBuffer->m_iSize  = m_iSize;
-    m_pBuffer->m_pNext  = NULL;
+    // initial payload buffers of "size" blocks
+    vector<char*> slots(m_iSize);
+    if (!m_SlotPool.allocate(&slots[0], m_iSize))
+        throw CUDTException(MJ_SYSTEMRES, MN_MEMORY, 0);
 
     // circular linked list for out bound packets
     m_pBlock  = new Block;
     Block* pb = m_pBlock;
-    char* pc  = m_pBuffer->m_pcData;
 
     for (int i = 0; i < m_iSize; ++i)
     {
         pb->m_iMsgNoBitset = 0;
-        pb->m_pcData       = pc;
-        pc                += m_iBlockLen;
+        pb->m_pcData       = slots[i];
+        pb->m_pcSlot       = slots[i];
+        pb->m_pShared      = NULL;
 
         if (i < m_iSize - 1)
         {
@@ -111,27 +155,81 @@ CSndBuffer::CSndBuffer(int ip_family, int size, int maxpld, int authtag)
 
 CSndBuffer::~CSndBuffer()
 {
-    Block* pb = m_pBlock->m_pNext;
-    while (pb != m_pBlock)
+    vector<char*> slots;
+    slots.reserve(m_iSize);
+
+    Block* pb = m_pBlock;
+    do
     {
         Block* temp = pb;
         pb          = pb->m_pNext;
+        if (temp->m_pcSlot)
+            slots.push_back(temp->m_pcSlot);
+        if (temp->m_pShared)
+            temp->m_pShared->release();
         delete temp;
-    }
-    delete m_pBlock;
+    } while (pb != m_pBlock);
 
-    while (m_pBuffer != NULL)
-    {
-        Buffer* temp = m_pBuffer;
-        m_pBuffer    = m_pBuffer->m_pNext;
-        delete[] temp->m_pcData;
-        delete temp;
-    }
+    if (!slots.empty())
+        m_SlotPool.release(&slots[0], (int)slots.size());
 
     releaseMutex(m_BufLock);
 }
 
+static int copyPayload(void* opaque, char* block, int offset, int size)
+{
+    memcpy((block), static_cast<const char*>(opaque) + offset, size);
+    return 0;
+}
+
 void CSndBuffer::addBuffer(const char* data, int len, SRT_MSGCTRL& w_mctrl)
+{
+    addBuffer(&copyPayload, const_cast<char*>(data), len, (w_mctrl));
+}
+
+bool CSndBuffer::addBuffer(srt_send_fill_fn* fill, void* opaque, int len, SRT_MSGCTRL& w_mctrl)
+{
+    return addMessage(fill, opaque, NULL, len, (w_mctrl));
+}
+
+bool CSndBuffer::addShared(CSndSharedPayload& payload, SRT_MSGCTRL& w_mctrl)
+{
+    if (payload.length() > getMaxPacketLen())
+        return false;
+
+    return addMessage(NULL, NULL, &payload, payload.length(), (w_mctrl));
+}
+
+void CSndBuffer::useOwnSlot(Block* b)
+{
+    if (b->m_pShared)
+    {
+        b->m_pShared->release();
+        b->m_pShared = NULL;
+    }
+
+    if (!b->m_pcSlot && !m_SlotPool.allocate(&b->m_pcSlot, 1))
+        b->m_pcSlot = NULL;
+    b->m_pcData = b->m_pcSlot;
+}
+
+void CSndBuffer::useShared(Block* b, CSndSharedPayload& payload)
+{
+    payload.retain();
+    if (b->m_pShared)
+        b->m_pShared->release();
+    b->m_pShared = &payload;
+
+    // The block doesn't need its own buffer until it gets a copied payload again.
+    if (b->m_pcSlot)
+    {
+        m_SlotPool.release(&b->m_pcSlot, 1);
+        b->m_pcSlot = NULL;
+    }
+    b->m_pcData = payload.data();
+}
+
+bool CSndBuffer::addMessage(srt_send_fill_fn* fill, void* opaque, CSndSharedPayload* shared, int len, SRT_MSGCTRL& w_mctrl)
 {
     int32_t& w_msgno     = w_mctrl.msgno;
     int32_t& w_seqno     = w_mctrl.pktseq;
@@ -170,6 +268,9 @@ void CSndBuffer::addBuffer(const char* data, int len, SRT_MSGCTRL& w_mctrl)
     // and then return the accordingly modified sequence number in the reference.
 
     Block* s = m_pLastBlock;
+    const int32_t orig_msgno = w_msgno;
+    const int32_t orig_seqno = w_seqno;
+    const int32_t orig_nextmsgno = m_iNextMsgNo;
 
     if (w_msgno == SRT_MSGNO_NONE) // DEFAULT-UNCHANGED msgno supplied
     {
@@ -188,10 +289,35 @@ void CSndBuffer::addBuffer(const char* data, int len, SRT_MSGCTRL& w_mctrl)
         if (pktlen > iPktLen)
             pktlen = iPktLen;
 
+        if (shared)
+        {
+            useShared(s, *shared);
+        }
+        else
+        {
+            useOwnSlot(s);
+            if (!s->m_pcData)
+            {
+                w_msgno      = orig_msgno;
+                w_seqno      = orig_seqno;
+                m_iNextMsgNo = orig_nextmsgno;
+                throw CUDTException(MJ_SYSTEMRES, MN_MEMORY, 0);
+            }
+        }
+
         HLOGC(bslog.Debug,
               log << "addBuffer: %" << w_seqno << " #" << w_msgno << " offset=" << (i * iPktLen)
-                  << " size=" << pktlen << " TO BUFFER:" << (void*)s->m_pcData);
-        memcpy((s->m_pcData), data + i * iPktLen, pktlen);
+                  << " size=" << pktlen << (shared ? " SHARED:" : " TO BUFFER:") << (void*)s->m_pcData);
+        if (!shared && fill(opaque, (s->m_pcData), i * iPktLen, pktlen) < 0)
+        {
+            // The blocks filled so far are not committed (m_pLastBlock stays).
+            HLOGC(bslog.Debug, log << CONID() << "addBuffer: payload filling failed at offset " << (i * iPktLen)
+                    << ", message of " << len << " bytes not scheduled");
+            w_msgno      = orig_msgno;
+            w_seqno      = orig_seqno;
+            m_iNextMsgNo = orig_nextmsgno;
+            return false;
+        }
         s->m_iLength = pktlen;
 
         s->m_iSeqNo = w_seqno;
@@ -210,6 +336,7 @@ void CSndBuffer::addBuffer(const char* data, int len, SRT_MSGCTRL& w_mctrl)
         // [PB_SOLO] - 1 packet per message
 
         s->m_iTTL = ttl;
+        s->m_bEncrypted = false;
         s->m_tsRexmitTime = time_point();
         s->m_tsOriginTime = m_tsLastOriginTime;
         
@@ -234,9 +361,27 @@ void CSndBuffer::addBuffer(const char* data, int len, SRT_MSGCTRL& w_mctrl)
     const int nextmsgno = ++MsgNo(m_iNextMsgNo);
     HLOGC(bslog.Debug, log << "CSndBuffer::addBuffer: updating msgno: #" << m_iNextMsgNo << " -> #" << nextmsgno);
     m_iNextMsgNo = nextmsgno;
+    return true;
+}
+
+namespace {
+    int readFromStream(char* dst, int len, void* arg)
+    {
+        fstream& ifs = *reinterpret_cast<fstream*>(arg);
+        if (ifs.bad() || ifs.fail() || ifs.eof())
+            return 0;
+
+        ifs.read(dst, len);
+        return int(ifs.gcount());
+    }
 }
 
 int CSndBuffer::addBufferFromFile(fstream& ifs, int len)
+{
+    return addBufferFromFile(readFromStream, reinterpret_cast<void*>(&ifs), len);
+}
+
+int CSndBuffer::addBufferFromFile(read_file_fn* read, void* arg, int len)
 {
     const int iPktLen    = getMaxPacketLen();
     const int iNumBlocks = countNumPacketsRequired(len, iPktLen);
@@ -257,22 +402,24 @@ int CSndBuffer::addBufferFromFile(fstream& ifs, int len)
           log << CONID() << "addBufferFromFile: adding " << iPktLen << " packets (" << len
               << " bytes) to send, msgno=" << m_iNextMsgNo);
 
-    Block* s     = m_pLastBlock;
-    int    total = 0;
+    Block* s       = m_pLastBlock;
+    Block* last    = NULL;
+    int    total   = 0;
+    int    nblocks = 0;
     for (int i = 0; i < iNumBlocks; ++i)
     {
-        if (ifs.bad() || ifs.fail() || ifs.eof())
-            break;
-
         int pktlen = len - i * iPktLen;
         if (pktlen > iPktLen)
             pktlen = iPktLen;
 
+        useOwnSlot(s);
+        if (!s->m_pcData)
+            break;
+
         HLOGC(bslog.Debug,
               log << "addBufferFromFile: reading from=" << (i * iPktLen) << " size=" << pktlen
                   << " TO BUFFER:" << (void*)s->m_pcData);
-        ifs.read(s->m_pcData, pktlen);
-        if ((pktlen = int(ifs.gcount())) <= 0)
+        if ((pktlen = read(s->m_pcData, pktlen, arg)) <= 0)
             break;
 
         // currently file transfer is only available in streaming mode, message is always in order, ttl = infinite
@@ -284,16 +431,24 @@ int CSndBuffer::addBufferFromFile(fstream& ifs, int len)
         // NOTE: PB_FIRST | PB_LAST == PB_SOLO.
         // none of PB_FIRST & PB_LAST == PB_SUBSEQUENT.
 
-        s->m_iLength = pktlen;
-        s->m_iTTL    = SRT_MSGTTL_INF;
-        s            = s->m_pNext;
+        s->m_iLength    = pktlen;
+        s->m_iTTL       = SRT_MSGTTL_INF;
+        s->m_bEncrypted = false;
+        last            = s;
+        s               = s->m_pNext;
 
         total += pktlen;
+        ++nblocks;
     }
     m_pLastBlock = s;
 
+    // The file ended earlier than expected; close the message
+    // with the last block read, and don't send the blocks not filled.
+    if (last && nblocks < iNumBlocks)
+        last->m_iMsgNoBitset |= PacketBoundaryBits(PB_LAST);
+
     enterCS(m_BufLock);
-    m_iCount = m_iCount + iNumBlocks;
+    m_iCount = m_iCount + nblocks;
     m_iBytesCount += total;
 
     leaveCS(m_BufLock);
@@ -305,10 +460,11 @@ int CSndBuffer::addBufferFromFile(fstream& ifs, int len)
     return total;
 }
 
-int CSndBuffer::readData(CPacket& w_packet, steady_clock::time_point& w_srctime, int kflgs, int& w_seqnoinc)
+int CSndBuffer::readData(CPacket& w_packet, steady_clock::time_point& w_srctime, int kflgs, int& w_seqnoinc, bool& w_encrypted)
 {
     int readlen = 0;
     w_seqnoinc = 0;
+    w_encrypted = false;
 
     ScopedLock bufferguard(m_BufLock);
     while (m_pCurrBlock != m_pLastBlock)
@@ -332,7 +488,13 @@ int CSndBuffer::readData(CPacket& w_packet, steady_clock::time_point& w_srctime,
         // This may also put an encryption burden on the application thread, rather than the sending thread,
         // which could be more efficient. Note that packet sequence number must be properly set in that case,
         // as it is used as a counter for the AES encryption.
-        if (kflgs == -1)
+        w_encrypted = false;
+        if (m_pCurrBlock->m_bEncrypted)
+        {
+            // Already encrypted by encryptNext(), which has also set the KK flags.
+            w_encrypted = true;
+        }
+        else if (kflgs == -1)
         {
             HLOGC(bslog.Debug, log << CONID() << " CSndBuffer: ERROR: encryption required and not possible. NOT SENDING.");
             readlen = 0;
@@ -346,6 +508,8 @@ int CSndBuffer::readData(CPacket& w_packet, steady_clock::time_point& w_srctime,
         w_packet.set_msgflags(m_pCurrBlock->m_iMsgNoBitset);
         w_srctime = m_pCurrBlock->m_tsOriginTime;
         m_pCurrBlock = m_pCurrBlock->m_pNext;
+        if (m_pEncBlock == p)
+            m_pEncBlock = NULL;
 
         if ((p->m_iTTL >= 0) && (count_milliseconds(steady_clock::now() - w_srctime) > p->m_iTTL))
         {
@@ -367,6 +531,36 @@ int CSndBuffer::readData(CPacket& w_packet, steady_clock::time_point& w_srctime,
     return readlen;
 }
 
+int CSndBuffer::encryptNext(encrypt_fn* encrypt, void* arg)
+{
+    ScopedLock bufferguard(m_BufLock);
+
+    // Blocks from m_pCurrBlock to m_pLastBlock are not sent yet, so they
+    // are neither acknowledged nor dropped, unless m_pCurrBlock is moved.
+    Block* p = m_pEncBlock ? m_pEncBlock : m_pCurrBlock;
+    while (p != m_pLastBlock && p->m_bEncrypted)
+        p = p->m_pNext;
+    m_pEncBlock = p;
+
+    if (p == m_pLastBlock)
+        return 0;
+
+    CPacket packet;
+    packet.m_pcData = p->m_pcData;
+    packet.setLength(p->m_iLength, m_iBlockLen);
+    packet.set_seqno(p->m_iSeqNo);
+    packet.set_msgflags(p->m_iMsgNoBitset);
+
+    const int kflgs = encrypt((packet), p->m_tsOriginTime, arg);
+    if (kflgs < 0)
+        return -1;
+
+    p->m_iMsgNoBitset |= MSGNO_ENCKEYSPEC::wrap(kflgs);
+    p->m_bEncrypted = true;
+    m_pEncBlock     = p->m_pNext;
+    return 1;
+}
+
 CSndBuffer::time_point CSndBuffer::peekNextOriginal() const
 {
     ScopedLock bufferguard(m_BufLock);
@@ -376,6 +570,15 @@ CSndBuffer::time_point CSndBuffer::peekNextOriginal() const
     return m_pCurrBlock->m_tsOriginTime;
 }
 
+int CSndBuffer::countUnsent(int max) const
+{
+    ScopedLock bufferguard(m_BufLock);
+    int        count = 0;
+    for (Block* p = m_pCurrBlock; p != m_pLastBlock && count < max; p = p->m_pNext)
+        ++count;
+    return count;
+}
+
 int32_t CSndBuffer::getMsgNoAt(const int offset)
 {
     ScopedLock bufferguard(m_BufLock);
@@ -484,6 +687,8 @@ int CSndBuffer::readData(const int offset, CPacket& w_packet, steady_clock::time
                 m_pCurrBlock = p;
             msglen++;
         }
+        if (move)
+            m_pEncBlock = NULL;
 
         HLOGC(qslog.Debug,
               log << "CSndBuffer::readData: due to TTL exceeded, %(" << first_seq << " - " << last_seq << "), "
@@ -559,7 +764,10 @@ void CSndBuffer::ackData(int offset)
         m_pFirstBlock = m_pFirstBlock->m_pNext;
     }
     if (move)
+    {
         m_pCurrBlock = m_pFirstBlock;
+        m_pEncBlock  = NULL;
+    }
 
     m_iCount = m_iCount - offset;
 
@@ -666,6 +874,7 @@ int CSndBuffer::dropLateData(int& w_bytes, int32_t& w_first_msgno, const steady_
     if (move)
     {
         m_pCurrBlock = m_pFirstBlock;
+        m_pEncBlock  = NULL;
     }
     m_iCount = m_iCount - dpkts;
 
@@ -684,28 +893,20 @@ int CSndBuffer::dropLateData(int& w_bytes, int32_t& w_first_msgno, const steady_
 
 void CSndBuffer::increase()
 {
-    int unitsize = m_pBuffer->m_iSize;
+    const int unitsize = m_iIncSize;
 
-    // new physical buffer
-    Buffer* nbuf = NULL;
+    // new payload buffers
+    vector<char*> slots;
     try
     {
-        nbuf           = new Buffer;
-        nbuf->m_pcData = new char[unitsize * m_iBlockLen];
+        slots.resize(unitsize);
     }
     catch (...)
     {
-        delete nbuf;
         throw CUDTException(MJ_SYSTEMRES, MN_MEMORY, 0);
     }
-    nbuf->m_iSize = unitsize;
-    nbuf->m_pNext = NULL;
-
-    // insert the buffer at the end of the buffer list
-    Buffer* p = m_pBuffer;
-    while (p->m_pNext != NULL)
-        p = p->m_pNext;
-    p->m_pNext = nbuf;
+    if (!m_SlotPool.allocate(&slots[0], unitsize))
+        throw CUDTException(MJ_SYSTEMRES, MN_MEMORY, 0);
 
     // new packet blocks
     Block* nblk = NULL;
@@ -716,6 +917,7 @@ void CSndBuffer::increase()
     catch (...)
     {
         delete nblk;
+        m_SlotPool.release(&slots[0], unitsize);
         throw CUDTException(MJ_SYSTEMRES, MN_MEMORY, 0);
     }
     Block* pb = nblk;
@@ -729,13 +931,13 @@ void CSndBuffer::increase()
     pb->m_pNext           = m_pLastBlock->m_pNext;
     m_pLastBlock->m_pNext = nblk;
 
-    pb       = nblk;
-    char* pc = nbuf->m_pcData;
+    pb = nblk;
     for (int i = 0; i < unitsize; ++i)
     {
-        pb->m_pcData = pc;
-        pb           = pb->m_pNext;
-        pc += m_iBlockLen;
+        pb->m_pcData  = slots[i];
+        pb->m_pcSlot  = slots[i];
+        pb->m_pShared = NULL;
+        pb            = pb->m_pNext;
     }
 
     m_iSize += unitsize;
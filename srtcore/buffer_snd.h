@@ -56,6 +56,7 @@ modified by
 #include "srt.h"
 #include "packet.h"
 #include "buffer_tools.h"
+#include "mempool.h"
 
 // The notation used for "circular numbers" in comments:
 // The "cicrular numbers" are numbers that when increased up to the
@@ -71,6 +72,37 @@ modified by
 
 namespace srt {
 
+/// A packet payload stored once and referenced by the sender buffers of
+/// several sockets that send it as is, that is, not encrypted: the members
+/// of a broadcast group. The last reference released frees it.
+class CSndSharedPayload
+{
+public:
+    /// Copy the payload into a new shared block with one reference.
+    /// @param [in] data the payload
+    /// @param [in] len size of the payload, up to SRT_LIVE_MAX_PLSIZE.
+    /// @return the new block, or NULL if @a len is too big or no memory.
+    static CSndSharedPayload* create(const char* data, int len);
+
+    void retain() { ++m_iRefCount; }
+    void release();
+
+    char* data() const { return m_pcData; }
+    int   length() const { return m_iLength; }
+
+private:
+    CSndSharedPayload(CPacketSlotPool& pool, char* slot, int len);
+
+    CPacketSlotPool&  m_Pool;
+    char* const       m_pcData;
+    const int         m_iLength;
+    sync::atomic<int> m_iRefCount;
+
+private:
+    CSndSharedPayload(const CSndSharedPayload&);
+    CSndSharedPayload& operator=(const CSndSharedPayload&);
+};
+
 class CSndBuffer
 {
     typedef sync::steady_clock::time_point time_point;
@@ -109,6 +141,27 @@ public:
     SRT_ATTR_EXCLUDES(m_BufLock)
     void addBuffer(const char* data, int len, SRT_MSGCTRL& w_mctrl);
 
+    /// Insert a message into the sending list, letting @a fill write the payload
+    /// directly into the blocks. @a fill is called once per block, in order,
+    /// with m_BufLock locked. @a w_mctrl is used as in addBuffer() above.
+    /// @param [in] fill callback writing the payload into a block.
+    /// @param [in] opaque user pointer passed to @a fill.
+    /// @param [in] len size of the message.
+    /// @param [inout] w_mctrl Message control data
+    /// @return false if @a fill reported a failure; nothing was inserted then.
+    SRT_ATTR_EXCLUDES(m_BufLock)
+    bool addBuffer(srt_send_fill_fn* fill, void* opaque, int len, SRT_MSGCTRL& w_mctrl);
+
+    /// Insert a message of a single packet, referencing the shared payload
+    /// instead of copying it. The payload must not be encrypted in place,
+    /// so this is only for a socket sending without encryption.
+    /// @a w_mctrl is used as in addBuffer() above.
+    /// @param [in] payload the payload, retained by the buffer.
+    /// @param [inout] w_mctrl Message control data
+    /// @return false if the payload doesn't fit into a single packet; nothing was inserted then.
+    SRT_ATTR_EXCLUDES(m_BufLock)
+    bool addShared(CSndSharedPayload& payload, SRT_MSGCTRL& w_mctrl);
+
     /// Read a block of data from file and insert it into the sending list.
     /// @param [in] ifs input file stream.
     /// @param [in] len size of the block.
@@ -116,6 +169,21 @@ public:
     SRT_ATTR_EXCLUDES(m_BufLock)
     int addBufferFromFile(std::fstream& ifs, int len);
 
+    /// Reads the next part of a file directly into a block.
+    /// @param [out] dst the block payload
+    /// @param [in] len the number of bytes to read
+    /// @param [in] arg the file, as passed to addBufferFromFile()
+    /// @return the number of bytes read, 0 or less if none (end of file or error)
+    typedef int read_file_fn(char* dst, int len, void* arg);
+
+    /// Read a block of data from file by @a read and insert it into the sending list.
+    /// @param [in] read function reading the file into the blocks.
+    /// @param [in] arg file passed to @a read.
+    /// @param [in] len size of the block.
+    /// @return actual size of data added from the file.
+    SRT_ATTR_EXCLUDES(m_BufLock)
+    int addBufferFromFile(read_file_fn* read, void* arg, int len);
+
     // Special values that can be returned by readData.
     static const int READ_NONE = 0;
     static const int READ_DROP = -1;
@@ -125,15 +193,39 @@ public:
     /// @param [out] origintime origin time stamp of the message
     /// @param [in] kflags Odd|Even crypto key flag
     /// @param [out] seqnoinc the number of packets skipped due to TTL, so that seqno should be incremented.
+    /// @param [out] encrypted true if the packet has been encrypted by encryptNext(),
+    ///              in which case @a kflgs are not applied.
     /// @return Actual length of data read.
     SRT_ATTR_EXCLUDES(m_BufLock)
-    int readData(CPacket& w_packet, time_point& w_origintime, int kflgs, int& w_seqnoinc);
+    int readData(CPacket& w_packet, time_point& w_origintime, int kflgs, int& w_seqnoinc, bool& w_encrypted);
+
+    /// Function encrypting in place a packet to be sent, called by encryptNext().
+    /// The packet has the payload, the sequence number and the message flags
+    /// set from the block, the function must set the other header fields used
+    /// for encryption and the crypto key flags.
+    /// @return Crypto key flags used for the packet, or -1 if not encrypted.
+    typedef int encrypt_fn(CPacket& w_packet, const time_point& origintime, void* arg);
+
+    /// Encrypt the next packet that hasn't been sent yet, ahead of readData().
+    /// @param [in] encrypt function encrypting the packet
+    /// @param [in] arg argument passed to @a encrypt
+    /// @retval 1 a packet has been encrypted
+    /// @retval 0 all packets scheduled for sending are already encrypted
+    /// @retval -1 @a encrypt failed; the packet will be encrypted when sent.
+    SRT_ATTR_EXCLUDES(m_BufLock)
+    int encryptNext(encrypt_fn* encrypt, void* arg);
 
     /// Peek an information on the next original data packet to send.
     /// @return origin time stamp of the next packet; epoch start time otherwise.
     SRT_ATTR_EXCLUDES(m_BufLock)
     time_point peekNextOriginal() const;
 
+    /// Count the packets scheduled for sending that haven't been sent yet.
+    /// @param [in] max the maximum number to count
+    /// @return the number of unsent packets, not more than @a max.
+    SRT_ATTR_EXCLUDES(m_BufLock)
+    int countUnsent(int max) const;
+
     struct DropRange
     {
         static const size_t BEGIN = 0, END = 1;
@@ -216,19 +308,27 @@ public:
 private:
     void increase();
 
+    /// Common part of addBuffer() and addShared(): the payload is written
+    /// by @a fill, or referenced from @a shared if it's not NULL.
+    bool addMessage(srt_send_fill_fn* fill, void* opaque, CSndSharedPayload* shared, int len, SRT_MSGCTRL& w_mctrl);
+
 private:
     mutable sync::Mutex m_BufLock; // used to synchronize buffer operation
 
     struct Block
     {
-        char* m_pcData;  // pointer to the data block
+        char* m_pcData;  // pointer to the data block: m_pcSlot, or the shared payload
         int   m_iLength; // payload length of the block (excluding auth tag).
 
+        char*              m_pcSlot;  // own payload buffer from m_SlotPool (NULL if given back)
+        CSndSharedPayload* m_pShared; // shared payload referenced (NULL if none)
+
         int32_t    m_iMsgNoBitset; // message number
         int32_t    m_iSeqNo;       // sequence number for scheduling
         time_point m_tsOriginTime; // block origin time (either provided from above or equals the time a message was submitted for sending.
         time_point m_tsRexmitTime; // packet retransmission time
         int        m_iTTL; // time to live (milliseconds)
+        bool       m_bEncrypted; // payload encrypted by encryptNext()
 
         Block* m_pNext; // next block
 
@@ -248,12 +348,17 @@ private:
     // m_pCurrBlock:	 The current block
     // m_pLastBlock:     The last block (if first == last, buffer is empty)
 
-    struct Buffer
-    {
-        char*   m_pcData; // buffer
-        int     m_iSize;  // size
-        Buffer* m_pNext;  // next buffer
-    } * m_pBuffer;        // physical buffer
+    Block* m_pEncBlock; // Where encryptNext() continues; NULL: from m_pCurrBlock
+
+    /// Make the block use its own payload buffer, taking one from the pool
+    /// if it was given back, and drop the shared payload it referenced.
+    void useOwnSlot(Block* b);
+
+    /// Make the block reference the shared payload, giving back its own buffer.
+    void useShared(Block* b, CSndSharedPayload& payload);
+
+    CPacketSlotPool& m_SlotPool; // shared pool of the block payload buffers
+    const int        m_iIncSize; // number of blocks added when the buffer is full
 
     int32_t m_iNextMsgNo; // next message number
 
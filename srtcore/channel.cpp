@@ -62,6 +62,13 @@ modified by
 #include "logging.h"
 #include "netinet_any.h"
 #include "utilities.h"
+#ifdef SRT_ENABLE_GSO
+#include <netinet/udp.h> // UDP_SEGMENT
+#endif
+#ifdef LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
 
 #ifdef _WIN32
 typedef int socklen_t;
@@ -138,6 +145,16 @@ static int set_cloexec(int fd, int set)
 
 srt::CChannel::CChannel()
     : m_iSocket(INVALID_SOCKET)
+    , m_tdReadTimeout(sync::microseconds_from(10000))
+    , m_llRecvSyscalls(0)
+#ifdef LINUX
+    , m_iReadEpoll(-1)
+    , m_iReadInterrupt(-1)
+    , m_bReadPending(false)
+#endif
+#ifdef SRT_ENABLE_GSO
+    , m_bGSO(true)
+#endif
 #ifdef SRT_ENABLE_PKTINFO
     , m_bBindMasked(true)
 #endif
@@ -230,6 +247,7 @@ void srt::CChannel::open(const sockaddr_any& addr)
     LOGC(kmlog.Debug, log << "CHANNEL: Bound to local address: " << m_BindAddr.str());
 
     setUDPSockOpt();
+    createReadEvents();
 }
 
 void srt::CChannel::open(int family)
@@ -278,6 +296,7 @@ void srt::CChannel::open(int family)
     HLOGC(kmlog.Debug, log << "CHANNEL: Bound to local address: " << m_BindAddr.str());
 
     setUDPSockOpt();
+    createReadEvents();
 }
 
 void srt::CChannel::attach(UDPSOCKET udpsock, const sockaddr_any& udpsocks_addr)
@@ -287,6 +306,7 @@ void srt::CChannel::attach(UDPSOCKET udpsock, const sockaddr_any& udpsocks_addr)
     m_iSocket  = udpsock;
     m_BindAddr = udpsocks_addr;
     setUDPSockOpt();
+    createReadEvents();
 }
 
 static inline string fmt_opt(bool value, const string& label)
@@ -587,6 +607,67 @@ void srt::CChannel::close() const
 #else
     ::closesocket(m_iSocket);
 #endif
+
+#ifdef LINUX
+    if (m_iReadEpoll != -1)
+    {
+        ::close(m_iReadEpoll);
+        ::close(m_iReadInterrupt);
+    }
+#endif
+}
+
+void srt::CChannel::createReadEvents()
+{
+#ifdef LINUX
+    m_iReadEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_iReadEpoll == -1)
+    {
+        LOGC(kmlog.Warn, log << "CChannel: epoll_create1: " << SysStrError(NET_ERROR) << " - will use select()");
+        return;
+    }
+
+    m_iReadInterrupt = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev;
+    memset(&ev, 0, sizeof ev);
+    ev.events  = EPOLLIN;
+    ev.data.fd = m_iSocket;
+    bool ok    = m_iReadInterrupt != -1 && ::epoll_ctl(m_iReadEpoll, EPOLL_CTL_ADD, m_iSocket, &ev) == 0;
+    ev.data.fd = m_iReadInterrupt;
+    ok         = ok && ::epoll_ctl(m_iReadEpoll, EPOLL_CTL_ADD, m_iReadInterrupt, &ev) == 0;
+    if (!ok)
+    {
+        LOGC(kmlog.Warn, log << "CChannel: can't set up epoll: " << SysStrError(NET_ERROR) << " - will use select()");
+        if (m_iReadInterrupt != -1)
+            ::close(m_iReadInterrupt);
+        ::close(m_iReadEpoll);
+        m_iReadInterrupt = -1;
+        m_iReadEpoll     = -1;
+    }
+#endif
+}
+
+bool srt::CChannel::canInterruptRead() const
+{
+#ifdef LINUX
+    return m_iReadEpoll != -1;
+#else
+    return false;
+#endif
+}
+
+void srt::CChannel::interruptRead() const
+{
+#ifdef LINUX
+    if (m_iReadEpoll == -1)
+        return;
+
+    const uint64_t one = 1;
+    if (::write(m_iReadInterrupt, &one, sizeof one) == -1)
+    {
+        HLOGC(kmlog.Debug, log << "CChannel::interruptRead: " << SysStrError(NET_ERROR));
+    }
+#endif
 }
 
 int srt::CChannel::getSndBufSize()
@@ -896,23 +977,188 @@ int srt::CChannel::sendto(const sockaddr_any& addr, CPacket& packet, const socka
     return res;
 }
 
+int srt::CChannel::sendmany(const sockaddr_any* addrs,
+                            CPacket* const*     packets,
+                            const sockaddr_any* srcs,
+                            int                 size,
+                            int&                w_ncalls) const
+{
+    w_ncalls = 0;
+
+    // With fake loss the packets must go through sendto() one by one.
+#if defined(SRT_ENABLE_SENDMMSG) && !defined(SRT_TEST_FAKE_LOSS)
+    if (size > 1)
+    {
+#ifdef SRT_ENABLE_PKTINFO
+        static const size_t CMSG_PKTINFO_SIZE = sizeof(CMSGNodeIPv4) + sizeof(CMSGNodeIPv6);
+#else
+        static const size_t CMSG_PKTINFO_SIZE = 0;
+#endif
+#ifdef SRT_ENABLE_GSO
+        // Total size of a GSO message must fit in a single UDP datagram
+        // and the number of segments must not exceed UDP_MAX_SEGMENTS (64).
+        static const size_t GSO_MAX_BYTES    = 65000;
+        static const int    GSO_MAX_SEGMENTS = 64;
+        static const size_t CMSG_GSO_SIZE    = CMSG_SPACE(sizeof(uint16_t));
+#else
+        static const size_t CMSG_GSO_SIZE = 0;
+#endif
+        static const size_t CMSG_BUF_SIZE = CMSG_PKTINFO_SIZE + CMSG_GSO_SIZE;
+
+        if (m_SendHeaders.size() < size_t(size))
+        {
+            m_SendHeaders.resize(size);
+            m_SendVectors.resize(2 * size);
+            m_SendFirst.resize(size);
+            m_SendControl.resize(size * CMSG_BUF_SIZE);
+        }
+
+        int nmsgs = 0;
+        for (int i = 0; i < size; ++nmsgs)
+        {
+            const int first = i;
+            packets[i]->toNetworkByteOrder();
+            ++i;
+
+            const bool have_src SRT_ATR_UNUSED = !srcs[first].isany() && srcs[first].family() != AF_UNSPEC;
+            size_t     segsize SRT_ATR_UNUSED  = CPacket::HDR_SIZE + packets[first]->getLength();
+
+#ifdef SRT_ENABLE_GSO
+            // Coalesce the following packets of the same size (only the last
+            // one may be shorter) that go to the same destination from the
+            // same source.
+            if (m_bGSO)
+            {
+                size_t total = segsize;
+                while (i < size && i - first < GSO_MAX_SEGMENTS && addrs[i] == addrs[first])
+                {
+                    const bool next_have_src = !srcs[i].isany() && srcs[i].family() != AF_UNSPEC;
+                    if (next_have_src != have_src || (have_src && srcs[i] != srcs[first]))
+                        break;
+
+                    const size_t nextsize = CPacket::HDR_SIZE + packets[i]->getLength();
+                    if (nextsize > segsize || total + nextsize > GSO_MAX_BYTES)
+                        break;
+
+                    packets[i]->toNetworkByteOrder();
+                    total += nextsize;
+                    ++i;
+
+                    if (nextsize < segsize)
+                        break;
+                }
+            }
+#endif
+
+            for (int k = first; k < i; ++k)
+            {
+                iovec* iov = &m_SendVectors[2 * k];
+                for (int v = 0; v < 2; ++v)
+                {
+                    iov[v].iov_base = packets[k]->m_PacketVector[v].data();
+                    iov[v].iov_len  = packets[k]->m_PacketVector[v].size();
+                }
+            }
+
+            msghdr& mh        = m_SendHeaders[nmsgs].msg_hdr;
+            mh.msg_name       = (sockaddr*)addrs[first].get();
+            mh.msg_namelen    = addrs[first].size();
+            mh.msg_iov        = &m_SendVectors[2 * first];
+            mh.msg_iovlen     = 2 * (i - first);
+            mh.msg_control    = NULL;
+            mh.msg_controllen = 0;
+            mh.msg_flags      = 0;
+            m_SendFirst[nmsgs] = first;
+
+            char* ctrl_buf SRT_ATR_UNUSED = m_SendControl.empty() ? NULL : &m_SendControl[nmsgs * CMSG_BUF_SIZE];
+#ifdef SRT_ENABLE_PKTINFO
+            if (m_bBindMasked && have_src && !setSourceAddress(mh, ctrl_buf, srcs[first]))
+            {
+                LOGC(kslog.Error, log << "CChannel::setSourceAddress: source address invalid family #"
+                                      << srcs[first].family() << ", NOT setting.");
+            }
+#endif
+#ifdef SRT_ENABLE_GSO
+            if (i - first > 1)
+            {
+                // CMSG_SPACE is aligned, so the next node starts right after the existing ones.
+                cmsghdr* cmsg    = (cmsghdr*)(ctrl_buf + mh.msg_controllen);
+                cmsg->cmsg_level = IPPROTO_UDP;
+                cmsg->cmsg_type  = UDP_SEGMENT;
+                cmsg->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+                const uint16_t gso_size = uint16_t(segsize);
+                memcpy(CMSG_DATA(cmsg), &gso_size, sizeof gso_size);
+
+                mh.msg_control = ctrl_buf;
+                mh.msg_controllen += CMSG_GSO_SIZE;
+            }
+#endif
+        }
+
+        int sent_msgs = 0;
+        int sent_pkts = 0;
+        while (sent_msgs < nmsgs)
+        {
+            const int res = ::sendmmsg(m_iSocket, &m_SendHeaders[sent_msgs], nmsgs - sent_msgs, 0);
+            ++w_ncalls;
+            if (res > 0)
+            {
+                const int next = sent_msgs + res;
+                sent_pkts += (next < nmsgs ? m_SendFirst[next] : size) - m_SendFirst[sent_msgs];
+                sent_msgs = next;
+                continue;
+            }
+
+            const int err = NET_ERROR;
+#ifdef SRT_ENABLE_GSO
+            const int first = m_SendFirst[sent_msgs];
+            const int last  = sent_msgs + 1 < nmsgs ? m_SendFirst[sent_msgs + 1] : size;
+            if (last - first > 1 && (err == EIO || err == EINVAL || err == ENOPROTOOPT))
+            {
+                // GSO isn't supported by the kernel or the network device.
+                // Send the remaining packets without it.
+                LOGC(kslog.Warn, log << CONID() << "sendmmsg: UDP GSO refused: " << SysStrError(err) << " - disabling");
+                m_bGSO = false;
+                for (int k = 0; k < size; ++k)
+                    packets[k]->toHostByteOrder();
+
+                int ncalls = 0;
+                sent_pkts += sendmany(addrs + first, packets + first, srcs + first, size - first, (ncalls));
+                w_ncalls += ncalls;
+                return sent_pkts;
+            }
+#endif
+            // Skip the message that failed, just like sendto() ignores a failure.
+            HLOGC(kslog.Debug, log << CONID() << "sendmmsg: " << SysStrError(err) << " [" << err << "]");
+            ++sent_msgs;
+        }
+
+        for (int k = 0; k < size; ++k)
+            packets[k]->toHostByteOrder();
+
+        HLOGC(kslog.Debug, log << CONID() << "sendmmsg: sent " << sent_pkts << " of " << size << " packets in "
+                               << nmsgs << " messages, " << w_ncalls << " calls");
+        return sent_pkts;
+    }
+#endif
+
+    int sent_pkts = 0;
+    for (int i = 0; i < size; ++i)
+    {
+        if (sendto(addrs[i], *packets[i], srcs[i]) >= 0)
+            ++sent_pkts;
+        ++w_ncalls;
+    }
+    return sent_pkts;
+}
+
 srt::EReadStatus srt::CChannel::recvfrom(sockaddr_any& w_addr, CPacket& w_packet) const
 {
     EReadStatus status    = RST_OK;
     int         msg_flags = 0;
     int         recv_size = -1;
 
-#if defined(UNIX) || defined(_WIN32)
-    fd_set  set;
-    timeval tv;
-    FD_ZERO(&set);
-    FD_SET(m_iSocket, &set);
-    tv.tv_sec            = 0;
-    tv.tv_usec           = 10000;
-    const int select_ret = ::select((int)m_iSocket + 1, &set, NULL, &set, &tv);
-#else
-    const int select_ret = 1; // the socket is expected to be in the blocking mode itself
-#endif
+    const int select_ret = waitReadable();
 
     if (select_ret == 0) // timeout
     {
@@ -954,8 +1200,12 @@ srt::EReadStatus srt::CChannel::recvfrom(sockaddr_any& w_addr, CPacket& w_packet
 
         mh.msg_flags      = 0;
 
-        recv_size = (int)::recvmsg(m_iSocket, (&mh), 0);
+        recv_size = (int)::recvmsg(m_iSocket, (&mh), readFlags());
         msg_flags = mh.msg_flags;
+        ++m_llRecvSyscalls;
+#ifdef LINUX
+        m_bReadPending = recv_size > 0 && m_iReadEpoll != -1;
+#endif
     }
 
     // Note that there are exactly four groups of possible errors
@@ -1077,13 +1327,186 @@ srt::EReadStatus srt::CChannel::recvfrom(sockaddr_any& w_addr, CPacket& w_packet
         msg_flags = 1;
 #endif
 
+    status = checkReceived(recv_size, msg_flags, (w_packet));
+    if (status != RST_OK)
+        goto Return_error;
+
+    return RST_OK;
+
+Return_error:
+    w_packet.setLength(-1);
+    return status;
+}
+
+srt::EReadStatus srt::CChannel::recvmany(sockaddr_any* w_addrs,
+                                         CPacket* const* w_packets,
+                                         EReadStatus*    w_status,
+                                         int             size,
+                                         int&            w_nrecv) const
+{
+    w_nrecv = 0;
+
+#ifdef SRT_ENABLE_RECVMMSG
+    if (size > 1)
+    {
+        const int select_ret = waitReadable();
+        if (select_ret == 0) // timeout
+            return RST_AGAIN;
+
+        int nrecv = -1;
+        if (select_ret > 0)
+        {
+            if (m_RecvHeaders.size() < size_t(size))
+                m_RecvHeaders.resize(size);
+#ifdef SRT_ENABLE_PKTINFO
+            static const size_t CMSG_BUF_SIZE = sizeof(CMSGNodeIPv4) + sizeof(CMSGNodeIPv6);
+            if (m_bBindMasked && m_RecvControl.size() < size * CMSG_BUF_SIZE)
+                m_RecvControl.resize(size * CMSG_BUF_SIZE);
+#endif
+
+            for (int i = 0; i < size; ++i)
+            {
+                msghdr& mh = m_RecvHeaders[i].msg_hdr;
+                mh.msg_name       = (w_addrs[i].get());
+                mh.msg_namelen    = w_addrs[i].size();
+                mh.msg_iov        = (w_packets[i]->m_PacketVector);
+                mh.msg_iovlen     = 2;
+                mh.msg_control    = NULL;
+                mh.msg_controllen = 0;
+#ifdef SRT_ENABLE_PKTINFO
+                if (m_bBindMasked)
+                {
+                    mh.msg_control    = &m_RecvControl[i * CMSG_BUF_SIZE];
+                    mh.msg_controllen = CMSG_BUF_SIZE;
+                }
+#endif
+                mh.msg_flags            = 0;
+                m_RecvHeaders[i].msg_len = 0;
+            }
+
+            nrecv = ::recvmmsg(m_iSocket, &m_RecvHeaders[0], size, readFlags(), NULL);
+            ++m_llRecvSyscalls;
+#ifdef LINUX
+            m_bReadPending = nrecv > 0 && m_iReadEpoll != -1;
+#endif
+        }
+
+        // Errors are interpreted the same way as in recvfrom.
+        if (select_ret == -1 || nrecv == -1)
+        {
+            const int err = NET_ERROR;
+            if (err == EAGAIN || err == EINTR || err == ECONNREFUSED)
+                return RST_AGAIN;
+
+            HLOGC(krlog.Debug, log << CONID() << "(sys)recvmmsg: " << SysStrError(err) << " [" << err << "]");
+            return RST_ERROR;
+        }
+
+        for (int i = 0; i < nrecv; ++i)
+        {
+            const msghdr& mh = m_RecvHeaders[i].msg_hdr;
+            w_status[i] = checkReceived(int(m_RecvHeaders[i].msg_len), mh.msg_flags, (*w_packets[i]));
+            if (w_status[i] != RST_OK)
+            {
+                w_packets[i]->setLength(-1);
+                continue;
+            }
+#ifdef SRT_ENABLE_PKTINFO
+            if (m_bBindMasked)
+                w_packets[i]->m_DestAddr = getTargetAddress(mh);
+#endif
+        }
+
+        w_nrecv = nrecv;
+        HLOGC(krlog.Debug, log << CONID() << "(sys)recvmmsg: retrieved " << nrecv << " of max " << size << " packets");
+        return nrecv > 0 ? RST_OK : RST_AGAIN;
+    }
+#endif
+
+    if (size < 1)
+        return RST_AGAIN;
+
+    const EReadStatus st = recvfrom((w_addrs[0]), (*w_packets[0]));
+    if (st == RST_OK)
+    {
+        w_status[0] = RST_OK;
+        w_nrecv     = 1;
+    }
+    return st;
+}
+
+int srt::CChannel::waitReadable() const
+{
+#ifdef LINUX
+    if (m_iReadEpoll != -1)
+    {
+        // After a successful read there are likely more packets waiting,
+        // so try to read without waiting (see readFlags()).
+        if (m_bReadPending)
+            return 1;
+
+        // Round up, otherwise a timeout shorter than 1ms would spin.
+        const int timeout_ms = int((sync::count_microseconds(m_tdReadTimeout) + 999) / 1000);
+        epoll_event ev[2];
+        const int nev = ::epoll_wait(m_iReadEpoll, ev, 2, timeout_ms);
+        ++m_llRecvSyscalls;
+
+        int readable = nev == -1 ? -1 : 0;
+        for (int i = 0; i < nev; ++i)
+        {
+            if (ev[i].data.fd == m_iSocket)
+            {
+                readable = 1;
+                continue;
+            }
+
+            // Interrupted. Consume the notification, the caller will get RST_AGAIN,
+            // unless there's also something to read.
+            uint64_t count;
+            if (::read(m_iReadInterrupt, &count, sizeof count) == -1)
+            {
+                HLOGC(krlog.Debug, log << CONID() << "CChannel: eventfd read: " << SysStrError(NET_ERROR));
+            }
+            ++m_llRecvSyscalls;
+        }
+        return readable;
+    }
+#endif
+
+#if defined(UNIX) || defined(_WIN32)
+    // Without a way to interrupt the wait, wait no longer than 10ms.
+    const int64_t timeout_us = std::min<int64_t>(sync::count_microseconds(m_tdReadTimeout), 10000);
+    fd_set  set;
+    timeval tv;
+    FD_ZERO(&set);
+    FD_SET(m_iSocket, &set);
+    tv.tv_sec  = 0;
+    tv.tv_usec = long(timeout_us);
+    ++m_llRecvSyscalls;
+    return ::select((int)m_iSocket + 1, &set, NULL, &set, &tv);
+#else
+    return 1; // the socket is expected to be in the blocking mode itself
+#endif
+}
+
+int srt::CChannel::readFlags() const
+{
+#ifdef LINUX
+    // The read may be tried without waiting, so it must not block.
+    if (m_iReadEpoll != -1)
+        return MSG_DONTWAIT;
+#endif
+    return 0;
+}
+
+srt::EReadStatus srt::CChannel::checkReceived(int recv_size, int msg_flags, CPacket& w_packet) const
+{
     // Sanity check for a case when it didn't fill in even the header
     if (size_t(recv_size) < CPacket::HDR_SIZE)
     {
-        status = RST_AGAIN;
         HLOGC(krlog.Debug,
               log << CONID() << "POSSIBLE ATTACK: received too short packet with " << recv_size << " bytes");
-        goto Return_error;
+        return RST_AGAIN;
     }
 
     // Fix for an issue with Linux Kernel found during tests at Tencent.
@@ -1138,16 +1561,11 @@ srt::EReadStatus srt::CChannel::recvfrom(sockaddr_any& w_addr, CPacket& w_packet
               log << CONID() << "NET ERROR: packet size=" << recv_size << " msg_flags=0x" << hex << msg_flags
                   << ", detected flags:" << flg.str());
 #endif
-        status = RST_AGAIN;
-        goto Return_error;
+        return RST_AGAIN;
     }
 
     w_packet.setLength(recv_size - CPacket::HDR_SIZE);
     w_packet.toHostByteOrder();
 
     return RST_OK;
-
-Return_error:
-    w_packet.setLength(-1);
-    return status;
 }
@@ -53,10 +53,12 @@ modified by
 #define INC_SRT_CHANNEL_H
 
 #include "platform_sys.h"
+#include <vector>
 #include "udt.h"
 #include "packet.h"
 #include "socketconfig.h"
 #include "netinet_any.h"
+#include "sync.h"
 
 namespace srt
 {
@@ -119,6 +121,25 @@ public:
 
     int sendto(const sockaddr_any& addr, srt::CPacket& packet, const sockaddr_any& src) const;
 
+    /// Send multiple packets, with as few system calls as possible. Where
+    /// supported, consecutive packets of equal size for the same destination
+    /// are additionally coalesced into one UDP GSO (UDP_SEGMENT) message.
+    /// When batched sending isn't supported, every packet is sent by sendto().
+    /// @param [in] addrs array of @a size destination addresses.
+    /// @param [in] packets array of @a size pointers to CPacket entities.
+    /// @param [in] srcs array of @a size source addresses (see sendto()).
+    /// @param [in] size number of packets to send.
+    /// @param [out] ncalls number of system calls used.
+    /// @return Number of packets sent.
+    /// @note This function may be used only by the sender worker thread.
+
+    int sendmany(const sockaddr_any* addrs, srt::CPacket* const* packets, const sockaddr_any* srcs, int size, int& ncalls) const;
+
+    /// Get the maximum number of packets to be sent by sendmany().
+    /// @return Batch size as configured by SRTO_UDP_SNDBATCH.
+
+    int getSndBatchSize() const { return m_mcfg.iUDPSndBatch; }
+
     /// Receive a packet from the channel and record the source address.
     /// @param [in] addr pointer to the source address.
     /// @param [in] packet reference to a CPacket entity.
@@ -126,6 +147,45 @@ public:
 
     EReadStatus recvfrom(sockaddr_any& addr, srt::CPacket& packet) const;
 
+    /// Receive up to @a size packets from the channel in a single system call
+    /// and record the source address of each of them. When batched reception
+    /// isn't supported by the system, at most one packet is received.
+    /// @param [out] addrs array of @a size source addresses.
+    /// @param [in,out] packets array of @a size pointers to CPacket entities.
+    /// @param [out] status array of @a size statuses: RST_OK or RST_AGAIN if the packet is to be dropped.
+    /// @param [in] size capacity of the arrays.
+    /// @param [out] nrecv number of entries that have been filled in.
+    /// @return RST_OK if at least one packet was received, otherwise same as recvfrom.
+
+    EReadStatus recvmany(sockaddr_any* addrs, srt::CPacket* const* packets, EReadStatus* status, int size, int& nrecv) const;
+
+    /// Get the maximum number of packets to be retrieved by recvmany().
+    /// @return Batch size as configured by SRTO_UDP_RCVBATCH.
+
+    int getRcvBatchSize() const { return m_mcfg.iUDPRcvBatch; }
+
+    /// Set the maximum time that recvfrom() and recvmany() may wait for
+    /// a packet. Unless the wait can be interrupted (see interruptRead()),
+    /// it's additionally limited to 10ms.
+    /// @param [in] timeout maximum time to wait
+
+    void setReadTimeout(const sync::steady_clock::duration& timeout) { m_tdReadTimeout = timeout; }
+
+    /// Check if a thread waiting in recvfrom() or recvmany() can be woken up.
+    /// @return true if interruptRead() is effective.
+
+    bool canInterruptRead() const;
+
+    /// Wake up the thread waiting in recvfrom() or recvmany(), if supported.
+    /// The interrupted call returns RST_AGAIN.
+
+    void interruptRead() const;
+
+    /// Get the number of system calls made so far for receiving,
+    /// including waiting for the socket and reading attempts.
+
+    int64_t getRecvSyscalls() const { return m_llRecvSyscalls; }
+
     void setConfig(const CSrtMuxerConfig& config);
 
     void getSocketOption(int level, int sockoptname, char* pw_dataptr, socklen_t& w_len, int& w_status);
@@ -166,6 +226,19 @@ public:
 
 private:
     void setUDPSockOpt();
+    void createReadEvents();
+
+    /// Wait for the socket to become readable, up to the read timeout.
+    /// @return Same as ::select: 1 if readable, 0 on timeout or interruption, -1 on error.
+    int waitReadable() const;
+
+    /// Flags for the system receive call, following waitReadable().
+    int readFlags() const;
+
+    /// Check the packet after a successful system receive call
+    /// and convert it to the host byte order.
+    /// @return RST_OK if the packet is valid, RST_AGAIN if it should be dropped.
+    EReadStatus checkReceived(int recv_size, int msg_flags, srt::CPacket& w_packet) const;
 
 private:
     UDPSOCKET m_iSocket; // socket descriptor
@@ -176,6 +249,37 @@ private:
     mutable CSrtMuxerConfig m_mcfg; // Note: ReuseAddr is unused and ineffective.
     sockaddr_any            m_BindAddr;
 
+    sync::steady_clock::duration  m_tdReadTimeout;   // Maximum time to wait for a packet
+    mutable sync::atomic<int64_t> m_llRecvSyscalls;  // Written by the receiving thread only
+
+#ifdef LINUX
+    // The receiving thread waits on an epoll descriptor watching the socket
+    // and an eventfd used to interrupt the wait. When a packet has just been
+    // read, the next read is tried first (non-blocking) without waiting.
+    int          m_iReadEpoll;     // -1 if not available: fall back to ::select
+    int          m_iReadInterrupt; // eventfd descriptor
+    mutable bool m_bReadPending;   // Last read succeeded: try to read before waiting
+#endif
+
+#ifdef SRT_ENABLE_RECVMMSG
+    // Headers for ::recvmmsg, used exclusively by the receiving thread in recvmany().
+    mutable std::vector<mmsghdr> m_RecvHeaders;
+#ifdef SRT_ENABLE_PKTINFO
+    mutable std::vector<char> m_RecvControl; // Ancillary data buffers for m_RecvHeaders
+#endif
+#endif
+
+#ifdef SRT_ENABLE_SENDMMSG
+    // Headers for ::sendmmsg, used exclusively by the sender worker thread in sendmany().
+    mutable std::vector<mmsghdr> m_SendHeaders;
+    mutable std::vector<iovec>   m_SendVectors; // Two entries (header, payload) per packet
+    mutable std::vector<int>     m_SendFirst;   // Index of the first packet of every message
+    mutable std::vector<char>    m_SendControl; // Ancillary data buffers for m_SendHeaders
+#ifdef SRT_ENABLE_GSO
+    mutable bool m_bGSO; // Cleared when the system refuses UDP_SEGMENT
+#endif
+#endif
+
     // This feature is not enabled on Windows, for now.
     // This is also turned off in case of MinGW
 #ifdef SRT_ENABLE_PKTINFO
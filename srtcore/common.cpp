@@ -362,6 +362,68 @@ void srt::CMD5::compute(const char* input, unsigned char result[16])
    md5_finish(&state, result);
 }
 
+namespace
+{
+inline uint64_t sipRotl(uint64_t x, int b)
+{
+    return (x << b) | (x >> (64 - b));
+}
+
+inline uint64_t sipLoad64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3)
+{
+    v0 += v1; v1 = sipRotl(v1, 13); v1 ^= v0; v0 = sipRotl(v0, 32);
+    v2 += v3; v3 = sipRotl(v3, 16); v3 ^= v2;
+    v0 += v3; v3 = sipRotl(v3, 21); v3 ^= v0;
+    v2 += v1; v1 = sipRotl(v1, 17); v1 ^= v2; v2 = sipRotl(v2, 32);
+}
+} // namespace
+
+uint64_t srt::CSipHash::compute(const unsigned char key[KEY_SIZE], const void* data, size_t len)
+{
+    const uint64_t k0 = sipLoad64(key);
+    const uint64_t k1 = sipLoad64(key + 8);
+
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+    const unsigned char* in  = (const unsigned char*)data;
+    const unsigned char* end = in + (len - len % 8);
+    for (; in != end; in += 8)
+    {
+        const uint64_t m = sipLoad64(in);
+        v3 ^= m;
+        sipRound(v0, v1, v2, v3);
+        sipRound(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // The last block: the remaining bytes and the length in the top byte.
+    uint64_t b = uint64_t(len) << 56;
+    for (size_t i = 0; i < len % 8; ++i)
+        b |= uint64_t(in[i]) << (8 * i);
+
+    v3 ^= b;
+    sipRound(v0, v1, v2, v3);
+    sipRound(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xff;
+    for (int i = 0; i < 4; ++i)
+        sipRound(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
 namespace srt {
 std::string MessageTypeStr(UDTMessageType mt, uint32_t extt)
 {
@@ -871,6 +871,14 @@ struct CMD5
    static void compute(const char* input, unsigned char result[16]);
 };
 
+// SipHash-2-4: a keyed hash, fast for short inputs and resistant
+// to the attacker who does not know the key.
+struct CSipHash
+{
+   static const size_t KEY_SIZE = 16;
+   static uint64_t compute(const unsigned char key[KEY_SIZE], const void* data, size_t len);
+};
+
 // Debug stats
 template <size_t SIZE>
 class StatsLossRecords
@@ -48,6 +48,23 @@ SrtCongestionControlBase::SrtCongestionControlBase(CUDT* parent)
     m_dPktSndPeriod = 1;
 }
 
+int SrtCongestionControlBase::sndTrainSize()
+{
+    // Sending periods of at least this length are paced packet by packet.
+    static const double MIN_TRAIN_PERIOD_US = 100;
+
+    const int    maxtrain  = m_parent->m_config.iPacingTrain;
+    const double period_us = pktSndPeriod_us();
+    if (maxtrain <= 1 || period_us <= 0 || period_us >= MIN_TRAIN_PERIOD_US)
+        return 1;
+
+    // Enough packets to make the wake-ups about MIN_TRAIN_PERIOD_US apart,
+    // but a train can't take longer than RTT at the configured rate.
+    const int by_period = int(MIN_TRAIN_PERIOD_US / period_us);
+    const int by_rtt    = int(m_parent->SRTT() / period_us);
+    return max(1, min(maxtrain, min(by_period, by_rtt)));
+}
+
 void SrtCongestion::Check()
 {
     if (!congctl)
@@ -172,6 +172,11 @@ public:
 
     virtual int64_t sndBandwidth() { return 0; }
 
+    // Number of packets that may be sent back to back when the sender
+    // worker wakes up for this socket (SRTO_PACINGTRAIN). The next wake-up
+    // is then delayed by as many sending periods, so the rate is kept.
+    virtual int sndTrainSize();
+
     // If user-defined, will return nonzero value.
     // If not, it will be internally calculated.
     virtual int RTO() { return 0; }
@@ -61,6 +61,12 @@ modified by
 #include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include "srt.h"
 #include "access_control.h" // Required for SRT_REJX_FALLBACK
 #include "queue.h"
@@ -167,6 +173,13 @@ struct SrtOptionAction
         flags[SRTO_RCVBUF]             = SRTO_R_PREBIND;
         flags[SRTO_UDP_SNDBUF]         = SRTO_R_PREBIND;
         flags[SRTO_UDP_RCVBUF]         = SRTO_R_PREBIND;
+        flags[SRTO_UDP_RCVBATCH]       = SRTO_R_PREBIND;
+        flags[SRTO_UDP_SNDBATCH]       = SRTO_R_PREBIND;
+        flags[SRTO_RCVWORKERS]         = SRTO_R_PREBIND;
+        flags[SRTO_CRYPTOWORKERS]      = SRTO_R_PREBIND;
+        flags[SRTO_ACCEPTWORKERS]      = SRTO_R_PREBIND;
+        flags[SRTO_PACINGMODE]         = SRTO_R_PREBIND;
+        flags[SRTO_PACINGSPIN]         = SRTO_R_PREBIND;
         flags[SRTO_RENDEZVOUS]         = SRTO_R_PRE;
         flags[SRTO_REUSEADDR]          = SRTO_R_PREBIND;
         flags[SRTO_MAXBW]              = SRTO_POST_SPEC;
@@ -208,6 +221,8 @@ struct SrtOptionAction
 #endif
         flags[SRTO_PACKETFILTER]       = SRTO_R_PRE;
         flags[SRTO_RETRANSMITALGO]     = SRTO_R_PRE;
+        flags[SRTO_PACINGTRAIN]        = SRTO_R_PRE;
+        flags[SRTO_INDUCTIONRATE]      = SRTO_R_PRE;
 #ifdef ENABLE_AEAD_API_PREVIEW
         flags[SRTO_CRYPTOMODE]         = SRTO_R_PRE;
 #endif
@@ -293,12 +308,16 @@ void srt::CUDT::construct()
     m_RejectReason        = SRT_REJ_UNKNOWN;
     m_tsLastReqTime.store(steady_clock::time_point());
     m_SrtHsSide           = HSD_DRAW;
+    for (size_t i = 0; i < sizeof m_CookieSecret; ++i)
+        m_CookieSecret[i] = (unsigned char)genRandomInt(0, 255);
     m_uPeerSrtVersion     = 0;  // Not defined until connected.
     m_iTsbPdDelay_ms      = 0;
     m_iPeerTsbPdDelay_ms  = 0;
     m_bPeerTsbPd          = false;
     m_bTsbPd              = false;
     m_bTsbPdNeedsWakeup   = false;
+    m_bTsbPdShared        = false;
+    m_bEncryptPosted      = false;
     m_bGroupTsbPd         = false;
     m_bPeerTLPktDrop      = false;
     m_bBufferWasFull      = false;
@@ -517,6 +536,41 @@ void srt::CUDT::getOpt(SRT_SOCKOPT optName, void *optval, int &optlen)
         optlen         = sizeof(int);
         break;
 
+    case SRTO_UDP_RCVBATCH:
+        *(int *)optval = m_config.iUDPRcvBatch;
+        optlen         = sizeof(int);
+        break;
+
+    case SRTO_UDP_SNDBATCH:
+        *(int *)optval = m_config.iUDPSndBatch;
+        optlen         = sizeof(int);
+        break;
+
+    case SRTO_RCVWORKERS:
+        *(int *)optval = m_config.iRcvWorkers;
+        optlen         = sizeof(int);
+        break;
+
+    case SRTO_CRYPTOWORKERS:
+        *(int *)optval = m_config.iCryptoWorkers;
+        optlen         = sizeof(int);
+        break;
+
+    case SRTO_ACCEPTWORKERS:
+        *(int *)optval = m_config.iAcceptWorkers;
+        optlen         = sizeof(int);
+        break;
+
+    case SRTO_PACINGMODE:
+        *(int *)optval = m_config.iPacingMode;
+        optlen         = sizeof(int);
+        break;
+
+    case SRTO_PACINGSPIN:
+        *(int *)optval = m_config.iPacingSpin;
+        optlen         = sizeof(int);
+        break;
+
     case SRTO_RENDEZVOUS:
         *(bool *)optval = m_config.bRendezvous;
         optlen          = sizeof(bool);
@@ -839,6 +893,16 @@ void srt::CUDT::getOpt(SRT_SOCKOPT optName, void *optval, int &optlen)
         ((char*)optval)[optlen] = '\0';
         break;
 
+    case SRTO_PACINGTRAIN:
+        *(int32_t *)optval = m_config.iPacingTrain;
+        optlen             = sizeof(int32_t);
+        break;
+
+    case SRTO_INDUCTIONRATE:
+        *(int32_t *)optval = m_config.iInductionRate;
+        optlen             = sizeof(int32_t);
+        break;
+
     case SRTO_RETRANSMITALGO:
         *(int32_t *)optval = m_config.iRetransmitAlgo;
         optlen         = sizeof(int32_t);
@@ -930,7 +994,8 @@ void srt::CUDT::clearData()
         m_stats.tsLastSampleTime = steady_clock::now();
         m_stats.traceReorderDistance = 0;
         m_stats.traceBelatedTime = 0;
-        m_stats.sndDuration = m_stats.m_sndDurationTotal = 0;
+        m_stats.m_sndDurationTotal = 0;
+        m_stats.sndDurationBase = 0;
     }
 
     // Resetting these data because this happens when agent isn't connected.
@@ -966,11 +1031,14 @@ void srt::CUDT::open()
     m_pSNode->m_pUDT      = this;
     m_pSNode->m_tsTimeStamp = steady_clock::now();
     m_pSNode->m_iHeapLoc  = -1;
+    m_pSNode->m_bReady    = false;
+    m_pSNode->m_pNextReady = NULL;
 
     if (m_pRNode == NULL)
         m_pRNode = new CRNode;
     m_pRNode->m_pUDT      = this;
-    m_pRNode->m_tsTimeStamp = steady_clock::now();
+    m_pRNode->m_iTick     = 0;
+    m_pRNode->m_iSlot     = -1;
     m_pRNode->m_pPrev = m_pRNode->m_pNext = NULL;
     m_pRNode->m_bOnList                   = false;
 
@@ -1005,6 +1073,8 @@ void srt::CUDT::open()
     m_iLightACKCount = 1;
     m_tsNextSendTime = steady_clock::time_point();
     m_tdSendTimeDiff = microseconds_from(0);
+    m_iSndTrainLen   = 1;
+    m_iSndTrainLeft  = 0;
 
     // Now UDT is opened.
     m_bOpened = true;
@@ -3413,13 +3483,13 @@ void srt::CUDT::synchronizeWithGroup(CUDTGroup* gp)
     // thing may happen in the meantime.
     steady_clock::time_point start_time, peer_start_time;
 
-    start_time = m_stats.tsStartTime;
+    start_time = m_stats.tsStartTime.load();
     peer_start_time = m_tsRcvPeerStartTime;
 
     if (!gp->applyGroupTime((start_time), (peer_start_time)))
     {
         HLOGC(gmlog.Debug,
-              log << CONID() << "synchronizeWithGroup: ST=" << FormatTime(m_stats.tsStartTime) << " -> "
+              log << CONID() << "synchronizeWithGroup: ST=" << FormatTime(m_stats.tsStartTime.load()) << " -> "
                   << FormatTime(start_time) << " PST=" << FormatTime(m_tsRcvPeerStartTime) << " -> "
                   << FormatTime(peer_start_time));
         m_stats.tsStartTime  = start_time;
@@ -3429,7 +3499,7 @@ void srt::CUDT::synchronizeWithGroup(CUDTGroup* gp)
     {
         // This was the first connected socket and it defined start time.
         HLOGC(gmlog.Debug,
-              log << CONID() << "synchronizeWithGroup: ST=" << FormatTime(m_stats.tsStartTime)
+              log << CONID() << "synchronizeWithGroup: ST=" << FormatTime(m_stats.tsStartTime.load())
                   << " PST=" << FormatTime(m_tsRcvPeerStartTime));
     }
 
@@ -5442,148 +5512,13 @@ void * srt::CUDT::tsbpd(void* param)
     self->m_bTsbPdNeedsWakeup = true;
     while (!self->m_bClosing)
     {
-        steady_clock::time_point tsNextDelivery; // Next packet delivery time
-        bool                     rxready = false;
-#if ENABLE_BONDING
-        bool shall_update_group = false;
-#endif
-
         INCREMENT_THREAD_ITERATIONS();
 
-        enterCS(self->m_RcvBufferLock);
-        const steady_clock::time_point tnow = steady_clock::now();
-
-        self->m_pRcvBuffer->updRcvAvgDataSize(tnow);
-        const srt::CRcvBuffer::PacketInfo info = self->m_pRcvBuffer->getFirstValidPacketInfo();
-
-        const bool is_time_to_deliver = !is_zero(info.tsbpd_time) && (tnow >= info.tsbpd_time);
-        tsNextDelivery = info.tsbpd_time;
-
-#if ENABLE_HEAVY_LOGGING
-        if (info.seqno == SRT_SEQNO_NONE)
-        {
-            HLOGC(tslog.Debug, log << self->CONID() << "sok/tsbpd: packet check: NO PACKETS");
-        }
-        else
-        {
-            HLOGC(tslog.Debug, log << self->CONID() << "sok/tsbpd: packet check: %"
-                << info.seqno << " T=" << FormatTime(tsNextDelivery)
-                << " diff-now-playtime=" << FormatDuration(tnow - tsNextDelivery)
-                << " ready=" << is_time_to_deliver
-                << " ondrop=" << info.seq_gap);
-        }
-#endif
-
-        if (!self->m_bTLPktDrop)
-        {
-            rxready = !info.seq_gap && is_time_to_deliver;
-        }
-        else if (is_time_to_deliver)
-        {
-            rxready = true;
-            if (info.seq_gap)
-            {
-                const int iDropCnt SRT_ATR_UNUSED = self->rcvDropTooLateUpTo(info.seqno);
 #if ENABLE_BONDING
-                shall_update_group = true;
-#endif
-
-#if ENABLE_LOGGING
-                const int64_t timediff_us = count_microseconds(tnow - info.tsbpd_time);
-#if ENABLE_HEAVY_LOGGING
-                HLOGC(tslog.Debug,
-                    log << self->CONID() << "tsbpd: DROPSEQ: up to seqno %" << CSeqNo::decseq(info.seqno) << " ("
-                    << iDropCnt << " packets) playable at " << FormatTime(info.tsbpd_time) << " delayed "
-                    << (timediff_us / 1000) << "." << std::setw(3) << std::setfill('0') << (timediff_us % 1000) << " ms");
-#endif
-                string why;
-                if (self->frequentLogAllowed(FREQLOGFA_RCV_DROPPED, tnow, (why)))
-                {
-                    LOGC(brlog.Warn, log << self->CONID() << "RCV-DROPPED " << iDropCnt << " packet(s). Packet seqno %" << info.seqno
-                            << " delayed for " << (timediff_us / 1000) << "." << std::setw(3) << std::setfill('0')
-                            << (timediff_us % 1000) << " ms " << why);
-                }
-#if SRT_ENABLE_FREQUENT_LOG_TRACE
-                else
-                {
-                    LOGC(brlog.Warn, log << "SUPPRESSED: RCV-DROPPED LOG: " << why);
-                }
-#endif
-#endif
-
-                tsNextDelivery = steady_clock::time_point(); // Ready to read, nothing to wait for.
-            }
-        }
-        leaveCS(self->m_RcvBufferLock);
-
-        if (rxready)
-        {
-            HLOGC(tslog.Debug,
-                  log << self->CONID() << "tsbpd: PLAYING PACKET seq=" << info.seqno << " (belated "
-                      << FormatDuration<DUNIT_MS>(steady_clock::now() - info.tsbpd_time) << ")");
-            /*
-             * There are packets ready to be delivered
-             * signal a waiting "recv" call if there is any data available
-             */
-            if (self->m_config.bSynRecving)
-            {
-                recvdata_lcc.notify_one();
-            }
-            /*
-             * Set EPOLL_IN to wakeup any thread waiting on epoll
-             */
-            self->uglobal().m_EPoll.update_events(self->m_SocketID, self->m_sPollID, SRT_EPOLL_IN, true);
-#if ENABLE_BONDING
-            // If this is NULL, it means:
-            // - the socket never was a group member
-            // - the socket was a group member, but:
-            //    - was just removed as a part of closure
-            //    - and will never be member of the group anymore
-
-            // If this is not NULL, it means:
-            // - This socket is currently member of the group
-            // - This socket WAS a member of the group, though possibly removed from it already, BUT:
-            //   - the group that this socket IS OR WAS member of is in the GroupKeeper
-            //   - the GroupKeeper prevents the group from being deleted
-            //   - it is then completely safe to access the group here,
-            //     EVEN IF THE SOCKET THAT WAS ITS MEMBER IS BEING DELETED.
-
-            // It is ensured that the group object exists here because GroupKeeper
-            // keeps it busy, even if you just closed the socket, remove it as a member
-            // or even the group is empty and was explicitly closed.
-            if (gkeeper.group)
-            {
-                // Functions called below will lock m_GroupLock, which in hierarchy
-                // lies after m_RecvLock. Must unlock m_RecvLock to be able to lock
-                // m_GroupLock inside the calls.
-                InvertedLock unrecv(self->m_RecvLock);
-                // The current "APP reader" needs to simply decide as to whether
-                // the next CUDTGroup::recv() call should return with no blocking or not.
-                // When the group is read-ready, it should update its pollers as it sees fit.
-
-                // NOTE: this call will set lock to m_IncludedGroup->m_GroupLock
-                HLOGC(tslog.Debug, log << self->CONID() << "tsbpd: GROUP: checking if %" << info.seqno << " makes group readable");
-                gkeeper.group->updateReadState(self->m_SocketID, info.seqno);
-
-                if (shall_update_group)
-                {
-                    // A group may need to update the parallelly used idle links,
-                    // should it have any. Pass the current socket position in order
-                    // to skip it from the group loop.
-                    // NOTE: SELF LOCKING.
-                    gkeeper.group->updateLatestRcv(self->m_parent);
-                }
-            }
-
-            // After re-acquisition of the m_RecvLock, re-check the closing flag
-            if (self->m_bClosing)
-            {
-                break;
-            }
+        const steady_clock::time_point tsNextDelivery = self->tsbpdCheck(gkeeper.group);
+#else
+        const steady_clock::time_point tsNextDelivery = self->tsbpdCheck(NULL);
 #endif
-            CGlobEvent::triggerEvent();
-            tsNextDelivery = steady_clock::time_point(); // Ready to read, nothing to wait for.
-        }
 
         // We may just briefly unlocked the m_RecvLock, so we need to check m_bClosing again to avoid deadlock.
         if (self->m_bClosing)
@@ -5593,14 +5528,14 @@ void * srt::CUDT::tsbpd(void* param)
 
         if (!is_zero(tsNextDelivery))
         {
-            IF_HEAVY_LOGGING(const steady_clock::duration timediff = tsNextDelivery - tnow);
+            IF_HEAVY_LOGGING(const steady_clock::duration timediff = tsNextDelivery - steady_clock::now());
             /*
              * Buffer at head of queue is not ready to play.
              * Schedule wakeup when it will be.
              */
             self->m_bTsbPdNeedsWakeup = false;
             HLOGC(tslog.Debug,
-                  log << self->CONID() << "tsbpd: FUTURE PACKET seq=" << info.seqno
+                  log << self->CONID() << "tsbpd: FUTURE PACKET"
                       << " T=" << FormatTime(tsNextDelivery) << " - waiting " << FormatDuration<DUNIT_MS>(timediff));
             THREAD_PAUSED();
             bWokeUpOnSignal = tsbpd_cc.wait_until(tsNextDelivery);
@@ -5636,6 +5571,185 @@ void * srt::CUDT::tsbpd(void* param)
     return NULL;
 }
 
+steady_clock::time_point srt::CUDT::tsbpdCheck(CUDTGroup* group SRT_ATR_UNUSED)
+{
+    steady_clock::time_point tsNextDelivery; // Next packet delivery time
+    bool                     rxready = false;
+#if ENABLE_BONDING
+    bool shall_update_group = false;
+#endif
+
+    enterCS(m_RcvBufferLock);
+    const steady_clock::time_point tnow = steady_clock::now();
+
+    m_pRcvBuffer->updRcvAvgDataSize(tnow);
+    const srt::CRcvBuffer::PacketInfo info = m_pRcvBuffer->getFirstValidPacketInfo();
+
+    const bool is_time_to_deliver = !is_zero(info.tsbpd_time) && (tnow >= info.tsbpd_time);
+    tsNextDelivery = info.tsbpd_time;
+
+#if ENABLE_HEAVY_LOGGING
+    if (info.seqno == SRT_SEQNO_NONE)
+    {
+        HLOGC(tslog.Debug, log << CONID() << "sok/tsbpd: packet check: NO PACKETS");
+    }
+    else
+    {
+        HLOGC(tslog.Debug, log << CONID() << "sok/tsbpd: packet check: %"
+            << info.seqno << " T=" << FormatTime(tsNextDelivery)
+            << " diff-now-playtime=" << FormatDuration(tnow - tsNextDelivery)
+            << " ready=" << is_time_to_deliver
+            << " ondrop=" << info.seq_gap);
+    }
+#endif
+
+    if (!m_bTLPktDrop)
+    {
+        rxready = !info.seq_gap && is_time_to_deliver;
+    }
+    else if (is_time_to_deliver)
+    {
+        rxready = true;
+        if (info.seq_gap)
+        {
+            const int iDropCnt SRT_ATR_UNUSED = rcvDropTooLateUpTo(info.seqno);
+#if ENABLE_BONDING
+            shall_update_group = true;
+#endif
+
+#if ENABLE_LOGGING
+            const int64_t timediff_us = count_microseconds(tnow - info.tsbpd_time);
+#if ENABLE_HEAVY_LOGGING
+            HLOGC(tslog.Debug,
+                log << CONID() << "tsbpd: DROPSEQ: up to seqno %" << CSeqNo::decseq(info.seqno) << " ("
+                << iDropCnt << " packets) playable at " << FormatTime(info.tsbpd_time) << " delayed "
+                << (timediff_us / 1000) << "." << std::setw(3) << std::setfill('0') << (timediff_us % 1000) << " ms");
+#endif
+            string why;
+            if (frequentLogAllowed(FREQLOGFA_RCV_DROPPED, tnow, (why)))
+            {
+                LOGC(brlog.Warn, log << CONID() << "RCV-DROPPED " << iDropCnt << " packet(s). Packet seqno %" << info.seqno
+                        << " delayed for " << (timediff_us / 1000) << "." << std::setw(3) << std::setfill('0')
+                        << (timediff_us % 1000) << " ms " << why);
+            }
+#if SRT_ENABLE_FREQUENT_LOG_TRACE
+            else
+            {
+                LOGC(brlog.Warn, log << "SUPPRESSED: RCV-DROPPED LOG: " << why);
+            }
+#endif
+#endif
+
+            tsNextDelivery = steady_clock::time_point(); // Ready to read, nothing to wait for.
+        }
+    }
+    leaveCS(m_RcvBufferLock);
+
+    if (rxready)
+    {
+        HLOGC(tslog.Debug,
+              log << CONID() << "tsbpd: PLAYING PACKET seq=" << info.seqno << " (belated "
+                  << FormatDuration<DUNIT_MS>(steady_clock::now() - info.tsbpd_time) << ")");
+        /*
+         * There are packets ready to be delivered
+         * signal a waiting "recv" call if there is any data available
+         */
+        if (m_config.bSynRecving)
+        {
+            m_RecvDataCond.notify_one();
+        }
+        /*
+         * Set EPOLL_IN to wakeup any thread waiting on epoll
+         */
+        uglobal().m_EPoll.update_events(m_SocketID, m_sPollID, SRT_EPOLL_IN, true);
+#if ENABLE_BONDING
+        // If this is NULL, it means:
+        // - the socket never was a group member
+        // - the socket was a group member, but:
+        //    - was just removed as a part of closure
+        //    - and will never be member of the group anymore
+
+        // If this is not NULL, it means:
+        // - This socket is currently member of the group
+        // - This socket WAS a member of the group, though possibly removed from it already, BUT:
+        //   - the group that this socket IS OR WAS member of is in the GroupKeeper
+        //   - the GroupKeeper prevents the group from being deleted
+        //   - it is then completely safe to access the group here,
+        //     EVEN IF THE SOCKET THAT WAS ITS MEMBER IS BEING DELETED.
+
+        // It is ensured that the group object exists here because GroupKeeper
+        // keeps it busy, even if you just closed the socket, remove it as a member
+        // or even the group is empty and was explicitly closed.
+        if (group)
+        {
+            // Functions called below will lock m_GroupLock, which in hierarchy
+            // lies after m_RecvLock. Must unlock m_RecvLock to be able to lock
+            // m_GroupLock inside the calls.
+            InvertedLock unrecv(m_RecvLock);
+            // The current "APP reader" needs to simply decide as to whether
+            // the next CUDTGroup::recv() call should return with no blocking or not.
+            // When the group is read-ready, it should update its pollers as it sees fit.
+
+            // NOTE: this call will set lock to m_IncludedGroup->m_GroupLock
+            HLOGC(tslog.Debug, log << CONID() << "tsbpd: GROUP: checking if %" << info.seqno << " makes group readable");
+            group->updateReadState(m_SocketID, info.seqno);
+
+            if (shall_update_group)
+            {
+                // A group may need to update the parallelly used idle links,
+                // should it have any. Pass the current socket position in order
+                // to skip it from the group loop.
+                // NOTE: SELF LOCKING.
+                group->updateLatestRcv(m_parent);
+            }
+        }
+
+        // After re-acquisition of the m_RecvLock, re-check the closing flag
+        if (m_bClosing)
+        {
+            return steady_clock::time_point();
+        }
+
+        if (group)
+        {
+            // While m_RecvLock was unlocked, the group reader could have read this
+            // packet, or discarded it as read from another member. The kick from the
+            // reader and the ACK of the next packet were then lost, as this thread
+            // wasn't waiting, so check the buffer again instead of waiting for them.
+            ScopedLock lck(m_RcvBufferLock);
+            if (m_pRcvBuffer->getFirstValidPacketInfo().seqno != info.seqno)
+            {
+                CGlobEvent::triggerEvent();
+                return steady_clock::now();
+            }
+        }
+#endif
+        CGlobEvent::triggerEvent();
+        tsNextDelivery = steady_clock::time_point(); // Ready to read, nothing to wait for.
+    }
+
+    return tsNextDelivery;
+}
+
+steady_clock::time_point srt::CUDT::tsbpdCheckShared()
+{
+    UniqueLock recvlock (m_RecvLock);
+    if (m_bClosing)
+        return steady_clock::time_point();
+
+    const steady_clock::time_point tsNextDelivery = tsbpdCheck(NULL);
+
+    // Same as the TSBPD thread when going to wait.
+    m_bTsbPdNeedsWakeup = is_zero(tsNextDelivery);
+    return tsNextDelivery;
+}
+
+void srt::CUDT::wakeupSharedTsbPd()
+{
+    if (m_bTsbPdShared)
+        uglobal().tsbpdScheduler().wakeup(this);
+}
+
 int srt::CUDT::rcvDropTooLateUpTo(int seqno, DropReason reason)
 {
     // Make sure that it would not drop over m_iRcvCurrSeqNo, which may break senders.
@@ -5653,11 +5767,9 @@ int srt::CUDT::rcvDropTooLateUpTo(int seqno, DropReason reason)
     const int iDropStatCnt = (reason == DROP_DISCARD) ? iDropCnt : iDropCntTotal;
     if (iDropStatCnt > 0)
     {
-        enterCS(m_StatsLock);
         // Estimate dropped bytes from average payload size.
         const uint64_t avgpayloadsz = m_pRcvBuffer->getRcvAvgPayloadSize();
         m_stats.rcvr.dropped.count(stats::BytesPackets(iDropStatCnt * avgpayloadsz, (uint32_t)iDropStatCnt));
-        leaveCS(m_StatsLock);
     }
     return iDropCntTotal;
 }
@@ -5679,7 +5791,6 @@ void srt::CUDT::setInitialRcvSeq(int32_t isn)
             LOGC(cnlog.Error, log << CONID() << "IPE: setInitialRcvSeq expected empty RCV buffer. Dropping all.");
             const int        iDropCnt     = m_pRcvBuffer->dropAll();
             const uint64_t   avgpayloadsz = m_pRcvBuffer->getRcvAvgPayloadSize();
-            sync::ScopedLock sl(m_StatsLock);
             m_stats.rcvr.dropped.count(stats::BytesPackets(iDropCnt * avgpayloadsz, (uint32_t) iDropCnt));
         }
 
@@ -5758,7 +5869,7 @@ bool srt::CUDT::prepareBuffers(CUDTException* eout)
 
         m_pSndBuffer = new CSndBuffer(AF_INET, 32, m_iMaxSRTPayloadSize, authtag);
         SRT_ASSERT(m_iPeerISN != -1);
-        m_pRcvBuffer = new srt::CRcvBuffer(m_iPeerISN, m_config.iRcvBufSize, m_pRcvQueue->m_pUnitQueue, m_config.bMessageAPI);
+        m_pRcvBuffer = new srt::CRcvBuffer(m_iPeerISN, m_config.iRcvBufSize, m_pRcvQueue->unitQueueOf(m_SocketID), m_config.bMessageAPI);
         // After introducing lite ACK, the sndlosslist may not be cleared in time, so it requires twice a space.
         m_pSndLossList = new CSndLossList(m_iFlowWindowSize * 2);
         m_pRcvLossList = new CRcvLossList(m_config.iFlightFlagSize);
@@ -6113,7 +6224,7 @@ SRT_REJECT_REASON srt::CUDT::setupCC()
         {
             // The filter configurer is build the way that allows to quit immediately
             // exit by exception, but the exception is meant for the filter only.
-            status = m_PacketFilter.configure(this, m_pRcvQueue->m_pUnitQueue, m_config.sPacketFilterConfig.str());
+            status = m_PacketFilter.configure(this, m_pRcvQueue->unitQueueOf(m_SocketID), m_config.sPacketFilterConfig.str());
         }
         catch (CUDTException& )
         {
@@ -6324,9 +6435,9 @@ bool srt::CUDT::closeInternal() ATR_NOEXCEPT
 
     // Make a copy under a lock because other thread might access it
     // at the same time.
-    enterCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.lock_shared();
     set<int> epollid = m_sPollID;
-    leaveCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.unlock_shared();
 
     // trigger any pending IO events.
     HLOGC(smlog.Debug, log << CONID() << "close: SETTING ERR readiness on E" << Printable(epollid));
@@ -6355,9 +6466,9 @@ bool srt::CUDT::closeInternal() ATR_NOEXCEPT
     // IMPORTANT: there's theoretically little time between setting ERR readiness
     // and unsubscribing, however if there's an application waiting on this event,
     // it should be informed before this below instruction locks the epoll mutex.
-    enterCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.lock();
     m_sPollID.clear();
-    leaveCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.unlock();
 
     // XXX What's this, could any of the above actions make it !m_bOpened?
     if (!m_bOpened)
@@ -6417,6 +6528,11 @@ bool srt::CUDT::closeInternal() ATR_NOEXCEPT
     ScopedLock sendguard(m_SendLock);
     ScopedLock recvguard(m_RecvLock);
 
+    // The crypto worker must be done with this socket before the
+    // crypto control is reset and the socket is possibly deleted.
+    if (m_pSndQueue)
+        m_pSndQueue->cancelEncryption(this);
+
     // Locking m_RcvBufferLock to protect calling to m_pCryptoControl->decrypt((packet))
     // from the processData(...) function while resetting Crypto Control.
     enterCS(m_RcvBufferLock);
@@ -6539,6 +6655,7 @@ int srt::CUDT::receiveBuffer(char *data, int len)
     {
         HLOGP(tslog.Debug, "Ping TSBPD thread to schedule wakeup");
         tscond.notify_one_locked(recvguard);
+        wakeupSharedTsbPd();
     }
     else
     {
@@ -6598,9 +6715,7 @@ int srt::CUDT::sndDropTooLate()
     m_iFlowWindowSize = m_iFlowWindowSize + dpkts;
 
     // If some packets were dropped update stats, socket state, loss list and the parent group if any.
-    enterCS(m_StatsLock);
     m_stats.sndr.dropped.count(stats::BytesPackets((uint64_t) dbytes, (uint32_t) dpkts));
-    leaveCS(m_StatsLock);
 
     IF_HEAVY_LOGGING(const int32_t realack = m_iSndLastDataAck);
     const int32_t fakeack = CSeqNo::incseq(m_iSndLastDataAck, dpkts);
@@ -6660,6 +6775,23 @@ int srt::CUDT::sendmsg(const char *data, int len, int msttl, bool inorder, int64
 // GroupLock is applied when this function is called from inside CUDTGroup::send,
 // which is the only case when the m_parent->m_GroupOf is not NULL.
 int srt::CUDT::sendmsg2(const char *data, int len, SRT_MSGCTRL& w_mctrl)
+{
+    return sendPayload(data, len, NULL, NULL, NULL, (w_mctrl));
+}
+
+int srt::CUDT::sendmsgFill(int len, srt_send_fill_fn* fill, void* opaque, SRT_MSGCTRL& w_mctrl)
+{
+    return sendPayload(NULL, len, fill, opaque, NULL, (w_mctrl));
+}
+
+// [[using maybe_locked(CUDTGroup::m_GroupLock, m_parent->m_GroupOf != NULL)]]
+int srt::CUDT::sendmsgShared(CSndSharedPayload& payload, SRT_MSGCTRL& w_mctrl)
+{
+    return sendPayload(payload.data(), payload.length(), NULL, NULL, &payload, (w_mctrl));
+}
+
+int srt::CUDT::sendPayload(const char* data, int len, srt_send_fill_fn* fill, void* opaque,
+                           CSndSharedPayload* shared, SRT_MSGCTRL& w_mctrl)
 {
     // throw an exception if not connected
     if (m_bBroken || m_bClosing)
@@ -6845,7 +6977,6 @@ int srt::CUDT::sendmsg2(const char *data, int len, SRT_MSGCTRL& w_mctrl)
     // record total time used for sending
     if (m_pSndBuffer->getCurrBufSize() == 0)
     {
-        ScopedLock lock(m_StatsLock);
         m_stats.sndDurationCounter = steady_clock::now();
     }
 
@@ -6900,9 +7031,9 @@ int srt::CUDT::sendmsg2(const char *data, int len, SRT_MSGCTRL& w_mctrl)
         HLOGC(aslog.Debug, log << CONID() << "buf:SENDING (BEFORE) srctime:"
                 << (w_mctrl.srctime ? FormatTime(ts_srctime) : "none")
                 << " DATA SIZE: " << size << " sched-SEQUENCE: " << seqno
-                << " STAMP: " << BufferStamp(data, size));
+                << " STAMP: " << (data ? BufferStamp(data, size) : string("(filled)")));
 
-        if (w_mctrl.srctime && w_mctrl.srctime < count_microseconds(m_stats.tsStartTime.time_since_epoch()))
+        if (w_mctrl.srctime && w_mctrl.srctime < count_microseconds(m_stats.tsStartTime.load().time_since_epoch()))
         {
             LOGC(aslog.Error,
                 log << CONID() << "Wrong source time was provided. Sending is rejected.");
@@ -6923,13 +7054,27 @@ int srt::CUDT::sendmsg2(const char *data, int len, SRT_MSGCTRL& w_mctrl)
         // - OUTPUT: value of the sequence number to be put on the first packet at the next sendmsg2 call.
         // We need to supply to the output the value that was STAMPED ON THE PACKET,
         // which is seqno. In the output we'll get the next sequence number.
-        m_pSndBuffer->addBuffer(data, size, (w_mctrl));
+        // The payload encrypted in the sender buffer can't be shared.
+        if (shared && size == len && m_pCryptoControl && m_pCryptoControl->getSndCryptoFlags() == EK_NOENC
+            && m_pSndBuffer->addShared(*shared, (w_mctrl)))
+        {
+            HLOGC(aslog.Debug, log << CONID() << "buf:SENDING: payload shared, not copied");
+        }
+        else if (!fill)
+        {
+            m_pSndBuffer->addBuffer(data, size, (w_mctrl));
+        }
+        else if (!m_pSndBuffer->addBuffer(fill, opaque, size, (w_mctrl)))
+        {
+            // Nothing was scheduled and w_mctrl was restored.
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+        }
         m_iSndNextSeqNo = w_mctrl.pktseq;
         w_mctrl.pktseq = seqno;
 
         HLOGC(aslog.Debug, log << CONID() << "buf:SENDING srctime:" << FormatTime(ts_srctime)
               << " size=" << size << " #" << w_mctrl.msgno << " SCHED %" << orig_seqno
-              << "(>> %" << seqno << ") !" << BufferStamp(data, size));
+              << "(>> %" << seqno << ") !" << (data ? BufferStamp(data, size) : string("(filled)")));
 
         if (sndBuffersLeft() < 1) // XXX Not sure if it should test if any space in the buffer, or as requried.
         {
@@ -6938,6 +7083,8 @@ int srt::CUDT::sendmsg2(const char *data, int len, SRT_MSGCTRL& w_mctrl)
         }
     }
 
+    postEncryptAhead();
+
     // Insert this socket to the snd list if it is not on the list already.
     // m_pSndUList->pop may lock CSndUList::m_ListLock and then m_RecvAckLock
     m_pSndQueue->m_pSndUList->update(this, CSndUList::DONT_RESCHEDULE);
@@ -7000,6 +7147,53 @@ int srt::CUDT::recvmsg2(char* data, int len, SRT_MSGCTRL& w_mctrl)
     return receiveBuffer(data, len);
 }
 
+int srt::CUDT::recvmsgView(srt_recv_view_fn* view, void* opaque, SRT_MSGCTRL& w_mctrl)
+{
+#if ENABLE_BONDING
+    if (m_parent->m_GroupOf && m_parent->m_GroupOf->isGroupReceiver())
+    {
+        LOGP(arlog.Error, "recv*: This socket is a receiver group member. Use group ID, NOT socket ID.");
+        throw CUDTException(MJ_NOTSUP, MN_INVALMSGAPI, 0);
+    }
+#endif
+
+    if (!m_bConnected || !m_CongCtl.ready())
+        throw CUDTException(MJ_CONNECTION, MN_NOCONN, 0);
+
+    // In the stream mode the payload isn't split into messages.
+    if (!m_config.bMessageAPI)
+        throw CUDTException(MJ_NOTSUP, MN_INVALBUFFERAPI, 0);
+
+    // There's no user buffer, so there's also no limit of the message size.
+    return receiveMessage(NULL, std::numeric_limits<int>::max(), (w_mctrl), 1, view, opaque);
+}
+
+namespace srt
+{
+struct RecvView
+{
+    srt_recv_view_fn* fn;
+    void*             opaque;
+};
+
+static bool passToRecvView(char* data, int len, int dst_offset, void* arg)
+{
+    const RecvView* v = reinterpret_cast<const RecvView*>(arg);
+    v->fn(v->opaque, data, dst_offset, len);
+    return true;
+}
+} // namespace srt
+
+// [[using locked(m_RcvBufferLock)]]
+int srt::CUDT::readRcvMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, srt_recv_view_fn* view, void* opaque)
+{
+    if (!view)
+        return m_pRcvBuffer->readMessage(data, len, &w_mctrl);
+
+    RecvView v = { view, opaque };
+    return m_pRcvBuffer->readMessageTo(len, passToRecvView, &v, &w_mctrl);
+}
+
 // [[using locked(m_RcvBufferLock)]]
 size_t srt::CUDT::getAvailRcvBufferSizeNoLock() const
 {
@@ -7027,7 +7221,7 @@ bool srt::CUDT::isRcvBufferFull() const
 // - 0 - by return value
 // - 1 - by exception
 // - 2 - by abort (unused)
-int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_exception)
+int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_exception, srt_recv_view_fn* view, void* opaque)
 {
     // Recvmsg isn't restricted to the congctl type, it's the most
     // basic method of passing the data. You can retrieve data as
@@ -7064,7 +7258,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
         HLOGC(arlog.Debug, log << CONID() << "receiveMessage: CONNECTION BROKEN - reading from recv buffer just for formality");
         enterCS(m_RcvBufferLock);
         const int res = (m_pRcvBuffer->isRcvDataReady(steady_clock::now()))
-            ? m_pRcvBuffer->readMessage(data, len, &w_mctrl)
+            ? readRcvMessage(data, len, (w_mctrl), view, opaque)
             : 0;
         leaveCS(m_RcvBufferLock);
 
@@ -7073,6 +7267,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
         {
             HLOGP(tslog.Debug, "Ping TSBPD thread to schedule wakeup");
             tscond.notify_one_locked(recvguard);
+            wakeupSharedTsbPd();
         }
         else
         {
@@ -7103,7 +7298,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
         HLOGC(arlog.Debug, log << CONID() << "receiveMessage: BEGIN ASYNC MODE. Going to extract payload size=" << len);
         enterCS(m_RcvBufferLock);
         const int res = (m_pRcvBuffer->isRcvDataReady(steady_clock::now()))
-            ? m_pRcvBuffer->readMessage(data, len, &w_mctrl)
+            ? readRcvMessage(data, len, (w_mctrl), view, opaque)
             : 0;
         leaveCS(m_RcvBufferLock);
         HLOGC(arlog.Debug, log << CONID() << "AFTER readMsg: (NON-BLOCKING) result=" << res);
@@ -7116,6 +7311,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
             {
                 HLOGP(arlog.Debug, "receiveMessage: nothing to read, kicking TSBPD, return AGAIN");
                 tscond.notify_one_locked(recvguard);
+                wakeupSharedTsbPd();
             }
             else
             {
@@ -7137,6 +7333,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
             {
                 HLOGP(arlog.Debug, "receiveMessage: DATA READ, but nothing more - kicking TSBPD.");
                 tscond.notify_one_locked(recvguard);
+                wakeupSharedTsbPd();
             }
             else
             {
@@ -7181,6 +7378,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
 
                 HLOGC(tslog.Debug, log << CONID() << "receiveMessage: KICK tsbpd");
                 tscond.notify_one_locked(recvguard);
+                wakeupSharedTsbPd();
             }
 
             THREAD_PAUSED();
@@ -7222,7 +7420,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
                 */
 
         enterCS(m_RcvBufferLock);
-        res = m_pRcvBuffer->readMessage((data), len, &w_mctrl);
+        res = readRcvMessage((data), len, (w_mctrl), view, opaque);
         leaveCS(m_RcvBufferLock);
         HLOGC(arlog.Debug, log << CONID() << "AFTER readMsg: (BLOCKING) result=" << res);
 
@@ -7258,6 +7456,7 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
         {
             HLOGP(tslog.Debug, "recvmsg: KICK tsbpd() (buffer empty)");
             tscond.notify_one_locked(recvguard);
+            wakeupSharedTsbPd();
         }
 
         // Shut up EPoll if no more messages in non-blocking mode
@@ -7278,7 +7477,193 @@ int srt::CUDT::receiveMessage(char* data, int len, SRT_MSGCTRL& w_mctrl, int by_
     return res;
 }
 
-int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int block)
+namespace srt
+{
+namespace
+{
+    // Sources and sinks of the file transmission in CUDT::sendfileFrom()
+    // and CUDT::recvfileTo(), wrapping the C++ stream or a file descriptor.
+
+    struct StreamFileSource
+    {
+        fstream& ifs;
+
+        explicit StreamFileSource(fstream& s) : ifs(s) {}
+
+        bool seek(int64_t offset, int64_t& w_size)
+        {
+            try
+            {
+                if (w_size == -1)
+                {
+                    ifs.seekg(0, std::ios::end);
+                    w_size = ifs.tellg();
+                    if (offset > w_size)
+                        return false;
+                }
+
+                // This will also set the position back to the beginning
+                // in case when it was moved to the end for measuring the size.
+                // This will also fail if the offset exceeds size, so measuring
+                // the size can be skipped if not needed.
+                ifs.seekg((streamoff)offset);
+                return ifs.good();
+            }
+            catch (...)
+            {
+                // XXX It would be nice to note that this is reported
+                // by exception only if explicitly requested by setting
+                // the exception flags in the stream. Here it's fixed so
+                // that when this isn't set, the exception is "thrown manually".
+                return false;
+            }
+        }
+
+        bool failed() const { return ifs.fail(); }
+        bool eof() const { return ifs.eof(); }
+
+        int addTo(CSndBuffer& buf, int len) { return buf.addBufferFromFile(ifs, len); }
+    };
+
+    struct StreamFileSink
+    {
+        fstream& ofs;
+
+        explicit StreamFileSink(fstream& s) : ofs(s) {}
+
+        bool seek(int64_t offset)
+        {
+            try
+            {
+                if (offset > 0)
+                {
+                    // Don't do anything around here if the offset == 0, as this
+                    // is the default offset after opening. Whether this operation
+                    // is performed correctly, it highly depends on how the file
+                    // has been open. For example, if you want to overwrite parts
+                    // of an existing file, the file must exist, and the ios::trunc
+                    // flag must not be set. If the file is open for only ios::out,
+                    // then the file will be truncated since the offset position on
+                    // at the time when first written; if ios::in|ios::out, then
+                    // it won't be truncated, just overwritten.
+
+                    // What is required here is that if offset is 0, don't try to
+                    // change the offset because this might be impossible with
+                    // the current flag set anyway.
+
+                    // Also check the status manually because you don't know,
+                    // as well, whether the user has set exception flags.
+
+                    ofs.seekp((streamoff)offset);
+                    return ofs.good();
+                }
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        bool failed() const { return ofs.fail(); }
+
+        int readFrom(CRcvBuffer& buf, int len) { return buf.readBufferToFile(ofs, len); }
+    };
+
+#ifndef _WIN32
+    // Reads the file with pread() at the explicit offset, so the file
+    // position of the descriptor is neither used nor changed.
+    struct FdFileSource
+    {
+        int     fd;
+        int64_t pos;
+        bool    error;
+        bool    end;
+
+        explicit FdFileSource(int f) : fd(f), pos(0), error(false), end(false) {}
+
+        bool seek(int64_t offset, int64_t& w_size)
+        {
+            if (offset < 0)
+                return false;
+
+            if (w_size == -1)
+            {
+                struct stat st;
+                if (::fstat(fd, &st) == -1)
+                    return false;
+                w_size = st.st_size;
+                if (offset > w_size)
+                    return false;
+            }
+
+            pos = offset;
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd, offset, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            return true;
+        }
+
+        bool failed() const { return error; }
+        bool eof() const { return end; }
+
+        int addTo(CSndBuffer& buf, int len) { return buf.addBufferFromFile(read, this, len); }
+
+        // Fills the whole block, unless the file ends earlier.
+        static int read(char* dst, int len, void* arg)
+        {
+            FdFileSource& self = *reinterpret_cast<FdFileSource*>(arg);
+            int           done = 0;
+            while (done < len && !self.error && !self.end)
+            {
+                const ssize_t res = ::pread(self.fd, dst + done, len - done, self.pos);
+                if (res > 0)
+                {
+                    done += int(res);
+                    self.pos += res;
+                }
+                else if (res == 0)
+                    self.end = true;
+                else if (errno != EINTR)
+                    self.error = true;
+            }
+            return done;
+        }
+    };
+
+    // Writes the file with pwritev() at the explicit offset.
+    struct FdFileSink
+    {
+        int     fd;
+        int64_t pos;
+        bool    error;
+
+        explicit FdFileSink(int f) : fd(f), pos(0), error(false) {}
+
+        bool seek(int64_t offset)
+        {
+            pos = offset;
+            return offset >= 0;
+        }
+
+        bool failed() const { return error; }
+
+        int readFrom(CRcvBuffer& buf, int len)
+        {
+            const int res = buf.readBufferToFd(fd, pos, len);
+            if (res < 0)
+                error = true;
+            else
+                pos += res;
+            return res;
+        }
+    };
+#endif
+} // namespace
+} // namespace srt
+
+template <class Source>
+int64_t srt::CUDT::sendfileFrom(Source& src, int64_t& offset, int64_t size, int block)
 {
     if (m_bBroken || m_bClosing)
         throw CUDTException(MJ_CONNECTION, MN_CONNLOST, 0);
@@ -7310,32 +7695,8 @@ int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int blo
     }
 
     // positioning...
-    try
-    {
-        if (size == -1)
-        {
-            ifs.seekg(0, std::ios::end);
-            size = ifs.tellg();
-            if (offset > size)
-                throw 0; // let it be caught below
-        }
-
-        // This will also set the position back to the beginning
-        // in case when it was moved to the end for measuring the size.
-        // This will also fail if the offset exceeds size, so measuring
-        // the size can be skipped if not needed.
-        ifs.seekg((streamoff)offset);
-        if (!ifs.good())
-            throw 0;
-    }
-    catch (...)
-    {
-        // XXX It would be nice to note that this is reported
-        // by exception only if explicitly requested by setting
-        // the exception flags in the stream. Here it's fixed so
-        // that when this isn't set, the exception is "thrown manually".
+    if (!src.seek(offset, (size)))
         throw CUDTException(MJ_FILESYSTEM, MN_SEEKGFAIL);
-    }
 
     int64_t tosend = size;
     int     unitsize;
@@ -7343,10 +7704,10 @@ int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int blo
     // sending block by block
     while (tosend > 0)
     {
-        if (ifs.fail())
+        if (src.failed())
             throw CUDTException(MJ_FILESYSTEM, MN_WRITEFAIL);
 
-        if (ifs.eof())
+        if (src.eof())
             break;
 
         unitsize = int((tosend >= block) ? block : tosend);
@@ -7374,13 +7735,12 @@ int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int blo
         // record total time used for sending
         if (m_pSndBuffer->getCurrBufSize() == 0)
         {
-            ScopedLock lock(m_StatsLock);
             m_stats.sndDurationCounter = steady_clock::now();
         }
 
         {
             ScopedLock        recvAckLock(m_RecvAckLock);
-            const int64_t sentsize = m_pSndBuffer->addBufferFromFile(ifs, unitsize);
+            const int64_t sentsize = src.addTo(*m_pSndBuffer, unitsize);
 
             if (sentsize > 0)
             {
@@ -7395,6 +7755,8 @@ int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int blo
             }
         }
 
+        postEncryptAhead();
+
         // insert this socket to snd list if it is not on the list yet
         m_pSndQueue->m_pSndUList->update(this, CSndUList::DONT_RESCHEDULE);
     }
@@ -7402,7 +7764,22 @@ int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int blo
     return size - tosend;
 }
 
-int64_t srt::CUDT::recvfile(fstream &ofs, int64_t &offset, int64_t size, int block)
+int64_t srt::CUDT::sendfile(fstream &ifs, int64_t &offset, int64_t size, int block)
+{
+    StreamFileSource src (ifs);
+    return sendfileFrom(src, (offset), size, block);
+}
+
+#ifndef _WIN32
+int64_t srt::CUDT::sendfile(int fd, int64_t &offset, int64_t size, int block)
+{
+    FdFileSource src (fd);
+    return sendfileFrom(src, (offset), size, block);
+}
+#endif
+
+template <class Sink>
+int64_t srt::CUDT::recvfileTo(Sink& dst, int64_t& offset, int64_t size, int block)
 {
     if (!m_bConnected || !m_CongCtl.ready())
         throw CUDTException(MJ_CONNECTION, MN_NOCONN, 0);
@@ -7433,41 +7810,8 @@ int64_t srt::CUDT::recvfile(fstream &ofs, int64_t &offset, int64_t size, int blo
     // have a chance to work or not.
 
     // positioning...
-    try
-    {
-        if (offset > 0)
-        {
-            // Don't do anything around here if the offset == 0, as this
-            // is the default offset after opening. Whether this operation
-            // is performed correctly, it highly depends on how the file
-            // has been open. For example, if you want to overwrite parts
-            // of an existing file, the file must exist, and the ios::trunc
-            // flag must not be set. If the file is open for only ios::out,
-            // then the file will be truncated since the offset position on
-            // at the time when first written; if ios::in|ios::out, then
-            // it won't be truncated, just overwritten.
-
-            // What is required here is that if offset is 0, don't try to
-            // change the offset because this might be impossible with
-            // the current flag set anyway.
-
-            // Also check the status and CAUSE exception manually because
-            // you don't know, as well, whether the user has set exception
-            // flags.
-
-            ofs.seekp((streamoff)offset);
-            if (!ofs.good())
-                throw 0; // just to get caught :)
-        }
-    }
-    catch (...)
-    {
-        // XXX It would be nice to note that this is reported
-        // by exception only if explicitly requested by setting
-        // the exception flags in the stream. For a case, when it's not,
-        // an additional explicit throwing happens when failbit is set.
+    if (!dst.seek(offset))
         throw CUDTException(MJ_FILESYSTEM, MN_SEEKPFAIL);
-    }
 
     int64_t torecv   = size;
     int     unitsize = block;
@@ -7476,7 +7820,7 @@ int64_t srt::CUDT::recvfile(fstream &ofs, int64_t &offset, int64_t size, int blo
     // receiving... "recvfile" is always blocking
     while (torecv > 0)
     {
-        if (ofs.fail())
+        if (dst.failed())
         {
             // send the sender a signal so it will not be blocked forever
             int32_t err_code = CUDTException::EFILE;
@@ -7505,7 +7849,7 @@ int64_t srt::CUDT::recvfile(fstream &ofs, int64_t &offset, int64_t size, int blo
 
         unitsize = int((torecv > block) ? block : torecv);
         enterCS(m_RcvBufferLock);
-        recvsize = m_pRcvBuffer->readBufferToFile(ofs, unitsize);
+        recvsize = dst.readFrom(*m_pRcvBuffer, unitsize);
         leaveCS(m_RcvBufferLock);
 
         if (recvsize > 0)
@@ -7524,6 +7868,20 @@ int64_t srt::CUDT::recvfile(fstream &ofs, int64_t &offset, int64_t size, int blo
     return size - torecv;
 }
 
+int64_t srt::CUDT::recvfile(fstream &ofs, int64_t &offset, int64_t size, int block)
+{
+    StreamFileSink dst (ofs);
+    return recvfileTo(dst, (offset), size, block);
+}
+
+#ifndef _WIN32
+int64_t srt::CUDT::recvfile(int fd, int64_t &offset, int64_t size, int block)
+{
+    FdFileSink dst (fd);
+    return recvfileTo(dst, (offset), size, block);
+}
+#endif
+
 void srt::CUDT::bstats(CBytePerfMon *perf, bool clear, bool instantaneous)
 {
     if (!m_bConnected)
@@ -7535,81 +7893,89 @@ void srt::CUDT::bstats(CBytePerfMon *perf, bool clear, bool instantaneous)
     {
         int32_t flight_span = getFlightSpan();
 
+        // The counters are read without blocking the threads counting them.
+        // The lock only serializes the readers, which keep the trace period.
         ScopedLock statsguard(m_StatsLock);
 
         const steady_clock::time_point currtime = steady_clock::now();
 
-        perf->msTimeStamp          = count_milliseconds(currtime - m_stats.tsStartTime);
-        perf->pktSent              = m_stats.sndr.sent.trace.count();
-        perf->pktSentUnique        = m_stats.sndr.sentUnique.trace.count();
-        perf->pktRecv              = m_stats.rcvr.recvd.trace.count();
-        perf->pktRecvUnique        = m_stats.rcvr.recvdUnique.trace.count();
-
-        perf->pktSndLoss           = m_stats.sndr.lost.trace.count();
-        perf->pktRcvLoss           = m_stats.rcvr.lost.trace.count();
-        perf->pktRetrans           = m_stats.sndr.sentRetrans.trace.count();
-        perf->pktRcvRetrans        = m_stats.rcvr.recvdRetrans.trace.count();
-        perf->pktSentACK           = m_stats.rcvr.sentAck.trace.count();
-        perf->pktRecvACK           = m_stats.sndr.recvdAck.trace.count();
-        perf->pktSentNAK           = m_stats.rcvr.sentNak.trace.count();
-        perf->pktRecvNAK           = m_stats.sndr.recvdNak.trace.count();
-        perf->usSndDuration        = m_stats.sndDuration;
+        stats::Sender::Sample   sndr;
+        stats::Receiver::Sample rcvr;
+        m_stats.sndr.sample((sndr), clear);
+        m_stats.rcvr.sample((rcvr), clear);
+        const int64_t sndDurationTotal = m_stats.m_sndDurationTotal;
+
+        perf->msTimeStamp          = count_milliseconds(currtime - m_stats.tsStartTime.load());
+        perf->pktSent              = sndr.sent.trace.count();
+        perf->pktSentUnique        = sndr.sentUnique.trace.count();
+        perf->pktRecv              = rcvr.recvd.trace.count();
+        perf->pktRecvUnique        = rcvr.recvdUnique.trace.count();
+
+        perf->pktSndLoss           = sndr.lost.trace.count();
+        perf->pktRcvLoss           = rcvr.lost.trace.count();
+        perf->pktRetrans           = sndr.sentRetrans.trace.count();
+        perf->pktRcvRetrans        = rcvr.recvdRetrans.trace.count();
+        perf->pktSentACK           = rcvr.sentAck.trace.count();
+        perf->pktRecvACK           = sndr.recvdAck.trace.count();
+        perf->pktSentNAK           = rcvr.sentNak.trace.count();
+        perf->pktRecvNAK           = sndr.recvdNak.trace.count();
+        perf->usSndDuration        = sndDurationTotal - m_stats.sndDurationBase;
         perf->pktReorderDistance   = m_stats.traceReorderDistance;
         perf->pktReorderTolerance  = m_iReorderTolerance;
-        perf->pktRcvAvgBelatedTime = m_stats.traceBelatedTime;
-        perf->pktRcvBelated        = m_stats.rcvr.recvdBelated.trace.count();
+        perf->pktRcvAvgBelatedTime = m_stats.traceBelatedTime / 1000.0;
+        perf->pktRcvBelated        = rcvr.recvdBelated.trace.count();
 
-        perf->pktSndFilterExtra  = m_stats.sndr.sentFilterExtra.trace.count();
-        perf->pktRcvFilterExtra  = m_stats.rcvr.recvdFilterExtra.trace.count();
-        perf->pktRcvFilterSupply = m_stats.rcvr.suppliedByFilter.trace.count();
-        perf->pktRcvFilterLoss   = m_stats.rcvr.lossFilter.trace.count();
+        perf->pktSndFilterExtra  = sndr.sentFilterExtra.trace.count();
+        perf->pktRcvFilterExtra  = rcvr.recvdFilterExtra.trace.count();
+        perf->pktRcvFilterSupply = rcvr.suppliedByFilter.trace.count();
+        perf->pktRcvFilterLoss   = rcvr.lossFilter.trace.count();
 
         /* perf byte counters include all headers (SRT+UDP+IP) */
-        perf->byteSent       = m_stats.sndr.sent.trace.bytesWithHdr(pktHdrSize);
-        perf->byteSentUnique = m_stats.sndr.sentUnique.trace.bytesWithHdr(pktHdrSize);
-        perf->byteRecv       = m_stats.rcvr.recvd.trace.bytesWithHdr(pktHdrSize);
-        perf->byteRecvUnique = m_stats.rcvr.recvdUnique.trace.bytesWithHdr(pktHdrSize);
-        perf->byteRetrans    = m_stats.sndr.sentRetrans.trace.bytesWithHdr(pktHdrSize);
-        perf->byteRcvLoss    = m_stats.rcvr.lost.trace.bytesWithHdr(pktHdrSize);
-
-        perf->pktSndDrop  = m_stats.sndr.dropped.trace.count();
-        perf->pktRcvDrop  = m_stats.rcvr.dropped.trace.count();
-        perf->byteSndDrop = m_stats.sndr.dropped.trace.bytesWithHdr(pktHdrSize);
-        perf->byteRcvDrop = m_stats.rcvr.dropped.trace.bytesWithHdr(pktHdrSize);
-        perf->pktRcvUndecrypt  = m_stats.rcvr.undecrypted.trace.count();
-        perf->byteRcvUndecrypt = m_stats.rcvr.undecrypted.trace.bytes();
-
-        perf->pktSentTotal       = m_stats.sndr.sent.total.count();
-        perf->pktSentUniqueTotal = m_stats.sndr.sentUnique.total.count();
-        perf->pktRecvTotal       = m_stats.rcvr.recvd.total.count();
-        perf->pktRecvUniqueTotal = m_stats.rcvr.recvdUnique.total.count();
-        perf->pktSndLossTotal    = m_stats.sndr.lost.total.count();
-        perf->pktRcvLossTotal    = m_stats.rcvr.lost.total.count();
-        perf->pktRetransTotal    = m_stats.sndr.sentRetrans.total.count();
-        perf->pktSentACKTotal    = m_stats.rcvr.sentAck.total.count();
-        perf->pktRecvACKTotal    = m_stats.sndr.recvdAck.total.count();
-        perf->pktSentNAKTotal    = m_stats.rcvr.sentNak.total.count();
-        perf->pktRecvNAKTotal    = m_stats.sndr.recvdNak.total.count();
-        perf->usSndDurationTotal = m_stats.m_sndDurationTotal;
-
-        perf->byteSentTotal           = m_stats.sndr.sent.total.bytesWithHdr(pktHdrSize);
-        perf->byteSentUniqueTotal     = m_stats.sndr.sentUnique.total.bytesWithHdr(pktHdrSize);
-        perf->byteRecvTotal           = m_stats.rcvr.recvd.total.bytesWithHdr(pktHdrSize);
-        perf->byteRecvUniqueTotal     = m_stats.rcvr.recvdUnique.total.bytesWithHdr(pktHdrSize);
-        perf->byteRetransTotal        = m_stats.sndr.sentRetrans.total.bytesWithHdr(pktHdrSize);
-        perf->pktSndFilterExtraTotal  = m_stats.sndr.sentFilterExtra.total.count();
-        perf->pktRcvFilterExtraTotal  = m_stats.rcvr.recvdFilterExtra.total.count();
-        perf->pktRcvFilterSupplyTotal = m_stats.rcvr.suppliedByFilter.total.count();
-        perf->pktRcvFilterLossTotal   = m_stats.rcvr.lossFilter.total.count();
-
-        perf->byteRcvLossTotal = m_stats.rcvr.lost.total.bytesWithHdr(pktHdrSize);
-        perf->pktSndDropTotal  = m_stats.sndr.dropped.total.count();
-        perf->pktRcvDropTotal  = m_stats.rcvr.dropped.total.count();
+        perf->byteSent       = sndr.sent.trace.bytesWithHdr(pktHdrSize);
+        perf->byteSentUnique = sndr.sentUnique.trace.bytesWithHdr(pktHdrSize);
+        perf->byteRecv       = rcvr.recvd.trace.bytesWithHdr(pktHdrSize);
+        perf->byteRecvUnique = rcvr.recvdUnique.trace.bytesWithHdr(pktHdrSize);
+        perf->byteRetrans    = sndr.sentRetrans.trace.bytesWithHdr(pktHdrSize);
+        perf->byteRcvLoss    = rcvr.lost.trace.bytesWithHdr(pktHdrSize);
+
+        perf->pktSndDrop  = sndr.dropped.trace.count();
+        perf->pktRcvDrop  = rcvr.dropped.trace.count();
+        perf->byteSndDrop = sndr.dropped.trace.bytesWithHdr(pktHdrSize);
+        perf->byteRcvDrop = rcvr.dropped.trace.bytesWithHdr(pktHdrSize);
+        perf->pktRcvUndecrypt  = rcvr.undecrypted.trace.count();
+        perf->byteRcvUndecrypt = rcvr.undecrypted.trace.bytes();
+
+        perf->pktSentTotal       = sndr.sent.total.count();
+        perf->pktSentUniqueTotal = sndr.sentUnique.total.count();
+        perf->pktRecvTotal       = rcvr.recvd.total.count();
+        perf->pktRecvUniqueTotal = rcvr.recvdUnique.total.count();
+        perf->pktSndLossTotal    = sndr.lost.total.count();
+        perf->pktRcvLossTotal    = rcvr.lost.total.count();
+        perf->pktRetransTotal    = sndr.sentRetrans.total.count();
+        perf->pktSentACKTotal    = rcvr.sentAck.total.count();
+        perf->pktRecvACKTotal    = sndr.recvdAck.total.count();
+        perf->pktSentNAKTotal    = rcvr.sentNak.total.count();
+        perf->pktRecvNAKTotal    = sndr.recvdNak.total.count();
+        perf->usSndDurationTotal = sndDurationTotal;
+
+        perf->byteSentTotal           = sndr.sent.total.bytesWithHdr(pktHdrSize);
+        perf->byteSentUniqueTotal     = sndr.sentUnique.total.bytesWithHdr(pktHdrSize);
+        perf->byteRecvTotal           = rcvr.recvd.total.bytesWithHdr(pktHdrSize);
+        perf->byteRecvUniqueTotal     = rcvr.recvdUnique.total.bytesWithHdr(pktHdrSize);
+        perf->byteRetransTotal        = sndr.sentRetrans.total.bytesWithHdr(pktHdrSize);
+        perf->pktSndFilterExtraTotal  = sndr.sentFilterExtra.total.count();
+        perf->pktRcvFilterExtraTotal  = rcvr.recvdFilterExtra.total.count();
+        perf->pktRcvFilterSupplyTotal = rcvr.suppliedByFilter.total.count();
+        perf->pktRcvFilterLossTotal   = rcvr.lossFilter.total.count();
+
+        perf->byteRcvLossTotal = rcvr.lost.total.bytesWithHdr(pktHdrSize);
+        perf->pktSndDropTotal  = sndr.dropped.total.count();
+        perf->pktRcvDropTotal  = rcvr.dropped.total.count();
         // TODO: The payload is dropped. Probably header sizes should not be counted?
-        perf->byteSndDropTotal = m_stats.sndr.dropped.total.bytesWithHdr(pktHdrSize);
-        perf->byteRcvDropTotal = m_stats.rcvr.dropped.total.bytesWithHdr(pktHdrSize);
-        perf->pktRcvUndecryptTotal  = m_stats.rcvr.undecrypted.total.count();
-        perf->byteRcvUndecryptTotal = m_stats.rcvr.undecrypted.total.bytes();
+        perf->byteSndDropTotal = sndr.dropped.total.bytesWithHdr(pktHdrSize);
+        perf->byteRcvDropTotal = rcvr.dropped.total.bytesWithHdr(pktHdrSize);
+        perf->pktRcvUndecryptTotal  = rcvr.undecrypted.total.count();
+        perf->byteRcvUndecryptTotal = rcvr.undecrypted.total.bytes();
 
         // TODO: The following class members must be protected with a different mutex, not the m_StatsLock.
         const double interval     = (double) count_microseconds(currtime - m_stats.tsLastSampleTime);
@@ -7630,14 +7996,39 @@ void srt::CUDT::bstats(CBytePerfMon *perf, bool clear, bool instantaneous)
 
         if (clear)
         {
-            m_stats.sndr.resetTrace();
-            m_stats.rcvr.resetTrace();
-
-            m_stats.sndDuration = 0;
+            m_stats.sndDurationBase  = sndDurationTotal;
             m_stats.tsLastSampleTime = currtime;
         }
     }
 
+    if (m_pRcvQueue)
+    {
+        m_pRcvQueue->getRecvStats((perf->muxRecvCallsTotal),
+                                  (perf->pktMuxRecvTotal),
+                                  (perf->pktMuxRecvBatchMax),
+                                  (perf->muxRecvSyscallsTotal));
+    }
+    else
+    {
+        perf->muxRecvCallsTotal    = 0;
+        perf->pktMuxRecvTotal      = 0;
+        perf->pktMuxRecvBatchMax   = 0;
+        perf->muxRecvSyscallsTotal = 0;
+    }
+
+    if (m_pSndQueue)
+    {
+        m_pSndQueue->getSendStats((perf->muxSendCallsTotal), (perf->pktMuxSentTotal), (perf->pktMuxSendBatchMax));
+        m_pSndQueue->getPacingStats((perf->muxPacingLateHist));
+    }
+    else
+    {
+        perf->muxSendCallsTotal  = 0;
+        perf->pktMuxSentTotal    = 0;
+        perf->pktMuxSendBatchMax = 0;
+        memset(perf->muxPacingLateHist, 0, sizeof perf->muxPacingLateHist);
+    }
+
     const int64_t availbw = m_iBandwidth == 1 ? m_RcvTimeWindow.getBandwidth() : m_iBandwidth.load();
 
     perf->mbpsBandwidth = Bps2Mbps(availbw * (m_iMaxSRTPayloadSize + pktHdrSize));
@@ -7827,6 +8218,7 @@ void srt::CUDT::initSynch()
     setupCond(m_SendBlockCond, "SendBlock");
     setupCond(m_RecvDataCond, "RecvData");
     setupMutex(m_SendLock, "Send");
+    setupMutex(m_SndCryptoLock, "SndCrypto");
     setupMutex(m_RecvLock, "Recv");
     setupMutex(m_RcvLossLock, "RcvLoss");
     setupMutex(m_RecvAckLock, "RecvAck");
@@ -7850,6 +8242,7 @@ void srt::CUDT::destroySynch()
     m_RecvDataCond.notify_all();
     releaseCond(m_RecvDataCond);
     releaseMutex(m_SendLock);
+    releaseMutex(m_SndCryptoLock);
     releaseMutex(m_RecvLock);
     releaseMutex(m_RcvLossLock);
     releaseMutex(m_RecvAckLock);
@@ -7887,6 +8280,10 @@ void srt::CUDT::releaseSynch()
     {
         m_RcvTsbPdThread.join();
     }
+    else if (m_bTsbPdShared)
+    {
+        uglobal().tsbpdScheduler().remove(this);
+    }
     leaveCS(m_RcvTsbPdStartupLock);
 
     // Acquiring the m_RecvLock it is assumed that both tsbpd()
@@ -7963,9 +8360,7 @@ void srt::CUDT::sendCtrl(UDTMessageType pkttype, const int32_t* lparam, void* rp
             ctrlpkt.set_id(m_PeerID);
             nbsent        = m_pSndQueue->sendto(m_PeerAddr, ctrlpkt, m_SourceAddr);
 
-            enterCS(m_StatsLock);
             m_stats.rcvr.sentNak.count(1);
-            leaveCS(m_StatsLock);
         }
         // Call with no arguments - get loss list from internal data.
         else if (m_pRcvLossList->getLossLength() > 0)
@@ -7984,9 +8379,7 @@ void srt::CUDT::sendCtrl(UDTMessageType pkttype, const int32_t* lparam, void* rp
                 ctrlpkt.set_id(m_PeerID);
                 nbsent        = m_pSndQueue->sendto(m_PeerAddr, ctrlpkt, m_SourceAddr);
 
-                enterCS(m_StatsLock);
                 m_stats.rcvr.sentNak.count(1);
-                leaveCS(m_StatsLock);
             }
 
             delete[] data;
@@ -8240,7 +8633,10 @@ int srt::CUDT::sendCtrlAck(CPacket& ctrlpkt, int size)
             CUniqueSync tslcc (m_RecvLock, m_RcvTsbPdCond);
             // m_bTsbPdAckWakeup is protected by m_RecvLock in the tsbpd() thread
             if (m_bTsbPdNeedsWakeup)
+            {
                 tslcc.notify_one();
+                wakeupSharedTsbPd();
+            }
         }
         else
         {
@@ -8367,9 +8763,7 @@ int srt::CUDT::sendCtrlAck(CPacket& ctrlpkt, int size)
 
         m_ACKWindow.store(m_iAckSeqNo, m_iRcvLastAck);
 
-        enterCS(m_StatsLock);
         m_stats.rcvr.sentAck.count(1);
-        leaveCS(m_StatsLock);
     }
     else
     {
@@ -8460,11 +8854,8 @@ void srt::CUDT::updateSndLossListOnACK(int32_t ackdata_seqno)
     }
 
     // record total time used for sending
-    enterCS(m_StatsLock);
-    m_stats.sndDuration += count_microseconds(currtime - m_stats.sndDurationCounter);
-    m_stats.m_sndDurationTotal += count_microseconds(currtime - m_stats.sndDurationCounter);
+    m_stats.m_sndDurationTotal.fetch_add(count_microseconds(currtime - m_stats.sndDurationCounter.load()));
     m_stats.sndDurationCounter = currtime;
-    leaveCS(m_StatsLock);
 }
 
 void srt::CUDT::processCtrlAck(const CPacket &ctrlpkt, const steady_clock::time_point& currtime)
@@ -8633,9 +9024,7 @@ void srt::CUDT::processCtrlAck(const CPacket &ctrlpkt, const steady_clock::time_
     {
         // Suppose transmission is bidirectional if sender is also receiving
         // data packets.
-        enterCS(m_StatsLock);
-        const bool bPktsReceived = m_stats.rcvr.recvd.total.count() != 0;
-        leaveCS(m_StatsLock);
+        const bool bPktsReceived = m_stats.rcvr.recvd.total().count() != 0;
 
         if (bPktsReceived)  // Transmission is bidirectional.
         {
@@ -8725,9 +9114,7 @@ void srt::CUDT::processCtrlAck(const CPacket &ctrlpkt, const steady_clock::time_
 
     updateCC(TEV_ACK, EventVariant(ackdata_seqno));
 
-    enterCS(m_StatsLock);
     m_stats.sndr.recvdAck.count(1);
-    leaveCS(m_StatsLock);
 }
 
 void srt::CUDT::processCtrlAckAck(const CPacket& ctrlpkt, const time_point& tsArrival)
@@ -8921,9 +9308,7 @@ void srt::CUDT::processCtrlLossReport(const CPacket& ctrlpkt)
                     sendCtrl(UMSG_DROPREQ, &no_msgno, seqpair, sizeof(seqpair));
                 }
 
-                enterCS(m_StatsLock);
                 m_stats.sndr.lost.count(num);
-                leaveCS(m_StatsLock);
             }
             // ELSE the loss is a single seq
             else
@@ -8945,9 +9330,7 @@ void srt::CUDT::processCtrlLossReport(const CPacket& ctrlpkt)
                             log << CONID() << "LOSSREPORT: adding %" << losslist[i] << " (1 packet) to loss list");
                     const int num = m_pSndLossList->insert(losslist[i], losslist[i]);
 
-                    enterCS(m_StatsLock);
                     m_stats.sndr.lost.count(num);
-                    leaveCS(m_StatsLock);
                 }
                 // ELSE loss_seq %< m_iSndLastAck
                 else
@@ -8984,9 +9367,7 @@ void srt::CUDT::processCtrlLossReport(const CPacket& ctrlpkt)
     // the lost packet (retransmission) should be sent out immediately
     m_pSndQueue->m_pSndUList->update(this, CSndUList::DONT_RESCHEDULE);
 
-    enterCS(m_StatsLock);
     m_stats.sndr.recvdNak.count(1);
-    leaveCS(m_StatsLock);
 }
 
 void srt::CUDT::processCtrlHS(const CPacket& ctrlpkt)
@@ -9120,7 +9501,6 @@ void srt::CUDT::processCtrlDropReq(const CPacket& ctrlpkt)
 
             if (iDropCnt > 0)
             {
-                ScopedLock lg (m_StatsLock);
                 const steady_clock::time_point tnow = steady_clock::now();
                 string why;
                 if (frequentLogAllowed(FREQLOGFA_RCV_DROPPED, tnow, (why)))
@@ -9148,6 +9528,7 @@ void srt::CUDT::processCtrlDropReq(const CPacket& ctrlpkt)
         {
             HLOGP(inlog.Debug, "DROPREQ: signal TSBPD");
             rcvtscc.notify_one();
+            wakeupSharedTsbPd();
         }
     }
 
@@ -9326,7 +9707,7 @@ void srt::CUDT::updateSrtSndSettings()
         HLOGC(cnlog.Debug, log << "AFTER HS: Set Snd TsbPd mode "
                 << (m_bPeerTLPktDrop ? "with" : "without")
                 << " TLPktDrop: delay=" << (m_iPeerTsbPdDelay_ms/1000) << "." << (m_iPeerTsbPdDelay_ms%1000)
-                << "s START TIME: " << FormatTime(m_stats.tsStartTime).c_str());
+                << "s START TIME: " << FormatTime(m_stats.tsStartTime.load()).c_str());
     }
     else
     {
@@ -9485,9 +9866,7 @@ int srt::CUDT::packLostData(CPacket& w_packet)
         // Therefore unlocking in order not to block other threads.
         ackguard.unlock();
 
-        enterCS(m_StatsLock);
         m_stats.sndr.sentRetrans.count(payload);
-        leaveCS(m_StatsLock);
 
         // Despite the contextual interpretation of packet.m_iMsgNo around
         // CSndBuffer::readData version 2 (version 1 doesn't return -1), in this particular
@@ -9597,17 +9976,13 @@ snd_logger g_snd_logger;
 
 void srt::CUDT::setPacketTS(CPacket& p, const time_point& ts)
 {
-    enterCS(m_StatsLock);
-    const time_point tsStart = m_stats.tsStartTime;
-    leaveCS(m_StatsLock);
+    const time_point tsStart = m_stats.tsStartTime.load();
     p.set_timestamp(makeTS(ts, tsStart));
 }
 
 void srt::CUDT::setDataPacketTS(CPacket& p, const time_point& ts)
 {
-    enterCS(m_StatsLock);
-    const time_point tsStart = m_stats.tsStartTime;
-    leaveCS(m_StatsLock);
+    const time_point tsStart = m_stats.tsStartTime.load();
 
     if (!m_bPeerTsbPd)
     {
@@ -9648,7 +10023,7 @@ bool srt::CUDT::isRetransmissionAllowed(const time_point& tnow SRT_ATR_UNUSED)
     const int msNextUniqueToSend = count_milliseconds(tnow - tsNextPacket) + m_iPeerTsbPdDelay_ms;
 
     g_snd_logger.state.tsNow = tnow;
-    g_snd_logger.state.usElapsed = count_microseconds(tnow - m_stats.tsStartTime);
+    g_snd_logger.state.usElapsed = count_microseconds(tnow - m_stats.tsStartTime.load());
     g_snd_logger.state.usSRTT = m_iSRTT;
     g_snd_logger.state.usRTTVar = m_iRTTVar;
     g_snd_logger.state.msSndBuffSpan = buffdelay_ms;
@@ -9725,7 +10100,6 @@ bool srt::CUDT::packData(CPacket& w_packet, steady_clock::time_point& w_nexttime
         IF_HEAVY_LOGGING(reason = "filter");
 
         // Stats
-        ScopedLock lg(m_StatsLock);
         m_stats.sndr.sentFilterExtra.count(1);
     }
     else
@@ -9734,6 +10108,7 @@ bool srt::CUDT::packData(CPacket& w_packet, steady_clock::time_point& w_nexttime
         {
             m_tsNextSendTime = steady_clock::time_point();
             m_tdSendTimeDiff = steady_clock::duration();
+            m_iSndTrainLeft  = 0;
             return false;
         }
         new_packet_packed = true;
@@ -9777,11 +10152,20 @@ bool srt::CUDT::packData(CPacket& w_packet, steady_clock::time_point& w_nexttime
     // different thread than the rest of the signals.
     // m_pSndTimeWindow->onPktSent(w_packet.timestamp());
 
-    enterCS(m_StatsLock);
     m_stats.sndr.sent.count(payload);
     if (new_packet_packed)
         m_stats.sndr.sentUnique.count(payload);
-    leaveCS(m_StatsLock);
+
+    if (m_iSndTrainLeft == 0)
+    {
+        // Start a packet train (SRTO_PACINGTRAIN), not longer than the packets
+        // ready to send, so that it's not cut short leaving the time borrowed.
+        m_iSndTrainLen = m_CongCtl->sndTrainSize();
+        if (m_iSndTrainLen > 1)
+            m_iSndTrainLen = 1 + m_pSndBuffer->countUnsent(m_iSndTrainLen - 1);
+        m_iSndTrainLeft = m_iSndTrainLen;
+    }
+    --m_iSndTrainLeft;
 
     const duration sendint = m_tdSendInterval;
     if (probe)
@@ -9792,10 +10176,19 @@ bool srt::CUDT::packData(CPacket& w_packet, steady_clock::time_point& w_nexttime
         m_tdSendTimeDiff = m_tdSendTimeDiff.load() - sendint;
         probe          = false;
     }
+    else if (m_iSndTrainLeft > 0)
+    {
+        // Send the rest of the train immediately. The time borrowed
+        // is paid back by delaying the packet after the last one.
+        m_tsNextSendTime = enter_time;
+#if !USE_BUSY_WAITING
+        m_tdSendTimeDiff = m_tdSendTimeDiff.load() - sendint;
+#endif
+    }
     else
     {
 #if USE_BUSY_WAITING
-        m_tsNextSendTime = enter_time + m_tdSendInterval.load();
+        m_tsNextSendTime = enter_time + m_tdSendInterval.load() * m_iSndTrainLen;
 #else
         const duration sendbrw = m_tdSendTimeDiff;
 
@@ -9828,6 +10221,11 @@ bool srt::CUDT::packUniqueData(CPacket& w_packet)
     int kflg;
     time_point tsOrigin;
     int pld_size;
+    bool encrypted;
+
+    // The crypto worker may be encrypting the next packets in the sender
+    // buffer, and HaiCrypt can't be used by two threads at once.
+    ScopedLock cryptolock(m_SndCryptoLock);
 
     {
         ScopedLock lkrack (m_RecvAckLock);
@@ -9849,7 +10247,7 @@ bool srt::CUDT::packUniqueData(CPacket& w_packet)
         // isn't a useless redundant state copy. If it is, then taking the flags here can be removed.
         kflg = m_pCryptoControl->getSndCryptoFlags();
         int pktskipseqno = 0;
-        pld_size = m_pSndBuffer->readData((w_packet), (tsOrigin), kflg, (pktskipseqno));
+        pld_size = m_pSndBuffer->readData((w_packet), (tsOrigin), kflg, (pktskipseqno), (encrypted));
         if (pktskipseqno)
         {
             // Some packets were skipped due to TTL expiry.
@@ -9942,6 +10340,15 @@ bool srt::CUDT::packUniqueData(CPacket& w_packet)
                   << " over SCHEDULING sequence " << w_packet.seqno() << " for socket not in group:"
                   << " DIFF=" << CSeqNo::seqcmp(current_sequence_number, w_packet.seqno())
                   << " STAMP=" << BufferStamp(w_packet.m_pcData, w_packet.getLength()));
+        if (encrypted && current_sequence_number != w_packet.seqno())
+        {
+            // The packet was encrypted ahead with the scheduling sequence as the counter.
+            LOGC(qslog.Error,
+                 log << CONID() << "IPE: packUniqueData: packet encrypted ahead with SCHEDULING sequence "
+                     << w_packet.seqno() << " differing from EXTRACTION sequence " << current_sequence_number
+                     << ", dropping this packet");
+            return false;
+        }
         // Do this always when not in a group.
         w_packet.set_seqno(current_sequence_number);
     }
@@ -9950,7 +10357,14 @@ bool srt::CUDT::packUniqueData(CPacket& w_packet)
     w_packet.set_id(m_PeerID); // Destination SRT Socket ID
     setDataPacketTS(w_packet, tsOrigin);
 
-    if (kflg != EK_NOENC)
+    if (encrypted)
+    {
+        // Encrypted ahead by encryptPacketAhead(), which has set the same header
+        // fields. The authentication tag is stored right after the payload.
+        if (getAuthTagSize() > 0)
+            w_packet.setLength(w_packet.getLength() + HAICRYPT_AUTHTAG_MAX);
+    }
+    else if (kflg != EK_NOENC)
     {
         // Note that the packet header must have a valid seqno set, as it is used as a counter for encryption.
         // Other fields of the data packet header (e.g. timestamp, destination socket ID) are not used for the counter.
@@ -9975,6 +10389,75 @@ bool srt::CUDT::packUniqueData(CPacket& w_packet)
     return true;
 }
 
+void srt::CUDT::postEncryptAhead()
+{
+    if (!m_pSndQueue->hasCryptoWorkers() || !m_pCryptoControl
+            || m_pCryptoControl->getSndCryptoFlags() == EK_NOENC)
+        return;
+
+#if ENABLE_BONDING
+    // Group members get the packets scheduled by the group with
+    // the sequence numbers that may still change when sending.
+    if (m_parent->m_GroupOf)
+        return;
+#endif
+
+    m_pSndQueue->postEncryption(this);
+}
+
+bool srt::CUDT::encryptAhead(int maxpackets)
+{
+    ScopedLock cryptolock(m_SndCryptoLock);
+
+    if (m_bBroken || m_bClosing || !m_bConnected || !m_pCryptoControl)
+        return false;
+
+    for (int i = 0; i < maxpackets; ++i)
+    {
+        const int st = m_pSndBuffer->encryptNext(&CUDT::encryptPacketAhead, this);
+        if (st <= 0)
+        {
+            // On failure the sending worker will try again and report it.
+            return false;
+        }
+
+        checkSndKMRefresh();
+    }
+
+    return true;
+}
+
+int srt::CUDT::encryptPacketAhead(CPacket& w_packet, const time_point& origintime, void* arg)
+{
+    CUDT* self = static_cast<CUDT*>(arg);
+
+    const int kflg = self->m_pCryptoControl->getSndCryptoFlags();
+    if (kflg == EK_NOENC)
+        return -1;
+
+    if (self->getAuthTagSize() > 0)
+    {
+        // AES-GCM also authenticates the timestamp, so the packet can be encrypted
+        // ahead only if the timestamp doesn't depend on the time of sending.
+        const time_point tsStart = self->m_stats.tsStartTime.load();
+        if (!self->m_bPeerTsbPd || origintime < tsStart)
+            return -1;
+    }
+
+    // Set the same header fields as packUniqueData(), as they might be used for encryption.
+    w_packet.set_msgflags(w_packet.msgflags() | MSGNO_ENCKEYSPEC::wrap(kflg));
+    w_packet.set_id(self->m_PeerID);
+    self->setDataPacketTS(w_packet, origintime);
+
+    if (self->m_pCryptoControl->encrypt((w_packet)) != ENCS_CLEAR)
+    {
+        HLOGC(qslog.Debug, log << self->CONID() << "encryptAhead: ENCRYPT FAILED %" << w_packet.seqno());
+        return -1;
+    }
+
+    return kflg;
+}
+
 // This is a close request, but called from the
 void srt::CUDT::processClose()
 {
@@ -10083,15 +10566,28 @@ bool srt::CUDT::overrideSndSeqNo(int32_t seq)
 int srt::CUDT::checkLazySpawnTsbPdThread()
 {
     const bool need_tsbpd = m_bTsbPd || m_bGroupTsbPd;
-    if (!need_tsbpd)
+    if (!need_tsbpd || m_bTsbPdShared)
         return 0;
 
     ScopedLock lock(m_RcvTsbPdStartupLock);
-    if (!m_RcvTsbPdThread.joinable())
+    if (!m_RcvTsbPdThread.joinable() && !m_bTsbPdShared)
     {
         if (m_bClosing) // Check m_bClosing to protect join() in CUDT::releaseSync().
             return -1;
 
+        // Group members keep their own thread, as it keeps the group busy
+        // for its whole lifetime.
+        bool use_shared = true;
+#if ENABLE_BONDING
+        use_shared = !m_parent->m_GroupOf;
+#endif
+        if (use_shared && uglobal().tsbpdScheduler().add(this))
+        {
+            HLOGP(qrlog.Debug, "Socket TSBPD driven by the shared scheduler");
+            m_bTsbPdShared = true;
+            return 0;
+        }
+
         HLOGP(qrlog.Debug, "Spawning Socket TSBPD thread");
 #if ENABLE_HEAVY_LOGGING
         std::ostringstream tns1, tns2;
@@ -10166,14 +10662,10 @@ int srt::CUDT::handleSocketPacketReception(const vector<CUnit*>& incoming, bool&
         {
             time_point pts = getPktTsbPdTime(NULL, rpkt);
 
-            enterCS(m_StatsLock);
-            const double bltime = (double) CountIIR<uint64_t>(
-                    uint64_t(m_stats.traceBelatedTime) * 1000,
+            m_stats.traceBelatedTime = CountIIR<int64_t>(
+                    m_stats.traceBelatedTime.load(),
                     count_microseconds(steady_clock::now() - pts), 0.2);
-
-            m_stats.traceBelatedTime = bltime / 1000.0;
             m_stats.rcvr.recvdBelated.count(rpkt.getLength());
-            leaveCS(m_StatsLock);
             HLOGC(qrlog.Debug,
                     log << CONID() << "RECEIVED: %" << rpkt.seqno() << " bufidx=" << bufidx << " (BELATED/"
                     << s_rexmitstat_str[pktrexmitflag] << ") with ACK %" << m_iRcvLastAck
@@ -10260,14 +10752,13 @@ int srt::CUDT::handleSocketPacketReception(const vector<CUnit*>& incoming, bool&
                     const int iDropCnt = m_pRcvBuffer->dropMessage(u->m_Packet.getSeqNo(), u->m_Packet.getSeqNo(), SRT_MSGNO_NONE, CRcvBuffer::DROP_EXISTING);
 
                     const steady_clock::time_point tnow = steady_clock::now();
-                    ScopedLock lg(m_StatsLock);
                     m_stats.rcvr.dropped.count(stats::BytesPackets(iDropCnt * rpkt.getLength(), iDropCnt));
                     m_stats.rcvr.undecrypted.count(stats::BytesPackets(rpkt.getLength(), 1));
                     string why;
                     if (frequentLogAllowed(FREQLOGFA_ENCRYPTION_FAILURE, tnow, (why)))
                     {
                         LOGC(qrlog.Warn, log << CONID() << "Decryption failed (seqno %" << u->m_Packet.getSeqNo() << "), dropped "
-                            << iDropCnt << ". pktRcvUndecryptTotal=" << m_stats.rcvr.undecrypted.total.count() << "." << why);
+                            << iDropCnt << ". pktRcvUndecryptTotal=" << m_stats.rcvr.undecrypted.total().count() << "." << why);
                     }
 #if SRT_ENABLE_FREQUENT_LOG_TRACE
                     else
@@ -10284,21 +10775,19 @@ int srt::CUDT::handleSocketPacketReception(const vector<CUnit*>& incoming, bool&
                 const int iDropCnt = m_pRcvBuffer->dropMessage(u->m_Packet.getSeqNo(), u->m_Packet.getSeqNo(), SRT_MSGNO_NONE, CRcvBuffer::DROP_EXISTING);
 
                 const steady_clock::time_point tnow = steady_clock::now();
-                ScopedLock lg(m_StatsLock);
                 m_stats.rcvr.dropped.count(stats::BytesPackets(iDropCnt* rpkt.getLength(), iDropCnt));
                 m_stats.rcvr.undecrypted.count(stats::BytesPackets(rpkt.getLength(), 1));
                 string why;
                 if (frequentLogAllowed(FREQLOGFA_ENCRYPTION_FAILURE, tnow, (why)))
                 {
                     LOGC(qrlog.Warn, log << CONID() << "Packet not encrypted (seqno %" << u->m_Packet.getSeqNo() << "), dropped "
-                        << iDropCnt << ". pktRcvUndecryptTotal=" << m_stats.rcvr.undecrypted.total.count() << ".");
+                        << iDropCnt << ". pktRcvUndecryptTotal=" << m_stats.rcvr.undecrypted.total().count() << ".");
                 }
             }
         }
 
         if (adding_successful)
         {
-            ScopedLock statslock(m_StatsLock);
             m_stats.rcvr.recvdUnique.count(u->m_Packet.getLength());
         }
 
@@ -10395,9 +10884,7 @@ int srt::CUDT::processData(CUnit* in_unit)
     if (retransmitted)
     {
         // This packet was retransmitted
-        enterCS(m_StatsLock);
         m_stats.rcvr.recvdRetrans.count(packet.getLength());
-        leaveCS(m_StatsLock);
 
 #if ENABLE_HEAVY_LOGGING
         // Check if packet was retransmitted on request or on ack timeout
@@ -10455,9 +10942,7 @@ int srt::CUDT::processData(CUnit* in_unit)
     // otherwise measurement must be rejected.
     m_RcvTimeWindow.probeArrival(packet, unordered || retransmitted);
 
-    enterCS(m_StatsLock);
     m_stats.rcvr.recvd.count(pktsz);
-    leaveCS(m_StatsLock);
 
     loss_seqs_t                             filter_loss_seqs;
     loss_seqs_t                             srt_loss_seqs;
@@ -10484,7 +10969,6 @@ int srt::CUDT::processData(CUnit* in_unit)
         {
             const int loss = diff - 1; // loss is all that is above diff == 1
 
-            ScopedLock lg(m_StatsLock);
             const uint64_t avgpayloadsz = m_pRcvBuffer->getRcvAvgPayloadSize();
             m_stats.rcvr.lost.count(stats::BytesPackets(loss * avgpayloadsz, (uint32_t) loss));
 
@@ -10660,6 +11144,7 @@ int srt::CUDT::processData(CUnit* in_unit)
         {
             HLOGC(qrlog.Debug, log << CONID() << "loss: signaling TSBPD cond");
             CSync::lock_notify_one(m_RcvTsbPdCond, m_RecvLock);
+            wakeupSharedTsbPd();
         }
         else
         {
@@ -10681,6 +11166,7 @@ int srt::CUDT::processData(CUnit* in_unit)
         {
             HLOGC(qrlog.Debug, log << CONID() << "loss: signaling TSBPD cond");
             CSync::lock_notify_one(m_RcvTsbPdCond, m_RecvLock);
+            wakeupSharedTsbPd();
         }
     }
 
@@ -10764,9 +11250,7 @@ int srt::CUDT::processData(CUnit* in_unit)
             if (m_iReorderTolerance > 0)
             {
                 m_iReorderTolerance--;
-                enterCS(m_StatsLock);
-                m_stats.traceReorderDistance--;
-                leaveCS(m_StatsLock);
+                --m_stats.traceReorderDistance;
                 HLOGC(qrlog.Debug, log << "ORDERED DELIVERY of 50 packets in a row - decreasing tolerance to "
                         << m_iReorderTolerance);
             }
@@ -10868,9 +11352,7 @@ void srt::CUDT::unlose(const CPacket &packet)
             HLOGC(qrlog.Debug, log << "received out-of-band packet %" << sequence);
 
             const int seqdiff = abs(CSeqNo::seqcmp(m_iRcvCurrSeqNo, packet.seqno()));
-            enterCS(m_StatsLock);
-            m_stats.traceReorderDistance = max(seqdiff, m_stats.traceReorderDistance);
-            leaveCS(m_StatsLock);
+            m_stats.traceReorderDistance = max(seqdiff, m_stats.traceReorderDistance.load());
             if (seqdiff > m_iReorderTolerance)
             {
                 const int new_tolerance = min(seqdiff, m_config.iMaxReorderTolerance);
@@ -10927,9 +11409,7 @@ void srt::CUDT::unlose(const CPacket &packet)
                 if (m_iReorderTolerance > 0)
                 {
                     m_iReorderTolerance--;
-                    enterCS(m_StatsLock);
-                    m_stats.traceReorderDistance--;
-                    leaveCS(m_StatsLock);
+                    --m_stats.traceReorderDistance;
                     HLOGC(qrlog.Debug, log << "... reached " << m_iConsecEarlyDelivery
                             << " times - decreasing tolerance to " << m_iReorderTolerance);
                 }
@@ -11020,43 +11500,54 @@ void srt::CUDT::dropFromLossLists(int32_t from, int32_t to)
 }
 
 // This function, as the name states, should bake a new cookie.
+// The cookie is the SipHash of the raw address of the peer and the
+// current minute, keyed with the random secret of this socket, so it
+// needs no state to be verified, but can't be forged by the peer.
 int32_t srt::CUDT::bake(const sockaddr_any& addr, int32_t current_cookie, int correction)
 {
-    static unsigned int distractor = 0;
-    unsigned int        rollover   = distractor + 10;
-
-    for (;;)
+    struct
     {
-        // SYN cookie
-        char clienthost[NI_MAXHOST];
-        char clientport[NI_MAXSERV];
-        getnameinfo(addr.get(),
-                    addr.size(),
-                    clienthost,
-                    sizeof(clienthost),
-                    clientport,
-                    sizeof(clientport),
-                    NI_NUMERICHOST | NI_NUMERICSERV);
-        int64_t timestamp = (count_microseconds(steady_clock::now() - m_stats.tsStartTime) / 60000000) + distractor +
-                            correction; // secret changes every one minute
-        stringstream cookiestr;
-        cookiestr << clienthost << ":" << clientport << ":" << timestamp;
-        union {
-            unsigned char cookie[16];
-            int32_t       cookie_val;
-        };
-        CMD5::compute(cookiestr.str().c_str(), cookie);
+        int64_t       timestamp;
+        uint32_t      distractor;
+        uint16_t      family;
+        uint16_t      port;
+        unsigned char host[16];
+    } input;
+    memset(&input, 0, sizeof input);
+
+    // secret changes every one minute
+    input.timestamp = (count_microseconds(steady_clock::now() - m_stats.tsStartTime.load()) / 60000000) + correction;
+    input.family    = addr.family();
+    input.port      = addr.hport();
+    if (addr.family() == AF_INET)
+        memcpy(input.host, &addr.sin.sin_addr, sizeof addr.sin.sin_addr);
+    else
+        memcpy(input.host, &addr.sin6.sin6_addr, sizeof addr.sin6.sin6_addr);
 
+    int32_t cookie_val = 0;
+    for (; input.distractor < 10; ++input.distractor)
+    {
+        cookie_val = int32_t(CSipHash::compute(m_CookieSecret, &input, sizeof input));
         if (cookie_val != current_cookie)
-            return cookie_val;
+            break;
+    }
+    return cookie_val;
+}
 
-        ++distractor;
+bool srt::CUDT::takeInductionCredit(const time_point& now)
+{
+    const int rate = m_config.iInductionRate;
+    if (rate == 0)
+        return true;
 
-        // This is just to make the loop formally breakable,
-        // but this is virtually impossible to happen.
-        if (distractor == rollover)
-            return cookie_val;
-    }
+    // Up to one second worth of responses can be sent at once,
+    // then one per 1/rate of a second.
+    const time_point start = std::max(m_tsInductionCredit, now);
+    if (start - now >= seconds_from(1))
+        return false;
+
+    m_tsInductionCredit = start + steady_clock::duration(seconds_from(1).count() / rate);
+    return true;
 }
 
 // XXX This is quite a mystery, why this function has a return value
@@ -11145,6 +11636,15 @@ int srt::CUDT::processConnectRequest(const sockaddr_any& addr, CPacket& packet)
     // required as a source of the peer's information used in processing in other
     // structures.
 
+    // The caller repeats the induction request if it gets no response,
+    // so under a flood of them the excess can be just ignored.
+    if (hs.m_iReqType == URQ_INDUCTION && !takeInductionCredit(steady_clock::now()))
+    {
+        HLOGC(cnlog.Debug, log << CONID() << "processConnectRequest: induction rate limit exceeded, ignoring request from "
+                               << addr.str());
+        return SRT_REJ_UNKNOWN;
+    }
+
     int32_t cookie_val = bake(addr);
 
     HLOGC(cnlog.Debug, log << CONID() << "processConnectRequest: new cookie: " << hex << cookie_val);
@@ -11539,23 +12039,7 @@ bool srt::CUDT::checkExpTimer(const steady_clock::time_point& currtime, int chec
     HLOGC(xtlog.Debug, log << CONID() << "checkTimer: ACTIVITIES PERFORMED: " << decision);
 #endif
 
-    // In UDT the m_bUserDefinedRTO and m_iRTO were in CCC class.
-    // There's nothing in the original code that alters these values.
-
-    steady_clock::time_point next_exp_time;
-    if (m_CongCtl->RTO())
-    {
-        next_exp_time = m_tsLastRspTime.load() + microseconds_from(m_CongCtl->RTO());
-    }
-    else
-    {
-        steady_clock::duration exp_timeout =
-            microseconds_from(m_iEXPCount * (m_iSRTT + 4 * m_iRTTVar) + COMM_SYN_INTERVAL_US);
-        if (exp_timeout < (m_iEXPCount * m_tdMinExpInterval))
-            exp_timeout = m_iEXPCount * m_tdMinExpInterval;
-        next_exp_time = m_tsLastRspTime.load() + exp_timeout;
-    }
-
+    const steady_clock::time_point next_exp_time = nextExpTime();
     if (currtime <= next_exp_time && !m_bBreakAsUnstable)
         return false;
 
@@ -11609,6 +12093,20 @@ bool srt::CUDT::checkExpTimer(const steady_clock::time_point& currtime, int chec
     return false;
 }
 
+srt::sync::steady_clock::time_point srt::CUDT::nextExpTime()
+{
+    // In UDT the m_bUserDefinedRTO and m_iRTO were in CCC class.
+    // There's nothing in the original code that alters these values.
+    if (m_CongCtl->RTO())
+        return m_tsLastRspTime.load() + microseconds_from(m_CongCtl->RTO());
+
+    steady_clock::duration exp_timeout =
+        microseconds_from(m_iEXPCount * (m_iSRTT + 4 * m_iRTTVar) + COMM_SYN_INTERVAL_US);
+    if (exp_timeout < (m_iEXPCount * m_tdMinExpInterval))
+        exp_timeout = m_iEXPCount * m_tdMinExpInterval;
+    return m_tsLastRspTime.load() + exp_timeout;
+}
+
 void srt::CUDT::checkRexmitTimer(const steady_clock::time_point& currtime)
 {
     // Check if HSv4 should be retransmitted, and if KM_REQ should be resent if the side is INITIATOR.
@@ -11667,9 +12165,7 @@ void srt::CUDT::checkRexmitTimer(const steady_clock::time_point& currtime)
         const int     num = m_pSndLossList->insert(m_iSndLastAck, csn);
         if (num > 0)
         {
-            enterCS(m_StatsLock);
             m_stats.sndr.lost.count(num);
-            leaveCS(m_StatsLock);
 
             HLOGC(xtlog.Debug,
                   log << CONID() << "ENFORCED " << (is_laterexmit ? "LATEREXMIT" : "FASTREXMIT")
@@ -11735,6 +12231,62 @@ void srt::CUDT::checkTimers()
     }
 }
 
+srt::sync::steady_clock::time_point srt::CUDT::nextTimerDeadline(const steady_clock::time_point& currtime)
+{
+    // A broken or closing socket is removed from the receiver queue when its
+    // timers are checked, and the packet counters require an immediate ACK.
+    if (!m_bConnected || m_bBroken || m_bClosing || m_bBreakAsUnstable
+        || (m_CongCtl->ACKMaxPackets() > 0 && m_iPktCount >= m_CongCtl->ACKMaxPackets())
+        || m_iPktCount >= SELF_CLOCK_INTERVAL * m_iLightACKCount)
+        return currtime;
+
+    steady_clock::time_point deadline = m_tsLastSndTime.load() + microseconds_from(COMM_KEEPALIVE_PERIOD_US);
+
+    const steady_clock::time_point next_exp_time = nextExpTime();
+    if (next_exp_time < deadline)
+        deadline = next_exp_time;
+
+    // The ACK is sent only if there's something new to acknowledge
+    // or the last one hasn't been confirmed by ACKACK (see sendCtrlAck).
+    if (m_iPktCount > 0 || m_iRcvLastAck != m_iRcvLastAckAck || m_bBufferWasFull)
+    {
+        const steady_clock::time_point next_ack_time = m_tsNextACKTime.load();
+        if (next_ack_time < deadline)
+            deadline = next_ack_time;
+    }
+
+    if (m_config.bRcvNakReport && m_PktFilterRexmitLevel == SRT_ARQ_ALWAYS)
+    {
+        enterCS(m_RcvLossLock);
+        const int loss_len = m_pRcvLossList->getLossLength();
+        leaveCS(m_RcvLossLock);
+
+        if (loss_len > 0)
+        {
+            const steady_clock::time_point next_nak_time = m_tsNextNAKTime.load();
+            if (next_nak_time < deadline)
+                deadline = next_nak_time;
+        }
+        else
+        {
+            m_tsNextNAKTime.store(currtime + m_tdNAKInterval);
+        }
+    }
+
+    // Blind retransmission applies only to the unacknowledged data.
+    if (m_pSndBuffer && m_pSndBuffer->getCurrBufSize() > 0)
+    {
+        ScopedLock ack_lock(m_RecvAckLock);
+        const uint64_t rtt_syn    = (m_iSRTT + 4 * m_iRTTVar + 2 * COMM_SYN_INTERVAL_US);
+        const uint64_t exp_int_us = (m_iReXmitCount * rtt_syn + COMM_SYN_INTERVAL_US);
+        const steady_clock::time_point next_rexmit_time = m_tsLastRspAckTime + microseconds_from(exp_int_us);
+        if (next_rexmit_time < deadline)
+            deadline = next_rexmit_time;
+    }
+
+    return deadline < currtime ? currtime : deadline;
+}
+
 void srt::CUDT::updateBrokenConnection()
 {
     HLOGC(smlog.Debug, log << "updateBrokenConnection: setting closing=true and taking out epoll events");
@@ -11813,9 +12365,9 @@ void srt::CUDT::completeBrokenConnectionDependencies(int errorcode)
 
 void srt::CUDT::addEPoll(const int eid)
 {
-    enterCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.lock();
     m_sPollID.insert(eid);
-    leaveCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.unlock();
 
     if (!stillConnected())
         return;
@@ -11844,9 +12396,9 @@ void srt::CUDT::removeEPollEvents(const int eid)
 
 void srt::CUDT::removeEPollID(const int eid)
 {
-    enterCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.lock();
     m_sPollID.erase(eid);
-    leaveCS(uglobal().m_EPoll.m_EPollLock);
+    uglobal().m_EPoll.m_EPollLock.unlock();
 }
 
 void srt::CUDT::ConnectSignal(ETransmissionEvent evt, EventSlot sl)
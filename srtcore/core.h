@@ -155,9 +155,7 @@ class CCryptoControl;
 namespace srt {
 class CUDTUnited;
 class CUDTSocket;
-#if ENABLE_BONDING
 class CUDTGroup;
-#endif
 
 // XXX REFACTOR: The 'CUDT' class is to be merged with 'CUDTSocket'.
 // There's no reason for separating them, there's no case of having them
@@ -174,6 +172,7 @@ class CUDT
     friend class CCache<CInfoBlock>;
     friend class CRendezvousQueue;
     friend class CSndQueue;
+    friend class CTsbPdScheduler;
     friend class CRcvQueue;
     friend class CSndUList;
     friend class CRcvUList;
@@ -197,6 +196,7 @@ private: // constructor and desctructor
 public: //API
     static int startup();
     static int cleanup();
+    static int setTsbPdThreads(int nthreads);
     static SRTSOCKET socket();
 #if ENABLE_BONDING
     static SRTSOCKET createGroup(SRT_GROUP_TYPE);
@@ -224,9 +224,13 @@ public: //API
     static int sendmsg(SRTSOCKET u, const char* buf, int len, int ttl = SRT_MSGTTL_INF, bool inorder = false, int64_t srctime = 0);
     static int recvmsg(SRTSOCKET u, char* buf, int len, int64_t& srctime);
     static int sendmsg2(SRTSOCKET u, const char* buf, int len, SRT_MSGCTRL& mctrl);
+    static int sendmsgFill(SRTSOCKET u, int len, srt_send_fill_fn* fill, void* opaque, SRT_MSGCTRL& mctrl);
     static int recvmsg2(SRTSOCKET u, char* buf, int len, SRT_MSGCTRL& w_mctrl);
+    static int recvmsgView(SRTSOCKET u, srt_recv_view_fn* view, void* opaque, SRT_MSGCTRL& w_mctrl);
     static int64_t sendfile(SRTSOCKET u, std::fstream& ifs, int64_t& offset, int64_t size, int block = SRT_DEFAULT_SENDFILE_BLOCK);
     static int64_t recvfile(SRTSOCKET u, std::fstream& ofs, int64_t& offset, int64_t size, int block = SRT_DEFAULT_RECVFILE_BLOCK);
+    static int64_t sendfile(SRTSOCKET u, int fd, int64_t& offset, int64_t size, int block = SRT_DEFAULT_SENDFILE_BLOCK);
+    static int64_t recvfile(SRTSOCKET u, int fd, int64_t& offset, int64_t size, int block = SRT_DEFAULT_RECVFILE_BLOCK);
     static int select(int nfds, UDT::UDSET* readfds, UDT::UDSET* writefds, UDT::UDSET* exceptfds, const timeval* timeout);
     static int selectEx(const std::vector<SRTSOCKET>& fds, std::vector<SRTSOCKET>* readfds, std::vector<SRTSOCKET>* writefds, std::vector<SRTSOCKET>* exceptfds, int64_t msTimeOut);
     static int epoll_create();
@@ -247,6 +251,7 @@ public: //API
 #if ENABLE_BONDING
     static int groupsockbstats(SRTSOCKET u, CBytePerfMon* perf, bool clear = true);
 #endif
+    static int muxstats(SRTSOCKET u, SRT_MUXSTATS* stats);
     static SRT_SOCKSTATUS getsockstate(SRTSOCKET u);
     static bool setstreamid(SRTSOCKET u, const std::string& sid);
     static std::string getstreamid(SRTSOCKET u);
@@ -422,14 +427,12 @@ public: // internal API
     /// @brief Set the timestamp field of the packet using the provided value (no check)
     /// @param p the packet structure to set the timestamp on.
     /// @param ts timestamp to use as a source for packet timestamp.
-    SRT_ATTR_EXCLUDES(m_StatsLock)
     void setPacketTS(CPacket& p, const time_point& ts);
 
     /// @brief Set the timestamp field of the packet according the TSBPD mode.
     /// Also checks the connection start time (m_tsStartTime).
     /// @param p the packet structure to set the timestamp on.
     /// @param ts timestamp to use as a source for packet timestamp. Ignored if m_bPeerTsbPd is false.
-    SRT_ATTR_EXCLUDES(m_StatsLock)
     void setDataPacketTS(CPacket& p, const time_point& ts);
 
     // Utility used for closing a listening socket
@@ -579,7 +582,7 @@ private:
 
     /// @brief Drop packets too late to be delivered if any.
     /// @returns the number of packets actually dropped.
-    SRT_ATTR_REQUIRES2(m_RecvAckLock, m_StatsLock)
+    SRT_ATTR_REQUIRES(m_RecvAckLock)
     int sndDropTooLate();
 
     /// @bried Allow packet retransmission.
@@ -641,9 +644,46 @@ private:
 
     SRT_ATR_NODISCARD int sendmsg2(const char* data, int len, SRT_MSGCTRL& w_m);
 
+    /// Send a message of size "len", whose payload is written by "fill"
+    /// directly into the sender buffer instead of being copied from "data".
+    /// @param fill [in] callback writing the payload, see srt_sendmsg_fill().
+    /// @param opaque [in] user pointer passed to "fill".
+    /// @return Actual size of data sent.
+
+    SRT_ATR_NODISCARD int sendmsgFill(int len, srt_send_fill_fn* fill, void* opaque, SRT_MSGCTRL& w_m);
+
+    /// Send a message of a single packet, whose payload is referenced in the
+    /// sender buffer instead of being copied, if the socket sends without
+    /// encryption (otherwise it's copied, as by sendmsg2()).
+    /// @param payload [in] the payload shared by the members of a broadcast group.
+    /// @return Actual size of data sent.
+
+    SRT_ATR_NODISCARD int sendmsgShared(CSndSharedPayload& payload, SRT_MSGCTRL& w_m);
+
+    /// Common part of sendmsg2(), sendmsgFill() and sendmsgShared(): the payload
+    /// is copied from "data", written by "fill" if it's not NULL, or referenced
+    /// from "shared" if it's not NULL.
+    SRT_ATR_NODISCARD int sendPayload(const char* data, int len, srt_send_fill_fn* fill, void* opaque,
+                                      CSndSharedPayload* shared, SRT_MSGCTRL& w_m);
+
     SRT_ATR_NODISCARD int recvmsg(char* data, int len, int64_t& srctime);
     SRT_ATR_NODISCARD int recvmsg2(char* data, int len, SRT_MSGCTRL& w_m);
-    SRT_ATR_NODISCARD int receiveMessage(char* data, int len, SRT_MSGCTRL& w_m, int erh = 1 /*throw exception*/);
+
+    /// Receive a message, passing the payload of its packets to "view"
+    /// directly from the receiver buffer instead of copying it.
+    /// @param view [in] callback receiving the payload, see srt_recvmsg_view().
+    /// @param opaque [in] user pointer passed to "view".
+    /// @return Size of the message received.
+
+    SRT_ATR_NODISCARD int recvmsgView(srt_recv_view_fn* view, void* opaque, SRT_MSGCTRL& w_m);
+
+    /// The payload is copied into "data", or passed to "view" if it's not NULL.
+    SRT_ATR_NODISCARD int receiveMessage(char* data, int len, SRT_MSGCTRL& w_m, int erh = 1 /*throw exception*/,
+                                         srt_recv_view_fn* view = NULL, void* opaque = NULL);
+
+    /// Read the next message from the receiver buffer as for receiveMessage().
+    SRT_ATTR_REQUIRES(m_RcvBufferLock)
+    int readRcvMessage(char* data, int len, SRT_MSGCTRL& w_m, srt_recv_view_fn* view, void* opaque);
     SRT_ATR_NODISCARD int receiveBuffer(char* data, int len);
 
     size_t dropMessage(int32_t seqtoskip);
@@ -666,6 +706,26 @@ private:
 
     SRT_ATR_NODISCARD int64_t recvfile(std::fstream& ofs, int64_t& offset, int64_t size, int block = 7320000);
 
+#ifndef _WIN32
+    /// Like sendfile(std::fstream&...), but reading the file with pread() directly
+    /// into the sender buffer blocks. The file position of @a fd is not changed.
+    /// @param fd [in] The file descriptor open for reading.
+    SRT_ATR_NODISCARD int64_t sendfile(int fd, int64_t& offset, int64_t size, int block = 366000);
+
+    /// Like recvfile(std::fstream&...), but writing the received units with pwritev()
+    /// directly from the receiver buffer. The file position of @a fd is not changed.
+    /// @param fd [in] The file descriptor open for writing.
+    SRT_ATR_NODISCARD int64_t recvfile(int fd, int64_t& offset, int64_t size, int block = 7320000);
+#endif
+
+    /// The common part of the sendfile() variants, reading from the file by @a src.
+    template <class Source>
+    int64_t sendfileFrom(Source& src, int64_t& offset, int64_t size, int block);
+
+    /// The common part of the recvfile() variants, writing to the file by @a dst.
+    template <class Sink>
+    int64_t recvfileTo(Sink& dst, int64_t& offset, int64_t size, int block);
+
     /// Configure UDT options.
     /// @param optName [in] The enum name of a UDT option.
     /// @param optval [in] The value to be set.
@@ -747,8 +807,7 @@ private:
 
     time_point socketStartTime()
     {
-        sync::ScopedLock lk (m_StatsLock);
-        return m_stats.tsStartTime;
+        return m_stats.tsStartTime.load();
     }
 
     SRT_ATTR_EXCLUDES(m_RcvBufferLock)
@@ -763,6 +822,23 @@ private:
     // TSBPD thread main function.
     static void* tsbpd(void* param);
 
+    /// Drop the packets too late to deliver and signal the read-readiness
+    /// if the first packet in the receiver buffer is ready to deliver.
+    /// This is a single round of the TSBPD thread loop.
+    /// @param group group kept busy by the caller, or NULL
+    /// @return time of the next delivery to check at, or zero time
+    /// if the check should be repeated only when signalled.
+    SRT_ATTR_REQUIRES(m_RecvLock)
+    time_point tsbpdCheck(CUDTGroup* group);
+
+    /// tsbpdCheck() called by the shared TSBPD scheduler.
+    SRT_ATTR_EXCLUDES(m_RecvLock)
+    time_point tsbpdCheckShared();
+
+    /// Signal the shared TSBPD scheduler to check the socket again,
+    /// if used instead of the TSBPD thread, in addition to m_RcvTsbPdCond.
+    void wakeupSharedTsbPd();
+
     enum DropReason
     {
         DROP_TOO_LATE, //< Drop to keep up to the live pace (TLPKTDROP).
@@ -855,6 +931,8 @@ private:
     CHandShake m_ConnRes;                        // Connection response
     CHandShake::RendezvousState m_RdvState;      // HSv5 rendezvous state
     HandshakeSide m_SrtHsSide;                   // HSv5 rendezvous handshake side resolved from cookie contest (DRAW if not yet resolved)
+    unsigned char m_CookieSecret[CSipHash::KEY_SIZE]; // Random key of the cookies baked by this socket
+    time_point m_tsInductionCredit;              // (LISTENER) Time until which the induction responses used up the rate limit
 
 private: // Sending related data
     CSndBuffer* m_pSndBuffer;                    // Sender buffer
@@ -895,6 +973,8 @@ private: // Timers
     int m_iLightACKCount;                        // Light ACK counter
 
     time_point m_tsNextSendTime;                 // Scheduled time of next packet sending
+    int m_iSndTrainLen;                          // Number of packets in the current packet train
+    int m_iSndTrainLeft;                         // Number of packets of the current packet train still to send
 
     sync::atomic<int32_t> m_iSndLastFullAck;     // Last full ACK received
     SRT_ATTR_GUARDED_BY(m_RecvAckLock)
@@ -1001,6 +1081,7 @@ private: // Receiving related data
     sync::CThread m_RcvTsbPdThread;              // Rcv TsbPD Thread handle
     sync::Condition m_RcvTsbPdCond;              // TSBPD signals if reading is ready. Use together with m_RecvLock
     bool m_bTsbPdNeedsWakeup;                    // Signal TsbPd thread to wake up on RCV buffer state change.
+    sync::atomic<bool> m_bTsbPdShared;           // TSBPD is driven by the shared scheduler instead of m_RcvTsbPdThread
     sync::Mutex m_RcvTsbPdStartupLock;           // Protects TSBPD thread creation and joining.
 
     CallbackHolder<srt_listen_callback_fn> m_cbAcceptHook;
@@ -1041,8 +1122,10 @@ private: // synchronization: mutexes and conditions
     sync::Mutex m_RecvLock;                      // used to synchronize "srt_recv*" call, protects TSBPD drift updates (CRcvBuffer::isRcvDataReady())
 
     sync::Mutex m_SendLock;                      // used to synchronize "send" call
+    sync::Mutex m_SndCryptoLock;                 // serializes the use of the sender crypto context (sending and crypto worker)
+    bool m_bEncryptPosted;                       // waiting for a crypto worker; protected by the worker's lock
     sync::Mutex m_RcvLossLock;                   // Protects the receiver loss list (access: CRcvQueue::worker, CUDT::tsbpd)
-    mutable sync::Mutex m_StatsLock;             // used to synchronize access to trace statistics
+    mutable sync::Mutex m_StatsLock;             // used to synchronize the readers of trace statistics
 
     void initSynch();
     void destroySynch();
@@ -1122,6 +1205,19 @@ private: // Generation and processing of packets
     /// @return true if a packet has been packets; false otherwise.
     bool packUniqueData(CPacket& packet);
 
+    /// Post the socket to the crypto worker of the multiplexer, if the
+    /// packets scheduled for sending may be encrypted ahead (SRTO_CRYPTOWORKERS).
+    void postEncryptAhead();
+
+    /// Encrypt the packets scheduled for sending that haven't been sent
+    /// yet, called by the crypto worker of the multiplexer.
+    /// @param maxpackets maximum number of packets to encrypt in this call
+    /// @return true if there are more packets to encrypt.
+    bool encryptAhead(int maxpackets);
+
+    /// CSndBuffer::encrypt_fn used by encryptAhead().
+    static int encryptPacketAhead(CPacket& w_packet, const time_point& origintime, void* arg);
+
     /// Pack in CPacket the next data to be send.
     ///
     /// @param packet [out] a CPacket structure to fill
@@ -1133,7 +1229,7 @@ private: // Generation and processing of packets
     bool packData(CPacket& packet, time_point& nexttime, sockaddr_any& src_addr);
 
     /// Also excludes srt::CUDTUnited::m_GlobControlLock.
-    SRT_ATTR_EXCLUDES(m_RcvTsbPdStartupLock, m_StatsLock, m_RecvLock, m_RcvLossLock, m_RcvBufferLock)
+    SRT_ATTR_EXCLUDES(m_RcvTsbPdStartupLock, m_RecvLock, m_RcvLossLock, m_RcvBufferLock)
     int processData(CUnit* unit);
 
     /// This function passes the incoming packet to the initial processing
@@ -1174,6 +1270,12 @@ private: // Generation and processing of packets
     static void addLossRecord(std::vector<int32_t>& lossrecord, int32_t lo, int32_t hi);
     int32_t bake(const sockaddr_any& addr, int32_t previous_cookie = 0, int correction = 0);
 
+    /// Check if the listener may respond to another induction request
+    /// within the limit of SRTO_INDUCTIONRATE, and count it if so.
+    /// @param now the time when the request is handled
+    /// @return true if the response may be sent
+    bool takeInductionCredit(const time_point& now);
+
     void processKeepalive(const CPacket& ctrlpkt, const time_point& tsArrival);
 
 
@@ -1183,20 +1285,24 @@ private: // Generation and processing of packets
     size_t getAvailRcvBufferSizeNoLock() const;
 
 private: // Trace
+    // The statistics are counted without a lock, so that reading them
+    // never blocks the threads handling the connection. The m_StatsLock
+    // is only used by the readers, to keep the trace period.
     struct CoreStats
     {
-        time_point tsStartTime;             // timestamp when the UDT entity is started
+        atomic_time_point tsStartTime;      // timestamp when the UDT entity is started
         stats::Sender sndr;                 // sender statistics
+        char sndrPad[stats::CACHE_LINE_SIZE];
         stats::Receiver rcvr;               // receiver statistics
+        char rcvrPad[stats::CACHE_LINE_SIZE];
 
-        int64_t m_sndDurationTotal;         // total real time for sending
+        sync::atomic<int64_t> m_sndDurationTotal; // total real time for sending
+        atomic_time_point sndDurationCounter;     // timers to record the sending Duration
+        int64_t sndDurationBase;                  // m_sndDurationTotal at the last trace reset (by m_StatsLock)
 
-        time_point tsLastSampleTime;        // last performance sample time
-        int traceReorderDistance;
-        double traceBelatedTime;
-
-        int64_t sndDuration;                // real time for sending
-        time_point sndDurationCounter;      // timers to record the sending Duration
+        time_point tsLastSampleTime;              // last performance sample time (by m_StatsLock)
+        sync::atomic<int> traceReorderDistance;   // updated by the receiver worker only
+        sync::atomic<int64_t> traceBelatedTime;   // [us], updated by the receiver worker only
 
     } m_stats;
 
@@ -1219,6 +1325,17 @@ private: // Timers functions
                      LAST_BECAUSE_BIT  =      3;
 
     void checkTimers();
+
+    /// Get the time when checkTimers() has to be called next: the earliest
+    /// of the ACK, NAK, EXP, retransmission and keepalive timers that are
+    /// pending. Timers that have nothing to do, like the ACK timer with
+    /// nothing new to acknowledge, are not considered. When no loss is
+    /// pending, the NAK timer is restarted, as checkNAKTimer() does.
+    /// @param currtime the current time
+    /// @return the deadline, @a currtime if the timers are due now
+    time_point nextTimerDeadline(const time_point& currtime);
+    time_point nextExpTime();
+
     void considerLegacySrtHandshake(const time_point &timebase);
     int checkACKTimer (const time_point& currtime);
     int checkNAKTimer(const time_point& currtime);
@@ -77,12 +77,158 @@ std::string KmStateStr(SRT_KM_STATE state)
 
 using srt_logging::KmStateStr;
 
+#ifdef SRT_ENABLE_ENCRYPTION
+namespace srt
+{
+
+// Overwrite the key so that the compiler can't elide it as a dead store.
+static void wipeKey(unsigned char* key, size_t len)
+{
+    volatile unsigned char* p = key;
+    while (len--)
+        *p++ = 0;
+}
+
+static int kekCacheLookup(const char* pwd, size_t pwd_len, const unsigned char* salt, size_t salt_len,
+                          unsigned char* kek, size_t kek_len)
+{
+    return CKekCache::instance().lookup(pwd, pwd_len, salt, salt_len, (kek), kek_len) ? 0 : -1;
+}
+
+static void kekCacheStore(const char* pwd, size_t pwd_len, const unsigned char* salt, size_t salt_len,
+                          const unsigned char* kek, size_t kek_len)
+{
+    CKekCache::instance().store(pwd, pwd_len, salt, salt_len, kek, kek_len);
+}
+
+static const HaiCrypt_KekCache s_HaiCryptKekCache = {&kekCacheLookup, &kekCacheStore};
+
+} // namespace srt
+
+srt::CKekCache& srt::CKekCache::instance()
+{
+    // First called by CCryptoControl::globalInit() at startup.
+    static CKekCache s_Cache;
+    return s_Cache;
+}
+
+srt::CKekCache::CKekCache()
+    : m_zCapacity(DEF_CAPACITY)
+    , m_iHits(0)
+    , m_iMisses(0)
+{
+    for (size_t k = 0; k < 2; ++k)
+        for (size_t i = 0; i < CSipHash::KEY_SIZE; ++i)
+            m_Secret[k][i] = (unsigned char)sync::genRandomInt(0, 255);
+}
+
+srt::CKekCache::~CKekCache()
+{
+    clear();
+    wipeKey(&m_Secret[0][0], sizeof m_Secret);
+}
+
+void srt::CKekCache::hashPassphrase(const char* pwd, size_t pwd_len, uint64_t w_hash[2]) const
+{
+    // Two independent 64-bit hashes make a collision of two passphrases negligible.
+    w_hash[0] = CSipHash::compute(m_Secret[0], pwd, pwd_len);
+    w_hash[1] = CSipHash::compute(m_Secret[1], pwd, pwd_len);
+}
+
+void srt::CKekCache::removeOldest()
+{
+    Entry& e = m_Entries.front();
+    wipeKey(e.kek, sizeof e.kek);
+    m_Entries.pop_front();
+}
+
+void srt::CKekCache::expire(const sync::steady_clock::time_point& now)
+{
+    while (!m_Entries.empty() && now - m_Entries.front().tsStored > sync::seconds_from(MAX_AGE_S))
+        removeOldest();
+}
+
+bool srt::CKekCache::lookup(const char* pwd, size_t pwd_len, const unsigned char* salt, size_t salt_len,
+                            unsigned char* w_kek, size_t kek_len)
+{
+    uint64_t pwdhash[2];
+    hashPassphrase(pwd, pwd_len, (pwdhash));
+
+    sync::ScopedLock lck(m_Lock);
+    expire(sync::steady_clock::now());
+
+    // The most recent are the most likely to be looked up.
+    for (std::deque<Entry>::reverse_iterator i = m_Entries.rbegin(); i != m_Entries.rend(); ++i)
+    {
+        if (i->kek_len == kek_len && i->salt_len == salt_len && memcmp(i->salt, salt, salt_len) == 0
+            && i->pwdhash[0] == pwdhash[0] && i->pwdhash[1] == pwdhash[1])
+        {
+            memcpy((w_kek), i->kek, kek_len);
+            ++m_iHits;
+            return true;
+        }
+    }
+
+    ++m_iMisses;
+    return false;
+}
+
+void srt::CKekCache::store(const char* pwd, size_t pwd_len, const unsigned char* salt, size_t salt_len,
+                           const unsigned char* kek, size_t kek_len)
+{
+    Entry e;
+    if (salt_len > sizeof e.salt || kek_len > sizeof e.kek)
+        return;
+
+    // The KEK is copied directly into the cache, not to leave a copy on the stack.
+    hashPassphrase(pwd, pwd_len, (e.pwdhash));
+    memcpy((e.salt), salt, salt_len);
+    e.salt_len = salt_len;
+    e.kek_len  = kek_len;
+    e.tsStored = sync::steady_clock::now();
+
+    sync::ScopedLock lck(m_Lock);
+    if (m_zCapacity == 0)
+        return;
+
+    expire(e.tsStored);
+    while (m_Entries.size() >= m_zCapacity)
+        removeOldest();
+
+    m_Entries.push_back(e);
+    memcpy((m_Entries.back().kek), kek, kek_len);
+}
+
+void srt::CKekCache::setCapacity(size_t capacity)
+{
+    sync::ScopedLock lck(m_Lock);
+    m_zCapacity = capacity;
+    while (m_Entries.size() > m_zCapacity)
+        removeOldest();
+}
+
+size_t srt::CKekCache::size()
+{
+    sync::ScopedLock lck(m_Lock);
+    return m_Entries.size();
+}
+
+void srt::CKekCache::clear()
+{
+    sync::ScopedLock lck(m_Lock);
+    while (!m_Entries.empty())
+        removeOldest();
+}
+#endif
+
 void srt::CCryptoControl::globalInit()
 {
 #ifdef SRT_ENABLE_ENCRYPTION
     // We need to force the Cryspr to be initialized during startup to avoid the
     // possibility of multiple threads initialzing the same static data later on.
     HaiCryptCryspr_Get_Instance();
+    CKekCache::instance();
+    HaiCrypt_SetKekCache(&s_HaiCryptKekCache);
 #endif
 }
 
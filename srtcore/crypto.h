@@ -17,10 +17,12 @@ written by
 #define INC_SRT_CRYPTO_H
 
 #include <cstring>
+#include <deque>
 #include <string>
 
 // UDT
 #include "udt.h"
+#include "common.h"
 #include "packet.h"
 #include "utilities.h"
 #include "logging.h"
@@ -50,6 +52,63 @@ const size_t SRT_KMR_KMSTATE = 0;
 #define SRT_CMD_MAXSZ       HCRYPT_MSG_KM_MAX_SZ  /* Maximum SRT custom messages payload size (bytes) */
 const size_t SRTDATA_MAXSIZE = SRT_CMD_MAXSZ/sizeof(uint32_t);
 
+#ifdef SRT_ENABLE_ENCRYPTION
+/// The cache of the KEKs derived by HaiCrypt from the passphrase (PBKDF2),
+/// shared by all the connections. The KEK depends only on the passphrase,
+/// the salt and the key length, so the sending and receiving context of a
+/// connection (cloned one from the other, with the same salt), as well as
+/// the repeated handshakes with the same Keying Material, derive it once.
+/// The passphrase is not stored, only its hash keyed with a random secret,
+/// and the KEKs are wiped from the memory when removed.
+class CKekCache
+{
+public:
+    static const size_t DEF_CAPACITY = 256; // Maximum number of cached KEKs
+    static const int    MAX_AGE_S    = 60;  // Time after which a cached KEK is removed [s]
+
+    /// The cache used by HaiCrypt, installed by CCryptoControl::globalInit().
+    static CKekCache& instance();
+
+    CKekCache();
+    ~CKekCache();
+
+    bool lookup(const char* pwd, size_t pwd_len, const unsigned char* salt, size_t salt_len,
+                unsigned char* w_kek, size_t kek_len);
+    void store(const char* pwd, size_t pwd_len, const unsigned char* salt, size_t salt_len,
+               const unsigned char* kek, size_t kek_len);
+
+    /// Set the maximum number of cached KEKs; 0 turns the cache off.
+    void   setCapacity(size_t capacity);
+    size_t size();
+    void   clear();
+
+    uint64_t hits() const { return m_iHits.load(); }
+    uint64_t misses() const { return m_iMisses.load(); }
+
+private:
+    struct Entry
+    {
+        uint64_t                       pwdhash[2];
+        unsigned char                  salt[HAICRYPT_PBKDF2_SALT_LEN];
+        size_t                         salt_len;
+        unsigned char                  kek[HAICRYPT_KEY_MAX_SZ];
+        size_t                         kek_len;
+        sync::steady_clock::time_point tsStored;
+    };
+
+    void hashPassphrase(const char* pwd, size_t pwd_len, uint64_t w_hash[2]) const;
+    void expire(const sync::steady_clock::time_point& now);
+    void removeOldest();
+
+    unsigned char          m_Secret[2][CSipHash::KEY_SIZE]; // Random keys of the passphrase hash
+    sync::Mutex            m_Lock;
+    std::deque<Entry>      m_Entries; // The oldest first
+    size_t                 m_zCapacity;
+    sync::atomic<uint64_t> m_iHits;
+    sync::atomic<uint64_t> m_iMisses;
+};
+#endif
+
 class CCryptoControl
 {
     SRTSOCKET m_SocketID;
@@ -86,23 +86,33 @@ srt::CEPoll::CEPoll():
 m_iIDSeed(0)
 {
    // Exception -> CUDTUnited ctor.
-   setupMutex(m_EPollLock, "EPoll");
+   setupMutex(m_SeedLock, "EPollSeed");
+   for (int i = 0; i < EID_SHARDS; ++i)
+      setupMutex(m_Shards[i].lock, "EPoll");
 }
 
 srt::CEPoll::~CEPoll()
 {
-   releaseMutex(m_EPollLock);
+   for (int i = 0; i < EID_SHARDS; ++i)
+      releaseMutex(m_Shards[i].lock);
+   releaseMutex(m_SeedLock);
 }
 
 int srt::CEPoll::create(CEPollDesc** pout)
 {
-   ScopedLock pg(m_EPollLock);
+   int eid;
+   {
+      ScopedLock sg(m_SeedLock);
+      if (++ m_iIDSeed >= 0x7FFFFFFF)
+         m_iIDSeed = 0;
+      eid = m_iIDSeed;
+   }
 
-   if (++ m_iIDSeed >= 0x7FFFFFFF)
-      m_iIDSeed = 0;
+   Shard& sh = shardOf(eid);
+   ScopedLock pg(sh.lock);
 
    // Check if an item already exists. Should not ever happen.
-   if (m_mPolls.find(m_iIDSeed) != m_mPolls.end())
+   if (sh.polls.find(eid) != sh.polls.end())
        throw CUDTException(MJ_SETUP, MN_NONE);
 
    int localid = 0;
@@ -150,27 +160,29 @@ ENOMEM: There was insufficient memory to create the kernel object.
    // on Windows, select
    #endif
 
-   pair<map<int, CEPollDesc>::iterator, bool> res = m_mPolls.insert(make_pair(m_iIDSeed, CEPollDesc(m_iIDSeed, localid)));
+   pair<map<int, CEPollDesc>::iterator, bool> res = sh.polls.insert(make_pair(eid, CEPollDesc(eid, localid)));
    if (!res.second)  // Insertion failed (no memory?)
        throw CUDTException(MJ_SETUP, MN_NONE);
    if (pout)
        *pout = &res.first->second;
 
-   return m_iIDSeed;
+   return eid;
 }
 
 int srt::CEPoll::clear_usocks(int eid)
 {
     // This should remove all SRT sockets from given eid.
-   ScopedLock pg (m_EPollLock);
+   Shard& sh = shardOf(eid);
+   ScopedLock pg(sh.lock);
 
-   map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-   if (p == m_mPolls.end())
+   map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+   if (p == sh.polls.end())
       throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
 
    CEPollDesc& d = p->second;
 
    d.clearAll();
+   d.notifyWaiters();
 
    return 0;
 }
@@ -184,7 +196,7 @@ void srt::CEPoll::clear_ready_usocks(CEPollDesc& d, int direction)
         LOGC(eilog.Error, log << "CEPoll::clear_ready_usocks: IPE, event flags exceed event types: " << direction);
         return;
     }
-    ScopedLock pg (m_EPollLock);
+    ScopedLock pg (shardOf(d.m_iID).lock);
 
     vector<SRTSOCKET> cleared;
 
@@ -211,14 +223,18 @@ void srt::CEPoll::clear_ready_usocks(CEPollDesc& d, int direction)
 
     for (size_t j = 0; j < cleared.size(); ++j)
         d.removeSubscription(cleared[j]);
+
+    if (!cleared.empty())
+        d.notifyWaiters();
 }
 
 int srt::CEPoll::add_ssock(const int eid, const SYSSOCKET& s, const int* events)
 {
-   ScopedLock pg(m_EPollLock);
+   Shard& sh = shardOf(eid);
+   ScopedLock pg(sh.lock);
 
-   map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-   if (p == m_mPolls.end())
+   map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+   if (p == sh.polls.end())
       throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
 
 #ifdef LINUX
@@ -281,16 +297,18 @@ int srt::CEPoll::add_ssock(const int eid, const SYSSOCKET& s, const int* events)
 #endif
 
    p->second.m_sLocals.insert(s);
+   p->second.notifyWaiters();
 
    return 0;
 }
 
 int srt::CEPoll::remove_ssock(const int eid, const SYSSOCKET& s)
 {
-   ScopedLock pg(m_EPollLock);
+   Shard& sh = shardOf(eid);
+   ScopedLock pg(sh.lock);
 
-   map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-   if (p == m_mPolls.end())
+   map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+   if (p == sh.polls.end())
       throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
 
 #ifdef LINUX
@@ -311,6 +329,7 @@ int srt::CEPoll::remove_ssock(const int eid, const SYSSOCKET& s)
 #endif
 
    p->second.m_sLocals.erase(s);
+   p->second.notifyWaiters();
 
    return 0;
 }
@@ -318,11 +337,12 @@ int srt::CEPoll::remove_ssock(const int eid, const SYSSOCKET& s)
 // Need this to atomically modify polled events (ex: remove write/keep read)
 int srt::CEPoll::update_usock(const int eid, const SRTSOCKET& u, const int* events)
 {
-    ScopedLock pg(m_EPollLock);
+    Shard& sh = shardOf(eid);
+    ScopedLock pg(sh.lock);
     IF_HEAVY_LOGGING(ostringstream evd);
 
-    map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-    if (p == m_mPolls.end())
+    map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+    if (p == sh.polls.end())
         throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
 
     CEPollDesc& d = p->second;
@@ -385,15 +405,19 @@ int srt::CEPoll::update_usock(const int eid, const SRTSOCKET& u, const int* even
         HLOGC(ealog.Debug, log << "srt_epoll_update_usock: REMOVED E" << eid << " socket @" << u);
         d.removeSubscription(u);
     }
+
+    // The subscription may be ready already, or the EID may have become empty.
+    d.notifyWaiters();
     return 0;
 }
 
 int srt::CEPoll::update_ssock(const int eid, const SYSSOCKET& s, const int* events)
 {
-   ScopedLock pg(m_EPollLock);
+   Shard& sh = shardOf(eid);
+   ScopedLock pg(sh.lock);
 
-   map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-   if (p == m_mPolls.end())
+   map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+   if (p == sh.polls.end())
       throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
 
 #ifdef LINUX
@@ -461,9 +485,10 @@ int srt::CEPoll::update_ssock(const int eid, const SYSSOCKET& s, const int* even
 
 int srt::CEPoll::setflags(const int eid, int32_t flags)
 {
-    ScopedLock pg(m_EPollLock);
-    map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-    if (p == m_mPolls.end())
+    Shard& sh = shardOf(eid);
+    ScopedLock pg(sh.lock);
+    map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+    if (p == sh.polls.end())
         throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
     CEPollDesc& ed = p->second;
 
@@ -481,6 +506,7 @@ int srt::CEPoll::setflags(const int eid, int32_t flags)
         ed.set_flags(flags);
     }
 
+    ed.notifyWaiters();
     return oflags;
 }
 
@@ -494,12 +520,13 @@ int srt::CEPoll::uwait(const int eid, SRT_EPOLL_EVENT* fdsSet, int fdsSize, int6
 
     steady_clock::time_point entertime = steady_clock::now();
 
+    Shard& sh = shardOf(eid);
+    UniqueLock pg(sh.lock);
     while (true)
     {
         {
-            ScopedLock pg(m_EPollLock);
-            map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-            if (p == m_mPolls.end())
+            map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+            if (p == sh.polls.end())
                 throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
             CEPollDesc& ed = p->second;
 
@@ -538,12 +565,19 @@ int srt::CEPoll::uwait(const int eid, SRT_EPOLL_EVENT* fdsSet, int fdsSize, int6
             }
             if (total)
                 return total;
-        }
 
-        if ((msTimeOut >= 0) && (count_microseconds(srt::sync::steady_clock::now() - entertime) >= msTimeOut * int64_t(1000)))
-            break; // official wait does: throw CUDTException(MJ_AGAIN, MN_XMTIMEOUT, 0);
+            steady_clock::duration timeout = steady_clock::duration(-1); // no limit
+            if (msTimeOut >= 0)
+            {
+                const steady_clock::duration passed = steady_clock::now() - entertime;
+                if (passed >= milliseconds_from(msTimeOut))
+                    break; // official wait does: throw CUDTException(MJ_AGAIN, MN_XMTIMEOUT, 0);
+                timeout = milliseconds_from(msTimeOut) - passed;
+            }
 
-        CGlobEvent::waitForEvent();
+            if (!waitForChange(pg, ed, timeout))
+                throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
+        }
     }
 
     return 0;
@@ -564,13 +598,13 @@ int srt::CEPoll::wait(const int eid, set<SRTSOCKET>* readfds, set<SRTSOCKET>* wr
     int total = 0;
 
     srt::sync::steady_clock::time_point entertime = srt::sync::steady_clock::now();
+    Shard& sh = shardOf(eid);
+    UniqueLock epollock(sh.lock);
     while (true)
     {
         {
-            ScopedLock epollock(m_EPollLock);
-
-            map<int, CEPollDesc>::iterator p = m_mPolls.find(eid);
-            if (p == m_mPolls.end())
+            map<int, CEPollDesc>::iterator p = sh.polls.find(eid);
+            if (p == sh.polls.end())
             {
                 LOGC(ealog.Error, log << "EID:" << eid << " INVALID.");
                 throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
@@ -725,22 +759,30 @@ int srt::CEPoll::wait(const int eid, set<SRTSOCKET>* readfds, set<SRTSOCKET>* wr
 #endif
             }
 
-        } // END-LOCK: m_EPollLock
+            HLOGC(ealog.Debug, log << "CEPoll::wait: Total of " << total << " READY SOCKETS");
 
-        HLOGC(ealog.Debug, log << "CEPoll::wait: Total of " << total << " READY SOCKETS");
+            if (total > 0)
+                return total;
 
-        if (total > 0)
-            return total;
+            steady_clock::duration timeout = steady_clock::duration(-1); // no limit
+            if (msTimeOut >= 0)
+            {
+                const steady_clock::duration passed = steady_clock::now() - entertime;
+                if (passed >= milliseconds_from(msTimeOut))
+                {
+                    HLOGC(ealog.Debug, log << "EID:" << eid << ": TIMEOUT.");
+                    throw CUDTException(MJ_AGAIN, MN_XMTIMEOUT, 0);
+                }
+                timeout = milliseconds_from(msTimeOut) - passed;
+            }
 
-        if ((msTimeOut >= 0) && (count_microseconds(srt::sync::steady_clock::now() - entertime) >= msTimeOut * int64_t(1000)))
-        {
-            HLOGC(ealog.Debug, log << "EID:" << eid << ": TIMEOUT.");
-            throw CUDTException(MJ_AGAIN, MN_XMTIMEOUT, 0);
-        }
+            // Nothing signals readiness of the system sockets, so they must be polled.
+            if (!ed.m_sLocals.empty() && (timeout < steady_clock::duration::zero() || timeout > milliseconds_from(10)))
+                timeout = milliseconds_from(10);
 
-        const bool wait_signaled SRT_ATR_UNUSED = CGlobEvent::waitForEvent();
-        HLOGC(ealog.Debug, log << "CEPoll::wait: EVENT WAITING: "
-            << (wait_signaled ? "TRIGGERED" : "CHECKPOINT"));
+            if (!waitForChange(epollock, ed, timeout))
+                throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
+        }
     }
 
     return 0;
@@ -749,7 +791,7 @@ int srt::CEPoll::wait(const int eid, set<SRTSOCKET>* readfds, set<SRTSOCKET>* wr
 int srt::CEPoll::swait(CEPollDesc& d, map<SRTSOCKET, int>& st, int64_t msTimeOut, bool report_by_exception)
 {
     {
-        ScopedLock lg (m_EPollLock);
+        ScopedLock lg (shardOf(d.m_iID).lock);
         if (!d.flags(SRT_EPOLL_ENABLE_EMPTY) && d.watch_empty() && msTimeOut < 0)
         {
             // no socket is being monitored, this may be a deadlock
@@ -763,18 +805,18 @@ int srt::CEPoll::swait(CEPollDesc& d, map<SRTSOCKET, int>& st, int64_t msTimeOut
     st.clear();
 
     steady_clock::time_point entertime = steady_clock::now();
+
+    // Not extracting separately because this function is
+    // for internal use only and we state that the eid could
+    // not be deleted or changed the target CEPollDesc in the
+    // meantime.
+
+    // Here we only prevent the pollset be updated simultaneously
+    // with unstable reading.
+    UniqueLock lg (shardOf(d.m_iID).lock);
     while (true)
     {
         {
-            // Not extracting separately because this function is
-            // for internal use only and we state that the eid could
-            // not be deleted or changed the target CEPollDesc in the
-            // meantime.
-
-            // Here we only prevent the pollset be updated simultaneously
-            // with unstable reading. 
-            ScopedLock lg (m_EPollLock);
-
             if (!d.flags(SRT_EPOLL_ENABLE_EMPTY) && d.watch_empty())
             {
                 // Empty EID is not allowed, report error.
@@ -819,15 +861,26 @@ int srt::CEPoll::swait(CEPollDesc& d, map<SRTSOCKET, int>& st, int64_t msTimeOut
             // extremely often.
         }
 
-        if ((msTimeOut >= 0) && ((steady_clock::now() - entertime) >= microseconds_from(msTimeOut * int64_t(1000))))
+        steady_clock::duration timeout = steady_clock::duration(-1); // no limit
+        if (msTimeOut >= 0)
         {
-            HLOGC(ealog.Debug, log << "EID:" << d.m_iID << ": TIMEOUT.");
-            if (report_by_exception)
-                throw CUDTException(MJ_AGAIN, MN_XMTIMEOUT, 0);
-            return 0; // meaning "none is ready"
+            const steady_clock::duration passed = steady_clock::now() - entertime;
+            if (passed >= milliseconds_from(msTimeOut))
+            {
+                HLOGC(ealog.Debug, log << "EID:" << d.m_iID << ": TIMEOUT.");
+                if (report_by_exception)
+                    throw CUDTException(MJ_AGAIN, MN_XMTIMEOUT, 0);
+                return 0; // meaning "none is ready"
+            }
+            timeout = milliseconds_from(msTimeOut) - passed;
         }
 
-        CGlobEvent::waitForEvent();
+        if (!waitForChange(lg, d, timeout))
+        {
+            if (report_by_exception)
+                throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
+            return -1;
+        }
     }
 
     return 0;
@@ -835,18 +888,29 @@ int srt::CEPoll::swait(CEPollDesc& d, map<SRTSOCKET, int>& st, int64_t msTimeOut
 
 bool srt::CEPoll::empty(const CEPollDesc& d) const
 {
-    ScopedLock lg (m_EPollLock);
+    ScopedLock lg (shardOf(d.m_iID).lock);
     return d.watch_empty();
 }
 
 int srt::CEPoll::release(const int eid)
 {
-   ScopedLock pg(m_EPollLock);
+   Shard& sh = shardOf(eid);
+   UniqueLock pg(sh.lock);
 
-   map<int, CEPollDesc>::iterator i = m_mPolls.find(eid);
-   if (i == m_mPolls.end())
+   map<int, CEPollDesc>::iterator i = sh.polls.find(eid);
+   if (i == sh.polls.end())
       throw CUDTException(MJ_NOTSUP, MN_EIDINVAL);
 
+   // Threads waiting for this EID refer to the descriptor,
+   // so let them quit before it's deleted.
+   CEPollDesc& d = i->second;
+   d.m_bReleased = true;
+   while (d.m_iWaiters)
+   {
+      d.m_ReadyCond.cond().notify_all();
+      d.m_ReadyCond.cond().wait(pg);
+   }
+
    #ifdef LINUX
    // release local/system epoll descriptor
    ::close(i->second.m_iLocalID);
@@ -854,12 +918,31 @@ int srt::CEPoll::release(const int eid)
    ::close(i->second.m_iLocalID);
    #endif
 
-   m_mPolls.erase(i);
+   sh.polls.erase(i);
 
    return 0;
 }
 
 
+bool srt::CEPoll::waitForChange(UniqueLock& lk, CEPollDesc& d, const steady_clock::duration& timeout)
+{
+    ++d.m_iWaiters;
+    if (timeout < steady_clock::duration::zero())
+        d.m_ReadyCond.cond().wait(lk);
+    else
+        d.m_ReadyCond.cond().wait_for(lk, timeout);
+    --d.m_iWaiters;
+    ++m_llWakeups;
+
+    if (d.m_bReleased)
+    {
+        // release() is waiting for all waiters to quit.
+        d.m_ReadyCond.cond().notify_all();
+        return false;
+    }
+    return true;
+}
+
 int srt::CEPoll::update_events(const SRTSOCKET& uid, std::set<int>& eids, const int events, const bool enable)
 {
     // As event flags no longer contain only event types, check now.
@@ -876,73 +959,115 @@ int srt::CEPoll::update_events(const SRTSOCKET& uid, std::set<int>& eids, const
     IF_HEAVY_LOGGING(debug << "epoll/update: @" << uid << " " << (enable ? "+" : "-"));
     IF_HEAVY_LOGGING(PrintEpollEvent(debug, events));
 
-    ScopedLock pg (m_EPollLock);
-    for (set<int>::iterator i = eids.begin(); i != eids.end(); ++ i)
     {
-        map<int, CEPollDesc>::iterator p = m_mPolls.find(*i);
-        if (p == m_mPolls.end())
+        // The set of EIDs is only read here, so updates of
+        // other sockets and other EIDs don't wait for each other.
+        SharedLock pg (m_EPollLock);
+        for (set<int>::iterator i = eids.begin(); i != eids.end(); ++ i)
         {
-            HLOGC(eilog.Note, log << "epoll/update: E" << *i << " was deleted in the meantime");
-            // EID invalid, though still present in the socket's subscriber list
-            // (dangling in the socket). Postpone to fix the subscruption and continue.
-            lost.push_back(*i);
-            continue;
-        }
+            Shard& sh = shardOf(*i);
+            UpdateLock sg (sh);
 
-        CEPollDesc& ed = p->second;
+            map<int, CEPollDesc>::iterator p = sh.polls.find(*i);
+            if (p == sh.polls.end())
+            {
+                HLOGC(eilog.Note, log << "epoll/update: E" << *i << " was deleted in the meantime");
+                // EID invalid, though still present in the socket's subscriber list
+                // (dangling in the socket). Postpone to fix the subscruption and continue.
+                lost.push_back(*i);
+                continue;
+            }
 
-        // Check if this EID is subscribed for this socket.
-        CEPollDesc::Wait* pwait = ed.watch_find(uid);
-        if (!pwait)
-        {
-            // As this is mapped in the socket's data, it should be impossible.
-            LOGC(eilog.Error, log << "epoll/update: IPE: update struck E"
-                    << (*i) << " which is NOT SUBSCRIBED to @" << uid);
-            continue;
-        }
+            CEPollDesc& ed = p->second;
 
-        IF_HEAVY_LOGGING(string tracking = " TRACKING: " + ed.DisplayEpollWatch());
-        // compute new states
+            // Check if this EID is subscribed for this socket.
+            CEPollDesc::Wait* pwait = ed.watch_find(uid);
+            if (!pwait)
+            {
+                // As this is mapped in the socket's data, it should be impossible.
+                LOGC(eilog.Error, log << "epoll/update: IPE: update struck E"
+                        << (*i) << " which is NOT SUBSCRIBED to @" << uid);
+                continue;
+            }
 
-        // New state to be set into the permanent state
-        const int newstate = enable ? pwait->state | events // SET event bits if enable
-                              : pwait->state & (~events); // CLEAR event bits
+            IF_HEAVY_LOGGING(string tracking = " TRACKING: " + ed.DisplayEpollWatch());
+            // compute new states
+
+            // New state to be set into the permanent state
+            const int newstate = enable ? pwait->state | events // SET event bits if enable
+                                  : pwait->state & (~events); // CLEAR event bits
+
+            // compute states changes!
+            int changes = pwait->state ^ newstate; // oldState XOR newState
+            if (!changes)
+            {
+                HLOGC(eilog.Debug, log << debug.str() << ": E" << (*i)
+                        << tracking << " NOT updated: no changes");
+                continue; // no changes!
+            }
+            // assign new state
+            pwait->state = newstate;
+            // filter change relating what is watching
+            changes &= pwait->watch;
+            if (!changes)
+            {
+                HLOGC(eilog.Debug, log << debug.str() << ": E" << (*i)
+                        << tracking << " NOT updated: not subscribed");
+                continue; // no change watching
+            }
+            // set events changes!
+
+            // This function will update the notice object associated with
+            // the given events, that is:
+            // - if enable, it will set event flags, possibly in a new notice object
+            // - if !enable, it will clear event flags, possibly remove notice if resulted in 0
+            ed.updateEventNotice(*pwait, uid, events, enable);
+            ++nupdated;
+
+            // Only the threads waiting for this EID are woken up.
+            if (enable)
+                ed.notifyWaiters();
 
-        // compute states changes!
-        int changes = pwait->state ^ newstate; // oldState XOR newState
-        if (!changes)
-        {
-            HLOGC(eilog.Debug, log << debug.str() << ": E" << (*i)
-                    << tracking << " NOT updated: no changes");
-            continue; // no changes!
-        }
-        // assign new state
-        pwait->state = newstate;
-        // filter change relating what is watching
-        changes &= pwait->watch;
-        if (!changes)
-        {
             HLOGC(eilog.Debug, log << debug.str() << ": E" << (*i)
-                    << tracking << " NOT updated: not subscribed");
-            continue; // no change watching
+                    << " TRACKING: " << ed.DisplayEpollWatch());
         }
-        // set events changes!
+    }
 
-        // This function will update the notice object associated with
-        // the given events, that is:
-        // - if enable, it will set event flags, possibly in a new notice object
-        // - if !enable, it will clear event flags, possibly remove notice if resulted in 0
-        ed.updateEventNotice(*pwait, uid, events, enable);
-        ++nupdated;
+    if (!lost.empty())
+    {
+        ExclusiveLock pg (m_EPollLock);
+        for (vector<int>::iterator i = lost.begin(); i != lost.end(); ++ i)
+            eids.erase(*i);
+    }
+
+    return nupdated;
+}
 
-        HLOGC(eilog.Debug, log << debug.str() << ": E" << (*i)
-                << " TRACKING: " << ed.DisplayEpollWatch());
+srt::CEPoll::UpdateLock::UpdateLock(Shard& sh)
+    : m_Shard(sh)
+{
+    ++sh.updates;
+    if (!tryEnterCS(sh.lock))
+    {
+        ++sh.contended;
+        enterCS(sh.lock);
     }
+}
 
-    for (vector<int>::iterator i = lost.begin(); i != lost.end(); ++ i)
-        eids.erase(*i);
+srt::CEPoll::UpdateLock::~UpdateLock()
+{
+    leaveCS(m_Shard.lock);
+}
 
-    return nupdated;
+void srt::CEPoll::getLockStats(int64_t& w_updates, int64_t& w_contended) const
+{
+    w_updates   = 0;
+    w_contended = 0;
+    for (int i = 0; i < EID_SHARDS; ++i)
+    {
+        w_updates   += m_Shards[i].updates;
+        w_contended += m_Shards[i].contended;
+    }
 }
 
 // Debug use only.
@@ -58,6 +58,7 @@ modified by
 #include <set>
 #include <list>
 #include "udt.h"
+#include "sync.h"
 
 namespace srt
 {
@@ -165,6 +166,35 @@ std::string DisplayEpollWatch();
    // Special behavior
    int32_t m_Flags;
 
+   /// The condition signaled to the threads waiting for this EID, used
+   /// together with the lock of its CEPoll shard. A copy gets its own condition:
+   /// descriptors are copied only when inserted into the shard.
+   class ReadyCond
+   {
+       srt::sync::Condition m_cond;
+
+   public:
+       ReadyCond() { srt::sync::setupCond(m_cond, "EPollReady"); }
+       ReadyCond(const ReadyCond&) { srt::sync::setupCond(m_cond, "EPollReady"); }
+       ~ReadyCond() { srt::sync::releaseCond(m_cond); }
+
+       srt::sync::Condition& cond() { return m_cond; }
+
+   private:
+       ReadyCond& operator=(const ReadyCond&);
+   };
+
+   ReadyCond m_ReadyCond;
+   int       m_iWaiters;  // Number of threads waiting on m_ReadyCond
+   bool      m_bReleased; // The EID is being released, waiters must quit
+
+   /// Wake up the threads waiting for this EID, if any.
+   void notifyWaiters()
+   {
+       if (m_iWaiters)
+           m_ReadyCond.cond().notify_all();
+   }
+
    enotice_t::iterator nullNotice() { return m_USockEventNotice.end(); }
 
    // Only CEPoll class should have access to it.
@@ -175,6 +205,8 @@ std::string DisplayEpollWatch();
    CEPollDesc(int id, int localID)
        : m_iID(id)
        , m_Flags(0)
+       , m_iWaiters(0)
+       , m_bReleased(false)
        , m_iLocalID(localID)
     {
     }
@@ -491,12 +523,58 @@ public: // for CUDT to acknowledge IO status
 
    int setflags(const int eid, int32_t flags);
 
+   /// Get the number of times a thread waiting in one of the wait functions
+   /// has been woken up, whether by an event, a timeout or spuriously.
+   int64_t wakeups() const { return m_llWakeups; }
+
+   /// Get the counters of locking the EIDs by update_events.
+   /// @param [out] w_updates number of times an EID was locked for an update
+   /// @param [out] w_contended how many of them had to wait for the lock
+   void getLockStats(int64_t& w_updates, int64_t& w_contended) const;
+
 private:
+   /// The EIDs are distributed among shards by their ID, each with its own
+   /// lock, so that the operations on EIDs in different shards don't contend.
+   static const int EID_SHARDS = 16;
+
+   struct Shard
+   {
+       mutable srt::sync::Mutex   lock;      // Protects `polls` and the state of EIDs in it
+       std::map<int, CEPollDesc>  polls;
+       srt::sync::atomic<int64_t> updates;   // Times locked by update_events
+       srt::sync::atomic<int64_t> contended; // Times update_events had to wait for the lock
+   };
+
+   /// Lock on a shard taken by update_events, counting the contention.
+   class UpdateLock
+   {
+       Shard& m_Shard;
+
+   public:
+       explicit UpdateLock(Shard& sh);
+       ~UpdateLock();
+   };
+
+   Shard& shardOf(int eid) { return m_Shards[unsigned(eid) % EID_SHARDS]; }
+   const Shard& shardOf(int eid) const { return m_Shards[unsigned(eid) % EID_SHARDS]; }
+
+   /// Wait until the state of the given EID changes or the timeout expires.
+   /// @param lk lock on the shard of the EID
+   /// @param d the EID to wait for
+   /// @param timeout maximum time to wait, negative to wait with no limit
+   /// @return false if the EID has been released in the meantime
+   bool waitForChange(srt::sync::UniqueLock& lk, CEPollDesc& d, const srt::sync::steady_clock::duration& timeout);
+
    int m_iIDSeed;                            // seed to generate a new ID
    srt::sync::Mutex m_SeedLock;
 
-   std::map<int, CEPollDesc> m_mPolls;       // all epolls
-   mutable srt::sync::Mutex m_EPollLock;
+   Shard m_Shards[EID_SHARDS];               // all epolls
+
+   /// Protects the sets of EIDs subscribed to the sockets and groups (m_sPollID).
+   /// They are only read by update_events, which can then run in parallel.
+   mutable srt::sync::SharedMutex m_EPollLock;
+
+   srt::sync::atomic<int64_t> m_llWakeups;   // Wake-ups of the waiting threads
 };
 
 #if ENABLE_HEAVY_LOGGING
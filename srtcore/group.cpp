@@ -275,6 +275,8 @@ CUDTGroup::CUDTGroup(SRT_GROUP_TYPE gtype)
     , m_bOpened(false)
     , m_bConnected(false)
     , m_bClosing(false)
+    , m_iMemberEpoch(0)
+    , m_iCheckedMemberEpoch(-1)
     , m_iLastSchedSeqNo(SRT_SEQNO_NONE)
     , m_iLastSchedMsgNo(SRT_MSGNO_NONE)
 {
@@ -576,6 +578,13 @@ void CUDTGroup::deriveSettings(CUDT* u)
 
     IM(SRTO_UDP_SNDBUF, iUDPSndBufSize);
     IM(SRTO_UDP_RCVBUF, iUDPRcvBufSize);
+    IM(SRTO_UDP_RCVBATCH, iUDPRcvBatch);
+    IM(SRTO_UDP_SNDBATCH, iUDPSndBatch);
+    IM(SRTO_RCVWORKERS, iRcvWorkers);
+    IM(SRTO_CRYPTOWORKERS, iCryptoWorkers);
+    IM(SRTO_ACCEPTWORKERS, iAcceptWorkers);
+    IM(SRTO_PACINGMODE, iPacingMode);
+    IM(SRTO_PACINGSPIN, iPacingSpin);
     // SRTO_RENDEZVOUS: impossible to have it set on a listener socket.
     // SRTO_SNDTIMEO/RCVTIMEO: groupwise setting
 
@@ -589,6 +598,7 @@ void CUDTGroup::deriveSettings(CUDT* u)
     IM(SRTO_INPUTBW, llInputBW);
     IM(SRTO_MININPUTBW, llMinInputBW);
     IM(SRTO_OHEADBW, iOverheadBW);
+    IM(SRTO_PACINGTRAIN, iPacingTrain);
     IM(SRTO_IPTOS, iIpToS);
     IM(SRTO_IPTTL, iIpTTL);
     IM(SRTO_TSBPDMODE, bTSBPD);
@@ -720,6 +730,20 @@ static bool getOptDefault(SRT_SOCKOPT optname, void* pw_optval, int& w_optlen)
     case SRTO_UDP_SNDBUF:
     case SRTO_UDP_RCVBUF:
         RD(CSrtConfig::DEF_UDP_BUFFER_SIZE);
+    case SRTO_UDP_RCVBATCH:
+        RD(CSrtConfig::DEF_UDP_RCV_BATCH);
+    case SRTO_UDP_SNDBATCH:
+        RD(CSrtConfig::DEF_UDP_SND_BATCH);
+    case SRTO_RCVWORKERS:
+        RD(CSrtConfig::DEF_RCV_WORKERS);
+    case SRTO_CRYPTOWORKERS:
+        RD(CSrtConfig::DEF_CRYPTO_WORKERS);
+    case SRTO_ACCEPTWORKERS:
+        RD(CSrtConfig::DEF_ACCEPT_WORKERS);
+    case SRTO_PACINGMODE:
+        RD(CSrtConfig::DEF_PACING_MODE);
+    case SRTO_PACINGSPIN:
+        RD(CSrtConfig::DEF_PACING_SPIN);
     case SRTO_RENDEZVOUS:
         RD(false);
     case SRTO_SNDTIMEO:
@@ -792,6 +816,8 @@ static bool getOptDefault(SRT_SOCKOPT optname, void* pw_optval, int& w_optlen)
         RD(0);
     case SRTO_RETRANSMITALGO:
         RD(1);
+    case SRTO_PACINGTRAIN:
+        RD(CSrtConfig::DEF_PACING_TRAIN);
     }
 
 #undef RD
@@ -1087,7 +1113,7 @@ void CUDTGroup::close()
         {
             // Global EPOLL lock must be applied to access any socket's epoll set.
             // This is a set of all epoll ids subscribed to it.
-            ScopedLock elock (CUDT::uglobal().m_EPoll.m_EPollLock);
+            ExclusiveLock elock (CUDT::uglobal().m_EPoll.m_EPollLock);
             epollid = m_sPollID; // use move() in C++11
             m_sPollID.clear();
         }
@@ -1176,6 +1202,23 @@ void CUDTGroup::send_CheckValidSockets()
     }
 }
 
+void CUDTGroup::send_CheckMemberEpoch()
+{
+    // Read before the check, so that a socket closed during
+    // the check makes the next call check again.
+    const int epoch = m_iMemberEpoch;
+    if (epoch == m_iCheckedMemberEpoch)
+        return;
+
+    // Acquire GlobControlLock to make sure all member sockets still exist
+    ScopedLock globlock(m_Global.m_GlobControlLock);
+    ScopedLock grouplock(m_GroupLock);
+
+    // LOCKED: GlobControlLock, GroupLock (RIGHT ORDER!)
+    send_CheckValidSockets();
+    m_iCheckedMemberEpoch = epoch;
+}
+
 int CUDTGroup::send(const char* buf, int len, SRT_MSGCTRL& w_mc)
 {
     switch (m_type)
@@ -1228,21 +1271,10 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
 
     vector<gli_t> activeLinks;
 
-    // First, acquire GlobControlLock to make sure all member sockets still exist
-    enterCS(m_Global.m_GlobControlLock);
+    // First, check if all sockets still can be dispatched, if any was closed
+    send_CheckMemberEpoch();
     ScopedLock guard(m_GroupLock);
 
-    if (m_bClosing)
-    {
-        leaveCS(m_Global.m_GlobControlLock);
-        throw CUDTException(MJ_CONNECTION, MN_CONNLOST, 0);
-    }
-
-    // Now, still under lock, check if all sockets still can be dispatched
-
-    // LOCKED: GlobControlLock, GroupLock (RIGHT ORDER!)
-    send_CheckValidSockets();
-    leaveCS(m_Global.m_GlobControlLock);
     // LOCKED: GroupLock (only)
     // Since this moment GlobControlLock may only be locked if GroupLock is unlocked first.
 
@@ -1335,6 +1367,13 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
     if (w_mc.srctime == 0)
         w_mc.srctime = count_microseconds(steady_clock::now().time_since_epoch());
 
+    // The payload sent over multiple links is stored once and referenced
+    // by the sender buffers of the links sending it without encryption.
+    // If it can't be shared, every link copies it.
+    CSndSharedPayload* shared = NULL;
+    if (activeLinks.size() + idleLinks.size() > 1)
+        shared = CSndSharedPayload::create(buf, len);
+
     for (vector<gli_t>::iterator snd = activeLinks.begin(); snd != activeLinks.end(); ++snd)
     {
         gli_t d   = *snd;
@@ -1346,7 +1385,7 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
             // Possible return values are only 0, in case when len was passed 0, or a positive
             // >0 value that defines the size of the data that it has sent, that is, in case
             // of Live mode, equal to 'len'.
-            stat = d->ps->core().sendmsg2(buf, len, (w_mc));
+            stat = shared ? d->ps->core().sendmsgShared(*shared, (w_mc)) : d->ps->core().sendmsg2(buf, len, (w_mc));
         }
         catch (CUDTException& e)
         {
@@ -1434,7 +1473,7 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
 
         try
         {
-            stat = d->ps->core().sendmsg2(buf, len, (w_mc));
+            stat = shared ? d->ps->core().sendmsgShared(*shared, (w_mc)) : d->ps->core().sendmsg2(buf, len, (w_mc));
         }
         catch (CUDTException& e)
         {
@@ -1462,6 +1501,10 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
         sendstates.push_back(cstate);
     }
 
+    // The sender buffers hold their own references.
+    if (shared)
+        shared->release();
+
     if (nextseq != SRT_SEQNO_NONE)
     {
         HLOGC(gslog.Debug,
@@ -1606,35 +1649,21 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
     // - wipeme - sending failed by any other reason than blocking, remove.
 
     // Now - sendstates contain directly sockets.
-    // In order to update members, you need to have locked:
-    // - GlobControlLock to prevent sockets from disappearing or being closed
-    // - then GroupLock to latch the validity of m_GroupMemberData field.
+    // A member is removed from the group container under GroupLock,
+    // so a member found there by ID is still valid.
 
     {
-        {
-            InvertedLock ung (m_GroupLock);
-            enterCS(CUDT::uglobal().m_GlobControlLock);
-            HLOGC(gslog.Debug, log << "grp/sendBroadcast: Locked GlobControlLock, locking back GroupLock");
-        }
-
-        // Under this condition, as an unlock-lock cycle was done on m_GroupLock,
-        // the Sendstate::it field shall not be used here!
+        // As an unlock-lock cycle might have been done on m_GroupLock,
+        // the Sendstate::mb field shall not be used here!
         for (vector<Sendstate>::iterator is = sendstates.begin(); is != sendstates.end(); ++is)
         {
-            CUDTSocket* ps = CUDT::uglobal().locateSocket_LOCKED(is->id);
-
-            // Is the socket valid? If not, simply SKIP IT. Nothing to be done with it,
-            // it's already deleted.
-            if (!ps)
-                continue;
-
             // Is the socket still group member? If not, SKIP IT. It could only be taken ownership
             // by being explicitly closed and so it's deleted from the container.
-            if (!ps->m_GroupOf)
+            const gli_t m = std::find_if(m_Group.begin(), m_Group.end(), HaveID(is->id));
+            if (m == m_Group.end())
                 continue;
 
-            // Now we are certain that m_GroupMemberData is valid.
-            SocketData* d = ps->m_GroupMemberData;
+            SocketData* d = &*m;
 
             if (is->stat == len)
             {
@@ -1663,9 +1692,6 @@ int CUDTGroup::sendBroadcast(const char* buf, int len, SRT_MSGCTRL& w_mc)
             // Turn this link broken
             d->sndstate = SRT_GST_BROKEN;
         }
-
-        // Now you can leave GlobControlLock, while GroupLock is still locked.
-        leaveCS(CUDT::uglobal().m_GlobControlLock);
     }
 
     // Re-check after the waiting lock has been reacquired
@@ -2061,31 +2087,6 @@ void CUDTGroup::fillGroupData(SRT_MSGCTRL&       w_out, // MSGCTRL to be written
     w_out.grpdata = grpdata;
 }
 
-// [[using locked(CUDT::uglobal()->m_GlobControLock)]]
-// [[using locked(m_GroupLock)]]
-struct FLookupSocketWithEvent_LOCKED
-{
-    CUDTUnited* glob;
-    int         evtype;
-    FLookupSocketWithEvent_LOCKED(CUDTUnited* g, int event_type)
-        : glob(g)
-        , evtype(event_type)
-    {
-    }
-
-    typedef CUDTSocket* result_type;
-
-    pair<CUDTSocket*, bool> operator()(const pair<SRTSOCKET, int>& es)
-    {
-        CUDTSocket* so = NULL;
-        if ((es.second & evtype) == 0)
-            return make_pair(so, false);
-
-        so = glob->locateSocket_LOCKED(es.first);
-        return make_pair(so, !!so);
-    }
-};
-
 void CUDTGroup::recv_CollectAliveAndBroken(vector<CUDTSocket*>& alive, set<CUDTSocket*>& broken)
 {
 #if ENABLE_HEAVY_LOGGING
@@ -2198,27 +2199,18 @@ vector<CUDTSocket*> CUDTGroup::recv_WaitForReadReady(const vector<CUDTSocket*>&
     // Poll on this descriptor until reading is available, indefinitely.
     CEPoll::fmap_t sready;
 
-    // GlobControlLock is required for dispatching the sockets.
-    // Therefore it must be applied only when GroupLock is off.
     {
         // This call may wait indefinite time, so GroupLock must be unlocked.
         InvertedLock ung (m_GroupLock);
         THREAD_PAUSED();
         nready  = m_Global.m_EPoll.swait(*m_RcvEpolld, sready, timeout, false /*report by retval*/);
         THREAD_RESUMED();
-
-        // HERE GlobControlLock is locked first, then GroupLock is applied back
-        enterCS(CUDT::uglobal().m_GlobControlLock);
     }
-    // BOTH m_GlobControlLock AND m_GroupLock are locked here.
 
     HLOGC(grlog.Debug, log << "group/recv: " << nready << " RDY: " << DisplayEpollResults(sready));
 
     if (nready == 0)
     {
-        // GlobControlLock is applied manually, so unlock manually.
-        // GroupLock will be unlocked as per scope.
-        leaveCS(CUDT::uglobal().m_GlobControlLock);
         // This can only happen when 0 is passed as timeout and none is ready.
         // And 0 is passed only in non-blocking mode. So this is none ready in
         // non-blocking mode.
@@ -2226,23 +2218,14 @@ vector<CUDTSocket*> CUDTGroup::recv_WaitForReadReady(const vector<CUDTSocket*>&
         throw CUDTException(MJ_AGAIN, MN_RDAVAIL, 0);
     }
 
-    // Handle sockets of pending connection and with errors.
-
-    // Nice to have something like:
-
-    // broken = FilterIf(sready, [] (auto s)
-    //                   { return s.second == SRT_EPOLL_ERR && (auto cs = g->locateSocket(s.first, ERH_RETURN))
-    //                          ? {cs, true}
-    //                          : {nullptr, false}
-    //                   });
-
-    FilterIf(
-        /*FROM*/ sready.begin(),
-        sready.end(),
-        /*TO*/ std::inserter(w_broken, w_broken.begin()),
-        /*VIA*/ FLookupSocketWithEvent_LOCKED(&m_Global, SRT_EPOLL_ERR));
+    // Handle sockets with errors. The sockets reported by the poller are
+    // only looked up among the members, so no GlobControlLock is required.
+    for (vector<CUDTSocket*>::const_iterator i = aliveMembers.begin(); i != aliveMembers.end(); ++i)
+    {
+        if (CEPoll::isready(sready, (*i)->m_SocketID, SRT_EPOLL_ERR))
+            w_broken.insert(*i);
+    }
 
-    
     // If this set is empty, it won't roll even once, therefore output
     // will be surely empty. This will be checked then same way as when
     // reading from every socket resulted in error.
@@ -2275,8 +2258,6 @@ vector<CUDTSocket*> CUDTGroup::recv_WaitForReadReady(const vector<CUDTSocket*>&
                 readReady.push_back(sock);
         }
     }
-    
-    leaveCS(CUDT::uglobal().m_GlobControlLock);
 
     return readReady;
 }
@@ -2382,8 +2363,8 @@ static bool isValidSeqno(int32_t iBaseSeqno, int32_t iPktSeqno)
 
 int CUDTGroup::recv(char* buf, int len, SRT_MSGCTRL& w_mc)
 {
-    // First, acquire GlobControlLock to make sure all member sockets still exist
-    enterCS(m_Global.m_GlobControlLock);
+    // First, check if all sockets still can be dispatched, if any was closed
+    send_CheckMemberEpoch();
     ScopedLock guard(m_GroupLock);
 
     if (m_bClosing)
@@ -2393,17 +2374,9 @@ int CUDTGroup::recv(char* buf, int len, SRT_MSGCTRL& w_mc)
         // must fist wait for being able to acquire this lock.
         // The group will not be deleted now because it is added usage counter
         // by this call, but will be released once it exits.
-        leaveCS(m_Global.m_GlobControlLock);
         throw CUDTException(MJ_CONNECTION, MN_CONNLOST, 0);
     }
 
-    // Now, still under lock, check if all sockets still can be dispatched
-    send_CheckValidSockets();
-    leaveCS(m_Global.m_GlobControlLock);
-
-    if (m_bClosing)
-        throw CUDTException(MJ_CONNECTION, MN_CONNLOST, 0);
-
     // Later iteration over it might be less efficient than
     // by vector, but we'll also often try to check a single id
     // if it was ever seen broken, so that it's skipped.
@@ -2991,9 +2964,7 @@ CUDTGroup::BackupMemberState CUDTGroup::sendBackup_QualifyActiveState(const gli_
         return BKUPST_ACTIVE_UNSTABLE;
     }
 
-    enterCS(u.m_StatsLock);
-    const int64_t drop_total = u.m_stats.sndr.dropped.total.count();
-    leaveCS(u.m_StatsLock);
+    const int64_t drop_total = u.m_stats.sndr.dropped.total().count();
 
     const bool have_new_drops = d->pktSndDropTotal != drop_total;
     if (have_new_drops)
@@ -3778,21 +3749,16 @@ int CUDTGroup::sendBackup(const char* buf, int len, SRT_MSGCTRL& w_mc)
 
     // [[using assert(this->m_pSndBuffer != nullptr)]];
 
-    // First, acquire GlobControlLock to make sure all member sockets still exist
-    enterCS(m_Global.m_GlobControlLock);
+    // First, check if all sockets still can be dispatched, if any was closed
+    send_CheckMemberEpoch();
     ScopedLock guard(m_GroupLock);
 
     if (m_bClosing)
     {
-        leaveCS(m_Global.m_GlobControlLock);
         LOGC(gslog.Error, log << "grp/send(backup): Cannot send, connection lost!");
         throw CUDTException(MJ_CONNECTION, MN_CONNLOST, 0);
     }
 
-    // Now, still under lock, check if all sockets still can be dispatched
-    send_CheckValidSockets();
-    leaveCS(m_Global.m_GlobControlLock);
-
     steady_clock::time_point currtime = steady_clock::now();
 
     SendBackupCtx sendBackupCtx; // default initialized as empty
@@ -4306,9 +4272,9 @@ void CUDTGroup::activateUpdateEvent(bool still_have_items)
 
 void CUDTGroup::addEPoll(int eid)
 {
-    enterCS(m_Global.m_EPoll.m_EPollLock);
+    m_Global.m_EPoll.m_EPollLock.lock();
     m_sPollID.insert(eid);
-    leaveCS(m_Global.m_EPoll.m_EPollLock);
+    m_Global.m_EPoll.m_EPollLock.unlock();
 
     bool any_read    = false;
     bool any_write   = false;
@@ -4367,9 +4333,9 @@ void CUDTGroup::removeEPollEvents(const int eid)
 
 void CUDTGroup::removeEPollID(const int eid)
 {
-    enterCS(m_Global.m_EPoll.m_EPollLock);
+    m_Global.m_EPoll.m_EPollLock.lock();
     m_sPollID.erase(eid);
-    leaveCS(m_Global.m_EPoll.m_EPollLock);
+    m_Global.m_EPoll.m_EPollLock.unlock();
 }
 
 void CUDTGroup::updateFailedLink()
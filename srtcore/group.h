@@ -313,6 +313,11 @@ private:
 
     void send_CheckValidSockets();
 
+    /// Calls send_CheckValidSockets() if any member socket has been
+    /// closed since the last call, otherwise doesn't lock anything.
+    /// [acquires lock for CUDT::uglobal()->m_GlobControlLock, then m_GroupLock, if needed]
+    void send_CheckMemberEpoch();
+
     SRT_KM_STATE getGroupEncryptionState();
 
 public:
@@ -349,6 +354,10 @@ public:
     void         updateWriteState();
     void         updateFailedLink();
     void         activateUpdateEvent(bool still_have_items);
+
+    /// Makes the sending and receiving functions check the member sockets
+    /// against the socket container again. Called when a member socket is closed.
+    void invalidateMembers() { ++m_iMemberEpoch; }
     int32_t      getRcvBaseSeqNo();
 
     /// Update the in-group array of packet providers per sequence number.
@@ -464,6 +473,12 @@ public:
     //       - UNLOCK GroupLock
     //    - UNLOCK GlobControlLock
     // - [Call the sending function (sendBroadcast/sendBackup)]
+    //    - Only if any member socket was closed since the last call:
+    //       - LOCK: GlobControlLock
+    //           - LOCK GroupLock
+    //               - Mark the members no longer in the socket container as broken
+    //           - UNLOCK GroupLock
+    //       - UNLOCK GlobControlLock
     //    - LOCK GroupLock
     //       - Preparation activities
     //       - Loop over group members
@@ -648,7 +663,6 @@ private:
     void recv_CollectAliveAndBroken(std::vector<srt::CUDTSocket*>& w_alive, std::set<srt::CUDTSocket*>& w_broken);
 
     /// The function polls alive member sockets and retrieves a list of read-ready.
-    /// [acquires lock for CUDT::uglobal()->m_GlobControlLock]
     /// [[using locked(m_GroupLock)]] temporally unlocks-locks internally
     ///
     /// @returns list of read-ready sockets
@@ -665,6 +679,12 @@ private:
     bool m_bConnected; // Set to true on first link confirmed connected
     bool m_bClosing;
 
+    // Incremented by invalidateMembers(). The sending and receiving functions
+    // check the members against the socket container, which requires the lock
+    // on GlobControlLock, only if it differs from m_iCheckedMemberEpoch.
+    sync::atomic<int> m_iMemberEpoch;
+    sync::atomic<int> m_iCheckedMemberEpoch;
+
     // There's no simple way of transforming config
     // items that are predicted to be used on socket.
     // Use some options for yourself, store the others
@@ -14,6 +14,7 @@ written by
  *****************************************************************************/
 
 
+#include <new>
 #include "srt_compat.h"
 #include "logging.h"
 
@@ -26,7 +27,7 @@ namespace srt_logging
 
 #if ENABLE_LOGGING
 
-LogDispatcher::Proxy::Proxy(LogDispatcher& guy) : that(guy), that_enabled(that.CheckEnabled())
+LogDispatcher::Proxy::Proxy(LogDispatcher& guy) : that(guy), site(), that_enabled(that.CheckEnabled())
 {
     if (that_enabled)
     {
@@ -38,6 +39,26 @@ LogDispatcher::Proxy::Proxy(LogDispatcher& guy) : that(guy), that_enabled(that.C
     }
 }
 
+LogDispatcher::Proxy::Proxy(LogDispatcher& guy, const LogSite& s) : that(guy), site(), that_enabled(that.CheckEnabled())
+{
+    if (that_enabled)
+    {
+        i_file = "";
+        i_line = 0;
+        flags = that.src_config->flags;
+        if (flags & SRT_LOGF_BINARY)
+        {
+            site = &s;
+            that.CreateLogRecordHeader((record), s);
+        }
+        else
+        {
+            // Create logger prefix
+            that.CreateLogLinePrefix(os);
+        }
+    }
+}
+
 LogDispatcher::Proxy LogDispatcher::operator()()
 {
     return Proxy(*this);
@@ -81,6 +102,31 @@ void LogDispatcher::CreateLogLinePrefix(std::ostringstream& serr)
     }
 }
 
+void LogDispatcher::CreateLogRecordHeader(std::string& w_record, const LogSite& site)
+{
+    using namespace srt;
+
+    w_record.reserve(128);
+    binlog::put(w_record, uint32_t(0)); // Length, set when complete
+    w_record += char(binlog::REC_LINE);
+    binlog::put(w_record, site.id);
+
+    int64_t time_us = 0;
+    if (!isset(SRT_LOGF_DISABLE_TIME))
+    {
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        time_us = int64_t(tv.tv_sec) * 1000000 + tv.tv_usec;
+    }
+    binlog::put(w_record, time_us);
+
+    char thname[ThreadName::BUFSIZE];
+    if (!isset(SRT_LOGF_DISABLE_THREADNAME) && ThreadName::get(thname))
+        binlog::putString(w_record, thname, strlen(thname));
+    else
+        binlog::putString(w_record, "", 0);
+}
+
 std::string LogDispatcher::Proxy::ExtractName(std::string pretty_function)
 {
     if ( pretty_function == "" )
@@ -145,5 +191,375 @@ std::string LogDispatcher::Proxy::ExtractName(std::string pretty_function)
 }
 #endif
 
+// The binary log records are written to the log stream only,
+// as the log handler can't take them.
+void LogDispatcher::SendLogRecord(const std::string& record)
+{
+    if (isset(SRT_LOGF_ASYNC) && src_config->async.push(int(level), NULL, 0, std::string(), record, true))
+        return;
+
+    srt::sync::ScopedLock outlk(src_config->output_mutex);
+    std::ostream*         stream;
+    {
+        srt::sync::ScopedLock lk(src_config->mutex);
+        stream = src_config->log_stream;
+    }
+    if (stream)
+    {
+        src_config->writeBinary(*stream, record);
+        stream->flush();
+    }
+}
+
+namespace
+{
+    // All call sites, by their IDs. Function statics, as
+    // the sites may be created during static initialization.
+    srt::sync::Mutex& siteLock()
+    {
+        static srt::sync::Mutex lock;
+        return lock;
+    }
+
+    std::vector<const LogSite*>& sites()
+    {
+        static std::vector<const LogSite*> all;
+        return all;
+    }
+}
+
+LogSite::LogSite(const LogDispatcher& d, const char* f, int l, const char* fn)
+    : dispatcher(&d)
+    , file(f)
+    , line(l)
+    , function(fn)
+{
+    srt::sync::ScopedLock lk(siteLock());
+    id = uint32_t(sites().size());
+    sites().push_back(this);
+}
+
+bool LogSite::describe(uint32_t id, std::string& w_record)
+{
+    const LogSite* site;
+    {
+        srt::sync::ScopedLock lk(siteLock());
+        if (id >= sites().size())
+            return false;
+        site = sites()[id];
+    }
+
+    std::string payload;
+    payload += char(binlog::REC_SITE);
+    binlog::put(payload, site->id);
+    payload += char(site->dispatcher->level);
+    binlog::putString(payload, site->dispatcher->prefix, site->dispatcher->prefix_len);
+    binlog::putString(payload, site->file, strlen(site->file));
+    binlog::put(payload, uint32_t(site->line));
+    binlog::putString(payload, site->function, strlen(site->function));
+
+    w_record.clear();
+    binlog::put(w_record, uint32_t(payload.size()));
+    w_record += payload;
+    return true;
+}
+
+void LogConfig::writeBinary(std::ostream& out, const std::string& record)
+{
+    if (binary_stream != &out)
+    {
+        out.write(binlog::MAGIC, sizeof binlog::MAGIC);
+        const uint32_t bom = binlog::BYTE_ORDER_MARK;
+        out.write((const char*)&bom, sizeof bom);
+        binary_stream = &out;
+        binary_sites.clear();
+    }
+
+    const size_t idpos = sizeof(uint32_t) + 1;
+    if (record.size() >= idpos + sizeof(uint32_t) && record[sizeof(uint32_t)] == char(binlog::REC_LINE))
+    {
+        uint32_t id;
+        memcpy(&id, record.data() + idpos, sizeof id);
+        if (id >= binary_sites.size())
+            binary_sites.resize(id + 1);
+        if (!binary_sites[id])
+        {
+            std::string def;
+            if (LogSite::describe(id, (def)))
+                out.write(def.data(), def.size());
+            binary_sites[id] = true;
+        }
+    }
+
+    out.write(record.data(), record.size());
+}
+
+struct LogAsyncWriter::Record
+{
+    int         level;
+    const char* file;
+    int         line;
+    std::string area;
+    std::string msg;
+    bool        binary; // msg is a binary log record
+};
+
+// Single producer (the logging thread), single consumer (the writer thread).
+struct LogAsyncWriter::Ring
+{
+    Record                   slots[RING_SIZE];
+    srt::sync::atomic<uint64_t> head;     // Next slot to write, by the logging thread
+    srt::sync::atomic<uint64_t> tail;     // Next slot to read, by the writer thread
+    srt::sync::atomic<int>      refs;     // Held by the logging thread and by the writer
+    srt::sync::atomic<bool>     orphaned; // The logging thread has exited
+
+    Ring() : head(0), tail(0), refs(2), orphaned(false) {}
+
+    static void release(Ring* r)
+    {
+        if (--r->refs == 0)
+            delete r;
+    }
+};
+
+// The ring of the current thread, released when the thread exits.
+struct LogAsyncWriter::ThreadRing
+{
+    LogAsyncWriter* owner;
+    Ring*           ring;
+
+    ThreadRing() : owner(NULL), ring(NULL) {}
+    ~ThreadRing() { reset(); }
+
+    void reset()
+    {
+        if (!ring)
+            return;
+        ring->orphaned = true;
+        Ring::release(ring);
+        ring = NULL;
+    }
+};
+
+LogAsyncWriter::LogAsyncWriter(LogConfig& config)
+    : m_config(config)
+    , m_bRunning(false)
+    , m_bStarting(false)
+    , m_bClosing(false)
+    , m_iDropped(0)
+    , m_iDroppedReported(0)
+{
+    srt::sync::setupCond(m_WakeCond, "LogAsyncWriter");
+}
+
+LogAsyncWriter::~LogAsyncWriter()
+{
+    stop();
+    for (size_t i = 0; i < m_Rings.size(); ++i)
+        Ring::release(m_Rings[i]);
+    srt::sync::releaseCond(m_WakeCond);
+}
+
+bool LogAsyncWriter::push(int level, const char* file, int line, const std::string& area, const std::string& msg, bool binary)
+{
+#if HAVE_CXX11
+    if (!m_bRunning && !start())
+        return false;
+
+    Ring* r = threadRing();
+    if (!r)
+        return false;
+
+    const uint64_t head = r->head.load();
+    const uint64_t fill = head - r->tail.load();
+    if (fill >= RING_SIZE)
+    {
+        ++m_iDropped;
+        return true;
+    }
+
+    // The strings keep their capacity in the slots,
+    // so they usually don't need to allocate.
+    Record& rec = r->slots[head % RING_SIZE];
+    rec.level   = level;
+    rec.file    = file;
+    rec.line    = line;
+    rec.area    = area;
+    rec.msg     = msg;
+    rec.binary  = binary;
+    r->head.store(head + 1);
+
+    if (fill + 1 == RING_SIZE / 2)
+        m_WakeCond.notify_one();
+    return true;
+#else
+    // Per-thread rings need thread_local.
+    (void)level; (void)file; (void)line; (void)area; (void)msg; (void)binary;
+    return false;
+#endif
+}
+
+bool LogAsyncWriter::start()
+{
+    // The thread starting may log, so no mutex can be used here.
+    // If it's being started by another thread, just queue the line.
+    if (!m_bStarting.compare_exchange(false, true))
+        return true;
+
+    bool started = m_bRunning;
+    if (!started)
+    {
+        m_bClosing = false;
+        started    = srt::sync::StartThread(m_Thread, LogAsyncWriter::worker, this, "SRT:Log");
+        m_bRunning = started;
+    }
+    m_bStarting = false;
+    return started;
+}
+
+void LogAsyncWriter::stop()
+{
+    while (!m_bStarting.compare_exchange(false, true))
+        srt::sync::this_thread::sleep_for(srt::sync::microseconds_from(100));
+
+    if (m_bRunning)
+    {
+        m_bClosing = true;
+        srt::sync::CSync::lock_notify_one(m_WakeCond, m_WakeLock);
+        m_Thread.join();
+        m_bRunning = false;
+    }
+    m_bStarting = false;
+}
+
+LogAsyncWriter::Ring* LogAsyncWriter::threadRing()
+{
+#if HAVE_CXX11
+    static thread_local ThreadRing t_ring;
+    if (t_ring.owner == this && t_ring.ring)
+        return t_ring.ring;
+
+    t_ring.reset();
+    Ring* r = new (std::nothrow) Ring;
+    if (!r)
+        return NULL;
+    {
+        srt::sync::ScopedLock lk(m_RingsLock);
+        m_Rings.push_back(r);
+    }
+    t_ring.owner = this;
+    t_ring.ring  = r;
+    return r;
+#else
+    return NULL;
+#endif
+}
+
+void* LogAsyncWriter::worker(void* param)
+{
+    LogAsyncWriter* self = (LogAsyncWriter*)param;
+    self->worker_Run();
+    return NULL;
+}
+
+void LogAsyncWriter::worker_Run()
+{
+    for (;;)
+    {
+        drain();
+
+        srt::sync::UniqueLock lk(m_WakeLock);
+        if (m_bClosing)
+            break;
+        m_WakeCond.wait_for(lk, srt::sync::milliseconds_from(FLUSH_PERIOD_MS));
+    }
+    drain();
+}
+
+void LogAsyncWriter::drain()
+{
+    {
+        srt::sync::ScopedLock lk(m_RingsLock);
+        m_Draining = m_Rings;
+    }
+
+    srt::sync::ScopedLock outlk(m_config.output_mutex);
+
+    SRT_LOG_HANDLER_FN* handler;
+    void*               opaque;
+    std::ostream*       stream;
+    bool                binary;
+    {
+        srt::sync::ScopedLock lk(m_config.mutex);
+        handler = m_config.loghandler_fn;
+        opaque  = m_config.loghandler_opaque;
+        stream  = m_config.log_stream;
+        binary  = (m_config.flags & SRT_LOGF_BINARY) != 0;
+    }
+
+    bool written = false;
+    for (size_t i = 0; i < m_Draining.size(); ++i)
+    {
+        Ring&          r    = *m_Draining[i];
+        const uint64_t head = r.head.load();
+        for (uint64_t tail = r.tail.load(); tail != head; ++tail)
+        {
+            const Record& rec = r.slots[tail % RING_SIZE];
+            if (rec.binary)
+            {
+                if (stream)
+                    m_config.writeBinary(*stream, rec.msg);
+            }
+            else if (handler)
+                (*handler)(opaque, rec.level, rec.file, rec.line, rec.area.c_str(), rec.msg.c_str());
+            else if (stream)
+                stream->write(rec.msg.data(), rec.msg.size());
+            written = true;
+
+            // Free the slot for the logging thread as soon as possible.
+            r.tail.store(tail + 1);
+        }
+    }
+
+    const int64_t dropped = m_iDropped.load();
+    if (dropped != m_iDroppedReported)
+    {
+        std::ostringstream os;
+        os << "SRT: " << (dropped - m_iDroppedReported) << " log lines dropped";
+        if ((m_config.flags & SRT_LOGF_DISABLE_EOL) == 0)
+            os << std::endl;
+        const std::string msg = os.str();
+        if (binary && stream)
+        {
+            std::string record;
+            binlog::putTextRecord((record), LogLevel::warning, msg);
+            m_config.writeBinary(*stream, record);
+        }
+        else if (handler)
+            (*handler)(opaque, LogLevel::warning, __FILE__, __LINE__, "LogAsyncWriter", msg.c_str());
+        else if (stream)
+            stream->write(msg.data(), msg.size());
+        written            = true;
+        m_iDroppedReported = dropped;
+    }
+
+    if (written && stream)
+        stream->flush();
+
+    // Forget the rings of the exited threads, once written.
+    srt::sync::ScopedLock lk(m_RingsLock);
+    for (size_t i = 0; i < m_Rings.size();)
+    {
+        Ring* r = m_Rings[i];
+        if (r->orphaned && r->tail.load() == r->head.load())
+        {
+            m_Rings.erase(m_Rings.begin() + i);
+            Ring::release(r);
+        }
+        else
+            ++i;
+    }
+}
+
 } // (end namespace srt_logging)
 
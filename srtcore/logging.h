@@ -21,6 +21,7 @@ written by
 #include <iomanip>
 #include <set>
 #include <sstream>
+#include <vector>
 #include <cstdarg>
 #ifdef _WIN32
 #include "win/wintime.h"
@@ -33,6 +34,7 @@ written by
 #include "utilities.h"
 #include "threadname.h"
 #include "logging_api.h"
+#include "logging_binary.h"
 #include "sync.h"
 
 #ifdef __GNUC__
@@ -50,9 +52,11 @@ written by
 // LOGC uses an iostream-like syntax, using the special 'log' symbol.
 // This symbol isn't visible outside the log macro parameters.
 // Usage: LOGC(gglog.Debug, log << param1 << param2 << param3);
+// The call site is identified for the binary log (SRT_LOGF_BINARY).
 #define LOGC(logdes, args) if (logdes.CheckEnabled()) \
 { \
-    srt_logging::LogDispatcher::Proxy log(logdes); \
+    static const srt_logging::LogSite logsite(logdes, __FILE__, __LINE__, __FUNCTION__); \
+    srt_logging::LogDispatcher::Proxy log(logdes, logsite); \
     log.setloc(__FILE__, __LINE__, __FUNCTION__); \
     { (void)(const srt_logging::LogDispatcher::Proxy&)(args); } \
 }
@@ -104,6 +108,81 @@ written by
 namespace srt_logging
 {
 
+struct LogConfig;
+
+// Writes the log lines in the background thread, when SRT_LOGF_ASYNC is set.
+//
+// Every logging thread pushes its lines into its own ring of RING_SIZE records,
+// read by the writer thread without locking. When the ring is full, the line
+// is dropped and counted instead of blocking the logging thread. The lines are
+// written in order per logging thread, but not necessarily between the threads.
+class SRT_API LogAsyncWriter
+{
+public:
+    static const size_t RING_SIZE       = 512;
+    static const int    FLUSH_PERIOD_MS = 10;
+
+    explicit LogAsyncWriter(LogConfig& config);
+    ~LogAsyncWriter();
+
+    /// Queue the line to be written by the writer thread, starting it if needed.
+    /// @return false if the line can't be queued and should be written directly
+    bool push(int level, const char* file, int line, const std::string& area, const std::string& msg, bool binary = false);
+
+    /// Write all queued lines and stop the writer thread.
+    /// It's started again with the next line pushed.
+    void stop();
+
+    /// The number of lines dropped because the ring of the logging thread was full.
+    int64_t dropped() const { return m_iDropped.load(); }
+
+private:
+    struct Record;
+    struct Ring;
+    struct ThreadRing;
+
+    bool  start();
+    Ring* threadRing();
+    void  drain();
+
+    static void* worker(void* param);
+    void         worker_Run();
+
+    LogConfig&                    m_config;
+    srt::sync::Mutex              m_RingsLock; // Protects m_Rings
+    std::vector<Ring*>            m_Rings;     // Rings of all logging threads
+    std::vector<Ring*>            m_Draining;  // Copy of m_Rings used by the writer thread
+    srt::sync::Mutex              m_WakeLock;
+    srt::sync::Condition          m_WakeCond;  // Signalled when a ring gets half full or on stop
+    srt::sync::CThread            m_Thread;
+    srt::sync::atomic<bool>       m_bRunning;
+    srt::sync::atomic<bool>       m_bStarting; // The thread is being started or stopped
+    srt::sync::atomic<bool>       m_bClosing;
+    srt::sync::atomic<int64_t>    m_iDropped;
+    int64_t                       m_iDroppedReported; // Writer thread only
+
+    LogAsyncWriter(const LogAsyncWriter&);
+    LogAsyncWriter& operator=(const LogAsyncWriter&);
+};
+
+struct LogDispatcher;
+
+// The LOGC call site, numbered for the binary log.
+struct SRT_API LogSite
+{
+    const LogDispatcher* dispatcher;
+    const char*          file;
+    int                  line;
+    const char*          function;
+    uint32_t             id;
+
+    LogSite(const LogDispatcher& d, const char* f, int l, const char* fn);
+
+    /// Make the REC_SITE record describing the site of the given ID.
+    /// @return false if there's no such site
+    static bool describe(uint32_t id, std::string& w_record);
+};
+
 struct LogConfig
 {
     typedef std::bitset<SRT_LOGFA_LASTNONE+1> fa_bitset_t;
@@ -113,7 +192,13 @@ struct LogConfig
     SRT_LOG_HANDLER_FN* loghandler_fn;
     void* loghandler_opaque;
     mutable srt::sync::Mutex mutex;
+    // Held while writing the lines by LogAsyncWriter, which doesn't keep
+    // the mutex locked then. Lock before the mutex to change the output.
+    mutable srt::sync::Mutex output_mutex;
     int flags;
+    LogAsyncWriter async;
+    std::ostream* binary_stream;    // Stream with the binary log header written, by output_mutex
+    std::vector<bool> binary_sites; // Sites described in binary_stream, by output_mutex
 
     LogConfig(const fa_bitset_t& efa,
             LogLevel::type l = LogLevel::warning,
@@ -124,6 +209,8 @@ struct LogConfig
         , loghandler_fn()
         , loghandler_opaque()
         , flags()
+        , async(*this)
+        , binary_stream()
     {
     }
 
@@ -136,12 +223,19 @@ struct LogConfig
 
     SRT_ATTR_RELEASE(mutex)
     void unlock() const { mutex.unlock(); }
+
+    /// Write the binary log record, preceded by the file header and the
+    /// description of its call site when not written to @a out yet.
+    SRT_ATTR_REQUIRES(output_mutex)
+    void writeBinary(std::ostream& out, const std::string& record);
 };
 
 // The LogDispatcher class represents the object that is responsible for
 // a decision whether to log something or not, and if so, print the log.
 struct SRT_API LogDispatcher
 {
+    friend struct LogSite;
+
 private:
     int fa;
     LogLevel::type level;
@@ -196,6 +290,10 @@ public:
     void CreateLogLinePrefix(std::ostringstream&);
     void SendLogLine(const char* file, int line, const std::string& area, const std::string& sl);
 
+    // The binary log records (SRT_LOGF_BINARY).
+    void CreateLogRecordHeader(std::string& w_record, const LogSite& site);
+    void SendLogRecord(const std::string& record);
+
     // log.Debug("This is the ", nth, " time");  <--- C++11 only.
     // log.Debug() << "This is the " << nth << " time";  <--- C++03 available.
 
@@ -288,6 +386,11 @@ struct LogDispatcher::Proxy
 
     std::ostringstream os;
 
+    // With SRT_LOGF_BINARY the arguments are recorded in 'record'
+    // instead of being formatted in 'os'.
+    const LogSite* site;
+    std::string record;
+
     // Cache the 'enabled' state in the beginning. If the logging
     // becomes enabled or disabled in the middle of the log, we don't
     // want it to be partially printed anyway.
@@ -299,11 +402,12 @@ struct LogDispatcher::Proxy
     int i_line;
     std::string area;
 
-    Proxy& setloc(const char* f, int l, std::string a)
+    Proxy& setloc(const char* f, int l, const char* a)
     {
         i_file = f;
         i_line = l;
-        area = a;
+        if (that_enabled && !site)
+            area = a;
         return *this;
     }
 
@@ -314,11 +418,12 @@ struct LogDispatcher::Proxy
     std::string ExtractName(std::string pretty_function);
 
     Proxy(LogDispatcher& guy);
+    Proxy(LogDispatcher& guy, const LogSite& s);
 
     // Copy constructor is needed due to noncopyable ostringstream.
     // This is used only in creation of the default object, so just
     // use the default values, just copy the location cache.
-    Proxy(const Proxy& p): that(p.that), area(p.area)
+    Proxy(const Proxy& p): that(p.that), site(), area(p.area)
     {
         i_file = p.i_file;
         i_line = p.i_line;
@@ -332,14 +437,23 @@ struct LogDispatcher::Proxy
     {
         if ( that_enabled )
         {
-            os << arg;
+            if (site)
+                binlog::putArg((record), arg);
+            else
+                os << arg;
         }
         return *this;
     }
 
     ~Proxy()
     {
-        if (that_enabled)
+        if (that_enabled && site)
+        {
+            const uint32_t len = uint32_t(record.size() - sizeof len);
+            memcpy(&record[0], &len, sizeof len);
+            that.SendLogRecord(record);
+        }
+        else if (that_enabled)
         {
             if ((flags & SRT_LOGF_DISABLE_EOL) == 0)
                 os << std::endl;
@@ -488,6 +602,18 @@ inline void LogDispatcher::PrintLogLine(const char* file SRT_ATR_UNUSED, int lin
 // - PrintLogLine, which has empty body when !ENABLE_LOGGING
 inline void LogDispatcher::SendLogLine(const char* file, int line, const std::string& area, const std::string& msg)
 {
+    if (isset(SRT_LOGF_BINARY))
+    {
+        // No call site known, so record the line formatted already.
+        std::string record;
+        binlog::putTextRecord((record), int(level), msg);
+        SendLogRecord(record);
+        return;
+    }
+
+    if (isset(SRT_LOGF_ASYNC) && src_config->async.push(int(level), file, line, area, msg))
+        return;
+
     src_config->lock();
     if ( src_config->loghandler_fn )
     {
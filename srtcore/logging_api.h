@@ -44,6 +44,8 @@ written by
 #define SRT_LOGF_DISABLE_THREADNAME 2
 #define SRT_LOGF_DISABLE_SEVERITY 4
 #define SRT_LOGF_DISABLE_EOL 8
+#define SRT_LOGF_ASYNC 16
+#define SRT_LOGF_BINARY 32
 
 // Handler type.
 typedef void SRT_LOG_HANDLER_FN(void* opaque, int level, const char* file, int line, const char* area, const char* message);
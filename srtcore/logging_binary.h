@@ -0,0 +1,168 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+#ifndef INC_SRT_LOGGING_BINARY_H
+#define INC_SRT_LOGGING_BINARY_H
+
+#include <cstring>
+#include <ios>
+#include <sstream>
+#include <string>
+
+#include "srt.h"
+
+// The binary log format, written with SRT_LOGF_BINARY instead of the text
+// lines. The log line is recorded as the ID of its LOGC call site and the
+// raw values of the arguments, and formatted only by the decoder
+// (srt-log-decode). The numbers are in the byte order of the writer.
+//
+// file   := MAGIC(8) u32(BYTE_ORDER_MARK) record*
+// record := u32(length of the rest) u8(type) payload
+//
+// REC_SITE: u32 site, u8 level, str prefix, str file, u32 line, str function
+//     Describes the call site, written before its first REC_LINE in the file.
+// REC_LINE: u32 site, i64 time [us since epoch], str thread, arg*
+//     The args are encoded until the end of the record.
+// REC_TEXT: u8 level, str line
+//     A line formatted already, as when logged without a call site.
+//
+// str := u32 length, bytes
+// arg := u8 type, value
+
+namespace srt_logging
+{
+namespace binlog
+{
+
+const char     MAGIC[8]        = {'S', 'R', 'T', 'B', 'L', 'O', 'G', '1'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+enum RecordType
+{
+    REC_SITE = 'S',
+    REC_LINE = 'L',
+    REC_TEXT = 'T'
+};
+
+enum ArgType
+{
+    ARG_INT32  = 'i', // int32_t
+    ARG_INT64  = 'I', // int64_t
+    ARG_UINT32 = 'u', // uint32_t
+    ARG_UINT64 = 'U', // uint64_t
+    ARG_DOUBLE = 'd', // double
+    ARG_CHAR   = 'c', // char
+    ARG_BOOL   = 'b', // u8
+    ARG_STRING = 's', // str
+    ARG_MANIP  = 'm'  // u8 Manipulator
+};
+
+// The stream manipulators kept by the binary log.
+// Others, like std::setw, are not recorded.
+enum Manipulator
+{
+    MANIP_DEC,
+    MANIP_HEX,
+    MANIP_OCT,
+    MANIP_BOOLALPHA,
+    MANIP_NOBOOLALPHA,
+    MANIP_FIXED,
+    MANIP_SCIENTIFIC,
+    MANIP_SHOWBASE,
+    MANIP_NOSHOWBASE,
+    MANIP_UPPERCASE,
+    MANIP_NOUPPERCASE
+};
+
+template <class T>
+inline void put(std::string& w_out, const T& value)
+{
+    w_out.append(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+inline void putString(std::string& w_out, const char* s, size_t len)
+{
+    put(w_out, uint32_t(len));
+    w_out.append(s, len);
+}
+
+// The arguments of the log line, by their type. The values of the types
+// not listed here are formatted and recorded as strings.
+
+inline void putArg(std::string& w_out, bool v)               { w_out += char(ARG_BOOL); put(w_out, uint8_t(v)); }
+inline void putArg(std::string& w_out, char v)               { w_out += char(ARG_CHAR); w_out += v; }
+inline void putArg(std::string& w_out, signed char v)        { putArg(w_out, char(v)); }
+inline void putArg(std::string& w_out, unsigned char v)      { putArg(w_out, char(v)); }
+inline void putArg(std::string& w_out, short v)              { w_out += char(ARG_INT32); put(w_out, int32_t(v)); }
+inline void putArg(std::string& w_out, unsigned short v)     { w_out += char(ARG_UINT32); put(w_out, uint32_t(v)); }
+inline void putArg(std::string& w_out, int v)                { w_out += char(ARG_INT32); put(w_out, int32_t(v)); }
+inline void putArg(std::string& w_out, unsigned int v)       { w_out += char(ARG_UINT32); put(w_out, uint32_t(v)); }
+inline void putArg(std::string& w_out, long long v)          { w_out += char(ARG_INT64); put(w_out, int64_t(v)); }
+inline void putArg(std::string& w_out, unsigned long long v) { w_out += char(ARG_UINT64); put(w_out, uint64_t(v)); }
+inline void putArg(std::string& w_out, float v)              { w_out += char(ARG_DOUBLE); put(w_out, double(v)); }
+inline void putArg(std::string& w_out, double v)             { w_out += char(ARG_DOUBLE); put(w_out, v); }
+inline void putArg(std::string& w_out, const char* v)        { w_out += char(ARG_STRING); putString(w_out, v, strlen(v)); }
+inline void putArg(std::string& w_out, const std::string& v) { w_out += char(ARG_STRING); putString(w_out, v.data(), v.size()); }
+
+// The size of long depends on the platform.
+inline void putArg(std::string& w_out, long v)
+{
+    if (sizeof v == sizeof(int32_t))
+        putArg(w_out, int(v));
+    else
+        putArg(w_out, (long long)v);
+}
+
+inline void putArg(std::string& w_out, unsigned long v)
+{
+    if (sizeof v == sizeof(uint32_t))
+        putArg(w_out, (unsigned int)v);
+    else
+        putArg(w_out, (unsigned long long)v);
+}
+
+inline void putArg(std::string& w_out, std::ios_base& (*m)(std::ios_base&))
+{
+    static std::ios_base& (* const manips[])(std::ios_base&) = {
+        std::dec, std::hex, std::oct, std::boolalpha, std::noboolalpha, std::fixed,
+        std::scientific, std::showbase, std::noshowbase, std::uppercase, std::nouppercase};
+
+    for (size_t i = 0; i < sizeof manips / sizeof manips[0]; ++i)
+    {
+        if (manips[i] == m)
+        {
+            w_out += char(ARG_MANIP);
+            w_out += char(i);
+            return;
+        }
+    }
+}
+
+template <class T>
+inline void putArg(std::string& w_out, const T& v)
+{
+    std::ostringstream os;
+    os << v;
+    if (os.tellp() > 0)
+        putArg(w_out, os.str());
+}
+
+inline void putTextRecord(std::string& w_out, int level, const std::string& line)
+{
+    put(w_out, uint32_t(1 + 1 + sizeof(uint32_t) + line.size()));
+    w_out += char(REC_TEXT);
+    w_out += char(level);
+    putString(w_out, line.data(), line.size());
+}
+
+} // namespace binlog
+} // namespace srt_logging
+
+#endif
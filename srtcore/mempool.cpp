@@ -0,0 +1,237 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+#include "platform_sys.h"
+
+#include <cstring>
+#include <map>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include "mempool.h"
+#include "logging.h"
+#include "logger_defs.h"
+
+using namespace std;
+using namespace srt::sync;
+using namespace srt_logging;
+
+namespace srt
+{
+
+namespace
+{
+
+// Slabs are allocated in multiples of the x86-64 huge page size.
+const size_t SLAB_SIZE = 2 * 1024 * 1024;
+
+// Slots are aligned to the cache line, so that no two slots share one.
+const size_t SLOT_ALIGN = 64;
+
+// A slab holds at least that many slots, also for unusually large slots.
+const size_t MIN_SLOTS_PER_SLAB = 16;
+
+const size_t PAGE_SIZE_MIN = 4096;
+
+struct PoolRegistry
+{
+    Mutex                              lock;
+    map<size_t, CPacketSlotPool*>      pools;
+
+    PoolRegistry() { setupMutex(lock, "SlotPools"); }
+};
+
+// The registry and the pools are never destroyed: the slots may still be
+// returned by the sockets closed during the destruction of static objects.
+PoolRegistry& registry()
+{
+    static PoolRegistry* r = new PoolRegistry;
+    return *r;
+}
+
+size_t roundUp(size_t value, size_t unit)
+{
+    return ((value + unit - 1) / unit) * unit;
+}
+
+} // namespace
+
+CPacketSlotPool& CPacketSlotPool::instance(size_t slot_size)
+{
+    const size_t  size = roundUp(slot_size, SLOT_ALIGN);
+    PoolRegistry& r    = registry();
+    ScopedLock    lk(r.lock);
+
+    map<size_t, CPacketSlotPool*>::iterator i = r.pools.find(size);
+    if (i != r.pools.end())
+        return *i->second;
+
+    CPacketSlotPool* pool = new CPacketSlotPool(size);
+    r.pools[size]         = pool;
+    return *pool;
+}
+
+void CPacketSlotPool::getStats(vector<Stats>& w_stats)
+{
+    PoolRegistry& r = registry();
+    ScopedLock    lk(r.lock);
+
+    w_stats.clear();
+    for (map<size_t, CPacketSlotPool*>::iterator i = r.pools.begin(); i != r.pools.end(); ++i)
+        w_stats.push_back(i->second->stats());
+}
+
+CPacketSlotPool::CPacketSlotPool(size_t slot_size)
+    : m_zSlotSize(slot_size)
+    , m_zSlabSize(roundUp(slot_size * MIN_SLOTS_PER_SLAB, SLAB_SIZE))
+    , m_iSlotsTotal(0)
+    , m_iSlotsUsedMax(0)
+    , m_llBytesHugePage(0)
+{
+    setupMutex(m_Lock, "SlotPool");
+}
+
+CPacketSlotPool::~CPacketSlotPool()
+{
+    for (size_t i = 0; i < m_Slabs.size(); ++i)
+    {
+#ifdef _WIN32
+        delete[] m_Slabs[i].m_pcData;
+#else
+        ::munmap(m_Slabs[i].m_pcData, m_Slabs[i].m_zSize);
+#endif
+    }
+    releaseMutex(m_Lock);
+}
+
+char* CPacketSlotPool::mapSlab(size_t size, bool& w_hugepage)
+{
+    w_hugepage = false;
+#ifdef _WIN32
+    char* data = new (nothrow) char[size];
+#else
+
+#ifdef MAP_ANONYMOUS
+    const int anon_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#else
+    const int anon_flags = MAP_PRIVATE | MAP_ANON;
+#endif
+
+    void* mem = MAP_FAILED;
+#if SRT_ENABLE_HUGEPAGES && defined(MAP_HUGETLB)
+    // Succeeds only if huge pages were reserved in the system (vm.nr_hugepages).
+    mem = ::mmap(NULL, size, PROT_READ | PROT_WRITE, anon_flags | MAP_HUGETLB, -1, 0);
+    if (mem != MAP_FAILED)
+        w_hugepage = true;
+#endif
+    if (mem == MAP_FAILED)
+    {
+        mem = ::mmap(NULL, size, PROT_READ | PROT_WRITE, anon_flags, -1, 0);
+        if (mem == MAP_FAILED)
+            return NULL;
+#if SRT_ENABLE_HUGEPAGES && defined(MADV_HUGEPAGE)
+        // Transparent huge pages, if enabled in the "madvise" mode.
+        // This is only a hint, so the result is ignored.
+        ::madvise(mem, size, MADV_HUGEPAGE);
+#endif
+    }
+    char* data = static_cast<char*>(mem);
+#endif
+
+    if (data == NULL)
+        return NULL;
+
+    // Prefault: write to every page now, so that storing the
+    // packets later does not cost a page fault each time.
+    for (size_t off = 0; off < size; off += PAGE_SIZE_MIN)
+        data[off] = 0;
+
+    return data;
+}
+
+bool CPacketSlotPool::addSlab()
+{
+    Slab slab;
+    slab.m_zSize  = m_zSlabSize;
+    slab.m_pcData = mapSlab(m_zSlabSize, (slab.m_bHugePage));
+    if (!slab.m_pcData)
+    {
+        LOGC(rslog.Error,
+             log << "CPacketSlotPool: failed to allocate a slab of " << m_zSlabSize << " bytes for slots of "
+                 << m_zSlotSize << " bytes");
+        return false;
+    }
+
+    const int nslots = int(m_zSlabSize / m_zSlotSize);
+    m_Slabs.push_back(slab);
+    m_FreeSlots.reserve(m_FreeSlots.size() + nslots);
+    // Push in reverse so that the slots are handed out in the address order.
+    for (int i = nslots - 1; i >= 0; --i)
+        m_FreeSlots.push_back(slab.m_pcData + i * m_zSlotSize);
+
+    m_iSlotsTotal += nslots;
+    if (slab.m_bHugePage)
+        m_llBytesHugePage += m_zSlabSize;
+
+    HLOGC(rslog.Debug,
+          log << "CPacketSlotPool: slots of " << m_zSlotSize << " bytes: added slab #" << m_Slabs.size() << " with "
+              << nslots << " slots" << (slab.m_bHugePage ? " (huge pages)" : ""));
+    return true;
+}
+
+bool CPacketSlotPool::allocate(char** w_slots, int n)
+{
+    ScopedLock lk(m_Lock);
+
+    while (int(m_FreeSlots.size()) < n)
+    {
+        if (!addSlab())
+            return false;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        w_slots[i] = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+
+    const int used = m_iSlotsTotal - int(m_FreeSlots.size());
+    if (used > m_iSlotsUsedMax)
+        m_iSlotsUsedMax = used;
+    return true;
+}
+
+void CPacketSlotPool::release(char* const* slots, int n)
+{
+    ScopedLock lk(m_Lock);
+    for (int i = 0; i < n; ++i)
+    {
+        SRT_ASSERT(slots[i] != NULL);
+        m_FreeSlots.push_back(slots[i]);
+    }
+}
+
+CPacketSlotPool::Stats CPacketSlotPool::stats() const
+{
+    ScopedLock lk(m_Lock);
+
+    Stats s;
+    s.slotSize      = m_zSlotSize;
+    s.slabs         = int(m_Slabs.size());
+    s.slotsTotal    = m_iSlotsTotal;
+    s.slotsUsed     = m_iSlotsTotal - int(m_FreeSlots.size());
+    s.slotsUsedMax  = m_iSlotsUsedMax;
+    s.bytesTotal    = int64_t(m_Slabs.size() * m_zSlabSize);
+    s.bytesHugePage = m_llBytesHugePage;
+    return s;
+}
+
+} // namespace srt
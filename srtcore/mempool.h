@@ -0,0 +1,106 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+#ifndef INC_SRT_MEMPOOL_H
+#define INC_SRT_MEMPOOL_H
+
+#include <vector>
+
+#include "platform_sys.h"
+#include "sync.h"
+
+namespace srt
+{
+
+/// @brief A process-wide pool of fixed-size packet payload slots.
+///
+/// The slots are carved out of large slabs (2MB, the size of a huge page
+/// on x86-64) that are written through once when allocated, so that the
+/// page faults happen when the pool grows and not when a packet is stored.
+/// With SRT_ENABLE_HUGEPAGES the slabs are mapped with MAP_HUGETLB where
+/// huge pages are reserved, or advised with MADV_HUGEPAGE otherwise.
+///
+/// There is one pool per slot size, shared by all unit queues and sender
+/// buffers using this size. Released slots return to the pool's free list
+/// and the slabs are kept until the process exits, so the memory used by
+/// the packet buffers stays at the highest level reached.
+class CPacketSlotPool
+{
+public:
+    struct Stats
+    {
+        size_t  slotSize;      // size of a single slot in bytes
+        int     slabs;         // number of slabs allocated
+        int     slotsTotal;    // number of slots in all slabs
+        int     slotsUsed;     // number of slots currently handed out
+        int     slotsUsedMax;  // highest number of slots handed out at once
+        int64_t bytesTotal;    // memory taken by all slabs
+        int64_t bytesHugePage; // part of bytesTotal backed by huge pages
+    };
+
+    /// Get the pool of slots of at least @a slot_size bytes.
+    /// The pool is created at first use.
+    static CPacketSlotPool& instance(size_t slot_size);
+
+    /// Collect statistics of all existing pools.
+    static void getStats(std::vector<Stats>& w_stats);
+
+    /// Size of a single slot, which is the requested size rounded
+    /// up to the cache line size.
+    size_t slotSize() const { return m_zSlotSize; }
+
+    /// Take @a n slots from the pool, allocating a new slab if needed.
+    /// @param [out] w_slots array of at least @a n pointers to fill
+    /// @param n number of slots to take
+    /// @return true on success, false if no memory could be allocated
+    /// (no slot is taken then).
+    bool allocate(char** w_slots, int n);
+
+    /// Return @a n slots previously taken by allocate().
+    void release(char* const* slots, int n);
+
+    /// Get statistics of this pool.
+    Stats stats() const;
+
+private:
+    explicit CPacketSlotPool(size_t slot_size);
+    ~CPacketSlotPool();
+
+    /// Map a new slab and put all its slots on the free list.
+    /// @return false if the memory could not be allocated.
+    bool addSlab();
+
+    static char* mapSlab(size_t size, bool& w_hugepage);
+
+private:
+    struct Slab
+    {
+        char*  m_pcData;
+        size_t m_zSize;
+        bool   m_bHugePage;
+    };
+
+    mutable sync::Mutex m_Lock;
+    const size_t        m_zSlotSize;
+    const size_t        m_zSlabSize;
+    std::vector<Slab>   m_Slabs;
+    std::vector<char*>  m_FreeSlots; // LIFO: the recently released slot is reused first
+    int                 m_iSlotsTotal;
+    int                 m_iSlotsUsedMax;
+    int64_t             m_llBytesHugePage;
+
+private:
+    CPacketSlotPool(const CPacketSlotPool&);
+    CPacketSlotPool& operator=(const CPacketSlotPool&);
+};
+
+} // namespace srt
+
+#endif
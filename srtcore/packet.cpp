@@ -556,6 +556,15 @@ CPacket* CPacket::clone() const
     return pkt;
 }
 
+void CPacket::copyFrom(const CPacket& source)
+{
+    SRT_ASSERT(source.getLength() <= m_zCapacity);
+    memcpy((m_nHeader), source.m_nHeader, HDR_SIZE);
+    memcpy((m_pcData), source.m_pcData, source.getLength());
+    setLength(source.getLength());
+    m_DestAddr = source.m_DestAddr;
+}
+
 // Useful for debugging
 std::string PacketMessageFlagStr(uint32_t msgno_field)
 {
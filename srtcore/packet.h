@@ -324,6 +324,11 @@ public:
     /// @return Pointer to the new packet.
     CPacket* clone() const;
 
+    /// Copy the header, the payload and the destination address
+    /// of another packet into the buffer of this packet.
+    /// @param [in] source packet to copy; its payload must fit in this packet's buffer.
+    void copyFrom(const CPacket& source);
+
     enum PacketVectorFields
     {
         PV_HEADER = 0,
@@ -138,7 +138,6 @@ void PacketFilter::receive(CUnit* unit, std::vector<CUnit*>& w_incoming, loss_se
     else
     {
         // Packet not to be passthru, update stats
-        ScopedLock lg(m_parent->m_StatsLock);
         m_parent->m_stats.rcvr.recvdFilterExtra.count(1);
     }
 
@@ -151,7 +150,6 @@ void PacketFilter::receive(CUnit* unit, std::vector<CUnit*>& w_incoming, loss_se
         int dist = CSeqNo::seqoff(i->first, i->second) + 1;
         if (dist > 0)
         {
-            ScopedLock lg(m_parent->m_StatsLock);
             m_parent->m_stats.rcvr.lossFilter.count(dist);
         }
         else
@@ -169,7 +167,6 @@ void PacketFilter::receive(CUnit* unit, std::vector<CUnit*>& w_incoming, loss_se
         size_t nsupply = m_provided.size();
         InsertRebuilt(w_incoming, m_unitq);
 
-        ScopedLock lg(m_parent->m_StatsLock);
         m_parent->m_stats.rcvr.suppliedByFilter.count((uint32_t)nsupply);
     }
 
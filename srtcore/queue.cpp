@@ -69,8 +69,9 @@ srt::CUnitQueue::CUnitQueue(int initNumUnits, int mss)
     : m_iNumTaken(0)
     , m_iMSS(mss)
     , m_iBlockSize(initNumUnits)
+    , m_SlotPool(CPacketSlotPool::instance(mss))
 {
-    CQEntry* tempq = allocateEntry(m_iBlockSize, m_iMSS);
+    CQEntry* tempq = allocateEntry(m_iBlockSize);
 
     if (tempq == NULL)
         throw CUDTException(MJ_SYSTEMRES, MN_MEMORY);
@@ -89,35 +90,40 @@ srt::CUnitQueue::~CUnitQueue()
 
     while (p != NULL)
     {
-        delete[] p->m_pUnit;
-        delete[] p->m_pBuffer;
-
         CQEntry* q = p;
         if (p == m_pLastQueue)
             p = NULL;
         else
             p = p->m_pNext;
-        delete q;
+        releaseEntry(q);
     }
 }
 
-srt::CUnitQueue::CQEntry* srt::CUnitQueue::allocateEntry(const int iNumUnits, const int mss)
+srt::CUnitQueue::CQEntry* srt::CUnitQueue::allocateEntry(const int iNumUnits)
 {
     CQEntry* tempq = NULL;
     CUnit* tempu   = NULL;
-    char* tempb    = NULL;
+    vector<char*> slots;
 
     try
     {
         tempq = new CQEntry;
         tempu = new CUnit[iNumUnits];
-        tempb = new char[iNumUnits * mss];
+        slots.resize(iNumUnits);
     }
     catch (...)
     {
         delete tempq;
         delete[] tempu;
-        delete[] tempb;
+
+        LOGC(rslog.Error, log << "CUnitQueue: failed to allocate " << iNumUnits << " units.");
+        return NULL;
+    }
+
+    if (!m_SlotPool.allocate(&slots[0], iNumUnits))
+    {
+        delete tempq;
+        delete[] tempu;
 
         LOGC(rslog.Error, log << "CUnitQueue: failed to allocate " << iNumUnits << " units.");
         return NULL;
@@ -126,22 +132,32 @@ srt::CUnitQueue::CQEntry* srt::CUnitQueue::allocateEntry(const int iNumUnits, co
     for (int i = 0; i < iNumUnits; ++i)
     {
         tempu[i].m_bTaken = false;
-        tempu[i].m_Packet.m_pcData = tempb + i * mss;
+        tempu[i].m_Packet.m_pcData = slots[i];
     }
 
     tempq->m_pUnit   = tempu;
-    tempq->m_pBuffer = tempb;
     tempq->m_iSize   = iNumUnits;
 
     return tempq;
 }
 
+void srt::CUnitQueue::releaseEntry(CQEntry* entry)
+{
+    vector<char*> slots(entry->m_iSize);
+    for (int i = 0; i < entry->m_iSize; ++i)
+        slots[i] = entry->m_pUnit[i].m_Packet.m_pcData;
+    m_SlotPool.release(&slots[0], entry->m_iSize);
+
+    delete[] entry->m_pUnit;
+    delete entry;
+}
+
 int srt::CUnitQueue::increase_()
 {
     const int numUnits = m_iBlockSize;
     HLOGC(qrlog.Debug, log << "CUnitQueue::increase: Capacity" << capacity() << " + " << numUnits << " new units, " << m_iNumTaken << " in use.");
 
-    CQEntry* tempq = allocateEntry(numUnits, m_iMSS);
+    CQEntry* tempq = allocateEntry(numUnits);
     if (tempq == NULL)
         return -1;
 
@@ -149,7 +165,7 @@ int srt::CUnitQueue::increase_()
     m_pLastQueue          = tempq;
     m_pLastQueue->m_pNext = m_pQEntry;
 
-    m_iSize += numUnits;
+    m_iSize = m_iSize + numUnits;
 
     return 0;
 }
@@ -208,6 +224,8 @@ srt::CSndUList::CSndUList(sync::CTimer* pTimer)
     , m_iArrayLength(512)
     , m_iLastEntry(-1)
     , m_ListLock()
+    , m_pReady(NULL)
+    , m_bWaiting(false)
     , m_pTimer(pTimer)
 {
     setupCond(m_ListCond, "CSndUListCond");
@@ -222,10 +240,38 @@ srt::CSndUList::~CSndUList()
 
 void srt::CSndUList::update(const CUDT* u, EReschedule reschedule, sync::steady_clock::time_point ts)
 {
-    ScopedLock listguard(m_ListLock);
-
     CSNode* n = u->m_pSNode;
 
+    if (reschedule == DONT_RESCHEDULE)
+    {
+        // The sending worker takes the node off the heap before asking the
+        // socket for a packet, so if it's still there, whatever has been
+        // added to the socket before this call will be found.
+        if (n->m_iHeapLoc >= 0)
+            return;
+
+        // Already on the ready list.
+        if (n->m_bReady.exchange(true))
+            return;
+
+        n->m_tsReady = ts;
+        for (;;)
+        {
+            CSNode* head    = m_pReady;
+            n->m_pNextReady = head;
+            if (m_pReady.compare_exchange(head, n))
+                break;
+        }
+
+        // The worker checks the ready list after setting m_bWaiting,
+        // so either it finds the node, or it's woken up here.
+        if (m_bWaiting)
+            wakeup_();
+        return;
+    }
+
+    ScopedLock listguard(m_ListLock);
+
     if (n->m_iHeapLoc >= 0)
     {
         if (reschedule == DONT_RESCHEDULE)
@@ -237,7 +283,8 @@ void srt::CSndUList::update(const CUDT* u, EReschedule reschedule, sync::steady_
         if (n->m_iHeapLoc == 0)
         {
             n->m_tsTimeStamp = ts;
-            m_pTimer->interrupt();
+            if (m_bWaiting)
+                m_pTimer->interrupt();
             return;
         }
 
@@ -252,6 +299,7 @@ void srt::CSndUList::update(const CUDT* u, EReschedule reschedule, sync::steady_
 srt::CUDT* srt::CSndUList::pop()
 {
     ScopedLock listguard(m_ListLock);
+    takeReady_();
 
     if (-1 == m_iLastEntry)
         return NULL;
@@ -268,12 +316,14 @@ srt::CUDT* srt::CSndUList::pop()
 void srt::CSndUList::remove(const CUDT* u)
 {
     ScopedLock listguard(m_ListLock);
+    takeReady_();
     remove_(u);
 }
 
 steady_clock::time_point srt::CSndUList::getNextProcTime()
 {
     ScopedLock listguard(m_ListLock);
+    takeReady_();
 
     if (-1 == m_iLastEntry)
         return steady_clock::time_point();
@@ -287,7 +337,20 @@ void srt::CSndUList::waitNonEmpty() const
     if (m_iLastEntry >= 0)
         return;
 
-    m_ListCond.wait(listguard);
+    m_bWaiting = true;
+    if (!m_pReady)
+        m_ListCond.wait(listguard);
+    m_bWaiting = false;
+}
+
+bool srt::CSndUList::sleepUntil(const steady_clock::time_point& tp) const
+{
+    bool reached = false;
+    m_bWaiting = true;
+    if (!m_pReady)
+        reached = m_pTimer->sleep_until(tp);
+    m_bWaiting = false;
+    return reached;
 }
 
 void srt::CSndUList::signalInterrupt() const
@@ -296,6 +359,35 @@ void srt::CSndUList::signalInterrupt() const
     m_ListCond.notify_one();
 }
 
+int srt::CSndUList::size() const
+{
+    ScopedLock listguard(m_ListLock);
+    return m_iLastEntry + 1;
+}
+
+void srt::CSndUList::wakeup_() const
+{
+    {
+        ScopedLock listguard(m_ListLock);
+        m_ListCond.notify_one();
+    }
+    m_pTimer->interrupt();
+}
+
+void srt::CSndUList::takeReady_()
+{
+    CSNode* n = m_pReady.exchange(NULL);
+    while (n)
+    {
+        CSNode* next = n->m_pNextReady;
+
+        // Nodes already on the heap stay where they are, as with DONT_RESCHEDULE.
+        insert_(n->m_tsReady, n->m_pUDT);
+        n->m_bReady = false;
+        n = next;
+    }
+}
+
 void srt::CSndUList::realloc_()
 {
     CSNode** temp = NULL;
@@ -353,7 +445,11 @@ void srt::CSndUList::insert_norealloc_(const steady_clock::time_point& ts, const
 
     n->m_iHeapLoc = q;
 
-    // an earlier event has been inserted, wake up sending worker
+    // An earlier event has been inserted, wake up the sending worker.
+    // It's never waiting when it puts the nodes on the heap itself.
+    if (!m_bWaiting)
+        return;
+
     if (n->m_iHeapLoc == 0)
         m_pTimer->interrupt();
 
@@ -400,7 +496,7 @@ void srt::CSndUList::remove_(const CUDT* u)
     }
 
     // the only event has been deleted, wake up immediately
-    if (0 == m_iLastEntry)
+    if (0 == m_iLastEntry && m_bWaiting)
         m_pTimer->interrupt();
 }
 
@@ -410,7 +506,17 @@ srt::CSndQueue::CSndQueue()
     , m_pChannel(NULL)
     , m_pTimer(NULL)
     , m_bClosing(false)
+    , m_szBatchPayload(0)
+    , m_iBatchCount(0)
+    , m_llSendCalls(0)
+    , m_llSentPackets(0)
+    , m_iSendBatchMax(0)
+    , m_llIterations(0)
+    , m_llWakeups(0)
+    , m_llPackTime(0)
 {
+    for (int i = 0; i < SRT_PACING_HIST_SIZE; ++i)
+        m_llPacingLate[i] = 0;
 }
 
 srt::CSndQueue::~CSndQueue()
@@ -431,7 +537,21 @@ srt::CSndQueue::~CSndQueue()
         m_WorkerThread.join();
     }
 
+    for (size_t i = 0; i < m_vCryptoWorkers.size(); ++i)
+    {
+        CryptoWorker* w = m_vCryptoWorkers[i];
+        CSync::lock_notify_one(w->cond, w->lock);
+        if (w->thread.joinable())
+            w->thread.join();
+        releaseCond(w->cond);
+        releaseCond(w->doneCond);
+        delete w;
+    }
+
     delete m_pSndUList;
+
+    for (size_t i = 0; i < m_vBatchPackets.size(); ++i)
+        delete m_vBatchPackets[i];
 }
 
 int srt::CSndQueue::ioctlQuery(int type) const
@@ -447,12 +567,27 @@ int srt::CSndQueue::sockoptQuery(int level, int type) const
 srt::sync::atomic<int> srt::CSndQueue::m_counter(0);
 #endif
 
-void srt::CSndQueue::init(CChannel* c, CTimer* t)
+void srt::CSndQueue::init(CChannel* c, CTimer* t, size_t payload, int cryptoworkers)
 {
     m_pChannel  = c;
     m_pTimer    = t;
     m_pSndUList = new CSndUList(t);
 
+    const int batch = c->getSndBatchSize();
+    if (batch > 1)
+    {
+        m_szBatchPayload = payload;
+        m_BatchBuffer.resize(batch * payload);
+        m_vBatchAddrs.resize(batch);
+        m_vBatchSrcs.resize(batch);
+        m_vBatchPackets.resize(batch);
+        for (int i = 0; i < batch; ++i)
+        {
+            m_vBatchPackets[i] = new CPacket;
+            m_vBatchPackets[i]->m_pcData = &m_BatchBuffer[i * payload];
+        }
+    }
+
 #if ENABLE_LOGGING
     ++m_counter;
     const std::string thrname = "SRT:SndQ:w" + Sprint(m_counter);
@@ -460,6 +595,31 @@ void srt::CSndQueue::init(CChannel* c, CTimer* t)
 #else
     const char* thname = "SRT:SndQ";
 #endif
+
+    if (cryptoworkers > 0)
+    {
+        m_vCryptoWorkers.resize(cryptoworkers);
+        for (int i = 0; i < cryptoworkers; ++i)
+        {
+            CryptoWorker* w = new CryptoWorker;
+            w->queue        = this;
+            w->current      = NULL;
+            setupCond(w->cond, "SndQueueCrypto");
+            setupCond(w->doneCond, "SndQueueCryptoDone");
+            m_vCryptoWorkers[i] = w;
+        }
+
+        for (int i = 0; i < cryptoworkers; ++i)
+        {
+            const std::string cthrname = std::string(thname) + "c" + Sprint(i);
+            if (!StartThread(m_vCryptoWorkers[i]->thread, CSndQueue::cryptoWorker, m_vCryptoWorkers[i], cthrname.c_str()))
+            {
+                m_bClosing = true;
+                throw CUDTException(MJ_SYSTEMRES, MN_THREAD);
+            }
+        }
+    }
+
     if (!StartThread(m_WorkerThread, CSndQueue::worker, this, thname))
         throw CUDTException(MJ_SYSTEMRES, MN_THREAD);
 }
@@ -481,25 +641,6 @@ bool srt::CSndQueue::getBind(char* dst, size_t len) const
 }
 #endif
 
-#if defined(SRT_DEBUG_SNDQ_HIGHRATE)
-static void CSndQueueDebugHighratePrint(const srt::CSndQueue* self, const steady_clock::time_point currtime)
-{
-    if (self->m_DbgTime <= currtime)
-    {
-        fprintf(stdout,
-                "SndQueue %lu slt:%lu nrp:%lu snt:%lu nrt:%lu ctw:%lu\n",
-                self->m_WorkerStats.lIteration,
-                self->m_WorkerStats.lSleepTo,
-                self->m_WorkerStats.lNotReadyPop,
-                self->m_WorkerStats.lSendTo,
-                self->m_WorkerStats.lNotReadyTs,
-                self->m_WorkerStats.lCondWait);
-        memset(&self->m_WorkerStats, 0, sizeof(self->m_WorkerStats));
-        self->m_DbgTime = currtime + self->m_DbgPeriod;
-    }
-}
-#endif
-
 void* srt::CSndQueue::worker(void* param)
 {
     CSndQueue* self = (CSndQueue*)param;
@@ -508,33 +649,25 @@ void* srt::CSndQueue::worker(void* param)
     ThreadName::get(thname);
     THREAD_STATE_INIT(thname.c_str());
 
-#if defined(SRT_DEBUG_SNDQ_HIGHRATE)
-#define IF_DEBUG_HIGHRATE(statement) statement
-    self->m_DbgTime = sync::steady_clock::now();
-    self->m_DbgPeriod = sync::microseconds_from(5000000);
-    self->m_DbgTime += self->m_DbgPeriod;
-#else
-#define IF_DEBUG_HIGHRATE(statement) (void)0
-#endif /* SRT_DEBUG_SNDQ_HIGHRATE */
-
     while (!self->m_bClosing)
     {
         const steady_clock::time_point next_time = self->m_pSndUList->getNextProcTime();
 
         INCREMENT_THREAD_ITERATIONS();
-
-        IF_DEBUG_HIGHRATE(self->m_WorkerStats.lIteration++);
+        self->m_llIterations = self->m_llIterations + 1;
 
         if (is_zero(next_time))
         {
-            IF_DEBUG_HIGHRATE(self->m_WorkerStats.lNotReadyTs++);
+            // Nothing more is due now, send what has been collected.
+            if (self->m_iBatchCount > 0)
+                self->worker_FlushBatch();
 
             // wait here if there is no sockets with data to be sent
             THREAD_PAUSED();
             if (!self->m_bClosing)
             {
                 self->m_pSndUList->waitNonEmpty();
-                IF_DEBUG_HIGHRATE(self->m_WorkerStats.lCondWait++);
+                self->m_llWakeups = self->m_llWakeups + 1;
             }
             THREAD_RESUMED();
 
@@ -543,23 +676,22 @@ void* srt::CSndQueue::worker(void* param)
 
         // wait until next processing time of the first socket on the list
         const steady_clock::time_point currtime = steady_clock::now();
-
-        IF_DEBUG_HIGHRATE(CSndQueueDebugHighratePrint(self, currtime));
         if (currtime < next_time)
         {
+            if (self->m_iBatchCount > 0)
+                self->worker_FlushBatch();
+
             THREAD_PAUSED();
-            self->m_pTimer->sleep_until(next_time);
+            if (self->m_pSndUList->sleepUntil(next_time))
+                self->worker_CountLateness(steady_clock::now() - next_time);
             THREAD_RESUMED();
-            IF_DEBUG_HIGHRATE(self->m_WorkerStats.lSleepTo++);
+            self->m_llWakeups = self->m_llWakeups + 1;
         }
 
         // Get a socket with a send request if any.
         CUDT* u = self->m_pSndUList->pop();
         if (u == NULL)
-        {
-            IF_DEBUG_HIGHRATE(self->m_WorkerStats.lNotReadyPop++);
             continue;
-        }
 
 #define UST(field) ((u->m_b##field) ? "+" : "-") << #field << " "
         HLOGC(qslog.Debug,
@@ -569,10 +701,7 @@ void* srt::CSndQueue::worker(void* param)
 #undef UST
 
         if (!u->m_bConnected || u->m_bBroken)
-        {
-            IF_DEBUG_HIGHRATE(self->m_WorkerStats.lNotReadyPop++);
             continue;
-        }
 
         CUDTUnited::SocketKeeper sk (CUDT::uglobal(), u->id());
         if (!sk.socket)
@@ -585,29 +714,204 @@ void* srt::CSndQueue::worker(void* param)
         CPacket pkt;
         steady_clock::time_point next_send_time;
         sockaddr_any source_addr;
+        const steady_clock::time_point pack_start = steady_clock::now();
         const bool res = u->packData((pkt), (next_send_time), (source_addr));
+        self->m_llPackTime = self->m_llPackTime + (steady_clock::now() - pack_start).count();
 
         // Check if extracted anything to send
         if (res == false)
-        {
-            IF_DEBUG_HIGHRATE(self->m_WorkerStats.lNotReadyPop++);
             continue;
-        }
 
         const sockaddr_any addr = u->m_PeerAddr;
         if (!is_zero(next_send_time))
             self->m_pSndUList->update(u, CSndUList::DO_RESCHEDULE, next_send_time);
 
-        HLOGC(qslog.Debug, log << self->CONID() << "chn:SENDING: " << pkt.Info());
-        self->m_pChannel->sendto(addr, pkt, source_addr);
+        if (self->m_vBatchPackets.empty())
+        {
+            HLOGC(qslog.Debug, log << self->CONID() << "chn:SENDING: " << pkt.Info());
+            self->m_pChannel->sendto(addr, pkt, source_addr);
+            self->worker_CountSent(1, 1);
+        }
+        else
+        {
+            self->worker_AddToBatch(addr, pkt, source_addr);
+        }
+    }
+
+    if (self->m_iBatchCount > 0)
+        self->worker_FlushBatch();
+
+    THREAD_EXIT();
+    return NULL;
+}
+
+void srt::CSndQueue::worker_AddToBatch(const sockaddr_any& addr, CPacket& pkt, const sockaddr_any& src)
+{
+    if (pkt.getLength() > m_szBatchPayload)
+    {
+        // Shouldn't happen, but don't drop the packet. Keep the order.
+        worker_FlushBatch();
+        HLOGC(qslog.Debug, log << CONID() << "chn:SENDING (oversized): " << pkt.Info());
+        m_pChannel->sendto(addr, pkt, src);
+        worker_CountSent(1, 1);
+        return;
+    }
+
+    // The packet must be copied because its payload refers to the sender
+    // buffer of the socket (or the packet filter), which may be reused
+    // before the batch is sent.
+    CPacket& slot = *m_vBatchPackets[m_iBatchCount];
+    memcpy((slot.getHeader()), pkt.getHeader(), CPacket::HDR_SIZE);
+    memcpy((slot.m_pcData), pkt.data(), pkt.getLength());
+    slot.setLength(pkt.getLength());
+    m_vBatchAddrs[m_iBatchCount] = addr;
+    m_vBatchSrcs[m_iBatchCount]  = src;
+    ++m_iBatchCount;
+
+    HLOGC(qslog.Debug, log << CONID() << "chn:BATCHING [" << m_iBatchCount << "]: " << slot.Info());
+
+    if (m_iBatchCount == int(m_vBatchPackets.size()))
+        worker_FlushBatch();
+}
+
+void srt::CSndQueue::worker_FlushBatch()
+{
+    int ncalls = 0;
+    m_pChannel->sendmany(&m_vBatchAddrs[0], &m_vBatchPackets[0], &m_vBatchSrcs[0], m_iBatchCount, (ncalls));
+    worker_CountSent(ncalls, m_iBatchCount);
+    m_iBatchCount = 0;
+}
+
+void srt::CSndQueue::worker_CountSent(int ncalls, int npackets)
+{
+    m_llSendCalls   = m_llSendCalls + ncalls;
+    m_llSentPackets = m_llSentPackets + npackets;
+    if (npackets > m_iSendBatchMax)
+        m_iSendBatchMax = npackets;
+}
+
+void srt::CSndQueue::getSendStats(int64_t& w_calls, int64_t& w_packets, int& w_maxbatch) const
+{
+    w_calls    = m_llSendCalls;
+    w_packets  = m_llSentPackets;
+    w_maxbatch = m_iSendBatchMax;
+}
+
+void srt::CSndQueue::worker_CountLateness(const steady_clock::duration& late)
+{
+    // Upper bounds of the ranges in CBytePerfMon::muxPacingLateHist,
+    // the last range has none.
+    static const int64_t bounds_us[SRT_PACING_HIST_SIZE - 1] = {1, 5, 10, 50, 100, 500, 1000};
+
+    const int64_t late_us = count_microseconds(late);
+    int           i       = 0;
+    while (i < SRT_PACING_HIST_SIZE - 1 && late_us >= bounds_us[i])
+        ++i;
+    m_llPacingLate[i] = m_llPacingLate[i] + 1;
+}
+
+void srt::CSndQueue::getPacingStats(int64_t (&w_hist)[SRT_PACING_HIST_SIZE]) const
+{
+    for (int i = 0; i < SRT_PACING_HIST_SIZE; ++i)
+        w_hist[i] = m_llPacingLate[i];
+}
+
+void srt::CSndQueue::getWorkerStats(SRT_MUXSTATS& w_stats) const
+{
+    w_stats.sndIterations   = m_llIterations;
+    w_stats.sndWakeups      = m_llWakeups;
+    w_stats.pktSent         = m_llSentPackets;
+    w_stats.sndCalls        = m_llSendCalls;
+    w_stats.pktSendBatchMax = m_iSendBatchMax;
+    w_stats.usPackData      = count_microseconds(steady_clock::duration(m_llPackTime));
+    w_stats.sndListLength   = m_pSndUList ? m_pSndUList->size() : 0;
+}
+
+void srt::CSndQueue::postEncryption(CUDT* u)
+{
+    CryptoWorker& w = cryptoWorkerOf(u->m_SocketID);
+
+    ScopedLock lk(w.lock);
+    if (u->m_bEncryptPosted)
+        return;
+    u->m_bEncryptPosted = true;
+    w.sockets.push_back(u);
+    w.cond.notify_one();
+}
+
+void srt::CSndQueue::cancelEncryption(CUDT* u)
+{
+    if (m_vCryptoWorkers.empty())
+        return;
 
-        IF_DEBUG_HIGHRATE(self->m_WorkerStats.lSendTo++);
+    CryptoWorker& w = cryptoWorkerOf(u->m_SocketID);
+
+    UniqueLock lk(w.lock);
+    // The worker may post the socket again when done with it.
+    while (w.current == u)
+        w.doneCond.wait(lk);
+    if (u->m_bEncryptPosted)
+    {
+        w.sockets.erase(std::find(w.sockets.begin(), w.sockets.end(), u));
+        u->m_bEncryptPosted = false;
     }
+}
+
+void* srt::CSndQueue::cryptoWorker(void* param)
+{
+    CryptoWorker* w = (CryptoWorker*)param;
+
+    std::string thname;
+    ThreadName::get(thname);
+    THREAD_STATE_INIT(thname.c_str());
+
+    w->queue->cryptoWorker_Run(*w);
+
+    HLOGC(qslog.Debug, log << "cryptoWorker: EXIT");
 
     THREAD_EXIT();
     return NULL;
 }
 
+void srt::CSndQueue::cryptoWorker_Run(CryptoWorker& w)
+{
+    // Packets encrypted for one socket before the others get their turn.
+    const int max_packets = 64;
+
+    UniqueLock lk(w.lock);
+    while (!m_bClosing)
+    {
+        if (w.sockets.empty())
+        {
+            THREAD_PAUSED();
+            w.cond.wait(lk);
+            THREAD_RESUMED();
+            continue;
+        }
+        INCREMENT_THREAD_ITERATIONS();
+
+        CUDT* u = w.sockets.front();
+        w.sockets.pop_front();
+        // Packets scheduled from now on need a new post.
+        u->m_bEncryptPosted = false;
+        w.current           = u;
+
+        bool more;
+        {
+            InvertedLock ulk(w.lock);
+            more = u->encryptAhead(max_packets);
+        }
+
+        w.current = NULL;
+        w.doneCond.notify_all();
+        if (more && !u->m_bEncryptPosted)
+        {
+            u->m_bEncryptPosted = true;
+            w.sockets.push_back(u);
+        }
+    }
+}
+
 int srt::CSndQueue::sendto(const sockaddr_any& addr, CPacket& w_packet, const sockaddr_any& src)
 {
     // send out the packet immediately (high priority), this is a control packet
@@ -620,93 +924,192 @@ int srt::CSndQueue::sendto(const sockaddr_any& addr, CPacket& w_packet, const so
 
 //
 srt::CRcvUList::CRcvUList()
-    : m_pUList(NULL)
-    , m_pLast(NULL)
+    : m_tsEpoch(steady_clock::now())
+    , m_iCurrTick(0)
 {
+    for (int i = 0; i < SLOTS; ++i)
+        m_pSlots[i] = NULL;
+    for (int i = 0; i <= LEVELS; ++i)
+        m_aiCount[i] = 0;
 }
 
 srt::CRcvUList::~CRcvUList() {}
 
 void srt::CRcvUList::insert(const CUDT* u)
 {
-    CRNode* n        = u->m_pRNode;
-    n->m_tsTimeStamp = steady_clock::now();
+    CRNode* n  = u->m_pRNode;
+    n->m_iTick = m_iCurrTick;
+    place(n);
+}
 
-    if (NULL == m_pUList)
-    {
-        // empty list, insert as the single node
-        n->m_pPrev = n->m_pNext = NULL;
-        m_pLast = m_pUList = n;
+void srt::CRcvUList::remove(const CUDT* u)
+{
+    CRNode* n = u->m_pRNode;
 
+    if (n->m_iSlot == -1)
         return;
-    }
 
-    // always insert at the end for RcvUList
-    n->m_pPrev       = m_pLast;
-    n->m_pNext       = NULL;
-    m_pLast->m_pNext = n;
-    m_pLast          = n;
+    unlink(n);
 }
 
-void srt::CRcvUList::remove(const CUDT* u)
+void srt::CRcvUList::update(const CUDT* u, const steady_clock::time_point& deadline)
 {
     CRNode* n = u->m_pRNode;
 
-    if (!n->m_bOnList)
+    if (n->m_iSlot == -1)
         return;
 
-    if (NULL == n->m_pPrev)
+    unlink(n);
+
+    // Round up, so that the node is never due before the deadline.
+    const int64_t us = count_microseconds(deadline - m_tsEpoch);
+    n->m_iTick       = us > 0 ? uint64_t(us + TICK_US - 1) / TICK_US : 0;
+    place(n);
+}
+
+srt::CRNode* srt::CRcvUList::expired(const steady_clock::time_point& now)
+{
+    advance(now);
+    return m_pSlots[DUE_SLOT];
+}
+
+steady_clock::time_point srt::CRcvUList::nextDue() const
+{
+    if (m_aiCount[LEVELS] > 0)
+        return m_tsEpoch;
+
+    if (m_aiCount[0] > 0)
     {
-        // n is the first node
-        m_pUList = n->m_pNext;
-        if (NULL == m_pUList)
-            m_pLast = NULL;
-        else
-            m_pUList->m_pPrev = NULL;
+        for (uint64_t tick = m_iCurrTick; tick < m_iCurrTick + LEVEL0_SIZE; ++tick)
+        {
+            if (m_pSlots[tick & (LEVEL0_SIZE - 1)])
+                return m_tsEpoch + microseconds_from(int64_t(tick) * TICK_US);
+        }
     }
-    else
+
+    for (int level = 1; level < LEVELS; ++level)
     {
-        n->m_pPrev->m_pNext = n->m_pNext;
-        if (NULL == n->m_pNext)
+        if (m_aiCount[level] > 0)
         {
-            // n is the last node
-            m_pLast = n->m_pPrev;
+            // The nodes are moved down to the first level at its next turn.
+            const uint64_t turn = (m_iCurrTick + LEVEL0_SIZE - 1) & ~uint64_t(LEVEL0_SIZE - 1);
+            return m_tsEpoch + microseconds_from(int64_t(turn) * TICK_US);
         }
-        else
-            n->m_pNext->m_pPrev = n->m_pPrev;
     }
 
-    n->m_pNext = n->m_pPrev = NULL;
+    return steady_clock::time_point();
 }
 
-void srt::CRcvUList::update(const CUDT* u)
+int srt::CRcvUList::levelOf(int slot)
 {
-    CRNode* n = u->m_pRNode;
-
-    if (!n->m_bOnList)
-        return;
+    if (slot < LEVEL0_SIZE)
+        return 0;
+    return 1 + (slot - LEVEL0_SIZE) / LEVELN_SIZE;
+}
 
-    n->m_tsTimeStamp = steady_clock::now();
+void srt::CRcvUList::place(CRNode* n)
+{
+    if (n->m_iTick < m_iCurrTick)
+        n->m_iTick = m_iCurrTick;
 
-    // if n is the last node, do not need to change
-    if (NULL == n->m_pNext)
+    const uint64_t delta = n->m_iTick - m_iCurrTick;
+    if (delta < uint64_t(LEVEL0_SIZE))
+    {
+        link(n, int(n->m_iTick & (LEVEL0_SIZE - 1)));
         return;
+    }
 
-    if (NULL == n->m_pPrev)
+    int shift = LEVEL0_BITS;
+    int level = 1;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (shift + LEVELN_BITS)))
     {
-        m_pUList          = n->m_pNext;
-        m_pUList->m_pPrev = NULL;
+        shift += LEVELN_BITS;
+        ++level;
     }
+
+    // Beyond the range of the wheel the node gets due earlier, which only
+    // makes the timers checked and the instance rescheduled.
+    const uint64_t range = uint64_t(1) << (shift + LEVELN_BITS);
+    if (delta >= range)
+        n->m_iTick = m_iCurrTick + range - 1;
+
+    const int slot = LEVEL0_SIZE + (level - 1) * LEVELN_SIZE + int((n->m_iTick >> shift) & (LEVELN_SIZE - 1));
+    link(n, slot);
+}
+
+void srt::CRcvUList::link(CRNode* n, int slot)
+{
+    n->m_iSlot = slot;
+    n->m_pPrev = NULL;
+    n->m_pNext = m_pSlots[slot];
+    if (n->m_pNext)
+        n->m_pNext->m_pPrev = n;
+    m_pSlots[slot] = n;
+    ++m_aiCount[slot == DUE_SLOT ? LEVELS : levelOf(slot)];
+}
+
+void srt::CRcvUList::unlink(CRNode* n)
+{
+    const int slot = n->m_iSlot;
+
+    if (NULL == n->m_pPrev)
+        m_pSlots[slot] = n->m_pNext;
     else
-    {
         n->m_pPrev->m_pNext = n->m_pNext;
+    if (n->m_pNext)
         n->m_pNext->m_pPrev = n->m_pPrev;
+
+    n->m_pNext = n->m_pPrev = NULL;
+    n->m_iSlot = -1;
+    --m_aiCount[slot == DUE_SLOT ? LEVELS : levelOf(slot)];
+}
+
+void srt::CRcvUList::cascade(int level)
+{
+    const int shift = LEVEL0_BITS + (level - 1) * LEVELN_BITS;
+    const int slot  = LEVEL0_SIZE + (level - 1) * LEVELN_SIZE + int((m_iCurrTick >> shift) & (LEVELN_SIZE - 1));
+
+    while (CRNode* n = m_pSlots[slot])
+    {
+        unlink(n);
+        place(n);
     }
+}
+
+void srt::CRcvUList::advance(const steady_clock::time_point& now)
+{
+    const int64_t  us       = count_microseconds(now - m_tsEpoch);
+    const uint64_t now_tick = us > 0 ? uint64_t(us) / TICK_US : 0;
 
-    n->m_pPrev       = m_pLast;
-    n->m_pNext       = NULL;
-    m_pLast->m_pNext = n;
-    m_pLast          = n;
+    while (m_iCurrTick <= now_tick)
+    {
+        int waiting = 0;
+        for (int level = 0; level < LEVELS; ++level)
+            waiting += m_aiCount[level];
+        if (waiting == 0)
+        {
+            // Nothing in the wheel, so nothing to do in the ticks between.
+            m_iCurrTick = now_tick + 1;
+            break;
+        }
+
+        // Move the nodes of the upper levels down at the turn of the level
+        // below, starting from the top, as they may go to the next level.
+        for (int level = LEVELS - 1; level > 0; --level)
+        {
+            const int shift = LEVEL0_BITS + (level - 1) * LEVELN_BITS;
+            if ((m_iCurrTick & ((uint64_t(1) << shift) - 1)) == 0)
+                cascade(level);
+        }
+
+        const int slot = int(m_iCurrTick & (LEVEL0_SIZE - 1));
+        while (CRNode* n = m_pSlots[slot])
+        {
+            unlink(n);
+            link(n, DUE_SLOT);
+        }
+        ++m_iCurrTick;
+    }
 }
 
 //
@@ -824,6 +1227,12 @@ void srt::CRendezvousQueue::insert(const SRTSOCKET&           id,
               << " (total connectors: " << m_lRendezvousID.size() << ")");
 }
 
+bool srt::CRendezvousQueue::empty() const
+{
+    ScopedLock vg(m_RIDListLock);
+    return m_lRendezvousID.empty();
+}
+
 void srt::CRendezvousQueue::remove(const SRTSOCKET& id)
 {
     ScopedLock lkv(m_RIDListLock);
@@ -1157,6 +1566,14 @@ srt::CRcvQueue::CRcvQueue()
     , m_iIPversion()
     , m_szPayloadSize()
     , m_bClosing(false)
+    , m_iBatchPos(0)
+    , m_iBatchCount(0)
+    , m_llRecvCalls(0)
+    , m_llRecvPackets(0)
+    , m_iRecvBatchMax(0)
+    , m_llIterations(0)
+    , m_llProcessTime(0)
+    , m_llTimersTime(0)
     , m_pRendezvousQueue(NULL)
     , m_vNewEntry()
     , m_IDLock()
@@ -1168,7 +1585,7 @@ srt::CRcvQueue::CRcvQueue()
 
 srt::CRcvQueue::~CRcvQueue()
 {
-    m_bClosing = true;
+    setClosing();
 
     if (m_WorkerThread.joinable())
     {
@@ -1177,6 +1594,27 @@ srt::CRcvQueue::~CRcvQueue()
     }
     releaseCond(m_BufferCond);
 
+    for (size_t i = 0; i < m_vProcessors.size(); ++i)
+    {
+        Processor* p = m_vProcessors[i];
+        if (p->thread.joinable())
+            p->thread.join();
+        releaseCond(p->cond);
+        delete p->units;
+        delete p;
+    }
+
+    for (size_t i = 0; i < m_vAcceptors.size(); ++i)
+    {
+        Acceptor* a = m_vAcceptors[i];
+        if (a->thread.joinable())
+            a->thread.join();
+        releaseCond(a->cond);
+        for (size_t r = 0; r < a->requests.size(); ++r)
+            delete a->requests[r].packet;
+        delete a;
+    }
+
     delete m_pUnitQueue;
     delete m_pRcvUList;
     delete m_pHash;
@@ -1198,7 +1636,7 @@ srt::CRcvQueue::~CRcvQueue()
 srt::sync::atomic<int> srt::CRcvQueue::m_counter(0);
 #endif
 
-void srt::CRcvQueue::init(int qsize, size_t payload, int version, int hsize, CChannel* cc, CTimer* t)
+void srt::CRcvQueue::init(int qsize, size_t payload, int version, int hsize, int workers, int acceptworkers, CChannel* cc, CTimer* t)
 {
     m_iIPversion    = version;
     m_szPayloadSize = payload;
@@ -1215,6 +1653,15 @@ void srt::CRcvQueue::init(int qsize, size_t payload, int version, int hsize, CCh
     m_pRcvUList        = new CRcvUList;
     m_pRendezvousQueue = new CRendezvousQueue;
 
+    const int batch = cc->getRcvBatchSize();
+    if (batch > 1)
+    {
+        m_vBatchUnits.resize(batch);
+        m_vBatchPackets.resize(batch);
+        m_vBatchAddrs.resize(batch, sockaddr_any(version));
+        m_vBatchStatus.resize(batch, RST_AGAIN);
+    }
+
 #if ENABLE_LOGGING
     const int cnt = ++m_counter;
     const std::string thrname = "SRT:RcvQ:w" + Sprint(cnt);
@@ -1222,6 +1669,52 @@ void srt::CRcvQueue::init(int qsize, size_t payload, int version, int hsize, CCh
     const std::string thrname = "SRT:RcvQ:w";
 #endif
 
+    if (workers > 1)
+    {
+        m_vProcessors.resize(workers);
+        for (int i = 0; i < workers; ++i)
+        {
+            Processor* p = new Processor;
+            p->queue     = this;
+            p->units     = new CUnitQueue(qsize, (int)payload);
+            p->waiting   = false;
+            setupCond(p->cond, "RcvQueueProcessor");
+            m_vProcessors[i] = p;
+        }
+
+        for (int i = 0; i < workers; ++i)
+        {
+            const std::string pthrname = thrname + "p" + Sprint(i);
+            if (!StartThread(m_vProcessors[i]->thread, CRcvQueue::processor, m_vProcessors[i], pthrname.c_str()))
+            {
+                setClosing();
+                throw CUDTException(MJ_SYSTEMRES, MN_THREAD);
+            }
+        }
+    }
+
+    if (acceptworkers > 0)
+    {
+        m_vAcceptors.resize(acceptworkers);
+        for (int i = 0; i < acceptworkers; ++i)
+        {
+            Acceptor* a = new Acceptor;
+            a->queue    = this;
+            setupCond(a->cond, "RcvQueueAcceptor");
+            m_vAcceptors[i] = a;
+        }
+
+        for (int i = 0; i < acceptworkers; ++i)
+        {
+            const std::string athrname = thrname + "a" + Sprint(i);
+            if (!StartThread(m_vAcceptors[i]->thread, CRcvQueue::acceptor, m_vAcceptors[i], athrname.c_str()))
+            {
+                setClosing();
+                throw CUDTException(MJ_SYSTEMRES, MN_THREAD);
+            }
+        }
+    }
+
     if (!StartThread(m_WorkerThread, CRcvQueue::worker, this, thrname.c_str()))
     {
         throw CUDTException(MJ_SYSTEMRES, MN_THREAD);
@@ -1242,10 +1735,14 @@ void* srt::CRcvQueue::worker(void* param)
     EConnectStatus cst  = CONN_AGAIN;
     while (!self->m_bClosing)
     {
+        // Don't wait for packets longer than until the earliest timer is due.
+        self->m_pChannel->setReadTimeout(self->worker_ReadTimeout());
+
         bool        have_received = false;
         EReadStatus rst           = self->worker_RetrieveUnit((id), (unit), (sa));
 
         INCREMENT_THREAD_ITERATIONS();
+        self->m_llIterations = self->m_llIterations + 1;
         if (rst == RST_OK)
         {
             if (id < 0)
@@ -1278,6 +1775,13 @@ void* srt::CRcvQueue::worker(void* param)
                 cst = self->worker_ProcessAddressedPacket(id, unit, sa);
                 // CAN RETURN CONN_REJECT, but m_RejectReason is already set
             }
+
+            // A packet dispatched to a connected socket might have been
+            // passed to a processor and must not be accessed anymore.
+            // It isn't of interest for the pending connections anyway.
+            if (!self->m_vProcessors.empty() && (cst == CONN_RUNNING || cst == CONN_ACCEPT))
+                unit = NULL;
+
             HLOGC(qrlog.Debug, log << self->CONID() << "worker: result for the unit: " << ConnectStatusStr(cst));
             if (cst == CONN_AGAIN)
             {
@@ -1310,37 +1814,13 @@ void* srt::CRcvQueue::worker(void* param)
         // OTHERWISE: this is an "AGAIN" situation. No data was read, but the process should continue.
 
         // take care of the timing event for all UDT sockets
-        const steady_clock::time_point curtime_minus_syn =
-            steady_clock::now() - microseconds_from(CUDT::COMM_SYN_INTERVAL_US);
-
-        CRNode* ul = self->m_pRcvUList->m_pUList;
-        while ((NULL != ul) && (ul->m_tsTimeStamp < curtime_minus_syn))
-        {
-            CUDT* u = ul->m_pUDT;
-
-            if (u->m_bConnected && !u->m_bBroken && !u->m_bClosing)
-            {
-                u->checkTimers();
-                self->m_pRcvUList->update(u);
-            }
-            else
-            {
-                HLOGC(qrlog.Debug,
-                      log << CUDTUnited::CONID(u->m_SocketID) << " SOCKET broken, REMOVING FROM RCV QUEUE/MAP.");
-                // the socket must be removed from Hash table first, then RcvUList
-                self->m_pHash->remove(u->m_SocketID);
-                self->m_pRcvUList->remove(u);
-                u->m_pRNode->m_bOnList = false;
-            }
-
-            ul = self->m_pRcvUList->m_pUList;
-        }
+        self->worker_CheckTimers(*self->m_pRcvUList);
 
         if (have_received)
         {
             HLOGC(qrlog.Debug,
                   log << "worker: RECEIVED PACKET --> updateConnStatus. cst=" << ConnectStatusStr(cst) << " id=" << id
-                      << " pkt-payload-size=" << unit->m_Packet.getLength());
+                      << " pkt-payload-size=" << (unit ? unit->m_Packet.getLength() : 0));
         }
 
         // Check connection requests status for all sockets in the RendezvousQueue.
@@ -1378,10 +1858,13 @@ srt::EReadStatus srt::CRcvQueue::worker_RetrieveUnit(int32_t& w_id, CUnit*& w_un
             HLOGC(qrlog.Debug,
                   log << CUDTUnited::CONID(ne->m_SocketID)
                       << " SOCKET pending for connection - ADDING TO RCV QUEUE/MAP");
-            m_pRcvUList->insert(ne);
-            m_pHash->insert(ne->m_SocketID, ne);
+            worker_AddEntry(ne);
         }
     }
+
+    if (!m_vBatchUnits.empty())
+        return worker_RetrieveBatchedUnit((w_id), (w_unit), (w_addr));
+
     // find next available slot for incoming packet
     w_unit = m_pUnitQueue->getNextAvailUnit();
     if (!w_unit)
@@ -1409,6 +1892,7 @@ srt::EReadStatus srt::CRcvQueue::worker_RetrieveUnit(int32_t& w_id, CUnit*& w_un
 
     if (rst == RST_OK)
     {
+        worker_CountReceived(1);
         w_id = w_unit->m_Packet.id();
         HLOGC(qrlog.Debug,
               log << "INCOMING PACKET: FROM=" << w_addr.str() << " BOUND=" << m_pChannel->bindAddressAny().str() << " "
@@ -1417,6 +1901,164 @@ srt::EReadStatus srt::CRcvQueue::worker_RetrieveUnit(int32_t& w_id, CUnit*& w_un
     return rst;
 }
 
+srt::EReadStatus srt::CRcvQueue::worker_RetrieveBatchedUnit(int32_t& w_id, CUnit*& w_unit, sockaddr_any& w_addr)
+{
+    if (m_iBatchPos >= m_iBatchCount)
+    {
+        // All units from the previous batch have been dispatched.
+        const EReadStatus rst = worker_ReadBatch();
+        if (rst != RST_OK)
+        {
+            w_unit = NULL;
+            return rst;
+        }
+    }
+
+    const int pos = m_iBatchPos++;
+    w_unit = m_vBatchUnits[pos];
+
+    // Drop the reservation. From now on it's up to the dispatching
+    // procedure whether the unit will be taken or left free.
+    w_unit->m_bTaken = false;
+
+    if (m_vBatchStatus[pos] != RST_OK)
+        return RST_AGAIN;
+
+    w_addr = m_vBatchAddrs[pos];
+    w_id   = w_unit->m_Packet.id();
+    HLOGC(qrlog.Debug,
+          log << "INCOMING PACKET [" << (pos + 1) << "/" << m_iBatchCount << "]: FROM=" << w_addr.str()
+              << " BOUND=" << m_pChannel->bindAddressAny().str() << " " << w_unit->m_Packet.Info());
+    return RST_OK;
+}
+
+srt::EReadStatus srt::CRcvQueue::worker_ReadBatch()
+{
+    m_iBatchPos   = 0;
+    m_iBatchCount = 0;
+
+    const int batch  = (int)m_vBatchUnits.size();
+    int       nunits = 0;
+    for (; nunits < batch; ++nunits)
+    {
+        CUnit* u = m_pUnitQueue->getNextAvailUnit();
+        if (!u)
+            break;
+
+        // Reserve the unit, otherwise the next call to getNextAvailUnit
+        // would return THE SAME UNIT (see PacketFilter::InsertRebuilt).
+        u->m_bTaken = true;
+        u->m_Packet.setLength(m_szPayloadSize);
+        m_vBatchUnits[nunits]   = u;
+        m_vBatchPackets[nunits] = &u->m_Packet;
+    }
+
+    if (nunits == 0)
+    {
+        // no space, skip this packet
+        CPacket temp;
+        temp.allocate(m_szPayloadSize);
+        sockaddr_any sa(m_iIPversion);
+        THREAD_PAUSED();
+        EReadStatus rst = m_pChannel->recvfrom((sa), (temp));
+        THREAD_RESUMED();
+        LOGC(qrlog.Error, log << CONID() << "LOCAL STORAGE DEPLETED. Dropping 1 packet: " << temp.Info());
+        return rst == RST_ERROR ? RST_ERROR : RST_AGAIN;
+    }
+
+    int nrecv = 0;
+    THREAD_PAUSED();
+    const EReadStatus rst = m_pChannel->recvmany(&m_vBatchAddrs[0], &m_vBatchPackets[0], &m_vBatchStatus[0], nunits, (nrecv));
+    THREAD_RESUMED();
+
+    // Units that haven't been filled in are free again.
+    for (int i = nrecv; i < nunits; ++i)
+        m_vBatchUnits[i]->m_bTaken = false;
+
+    if (rst != RST_OK)
+        return rst;
+
+    worker_CountReceived(nrecv);
+    m_iBatchCount = nrecv;
+    return RST_OK;
+}
+
+void srt::CRcvQueue::worker_CountReceived(int npackets)
+{
+    m_llRecvCalls   = m_llRecvCalls + 1;
+    m_llRecvPackets = m_llRecvPackets + npackets;
+    if (npackets > m_iRecvBatchMax)
+        m_iRecvBatchMax = npackets;
+}
+
+void srt::CRcvQueue::getRecvStats(int64_t& w_calls, int64_t& w_packets, int& w_maxbatch, int64_t& w_syscalls) const
+{
+    w_calls    = m_llRecvCalls;
+    w_packets  = m_llRecvPackets;
+    w_maxbatch = m_iRecvBatchMax;
+    w_syscalls = m_pChannel ? m_pChannel->getRecvSyscalls() : 0;
+}
+
+void srt::CRcvQueue::getWorkerStats(SRT_MUXSTATS& w_stats) const
+{
+    getRecvStats((w_stats.rcvCalls), (w_stats.pktRecv), (w_stats.pktRecvBatchMax), (w_stats.rcvSyscalls));
+    w_stats.rcvIterations   = m_llIterations;
+    w_stats.usProcessData   = count_microseconds(steady_clock::duration(m_llProcessTime));
+    w_stats.usCheckTimers   = count_microseconds(steady_clock::duration(m_llTimersTime));
+    w_stats.rcvUnitsFree    = m_pUnitQueue ? m_pUnitQueue->size() : 0;
+    w_stats.rcvUnitsTotal   = m_pUnitQueue ? m_pUnitQueue->capacity() : 0;
+    for (size_t i = 0; i < m_vProcessors.size(); ++i)
+    {
+        w_stats.rcvUnitsFree += m_vProcessors[i]->units->size();
+        w_stats.rcvUnitsTotal += m_vProcessors[i]->units->capacity();
+    }
+}
+
+steady_clock::duration srt::CRcvQueue::worker_ReadTimeout() const
+{
+    const steady_clock::duration syn_interval = microseconds_from(CUDT::COMM_SYN_INTERVAL_US);
+
+    // Pending connections are checked periodically, and without the ability
+    // to interrupt the wait (when a socket is added or the queue is closing)
+    // the period is the only bound for the reaction time.
+    if (!m_pChannel->canInterruptRead() || !m_pRendezvousQueue->empty())
+        return syn_interval;
+
+    // With no sockets there's nothing to do but wait for packets. The
+    // limit is only a safety measure; nothing depends on it.
+    const steady_clock::time_point due = m_pRcvUList->nextDue();
+    if (is_zero(due))
+        return syn_interval;
+
+    // The timers are checked for the sockets on the list when
+    // their deadlines have passed (see CRcvQueue::worker).
+    const steady_clock::time_point now = steady_clock::now();
+    return due > now ? due - now : steady_clock::duration::zero();
+}
+
+void srt::CRcvQueue::setClosing()
+{
+    m_bClosing = true;
+
+    // Wake up the worker if it's waiting for packets.
+    if (m_pChannel)
+        m_pChannel->interruptRead();
+
+    for (size_t i = 0; i < m_vProcessors.size(); ++i)
+    {
+        Processor& p = *m_vProcessors[i];
+        ScopedLock lk(p.lock);
+        p.cond.notify_one();
+    }
+
+    for (size_t i = 0; i < m_vAcceptors.size(); ++i)
+    {
+        Acceptor& a = *m_vAcceptors[i];
+        ScopedLock lk(a.lock);
+        a.cond.notify_one();
+    }
+}
+
 srt::EConnectStatus srt::CRcvQueue::worker_ProcessConnectionRequest(CUnit* unit, const sockaddr_any& addr)
 {
     HLOGC(cnlog.Debug,
@@ -1431,7 +2073,22 @@ srt::EConnectStatus srt::CRcvQueue::worker_ProcessConnectionRequest(CUnit* unit,
         SharedLock shl(m_pListener);
         CUDT*      pListener = m_pListener.getPtrNoLock();
 
-        if (pListener)
+        // Only the conclusion handshakes are passed to the acceptors. The
+        // induction requests and the malformed packets are handled here.
+        CHandShake hs;
+        const bool to_acceptor = pListener && !m_vAcceptors.empty() && unit->m_Packet.isControl(UMSG_HANDSHAKE)
+            && hs.load_from(unit->m_Packet.m_pcData, unit->m_Packet.getLength()) == 0
+            && hs.m_iReqType != URQ_INDUCTION;
+
+        if (to_acceptor)
+        {
+            // If the acceptor's queue is full, the request is dropped,
+            // and the caller will repeat it.
+            HLOGC(cnlog.Debug, log << "PASSING conclusion from: " << addr.str() << " @" << hs.m_iID << " to an acceptor");
+            acceptor_Post(hs.m_iID, unit->m_Packet, addr);
+            have_listener = true;
+        }
+        else if (pListener)
         {
             LOGC(cnlog.Debug, log << "PASSING request from: " << addr.str() << " to listener:" << pListener->socketID());
             listener_ret = pListener->processConnectRequest(addr, unit->m_Packet);
@@ -1464,7 +2121,7 @@ srt::EConnectStatus srt::CRcvQueue::worker_ProcessConnectionRequest(CUnit* unit,
 
 srt::EConnectStatus srt::CRcvQueue::worker_ProcessAddressedPacket(int32_t id, CUnit* unit, const sockaddr_any& addr)
 {
-    CUDT* u = m_pHash->lookup(id);
+    CUDT* u = worker_LookupEntry(id);
     if (!u)
     {
         // Pass this to either async rendezvous connection,
@@ -1472,6 +2129,24 @@ srt::EConnectStatus srt::CRcvQueue::worker_ProcessAddressedPacket(int32_t id, CU
         HLOGC(cnlog.Debug, log << "worker_ProcessAddressedPacket: resending to QUEUED socket @" << id);
         return worker_TryAsyncRend_OrStore(id, unit, addr);
     }
+
+    if (!m_vProcessors.empty())
+    {
+        // The socket is handled by its processor. The packet
+        // will be checked there as the socket may be gone by then.
+        processor_Post(id, unit, addr);
+        return CONN_RUNNING;
+    }
+
+    return worker_ProcessConnectedPacket(u, unit, addr, *m_pRcvUList);
+}
+
+srt::EConnectStatus srt::CRcvQueue::worker_ProcessConnectedPacket(CUDT*               u,
+                                                                  CUnit*              unit,
+                                                                  const sockaddr_any& addr,
+                                                                  CRcvUList&          ulist)
+{
+    const int32_t id SRT_ATR_UNUSED = u->m_SocketID;
     // Although we don´t have an exclusive passing here,
     // we can count on that when the socket was once present in the hash,
     // it will not be deleted for at least one GC cycle. But we still need
@@ -1501,17 +2176,267 @@ srt::EConnectStatus srt::CRcvQueue::worker_ProcessAddressedPacket(int32_t id, CU
         return CONN_REJECT;
     }
 
+    const steady_clock::time_point start = steady_clock::now();
     if (unit->m_Packet.isControl())
         u->processCtrl(unit->m_Packet);
     else
         u->processData(unit);
 
-    u->checkTimers();
-    m_pRcvUList->update(u);
+    // The packet may have changed the deadline of the timers, and
+    // they are checked here only if they are due already.
+    const steady_clock::time_point now      = steady_clock::now();
+    steady_clock::time_point       deadline = u->nextTimerDeadline(now);
+    m_llProcessTime.fetch_add((now - start).count());
+    if (deadline <= now)
+    {
+        u->checkTimers();
+        const steady_clock::time_point after = steady_clock::now();
+        m_llTimersTime.fetch_add((after - now).count());
+        deadline = u->nextTimerDeadline(after);
+    }
+    ulist.update(u, deadline);
 
     return CONN_RUNNING;
 }
 
+void srt::CRcvQueue::worker_CheckTimers(CRcvUList& ulist)
+{
+    const steady_clock::time_point now = steady_clock::now();
+    bool                           any = false;
+
+    while (CRNode* ul = ulist.expired(now))
+    {
+        any = true;
+        CUDT* u = ul->m_pUDT;
+
+        if (u->m_bConnected && !u->m_bBroken && !u->m_bClosing)
+        {
+            u->checkTimers();
+            ulist.update(u, u->nextTimerDeadline(steady_clock::now()));
+        }
+        else
+        {
+            HLOGC(qrlog.Debug,
+                  log << CUDTUnited::CONID(u->m_SocketID) << " SOCKET broken, REMOVING FROM RCV QUEUE/MAP.");
+            // the socket must be removed from Hash table first, then RcvUList
+            {
+                ScopedLock lk(m_HashLock);
+                m_pHash->remove(u->m_SocketID);
+            }
+            ulist.remove(u);
+            u->m_pRNode->m_bOnList = false;
+        }
+    }
+
+    if (any)
+        m_llTimersTime.fetch_add((steady_clock::now() - now).count());
+}
+
+void srt::CRcvQueue::worker_AddEntry(CUDT* u)
+{
+    if (m_vProcessors.empty())
+    {
+        m_pRcvUList->insert(u);
+        m_pHash->insert(u->m_SocketID, u);
+        return;
+    }
+
+    // The processor must have the socket on its list before
+    // the first packet for this socket is passed to it.
+    Processor& p = processorOf(u->m_SocketID);
+    {
+        ScopedLock lk(p.lock);
+        p.newEntries.push_back(u);
+        if (p.waiting)
+            p.cond.notify_one();
+    }
+
+    ScopedLock lk(m_HashLock);
+    m_pHash->insert(u->m_SocketID, u);
+}
+
+srt::CUDT* srt::CRcvQueue::worker_LookupEntry(int32_t id)
+{
+    // The hash is modified by the processors, and only then it needs
+    // protection. Without them everything happens in the worker thread.
+    if (m_vProcessors.empty())
+        return m_pHash->lookup(id);
+
+    ScopedLock lk(m_HashLock);
+    return m_pHash->lookup(id);
+}
+
+void srt::CRcvQueue::processor_Post(int32_t id, CUnit* unit, const sockaddr_any& addr)
+{
+    // The unit is in use until the processor has copied the packet.
+    // Counting it as taken lets the unit queue grow when the processors
+    // fall behind the worker.
+    m_pUnitQueue->makeUnitTaken(unit);
+
+    Processor&              p   = processorOf(id);
+    const Processor::Packet pkt = {id, unit, addr};
+
+    ScopedLock lk(p.lock);
+    p.packets.push_back(pkt);
+    if (p.waiting)
+        p.cond.notify_one();
+}
+
+void* srt::CRcvQueue::processor(void* param)
+{
+    Processor* p = (Processor*)param;
+
+    std::string thname;
+    ThreadName::get(thname);
+    THREAD_STATE_INIT(thname.c_str());
+
+    p->queue->processor_Run(*p);
+
+    HLOGC(qrlog.Debug, log << "processor: EXIT");
+
+    THREAD_EXIT();
+    return NULL;
+}
+
+void srt::CRcvQueue::processor_Run(Processor& p)
+{
+    const steady_clock::duration syn_interval = microseconds_from(CUDT::COMM_SYN_INTERVAL_US);
+    std::vector<CUDT*>           entries;
+
+    while (!m_bClosing)
+    {
+        {
+            UniqueLock lk(p.lock);
+            if (p.packets.empty() && p.newEntries.empty() && !m_bClosing)
+            {
+                // Don't wait longer than until the earliest timer is due.
+                steady_clock::duration         timeout = syn_interval;
+                const steady_clock::time_point due     = p.ulist.nextDue();
+                if (!is_zero(due))
+                {
+                    const steady_clock::time_point now = steady_clock::now();
+                    timeout = due > now ? due - now : steady_clock::duration::zero();
+                }
+
+                p.waiting = true;
+                p.cond.wait_for(lk, timeout);
+                p.waiting = false;
+            }
+            entries.swap(p.newEntries);
+            p.processing.swap(p.packets);
+        }
+        INCREMENT_THREAD_ITERATIONS();
+
+        for (size_t i = 0; i < entries.size(); ++i)
+            p.ulist.insert(entries[i]);
+        entries.clear();
+
+        for (; !p.processing.empty(); p.processing.pop_front())
+        {
+            const Processor::Packet& pkt = p.processing.front();
+
+            // Move the packet to the own unit and return the worker's unit.
+            // It's up to the dispatching procedure whether the new unit
+            // will be taken or left free.
+            CUnit* unit = p.units->getNextAvailUnit();
+            if (unit)
+                unit->m_Packet.copyFrom(pkt.unit->m_Packet);
+            else
+                LOGC(qrlog.Error,
+                     log << CONID() << "LOCAL STORAGE DEPLETED. Dropping 1 packet: " << pkt.unit->m_Packet.Info());
+            m_pUnitQueue->makeUnitFree(pkt.unit);
+            if (!unit)
+                continue;
+
+            // The socket could have been removed from the hash by this
+            // thread since the packet has been posted. Only this thread
+            // removes it, so it stays valid while being processed.
+            CUDT* u = worker_LookupEntry(pkt.id);
+            if (u)
+                worker_ProcessConnectedPacket(u, unit, pkt.addr, p.ulist);
+        }
+
+        worker_CheckTimers(p.ulist);
+    }
+
+    // Release the units of the packets that haven't been processed.
+    UniqueLock lk(p.lock);
+    for (size_t i = 0; i < p.packets.size(); ++i)
+        m_pUnitQueue->makeUnitFree(p.packets[i].unit);
+    p.packets.clear();
+}
+
+void srt::CRcvQueue::acceptor_Post(int32_t peerid, const CPacket& pkt, const sockaddr_any& addr)
+{
+    Acceptor& a = *m_vAcceptors[uint32_t(peerid) % m_vAcceptors.size()];
+
+    ScopedLock lk(a.lock);
+    if (a.requests.size() >= MAX_ACCEPT_REQUESTS)
+    {
+        HLOGC(cnlog.Debug, log << "acceptor: queue full, dropping the conclusion from " << addr.str());
+        return;
+    }
+
+    // The response is crafted in the packet, so it
+    // needs the capacity of the whole payload.
+    CPacket* packet = new CPacket;
+    packet->allocate(m_szPayloadSize);
+    packet->setCapacity(m_szPayloadSize);
+    packet->copyFrom(pkt);
+
+    const Acceptor::Request req = {packet, addr};
+    a.requests.push_back(req);
+    a.cond.notify_one();
+}
+
+void* srt::CRcvQueue::acceptor(void* param)
+{
+    Acceptor* a = (Acceptor*)param;
+
+    std::string thname;
+    ThreadName::get(thname);
+    THREAD_STATE_INIT(thname.c_str());
+
+    a->queue->acceptor_Run(*a);
+
+    HLOGC(qrlog.Debug, log << "acceptor: EXIT");
+
+    THREAD_EXIT();
+    return NULL;
+}
+
+void srt::CRcvQueue::acceptor_Run(Acceptor& a)
+{
+    for (;;)
+    {
+        Acceptor::Request req;
+        {
+            UniqueLock lk(a.lock);
+            while (a.requests.empty() && !m_bClosing)
+                a.cond.wait(lk);
+            if (m_bClosing)
+                break;
+            req = a.requests.front();
+            a.requests.pop_front();
+        }
+        INCREMENT_THREAD_ITERATIONS();
+
+        {
+            // The listener can't be removed while its request is being processed.
+            SharedLock shl(m_pListener);
+            CUDT*      pListener = m_pListener.getPtrNoLock();
+            if (pListener)
+            {
+                const int listener_ret SRT_ATR_UNUSED = pListener->processConnectRequest(req.addr, *req.packet);
+                HLOGC(cnlog.Debug,
+                      log << "acceptor: listener @" << pListener->socketID() << " processed the request from "
+                          << req.addr.str() << " result:" << RequestTypeStr(UDTRequestType(listener_ret)));
+            }
+        }
+        delete req.packet;
+    }
+}
+
 // This function responds to the fact that a packet has come
 // for a socket that does not expect to receive a normal connection
 // request. This can be then:
@@ -1610,8 +2535,7 @@ srt::EConnectStatus srt::CRcvQueue::worker_TryAsyncRend_OrStore(int32_t id, CUni
                 HLOGC(cnlog.Debug,
                       log << CUDTUnited::CONID(ne->m_SocketID)
                           << " SOCKET pending for connection - ADDING TO RCV QUEUE/MAP");
-                m_pRcvUList->insert(ne);
-                m_pHash->insert(ne->m_SocketID, ne);
+                worker_AddEntry(ne);
 
                 // The current situation is that this has passed processAsyncConnectResponse, but actually
                 // this packet *SHOULD HAVE BEEN* handled by worker_ProcessAddressedPacket, however the
@@ -1665,6 +2589,18 @@ void srt::CRcvQueue::stopWorker()
     HLOGC(rslog.Debug, log << "RcvQueue: EXIT (forced)");
     // And we trust the thread that it does.
     m_WorkerThread.join();
+
+    setClosing();
+    for (size_t i = 0; i < m_vProcessors.size(); ++i)
+    {
+        if (m_vProcessors[i]->thread.joinable())
+            m_vProcessors[i]->thread.join();
+    }
+    for (size_t i = 0; i < m_vAcceptors.size(); ++i)
+    {
+        if (m_vAcceptors[i]->thread.joinable())
+            m_vAcceptors[i]->thread.join();
+    }
 }
 
 int srt::CRcvQueue::recvfrom(int32_t id, CPacket& w_packet)
@@ -1741,6 +2677,9 @@ void srt::CRcvQueue::registerConnector(const SRTSOCKET&                id,
     HLOGC(cnlog.Debug,
           log << "registerConnector: adding @" << id << " addr=" << addr.str() << " TTL=" << FormatTime(ttl));
     m_pRendezvousQueue->insert(id, u, addr, ttl);
+
+    // Make the worker apply the period for pending connections.
+    m_pChannel->interruptRead();
 }
 
 void srt::CRcvQueue::removeConnector(const SRTSOCKET& id)
@@ -1767,8 +2706,14 @@ void srt::CRcvQueue::removeConnector(const SRTSOCKET& id)
 void srt::CRcvQueue::setNewEntry(CUDT* u)
 {
     HLOGC(cnlog.Debug, log << CUDTUnited::CONID(u->m_SocketID) << "setting socket PENDING FOR CONNECTION");
-    ScopedLock listguard(m_IDLock);
-    m_vNewEntry.push_back(u);
+    {
+        ScopedLock listguard(m_IDLock);
+        m_vNewEntry.push_back(u);
+    }
+
+    // The worker should add the socket to the list now
+    // to start checking its timers.
+    m_pChannel->interruptRead();
 }
 
 bool srt::CRcvQueue::ifNewEntry()
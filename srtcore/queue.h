@@ -55,9 +55,11 @@ modified by
 
 #include "common.h"
 #include "packet.h"
+#include "mempool.h"
 #include "socketconfig.h"
 #include "netinet_any.h"
 #include "utilities.h"
+#include <deque>
 #include <list>
 #include <map>
 #include <queue>
@@ -103,7 +105,6 @@ private:
     struct CQEntry
     {
         CUnit* m_pUnit;   // unit queue
-        char*  m_pBuffer; // data buffer
         int    m_iSize;   // size of each queue
 
         CQEntry* m_pNext;
@@ -114,21 +115,25 @@ private:
     /// @return 0: success, -1: failure.
     int increase_();
 
-    /// @brief Allocated a CQEntry of iNumUnits with each unit of mss bytes.
+    /// @brief Allocated a CQEntry of iNumUnits with each unit of m_iMSS bytes
+    /// taken from the slot pool.
     /// @param iNumUnits a number of units to allocate
-    /// @param mss the size of each unit in bytes.
     /// @return a pointer to a newly allocated entry on success, NULL otherwise.
-    static CQEntry* allocateEntry(const int iNumUnits, const int mss);
+    CQEntry* allocateEntry(const int iNumUnits);
+
+    /// Return the data buffers of the entry's units to the slot pool and delete the entry.
+    void releaseEntry(CQEntry* entry);
 
 private:
     CQEntry* m_pQEntry;    // pointer to the first unit queue
     CQEntry* m_pCurrQueue; // pointer to the current available queue
     CQEntry* m_pLastQueue; // pointer to the last unit queue
     CUnit* m_pAvailUnit; // recent available unit
-    int m_iSize;  // total size of the unit queue, in number of packets
+    sync::atomic<int> m_iSize; // total size of the unit queue, in number of packets
     sync::atomic<int> m_iNumTaken; // total number of valid (occupied) packets in the queue
     const int m_iMSS; // unit buffer size
     const int m_iBlockSize; // Number of units in each CQEntry.
+    CPacketSlotPool& m_SlotPool; // shared pool of the unit data buffers
 
 private:
     CUnitQueue(const CUnitQueue&);
@@ -141,6 +146,10 @@ struct CSNode
     sync::steady_clock::time_point m_tsTimeStamp;
 
     sync::atomic<int> m_iHeapLoc; // location on the heap, -1 means not on the heap
+
+    sync::atomic<bool>             m_bReady;     // if the node is on the ready list, waiting to be put on the heap
+    sync::steady_clock::time_point m_tsReady;    // time stamp to put the node on the heap with
+    CSNode*                        m_pNextReady; // next node on the ready list
 };
 
 class CSndUList
@@ -159,6 +168,9 @@ public:
     static EReschedule rescheduleIf(bool cond) { return cond ? DO_RESCHEDULE : DONT_RESCHEDULE; }
 
     /// Update the timestamp of the UDT instance on the list.
+    /// Without rescheduling, an instance that isn't on the list is put
+    /// on the ready list without locking, and moved to the heap by the
+    /// sending worker, which is only woken up if it's waiting.
     /// @param [in] u pointer to the UDT instance
     /// @param [in] reschedule if the timestamp should be rescheduled
     /// @param [in] ts the next time to trigger sending logic on the CUDT
@@ -179,9 +191,19 @@ public:
     /// Wait for the list to become non empty.
     void waitNonEmpty() const;
 
+    /// Sleep on the timer until the given time, or until woken up
+    /// by an earlier update.
+    /// @param [in] tp the time to sleep until
+    /// @return true if slept until the given time, false if woken up earlier
+    bool sleepUntil(const sync::steady_clock::time_point& tp) const;
+
     /// Signal to stop waiting in waitNonEmpty().
     void signalInterrupt() const;
 
+    /// Get the number of sockets on the heap, not counting
+    /// those on the ready list.
+    int size() const;
+
 private:
     /// Doubles the size of the list.
     ///
@@ -204,6 +226,12 @@ private:
     /// If the last entry is removed, calls sync::CTimer::interrupt().
     void remove_(const CUDT* u);
 
+    /// Move the nodes from the ready list to the heap.
+    void takeReady_();// REQUIRES(m_ListLock);
+
+    /// Wake up the sending worker, if it's waiting.
+    void wakeup_() const;
+
 private:
     CSNode** m_pHeap;        // The heap array
     int      m_iArrayLength; // physical length of the array
@@ -212,6 +240,9 @@ private:
     mutable sync::Mutex     m_ListLock; // Protects the list (m_pHeap, m_iArrayLength, m_iLastEntry).
     mutable sync::Condition m_ListCond;
 
+    sync::atomic<CSNode*>      m_pReady;   // Ready list: stack of nodes to put on the heap, updated without locking
+    mutable sync::atomic<bool> m_bWaiting; // The sending worker is waiting in waitNonEmpty() or sleeping on the timer
+
     sync::CTimer* const m_pTimer;
 
 private:
@@ -221,8 +252,9 @@ private:
 
 struct CRNode
 {
-    CUDT*                          m_pUDT;        // Pointer to the instance of CUDT socket
-    sync::steady_clock::time_point m_tsTimeStamp; // Time Stamp
+    CUDT*    m_pUDT;  // Pointer to the instance of CUDT socket
+    uint64_t m_iTick; // Deadline of the timers, in CRcvUList ticks
+    int      m_iSlot; // Slot of CRcvUList with this node, -1 if none
 
     CRNode* m_pPrev; // previous link
     CRNode* m_pNext; // next link
@@ -230,14 +262,24 @@ struct CRNode
     sync::atomic<bool> m_bOnList; // if the node is already on the list
 };
 
+/// The list of UDT instances receiving packets from the queue, ordered by
+/// the deadlines of their timers (see CUDT::nextTimerDeadline()).
+///
+/// This is a hierarchical timer wheel. The first level has a slot per tick,
+/// and every next level has slots as wide as the whole level below. The
+/// nodes are moved down to the lower levels when the wheel gets to their
+/// slots, so every operation is O(1) and the instances waiting for their
+/// deadlines take no processing at all.
 class CRcvUList
 {
 public:
+    static const int TICK_US = 1000; // Time resolution of the deadlines
+
     CRcvUList();
     ~CRcvUList();
 
 public:
-    /// Insert a new UDT instance to the list.
+    /// Insert a new UDT instance to the list. Its timers are due immediately.
     /// @param [in] u pointer to the UDT instance
 
     void insert(const CUDT* u);
@@ -247,16 +289,48 @@ public:
 
     void remove(const CUDT* u);
 
-    /// Move the UDT instance to the end of the list, if it already exists; otherwise, do nothing.
+    /// Reschedule the UDT instance to the new deadline, if it already exists; otherwise, do nothing.
     /// @param [in] u pointer to the UDT instance
+    /// @param [in] deadline time when the timers of the instance are due
 
-    void update(const CUDT* u);
+    void update(const CUDT* u, const sync::steady_clock::time_point& deadline);
 
-public:
-    CRNode* m_pUList; // the head node
+    /// Get a UDT instance whose deadline has passed. The instance stays on the
+    /// list, so it must be updated or removed before getting the next one.
+    /// @param [in] now current time
+    /// @return the node of the instance, or NULL if none is due
+
+    CRNode* expired(const sync::steady_clock::time_point& now);
+
+    /// Get the time before which no instance is due, although there may be
+    /// still none due at this time, when the nodes are moved between the levels.
+    /// @return the time, or zero if the list is empty
+
+    sync::steady_clock::time_point nextDue() const;
 
 private:
-    CRNode* m_pLast; // the last node
+    enum
+    {
+        LEVELS      = 3,
+        LEVEL0_BITS = 8, // 256 ms
+        LEVELN_BITS = 6, // 16 s, 17 min
+        LEVEL0_SIZE = 1 << LEVEL0_BITS,
+        LEVELN_SIZE = 1 << LEVELN_BITS,
+        DUE_SLOT    = LEVEL0_SIZE + (LEVELS - 1) * LEVELN_SIZE, // Nodes whose deadline has passed
+        SLOTS       = DUE_SLOT + 1
+    };
+
+    static int levelOf(int slot);
+    void       place(CRNode* n);
+    void       link(CRNode* n, int slot);
+    void       unlink(CRNode* n);
+    void       cascade(int level);
+    void       advance(const sync::steady_clock::time_point& now);
+
+    sync::steady_clock::time_point m_tsEpoch;         // Time of tick 0
+    uint64_t                       m_iCurrTick;       // The first tick not yet expired
+    CRNode*                        m_pSlots[SLOTS];   // Lists of nodes, by deadline
+    int                            m_aiCount[LEVELS + 1]; // Number of nodes in every level and in DUE_SLOT
 
 private:
     CRcvUList(const CRcvUList&);
@@ -343,6 +417,9 @@ public:
     /// @param pktIn packet received from the UDP socket.
     void updateConnStatus(EReadStatus rst, EConnectStatus cst, CUnit* unit);
 
+    /// @brief Check if there are no sockets pending for connection.
+    bool empty() const;
+
 private:
     struct LinkStatusInfo
     {
@@ -410,7 +487,9 @@ public:
     /// Initialize the sending queue.
     /// @param [in] c UDP channel to be associated to the queue
     /// @param [in] t Timer
-    void init(CChannel* c, sync::CTimer* t);
+    /// @param [in] payload maximum payload size of a packet
+    /// @param [in] cryptoworkers number of threads encrypting the packets ahead of sending (SRTO_CRYPTOWORKERS)
+    void init(CChannel* c, sync::CTimer* t, size_t payload, int cryptoworkers);
 
     /// Send out a packet to a given address. The @a src parameter is
     /// blindly passed by the caller down the call with intention to
@@ -440,10 +519,63 @@ public:
 
     void setClosing() { m_bClosing = true; }
 
+    bool hasCryptoWorkers() const { return !m_vCryptoWorkers.empty(); }
+
+    /// Let a crypto worker encrypt the packets scheduled for sending
+    /// by the socket, unless it is already waiting for it.
+    /// @param [in] u socket with new packets in the sender buffer
+    void postEncryption(CUDT* u);
+
+    /// Remove the socket from its crypto worker, waiting until
+    /// the worker has finished encrypting its packets, if it does.
+    /// @param [in] u socket being closed
+    void cancelEncryption(CUDT* u);
+
+    /// Get the statistics of sending packets by the worker thread.
+    /// @param [out] w_calls number of system send calls
+    /// @param [out] w_packets number of packets sent
+    /// @param [out] w_maxbatch maximum number of packets submitted to the channel at once
+    void getSendStats(int64_t& w_calls, int64_t& w_packets, int& w_maxbatch) const;
+
+    /// Get the histogram of the lateness of the worker thread waking
+    /// up from the sleep until the sending time (see SRTO_PACINGMODE).
+    /// @param [out] w_hist number of sleeps in each lateness range
+    void getPacingStats(int64_t (&w_hist)[SRT_PACING_HIST_SIZE]) const;
+
+    /// Get the statistics of the worker thread (see srt_muxstats).
+    /// @param [out] w_stats the fields of the sender worker are filled
+    void getWorkerStats(SRT_MUXSTATS& w_stats) const;
+
 private:
     static void*  worker(void* param);
     sync::CThread m_WorkerThread;
 
+    void worker_AddToBatch(const sockaddr_any& addr, CPacket& pkt, const sockaddr_any& src);
+    void worker_FlushBatch();
+    void worker_CountSent(int ncalls, int npackets);
+    void worker_CountLateness(const sync::steady_clock::duration& late);
+
+    // Encryption ahead of sending (SRTO_CRYPTOWORKERS > 0). A socket that
+    // has scheduled new packets is posted to the crypto worker selected by
+    // its socket ID, which encrypts these packets in the sender buffer, so
+    // the sending worker only has to send them. The encryption of a single
+    // socket is never done by two workers at once, as it must follow the
+    // packet order and HaiCrypt contexts aren't thread-safe.
+    struct CryptoWorker
+    {
+        CSndQueue*        queue;
+        sync::CThread     thread;
+        sync::Mutex       lock;
+        sync::Condition   cond;     // Signalled when a socket is posted
+        sync::Condition   doneCond; // Signalled when a socket has been processed
+        std::deque<CUDT*> sockets;  // Flagged with CUDT::m_bEncryptPosted
+        CUDT*             current;  // Socket being processed, if any
+    };
+    static void*               cryptoWorker(void* param);
+    void                       cryptoWorker_Run(CryptoWorker& w);
+    CryptoWorker&              cryptoWorkerOf(int32_t id) { return *m_vCryptoWorkers[id % m_vCryptoWorkers.size()]; }
+    std::vector<CryptoWorker*> m_vCryptoWorkers;
+
 private:
     CSndUList*    m_pSndUList; // List of UDT instances for data sending
     CChannel*     m_pChannel;  // The UDP channel for data sending
@@ -451,22 +583,25 @@ private:
 
     sync::atomic<bool> m_bClosing;            // closing the worker
 
-public:
-#if defined(SRT_DEBUG_SNDQ_HIGHRATE) //>>debug high freq worker
-    sync::steady_clock::duration m_DbgPeriod;
-    mutable sync::steady_clock::time_point m_DbgTime;
-    struct
-    {
-        unsigned long lIteration;   //
-        unsigned long lSleepTo;     // SleepTo
-        unsigned long lNotReadyPop; // Continue
-        unsigned long lSendTo;
-        unsigned long lNotReadyTs;
-        unsigned long lCondWait; // block on m_WindowCond
-    } mutable m_WorkerStats;
-#endif /* SRT_DEBUG_SNDQ_HIGHRATE */
+    // Batched sending (SRTO_UDP_SNDBATCH > 1). Packets due in the current
+    // scheduling round, from all sockets of the multiplexer, are copied here
+    // and sent together when the batch is full or the worker is about to wait.
+    std::vector<CPacket*>     m_vBatchPackets;
+    std::vector<sockaddr_any> m_vBatchAddrs;
+    std::vector<sockaddr_any> m_vBatchSrcs;
+    std::vector<char>         m_BatchBuffer;  // Payload storage for m_vBatchPackets
+    size_t                    m_szBatchPayload; // Payload capacity of a single batch entry
+    int                       m_iBatchCount;  // Number of packets collected
+
+    // Written by the worker thread only.
+    sync::atomic<int64_t> m_llSendCalls;   // Number of system send calls
+    sync::atomic<int64_t> m_llSentPackets; // Number of packets sent
+    sync::atomic<int>     m_iSendBatchMax; // Maximum number of packets submitted at once
+    sync::atomic<int64_t> m_llPacingLate[SRT_PACING_HIST_SIZE]; // Sleeps by wake-up lateness
+    sync::atomic<int64_t> m_llIterations;  // Number of the worker loop iterations
+    sync::atomic<int64_t> m_llWakeups;     // Number of wake-ups from waiting for a socket or sleeping until sending time
+    sync::atomic<int64_t> m_llPackTime;    // Time spent in CUDT::packData, in steady_clock ticks
 
-private:
 
 #if ENABLE_LOGGING
     static srt::sync::atomic<int> m_counter;
@@ -497,9 +632,11 @@ public:
     /// @param [in] mss maximum packet size
     /// @param [in] version IP version
     /// @param [in] hsize hash table size
+    /// @param [in] workers number of threads processing the received packets (SRTO_RCVWORKERS)
+    /// @param [in] acceptworkers number of threads processing the conclusion handshakes (SRTO_ACCEPTWORKERS)
     /// @param [in] c UDP channel to be associated to the queue
     /// @param [in] t timer
-    void init(int size, size_t payload, int version, int hsize, CChannel* c, sync::CTimer* t);
+    void init(int size, size_t payload, int version, int hsize, int workers, int acceptworkers, CChannel* c, sync::CTimer* t);
 
     /// Read a packet for a specific UDT socket id.
     /// @param [in] id Socket ID
@@ -509,18 +646,45 @@ public:
 
     void stopWorker();
 
-    void setClosing() { m_bClosing = true; }
+    void setClosing();
 
     int getIPversion() { return m_iIPversion; }
 
+    /// Get the unit queue for the receiver buffer of a socket.
+    /// @param [in] id Socket ID
+    /// @return The unit queue of the thread that processes the packets for this socket.
+    CUnitQueue* unitQueueOf(int32_t id)
+    {
+        return m_vProcessors.empty() ? m_pUnitQueue : processorOf(id).units;
+    }
+
+    /// Get the statistics of reading packets from the UDP channel.
+    /// @param [out] w_calls number of system receive calls that retrieved at least one packet
+    /// @param [out] w_packets number of packets retrieved from the channel
+    /// @param [out] w_maxbatch maximum number of packets retrieved by a single call
+    /// @param [out] w_syscalls number of all system calls made for reception (including waiting)
+    void getRecvStats(int64_t& w_calls, int64_t& w_packets, int& w_maxbatch, int64_t& w_syscalls) const;
+
+    /// Get the statistics of the worker thread and the processors (see srt_muxstats).
+    /// @param [out] w_stats the fields of the receiver worker are filled
+    void getWorkerStats(SRT_MUXSTATS& w_stats) const;
+
 private:
     static void*  worker(void* param);
     sync::CThread m_WorkerThread;
     // Subroutines of worker
     EReadStatus    worker_RetrieveUnit(int32_t& id, CUnit*& unit, sockaddr_any& sa);
+    EReadStatus    worker_RetrieveBatchedUnit(int32_t& id, CUnit*& unit, sockaddr_any& sa);
+    EReadStatus    worker_ReadBatch();
+    void           worker_CountReceived(int npackets);
+    sync::steady_clock::duration worker_ReadTimeout() const;
     EConnectStatus worker_ProcessConnectionRequest(CUnit* unit, const sockaddr_any& sa);
     EConnectStatus worker_TryAsyncRend_OrStore(int32_t id, CUnit* unit, const sockaddr_any& sa);
     EConnectStatus worker_ProcessAddressedPacket(int32_t id, CUnit* unit, const sockaddr_any& sa);
+    EConnectStatus worker_ProcessConnectedPacket(CUDT* u, CUnit* unit, const sockaddr_any& sa, CRcvUList& ulist);
+    void           worker_CheckTimers(CRcvUList& ulist);
+    void           worker_AddEntry(CUDT* u);
+    CUDT*          worker_LookupEntry(int32_t id);
 
 private:
     CUnitQueue*   m_pUnitQueue; // The received packet queue
@@ -537,6 +701,86 @@ private:
     static srt::sync::atomic<int> m_counter; // A static counter to log RcvQueue worker thread number.
 #endif
 
+    // Batched reception (SRTO_UDP_RCVBATCH > 1). The units filled by the last
+    // call to CChannel::recvmany are dispatched one by one by the worker before
+    // the channel is read again. Units waiting for dispatch are kept reserved.
+    std::vector<CUnit*>       m_vBatchUnits;
+    std::vector<CPacket*>     m_vBatchPackets;
+    std::vector<sockaddr_any> m_vBatchAddrs;
+    std::vector<EReadStatus>  m_vBatchStatus;
+    int                       m_iBatchPos;   // Position of the next unit to dispatch
+    int                       m_iBatchCount; // Number of units filled by the last call
+
+    // Packet processing threads (SRTO_RCVWORKERS > 1). The worker thread
+    // only reads the channel and handles the connection requests; packets
+    // addressed to a connected socket are passed to the processor selected
+    // by the socket ID, so every socket is always handled by the same thread.
+    // A processor maintains the timers of its sockets in its own list, and
+    // it has its own unit queue for their receiver buffers (and filters): the
+    // posted packets are copied there so that the worker can reuse its units.
+    struct Processor
+    {
+        struct Packet
+        {
+            int32_t      id;
+            CUnit*       unit; // Reserved until processed
+            sockaddr_any addr;
+        };
+
+        CRcvQueue*         queue;
+        CUnitQueue*        units;
+        sync::CThread      thread;
+        CRcvUList          ulist;
+        sync::Mutex        lock;
+        sync::Condition    cond;
+        std::vector<CUDT*> newEntries; // Added to ulist before the packets are processed
+        std::deque<Packet> packets;
+        std::deque<Packet> processing; // Used by the processor thread only
+        bool               waiting;    // The thread is waiting for cond
+    };
+    static void*            processor(void* param);
+    void                    processor_Run(Processor& p);
+    void                    processor_Post(int32_t id, CUnit* unit, const sockaddr_any& sa);
+    Processor&              processorOf(int32_t id) { return *m_vProcessors[id % m_vProcessors.size()]; }
+    std::vector<Processor*> m_vProcessors;
+    sync::Mutex             m_HashLock; // Protects m_pHash when the processors are used
+
+    // Connection request threads (SRTO_ACCEPTWORKERS > 0). The worker thread
+    // responds to the induction requests itself, but the conclusion handshakes
+    // for the listener are copied and passed to the acceptor selected by the
+    // caller's socket ID, which does the rest of the processing (including the
+    // key material and creating the accepted socket). The repeated conclusions
+    // of one caller are then always handled in order by the same thread.
+    struct Acceptor
+    {
+        struct Request
+        {
+            CPacket*     packet;
+            sockaddr_any addr;
+        };
+
+        CRcvQueue*          queue;
+        sync::CThread       thread;
+        sync::Mutex         lock;
+        sync::Condition     cond;
+        std::deque<Request> requests;
+    };
+    static const size_t    MAX_ACCEPT_REQUESTS = 1024; // Per acceptor; the callers repeat the dropped ones
+    static void*           acceptor(void* param);
+    void                   acceptor_Run(Acceptor& a);
+    void                   acceptor_Post(int32_t peerid, const CPacket& pkt, const sockaddr_any& sa);
+    std::vector<Acceptor*> m_vAcceptors;
+
+    // Written by the worker thread only.
+    sync::atomic<int64_t> m_llRecvCalls;   // Number of system receive calls that retrieved packets
+    sync::atomic<int64_t> m_llRecvPackets; // Number of packets retrieved from the channel
+    sync::atomic<int>     m_iRecvBatchMax; // Maximum number of packets retrieved by a single call
+    sync::atomic<int64_t> m_llIterations;  // Number of the worker loop iterations
+
+    // Written by the worker thread and the processors.
+    sync::atomic<int64_t> m_llProcessTime; // Time spent in processing the packets of connected sockets, in steady_clock ticks
+    sync::atomic<int64_t> m_llTimersTime;  // Time spent in CUDT::checkTimers, in steady_clock ticks
+
 private:
     int  setListener(CUDT* u);
     void removeListener(const CUDT* u);
@@ -173,6 +173,97 @@ struct CSrtConfigSetter<SRTO_UDP_RCVBUF>
         co.iUDPRcvBufSize = std::max(co.iMSS, cast_optval<int>(optval, optlen));
     }
 };
+
+template<>
+struct CSrtConfigSetter<SRTO_UDP_RCVBATCH>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 1 || val > CSrtMuxerConfig::MAX_UDP_RCV_BATCH)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iUDPRcvBatch = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_UDP_SNDBATCH>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 1 || val > CSrtMuxerConfig::MAX_UDP_SND_BATCH)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iUDPSndBatch = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_RCVWORKERS>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 1 || val > CSrtMuxerConfig::MAX_RCV_WORKERS)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iRcvWorkers = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_CRYPTOWORKERS>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 0 || val > CSrtMuxerConfig::MAX_CRYPTO_WORKERS)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iCryptoWorkers = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_ACCEPTWORKERS>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 0 || val > CSrtMuxerConfig::MAX_ACCEPT_WORKERS)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iAcceptWorkers = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_PACINGMODE>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < SRT_PACING_WAIT || val > SRT_PACING_SPIN)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iPacingMode = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_PACINGSPIN>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 0 || val > CSrtMuxerConfig::MAX_PACING_SPIN)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iPacingSpin = val;
+    }
+};
 template<>
 struct CSrtConfigSetter<SRTO_RENDEZVOUS>
 {
@@ -889,6 +980,32 @@ struct CSrtConfigSetter<SRTO_RETRANSMITALGO>
     }
 };
 
+template<>
+struct CSrtConfigSetter<SRTO_PACINGTRAIN>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 1 || val > CSrtConfig::MAX_PACING_TRAIN)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iPacingTrain = val;
+    }
+};
+
+template<>
+struct CSrtConfigSetter<SRTO_INDUCTIONRATE>
+{
+    static void set(CSrtConfig& co, const void* optval, int optlen)
+    {
+        const int val = cast_optval<int>(optval, optlen);
+        if (val < 0 || val > CSrtConfig::MAX_INDUCTION_RATE)
+            throw CUDTException(MJ_NOTSUP, MN_INVAL, 0);
+
+        co.iInductionRate = val;
+    }
+};
+
 #ifdef ENABLE_AEAD_API_PREVIEW
 template<>
 struct CSrtConfigSetter<SRTO_CRYPTOMODE>
@@ -936,6 +1053,13 @@ int dispatchSet(SRT_SOCKOPT optName, CSrtConfig& co, const void* optval, int opt
         DISPATCH(SRTO_LINGER);
         DISPATCH(SRTO_UDP_SNDBUF);
         DISPATCH(SRTO_UDP_RCVBUF);
+        DISPATCH(SRTO_UDP_RCVBATCH);
+        DISPATCH(SRTO_UDP_SNDBATCH);
+        DISPATCH(SRTO_RCVWORKERS);
+        DISPATCH(SRTO_CRYPTOWORKERS);
+        DISPATCH(SRTO_ACCEPTWORKERS);
+        DISPATCH(SRTO_PACINGMODE);
+        DISPATCH(SRTO_PACINGSPIN);
         DISPATCH(SRTO_RENDEZVOUS);
         DISPATCH(SRTO_SNDTIMEO);
         DISPATCH(SRTO_RCVTIMEO);
@@ -979,6 +1103,8 @@ int dispatchSet(SRT_SOCKOPT optName, CSrtConfig& co, const void* optval, int opt
         DISPATCH(SRTO_IPV6ONLY);
         DISPATCH(SRTO_PACKETFILTER);
         DISPATCH(SRTO_RETRANSMITALGO);
+        DISPATCH(SRTO_PACINGTRAIN);
+        DISPATCH(SRTO_INDUCTIONRATE);
 #ifdef ENABLE_AEAD_API_PREVIEW
         DISPATCH(SRTO_CRYPTOMODE);
 #endif
@@ -1078,6 +1204,13 @@ bool SRT_SocketOptionObject::add(SRT_SOCKOPT optname, const void* optval, size_t
     case SRTO_SNDDROPDELAY:
         //SRTO_TLPKTDROP - per transmission setting
         //SRTO_TSBPDMODE - per transmission setting
+    case SRTO_UDP_RCVBATCH:
+    case SRTO_UDP_SNDBATCH:
+    case SRTO_RCVWORKERS:
+    case SRTO_CRYPTOWORKERS:
+    case SRTO_ACCEPTWORKERS:
+    case SRTO_PACINGMODE:
+    case SRTO_PACINGSPIN:
     case SRTO_UDP_RCVBUF:
     case SRTO_UDP_SNDBUF:
         break;
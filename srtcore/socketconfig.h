@@ -81,6 +81,19 @@ namespace srt
 struct CSrtMuxerConfig
 {
     static const int DEF_UDP_BUFFER_SIZE = 65536;
+    static const int DEF_UDP_RCV_BATCH = 1;  // One packet per system call (no batching)
+    static const int MAX_UDP_RCV_BATCH = 64;
+    static const int DEF_UDP_SND_BATCH = 1;  // One packet per system call (no batching)
+    static const int MAX_UDP_SND_BATCH = 64;
+    static const int DEF_RCV_WORKERS = 1;    // Packets processed by the reading thread itself
+    static const int MAX_RCV_WORKERS = 16;
+    static const int DEF_CRYPTO_WORKERS = 0; // Packets encrypted by the sending thread itself
+    static const int MAX_CRYPTO_WORKERS = 16;
+    static const int DEF_ACCEPT_WORKERS = 0; // Connection requests processed by the reading thread itself
+    static const int MAX_ACCEPT_WORKERS = 16;
+    static const int DEF_PACING_MODE = SRT_PACING_WAIT;
+    static const int DEF_PACING_SPIN = 1000; // us
+    static const int MAX_PACING_SPIN = 100000;
 
     int  iIpTTL;
     int  iIpToS;
@@ -92,6 +105,13 @@ struct CSrtMuxerConfig
 #endif
     int iUDPSndBufSize; // UDP sending buffer size
     int iUDPRcvBufSize; // UDP receiving buffer size
+    int iUDPRcvBatch;   // Maximum number of UDP packets retrieved by a single system call
+    int iUDPSndBatch;   // Maximum number of UDP packets sent by a single system call
+    int iRcvWorkers;    // Number of threads processing the received packets
+    int iCryptoWorkers; // Number of threads encrypting the packets ahead of sending
+    int iAcceptWorkers; // Number of threads processing the conclusion handshakes for the listener
+    int iPacingMode;    // How the sender waits for the sending time (SRT_PACING_MODE)
+    int iPacingSpin;    // Time in us to spin for before the sending time in SRT_PACING_HYBRID mode
 
     // NOTE: this operator is not reversable. The syntax must use:
     //  muxer_entry == socket_entry
@@ -106,6 +126,13 @@ struct CSrtMuxerConfig
 #endif
             && CEQUAL(iUDPSndBufSize)
             && CEQUAL(iUDPRcvBufSize)
+            && CEQUAL(iUDPRcvBatch)
+            && CEQUAL(iUDPSndBatch)
+            && CEQUAL(iRcvWorkers)
+            && CEQUAL(iCryptoWorkers)
+            && CEQUAL(iAcceptWorkers)
+            && CEQUAL(iPacingMode)
+            && CEQUAL(iPacingSpin)
             && (other.iIpV6Only == -1 || CEQUAL(iIpV6Only))
             // NOTE: iIpV6Only is not regarded because
             // this matches only in case of IPv6 with "any" address.
@@ -123,6 +150,13 @@ struct CSrtMuxerConfig
         , bReuseAddr(true) // This is default in SRT
         , iUDPSndBufSize(DEF_UDP_BUFFER_SIZE)
         , iUDPRcvBufSize(DEF_UDP_BUFFER_SIZE)
+        , iUDPRcvBatch(DEF_UDP_RCV_BATCH)
+        , iUDPSndBatch(DEF_UDP_SND_BATCH)
+        , iRcvWorkers(DEF_RCV_WORKERS)
+        , iCryptoWorkers(DEF_CRYPTO_WORKERS)
+        , iAcceptWorkers(DEF_ACCEPT_WORKERS)
+        , iPacingMode(DEF_PACING_MODE)
+        , iPacingSpin(DEF_PACING_SPIN)
     {
     }
 };
@@ -217,6 +251,9 @@ struct CSrtConfig: CSrtMuxerConfig
     static const size_t MAX_SID_LENGTH     = 512;
     static const size_t MAX_PFILTER_LENGTH = 64;
     static const size_t MAX_CONG_LENGTH    = 16;
+    static const int    DEF_PACING_TRAIN   = 1; // A packet per wake-up (no trains)
+    static const int    MAX_PACING_TRAIN   = 64;
+    static const int    MAX_INDUCTION_RATE = 1000000;
 
     int    iMSS;            // Maximum Segment Size, in bytes
     size_t zExpPayloadSize; // Expected average payload size (user option)
@@ -261,6 +298,8 @@ struct CSrtConfig: CSrtMuxerConfig
     uint32_t uMinStabilityTimeout_ms;
     int      iRetransmitAlgo;
     int      iCryptoMode; // SRTO_CRYPTOMODE
+    int      iPacingTrain; // Maximum number of packets sent per wake-up of the sender
+    int      iInductionRate; // Maximum number of induction responses sent by the listener per second, 0 if unlimited
 
     int64_t llInputBW;         // Input stream rate (bytes/sec). 0: use internally estimated input bandwidth
     int64_t llMinInputBW;      // Minimum input stream rate estimate (bytes/sec)
@@ -316,6 +355,8 @@ struct CSrtConfig: CSrtMuxerConfig
         , uMinStabilityTimeout_ms(COMM_DEF_MIN_STABILITY_TIMEOUT_MS)
         , iRetransmitAlgo(1)
         , iCryptoMode(CIPHER_MODE_AUTO)
+        , iPacingTrain(DEF_PACING_TRAIN)
+        , iInductionRate(0)
         , llInputBW(0)
         , llMinInputBW(0)
         , iOverheadBW(SRT_OHEAD_DEFAULT_P100)
@@ -233,6 +233,15 @@ typedef enum SRT_SOCKOPT {
 #ifdef ENABLE_MAXREXMITBW
    SRTO_MAXREXMITBW = 63,    // Maximum bandwidth limit for retransmision (Bytes/s)
 #endif
+   SRTO_UDP_RCVBATCH = 64,   // Maximum number of UDP packets the multiplexer retrieves in one system call
+   SRTO_UDP_SNDBATCH,        // Maximum number of UDP packets the multiplexer sends in one system call
+   SRTO_RCVWORKERS,          // Number of threads the multiplexer uses to process the received packets
+   SRTO_CRYPTOWORKERS,       // Number of threads the multiplexer uses to encrypt the packets ahead of sending
+   SRTO_PACINGMODE,          // How the multiplexer's sender waits for the time to send the next packet (SRT_PACING_MODE)
+   SRTO_PACINGSPIN,          // Time in microseconds before the sending time to spin for in SRT_PACING_HYBRID mode
+   SRTO_PACINGTRAIN,         // Maximum number of packets sent back to back when the sender wakes up for the socket
+   SRTO_INDUCTIONRATE,       // Maximum number of induction responses the listener sends per second (0: unlimited)
+   SRTO_ACCEPTWORKERS,       // Number of threads the multiplexer uses to process the conclusion handshakes for the listener
 
    SRTO_E_SIZE // Always last element, not a valid option.
 } SRT_SOCKOPT;
@@ -282,6 +291,15 @@ typedef enum SRT_TRANSTYPE
     SRTT_INVALID
 } SRT_TRANSTYPE;
 
+// Values of SRTO_PACINGMODE
+typedef enum SRT_PACING_MODE
+{
+    SRT_PACING_WAIT,    // Condition variable wait (default)
+    SRT_PACING_TIMERFD, // Wait on a timerfd (Linux), elsewhere as SRT_PACING_WAIT
+    SRT_PACING_HYBRID,  // Wait until SRTO_PACINGSPIN before the sending time, then spin
+    SRT_PACING_SPIN     // Spin all the time (one CPU core fully used by the sender)
+} SRT_PACING_MODE;
+
 // These sizes should be used for Live mode. In Live mode you should not
 // exceed the size that fits in a single MTU.
 
@@ -296,6 +314,9 @@ static const int SRT_LIVE_MAX_PLSIZE = 1456; // MTU(1500) - UDP.hdr(28) - SRT.hd
 static const int SRT_LIVE_DEF_LATENCY_MS = 120;
 
 // Importrant note: please add new fields to this structure to the end and don't remove any existing fields 
+// Number of the wake-up lateness ranges in CBytePerfMon::muxPacingLateHist
+#define SRT_PACING_HIST_SIZE 8
+
 struct CBytePerfMon
 {
    // global measurements
@@ -401,6 +422,18 @@ struct CBytePerfMon
    int64_t  pktRecvUnique;              // number of packets to be received by the application
    uint64_t byteSentUnique;             // number of data bytes, sent by the application
    uint64_t byteRecvUnique;             // number of data bytes to be received by the application
+
+   // New stats in 1.5.4
+
+   // Multiplexer (shared by all sockets bound to the same UDP socket)
+   int64_t  pktMuxRecvTotal;            // total number of packets retrieved from the UDP socket
+   int64_t  muxRecvCallsTotal;          // total number of system receive calls that retrieved at least one packet
+   int      pktMuxRecvBatchMax;         // maximum number of packets retrieved by a single receive call
+   int64_t  pktMuxSentTotal;            // total number of data packets sent by the sender worker
+   int64_t  muxSendCallsTotal;          // total number of system send calls made by the sender worker
+   int      pktMuxSendBatchMax;         // maximum number of packets submitted to the UDP socket at once
+   int64_t  muxRecvSyscallsTotal;       // total number of system calls made for reception, including waiting
+   int64_t  muxPacingLateHist[SRT_PACING_HIST_SIZE]; // number of sender sleeps by wake-up lateness: <1, <5, <10, <50, <100, <500, <1000 us, more
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -737,6 +770,35 @@ inline SRT_EPOLL_OPT operator|(SRT_EPOLL_OPT a1, SRT_EPOLL_OPT a2)
 
 typedef struct CBytePerfMon SRT_TRACEBSTATS;
 
+// Statistics of the worker threads of a multiplexer (the UDP socket shared
+// by the SRT sockets bound to it), see srt_muxstats. The counters are totals
+// since the multiplexer was created, the others are the current state.
+typedef struct SRT_MuxStats
+{
+   int      muxID;                      // ID of the multiplexer
+   int      muxPort;                    // local UDP port of the multiplexer
+
+   // Sender worker
+   int64_t  sndIterations;              // number of the worker loop iterations
+   int64_t  sndWakeups;                 // number of wake-ups after waiting for a socket or sleeping until sending time
+   int64_t  pktSent;                    // number of packets sent
+   int64_t  sndCalls;                   // number of system send calls
+   int      pktSendBatchMax;            // maximum number of packets submitted to the UDP socket at once
+   int64_t  usPackData;                 // time spent in preparing the packets to send [us]
+   int      sndListLength;              // number of sockets currently scheduled for sending
+
+   // Receiver worker (and the processors, see SRTO_RCVWORKERS)
+   int64_t  rcvIterations;              // number of the worker loop iterations
+   int64_t  pktRecv;                    // number of packets retrieved from the UDP socket
+   int64_t  rcvCalls;                   // number of system receive calls that retrieved at least one packet
+   int64_t  rcvSyscalls;                // number of system calls made for reception, including waiting
+   int      pktRecvBatchMax;            // maximum number of packets retrieved by a single receive call
+   int64_t  usProcessData;              // time spent in processing the packets of the connected sockets [us]
+   int64_t  usCheckTimers;              // time spent in checking the timers of the connected sockets [us]
+   int      rcvUnitsFree;               // number of free units for the received packets
+   int      rcvUnitsTotal;              // number of all units for the received packets
+} SRT_MUXSTATS;
+
 static const SRTSOCKET SRT_INVALID_SOCK = -1;
 static const int SRT_ERROR = -1;
 
@@ -744,6 +806,11 @@ static const int SRT_ERROR = -1;
 SRT_API       int srt_startup(void);
 SRT_API       int srt_cleanup(void);
 
+// Number of threads shared by all sockets to deliver the received packets
+// at their time (TSBPD). 0 (default): every receiving socket runs its own thread.
+// Applies to the threads started at the next first use after srt_startup().
+SRT_API       int srt_set_tsbpd_threads(int nthreads);
+
 //
 // Socket operations
 //
@@ -835,6 +902,14 @@ SRT_API int srt_send    (SRTSOCKET u, const char* buf, int len);
 SRT_API int srt_sendmsg (SRTSOCKET u, const char* buf, int len, int ttl/* = -1*/, int inorder/* = false*/);
 SRT_API int srt_sendmsg2(SRTSOCKET u, const char* buf, int len, SRT_MSGCTRL *mctrl);
 
+// Zero-copy sending: instead of copying the payload from a user buffer,
+// the "fill" callback is called for every packet of the message to write
+// "size" bytes of the payload, starting at "offset" in the message,
+// directly into the sender buffer at "block". It should return 0, or
+// a negative value to cancel sending of the whole message.
+typedef int srt_send_fill_fn(void* opaque, char* block, int offset, int size);
+SRT_API int srt_sendmsg_fill(SRTSOCKET u, int len, srt_send_fill_fn* fill, void* opaque, SRT_MSGCTRL *mctrl);
+
 //
 // Receiving functions
 //
@@ -844,6 +919,13 @@ SRT_API int srt_recv    (SRTSOCKET u, char* buf, int len);
 SRT_API int srt_recvmsg (SRTSOCKET u, char* buf, int len);
 SRT_API int srt_recvmsg2(SRTSOCKET u, char *buf, int len, SRT_MSGCTRL *mctrl);
 
+// Zero-copy receiving: instead of copying the next message into a user
+// buffer, the "view" callback is called for every packet of the message
+// with its payload of "size" bytes, placed at "offset" in the message.
+// The payload stays valid only until the callback returns.
+typedef void srt_recv_view_fn(void* opaque, const char* data, int offset, int size);
+SRT_API int srt_recvmsg_view(SRTSOCKET u, srt_recv_view_fn* view, void* opaque, SRT_MSGCTRL *mctrl);
+
 
 // Special send/receive functions for files only.
 #define SRT_DEFAULT_SENDFILE_BLOCK 364000
@@ -851,6 +933,11 @@ SRT_API int srt_recvmsg2(SRTSOCKET u, char *buf, int len, SRT_MSGCTRL *mctrl);
 SRT_API int64_t srt_sendfile(SRTSOCKET u, const char* path, int64_t* offset, int64_t size, int block);
 SRT_API int64_t srt_recvfile(SRTSOCKET u, const char* path, int64_t* offset, int64_t size, int block);
 
+// The same with the file given by a descriptor, read with pread() and written
+// with pwritev() at *offset, without changing the file position. Not supported on Windows.
+SRT_API int64_t srt_sendfile_fd(SRTSOCKET u, int fd, int64_t* offset, int64_t size, int block);
+SRT_API int64_t srt_recvfile_fd(SRTSOCKET u, int fd, int64_t* offset, int64_t size, int block);
+
 
 // last error detection
 SRT_API const char* srt_getlasterror_str(void);
@@ -863,6 +950,8 @@ SRT_API       void  srt_clearlasterror(void);
 SRT_API int srt_bstats(SRTSOCKET u, SRT_TRACEBSTATS * perf, int clear);
 // Performance monitor with Byte counters and instantaneous stats instead of moving averages for Snd/Rcvbuffer sizes.
 SRT_API int srt_bistats(SRTSOCKET u, SRT_TRACEBSTATS * perf, int clear, int instantaneous);
+// Statistics of the worker threads of the multiplexer that the socket is bound to.
+SRT_API int srt_muxstats(SRTSOCKET u, SRT_MUXSTATS * stats);
 
 // Socket Status (for problem tracking)
 SRT_API SRT_SOCKSTATUS srt_getsockstate(SRTSOCKET u);
@@ -903,6 +992,7 @@ SRT_API void srt_resetlogfa(const int* fara, size_t fara_size);
 // SRT_API void srt_setlogstream(std::ostream& stream);
 SRT_API void srt_setloghandler(void* opaque, SRT_LOG_HANDLER_FN* handler);
 SRT_API void srt_setlogflags(int flags);
+SRT_API int64_t srt_getlogdropped(void);
 
 
 SRT_API int srt_getsndbuffer(SRTSOCKET sock, size_t* blocks, size_t* bytes);
@@ -31,6 +31,7 @@ extern "C" {
 
 int srt_startup() { return CUDT::startup(); }
 int srt_cleanup() { return CUDT::cleanup(); }
+int srt_set_tsbpd_threads(int nthreads) { return CUDT::setTsbPdThreads(nthreads); }
 
 // Socket creation.
 SRTSOCKET srt_socket(int , int , int ) { return CUDT::socket(); }
@@ -205,6 +206,24 @@ int64_t srt_recvfile(SRTSOCKET u, const char* path, int64_t* offset, int64_t siz
     return ret;
 }
 
+int64_t srt_sendfile_fd(SRTSOCKET u, int fd, int64_t* offset, int64_t size, int block)
+{
+    if (fd < 0 || !offset)
+    {
+        return CUDT::APIError(MJ_NOTSUP, MN_INVAL, 0);
+    }
+    return CUDT::sendfile(u, fd, *offset, size, block);
+}
+
+int64_t srt_recvfile_fd(SRTSOCKET u, int fd, int64_t* offset, int64_t size, int block)
+{
+    if (fd < 0 || !offset)
+    {
+        return CUDT::APIError(MJ_NOTSUP, MN_INVAL, 0);
+    }
+    return CUDT::recvfile(u, fd, *offset, size, block);
+}
+
 extern const SRT_MSGCTRL srt_msgctrl_default = {
     0,     // no flags set
     SRT_MSGTTL_INF,
@@ -231,6 +250,16 @@ int srt_sendmsg2(SRTSOCKET u, const char * buf, int len, SRT_MSGCTRL *mctrl)
     return CUDT::sendmsg2(u, buf, len, (mignore));
 }
 
+int srt_sendmsg_fill(SRTSOCKET u, int len, srt_send_fill_fn* fill, void* opaque, SRT_MSGCTRL *mctrl)
+{
+    if (!fill)
+        return CUDT::APIError(MJ_NOTSUP, MN_INVAL, 0);
+    if (mctrl)
+        return CUDT::sendmsgFill(u, len, fill, opaque, (*mctrl));
+    SRT_MSGCTRL mignore = srt_msgctrl_default;
+    return CUDT::sendmsgFill(u, len, fill, opaque, (mignore));
+}
+
 int srt_recvmsg2(SRTSOCKET u, char * buf, int len, SRT_MSGCTRL *mctrl)
 {
     if (mctrl)
@@ -239,6 +268,16 @@ int srt_recvmsg2(SRTSOCKET u, char * buf, int len, SRT_MSGCTRL *mctrl)
     return CUDT::recvmsg2(u, buf, len, (mignore));
 }
 
+int srt_recvmsg_view(SRTSOCKET u, srt_recv_view_fn* view, void* opaque, SRT_MSGCTRL *mctrl)
+{
+    if (!view)
+        return CUDT::APIError(MJ_NOTSUP, MN_INVAL, 0);
+    if (mctrl)
+        return CUDT::recvmsgView(u, view, opaque, (*mctrl));
+    SRT_MSGCTRL mignore = srt_msgctrl_default;
+    return CUDT::recvmsgView(u, view, opaque, (mignore));
+}
+
 const char* srt_getlasterror_str() { return UDT::getlasterror().getErrorMessage(); }
 
 int srt_getlasterror(int* loc_errno)
@@ -263,6 +302,7 @@ void srt_clearlasterror()
 
 int srt_bstats(SRTSOCKET u, SRT_TRACEBSTATS * perf, int clear) { return CUDT::bstats(u, perf, 0!=  clear); }
 int srt_bistats(SRTSOCKET u, SRT_TRACEBSTATS * perf, int clear, int instantaneous) { return CUDT::bstats(u, perf, 0!=  clear, 0!= instantaneous); }
+int srt_muxstats(SRTSOCKET u, SRT_MUXSTATS * stats) { return CUDT::muxstats(u, stats); }
 
 SRT_SOCKSTATUS srt_getsockstate(SRTSOCKET u) { return SRT_SOCKSTATUS((int)CUDT::getsockstate(u)); }
 
@@ -370,6 +410,11 @@ void srt_setlogflags(int flags)
     UDT::setlogflags(flags);
 }
 
+int64_t srt_getlogdropped()
+{
+    return UDT::getlogdropped();
+}
+
 int srt_getsndbuffer(SRTSOCKET sock, size_t* blocks, size_t* bytes)
 {
     return CUDT::getsndbuffer(sock, blocks, bytes);
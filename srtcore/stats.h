@@ -13,6 +13,7 @@
 
 #include "platform_sys.h"
 #include "packet.h"
+#include "atomic.h"
 
 namespace srt
 {
@@ -42,6 +43,12 @@ public:
         return m_count;
     }
 
+    // The counts wrap around, so the difference is correct also after the wrap.
+    Packets operator- (const Packets& other) const
+    {
+        return Packets(m_count - other.m_count);
+    }
+
 private:
     uint32_t m_count;
 };
@@ -94,12 +101,57 @@ public:
         return m_bytes + m_packets * hdr_size;
     }
 
+    BytesPackets operator- (const BytesPackets& other) const
+    {
+        return BytesPackets(m_bytes - other.m_bytes, m_packets - other.m_packets);
+    }
+
 protected:
     uint64_t m_bytes;
     uint32_t m_packets;
 };
 
 
+/// The value of Packets or BytesPackets counted atomically.
+template <class METRIC_TYPE>
+class AtomicValue;
+
+template <>
+class AtomicValue<Packets>
+{
+public:
+    void count(const Packets& val) { m_count.fetch_add(val.count()); }
+    Packets load() const { return Packets(m_count.load()); }
+    void reset() { m_count = 0; }
+
+private:
+    sync::atomic<uint32_t> m_count;
+};
+
+template <>
+class AtomicValue<BytesPackets>
+{
+public:
+    void count(const BytesPackets& val)
+    {
+        m_packets.fetch_add(val.count());
+        m_bytes.fetch_add(val.bytes());
+    }
+
+    // The bytes may be a packet ahead of the packets when read while counting.
+    BytesPackets load() const { return BytesPackets(m_bytes.load(), m_packets.load()); }
+
+    void reset()
+    {
+        m_bytes   = 0;
+        m_packets = 0;
+    }
+
+private:
+    sync::atomic<uint64_t> m_bytes;
+    sync::atomic<uint32_t> m_packets;
+};
+
 template <class METRIC_TYPE, class BASE_METRIC_TYPE = METRIC_TYPE>
 struct Metric
 {
@@ -130,19 +182,74 @@ struct Metric
     }
 };
 
+/// The metric counted by the threads handling the connection without a lock,
+/// and read at any time by the statistics calls. Only the total value is
+/// counted. The trace value is the difference from the total remembered
+/// at the last trace reset, so the reset doesn't race with the counting.
+template <class METRIC_TYPE>
+class SharedMetric
+{
+public:
+    void count(const METRIC_TYPE& val)
+    {
+        m_total.count(val);
+    }
+
+    METRIC_TYPE total() const
+    {
+        return m_total.load();
+    }
+
+    /// Get the trace and total values, optionally starting a new trace period.
+    /// Must not be called by multiple threads at a time.
+    Metric<METRIC_TYPE> sample(bool reset_trace)
+    {
+        Metric<METRIC_TYPE> m;
+        m.total = m_total.load();
+        m.trace = m.total - m_traceBase;
+        if (reset_trace)
+            m_traceBase = m.total;
+        return m;
+    }
+
+    /// Must not be called while counting.
+    void reset()
+    {
+        m_total.reset();
+        m_traceBase.reset();
+    }
+
+private:
+    AtomicValue<METRIC_TYPE> m_total;
+    METRIC_TYPE              m_traceBase; // Total value at the last trace reset
+};
+
 /// Sender-side statistics.
 struct Sender
 {
-    Metric<BytesPackets> sent;
-    Metric<BytesPackets> sentUnique;
-    Metric<BytesPackets> sentRetrans; // The number of data packets retransmitted by the sender.
-    Metric<Packets> lost; // The number of packets reported lost (including repeated reports) to the sender in NAKs.
-    Metric<BytesPackets> dropped; // The number of data packets dropped by the sender.
+    SharedMetric<BytesPackets> sent;
+    SharedMetric<BytesPackets> sentUnique;
+    SharedMetric<BytesPackets> sentRetrans; // The number of data packets retransmitted by the sender.
+    SharedMetric<Packets> lost; // The number of packets reported lost (including repeated reports) to the sender in NAKs.
+    SharedMetric<BytesPackets> dropped; // The number of data packets dropped by the sender.
 
-    Metric<Packets> sentFilterExtra; // The number of packets generate by the packet filter and sent by the sender.
+    SharedMetric<Packets> sentFilterExtra; // The number of packets generate by the packet filter and sent by the sender.
     
-    Metric<Packets> recvdAck; // The number of ACK packets received by the sender.
-    Metric<Packets> recvdNak; // The number of ACK packets received by the sender.
+    SharedMetric<Packets> recvdAck; // The number of ACK packets received by the sender.
+    SharedMetric<Packets> recvdNak; // The number of ACK packets received by the sender.
+
+    /// The values of the sender statistics at one time.
+    struct Sample
+    {
+        Metric<BytesPackets> sent;
+        Metric<BytesPackets> sentUnique;
+        Metric<BytesPackets> sentRetrans;
+        Metric<Packets> lost;
+        Metric<BytesPackets> dropped;
+        Metric<Packets> sentFilterExtra;
+        Metric<Packets> recvdAck;
+        Metric<Packets> recvdNak;
+    };
 
     void reset()
     {
@@ -156,36 +263,53 @@ struct Sender
         sentFilterExtra.reset();
     }
 
-    void resetTrace()
+    void sample(Sample& w_sample, bool reset_trace)
     {
-        sent.resetTrace();
-        sentUnique.resetTrace();
-        sentRetrans.resetTrace();
-        lost.resetTrace();
-        dropped.resetTrace();
-        recvdAck.resetTrace();
-        recvdNak.resetTrace();
-        sentFilterExtra.resetTrace();
+        w_sample.sent            = sent.sample(reset_trace);
+        w_sample.sentUnique      = sentUnique.sample(reset_trace);
+        w_sample.sentRetrans     = sentRetrans.sample(reset_trace);
+        w_sample.lost            = lost.sample(reset_trace);
+        w_sample.dropped         = dropped.sample(reset_trace);
+        w_sample.recvdAck        = recvdAck.sample(reset_trace);
+        w_sample.recvdNak        = recvdNak.sample(reset_trace);
+        w_sample.sentFilterExtra = sentFilterExtra.sample(reset_trace);
     }
 };
 
 /// Receiver-side statistics.
 struct Receiver
 {
-    Metric<BytesPackets> recvd;
-    Metric<BytesPackets> recvdUnique;
-    Metric<BytesPackets> recvdRetrans; // The number of retransmitted data packets received by the receiver.
-    Metric<BytesPackets> lost; // The number of packets detected by the receiver as lost.
-    Metric<BytesPackets> dropped; // The number of packets dropped by the receiver (as too-late to be delivered).
-    Metric<BytesPackets> recvdBelated; // The number of belated packets received (dropped as too late but eventually received).
-    Metric<BytesPackets> undecrypted; // The number of packets received by the receiver that failed to be decrypted.
-
-    Metric<Packets> recvdFilterExtra; // The number of filter packets (e.g. FEC) received by the receiver.
-    Metric<Packets> suppliedByFilter; // The number of lost packets got from the packet filter at the receiver side (e.g. loss recovered by FEC).
-    Metric<Packets> lossFilter; // The number of lost DATA packets not recovered by the packet filter at the receiver side.
-
-    Metric<Packets> sentAck; // The number of ACK packets sent by the receiver.
-    Metric<Packets> sentNak; // The number of NACK packets sent by the receiver.
+    SharedMetric<BytesPackets> recvd;
+    SharedMetric<BytesPackets> recvdUnique;
+    SharedMetric<BytesPackets> recvdRetrans; // The number of retransmitted data packets received by the receiver.
+    SharedMetric<BytesPackets> lost; // The number of packets detected by the receiver as lost.
+    SharedMetric<BytesPackets> dropped; // The number of packets dropped by the receiver (as too-late to be delivered).
+    SharedMetric<BytesPackets> recvdBelated; // The number of belated packets received (dropped as too late but eventually received).
+    SharedMetric<BytesPackets> undecrypted; // The number of packets received by the receiver that failed to be decrypted.
+
+    SharedMetric<Packets> recvdFilterExtra; // The number of filter packets (e.g. FEC) received by the receiver.
+    SharedMetric<Packets> suppliedByFilter; // The number of lost packets got from the packet filter at the receiver side (e.g. loss recovered by FEC).
+    SharedMetric<Packets> lossFilter; // The number of lost DATA packets not recovered by the packet filter at the receiver side.
+
+    SharedMetric<Packets> sentAck; // The number of ACK packets sent by the receiver.
+    SharedMetric<Packets> sentNak; // The number of NACK packets sent by the receiver.
+
+    /// The values of the receiver statistics at one time.
+    struct Sample
+    {
+        Metric<BytesPackets> recvd;
+        Metric<BytesPackets> recvdUnique;
+        Metric<BytesPackets> recvdRetrans;
+        Metric<BytesPackets> lost;
+        Metric<BytesPackets> dropped;
+        Metric<BytesPackets> recvdBelated;
+        Metric<BytesPackets> undecrypted;
+        Metric<Packets> recvdFilterExtra;
+        Metric<Packets> suppliedByFilter;
+        Metric<Packets> lossFilter;
+        Metric<Packets> sentAck;
+        Metric<Packets> sentNak;
+    };
 
     void reset()
     {
@@ -203,23 +327,27 @@ struct Receiver
         sentNak.reset();
     }
 
-    void resetTrace()
+    void sample(Sample& w_sample, bool reset_trace)
     {
-        recvd.resetTrace();
-        recvdUnique.resetTrace();
-        recvdRetrans.resetTrace();
-        lost.resetTrace();
-        dropped.resetTrace();
-        recvdBelated.resetTrace();
-        undecrypted.resetTrace();
-        recvdFilterExtra.resetTrace();
-        suppliedByFilter.resetTrace();
-        lossFilter.resetTrace();
-        sentAck.resetTrace();
-        sentNak.resetTrace();
+        w_sample.recvd            = recvd.sample(reset_trace);
+        w_sample.recvdUnique      = recvdUnique.sample(reset_trace);
+        w_sample.recvdRetrans     = recvdRetrans.sample(reset_trace);
+        w_sample.lost             = lost.sample(reset_trace);
+        w_sample.dropped          = dropped.sample(reset_trace);
+        w_sample.recvdBelated     = recvdBelated.sample(reset_trace);
+        w_sample.undecrypted      = undecrypted.sample(reset_trace);
+        w_sample.recvdFilterExtra = recvdFilterExtra.sample(reset_trace);
+        w_sample.suppliedByFilter = suppliedByFilter.sample(reset_trace);
+        w_sample.lossFilter       = lossFilter.sample(reset_trace);
+        w_sample.sentAck          = sentAck.sample(reset_trace);
+        w_sample.sentNak          = sentNak.sample(reset_trace);
     }
 };
 
+// The statistics counted by different threads are kept this far apart
+// in memory, so that they don't share a cache line.
+const size_t CACHE_LINE_SIZE = 64;
+
 } // namespace stats
 } // namespace srt
 
@@ -18,6 +18,12 @@
 #include "logging.h"
 #include "common.h"
 
+#ifdef __linux__
+#include <sys/timerfd.h>
+#include <unistd.h>
+#define SRT_TIMER_HAVE_TIMERFD 1
+#endif
+
 // HAVE_CXX11 is defined in utilities.h, included with common.h. 
 // The following conditional inclusion must go after common.h.
 #if HAVE_CXX11 
@@ -182,12 +188,52 @@ srt::sync::CEvent g_Sync;
 ////////////////////////////////////////////////////////////////////////////////
 
 srt::sync::CTimer::CTimer()
+    : m_ePacing(PACING_WAIT)
+    , m_iTimerFd(-1)
 {
+#if USE_BUSY_WAITING
+#if defined(_WIN32)
+    // 10 ms on Windows: bad accuracy of timers
+    m_tdSpinThreshold = milliseconds_from(10);
+#else
+    // 1 ms on non-Windows platforms
+    m_tdSpinThreshold = milliseconds_from(1);
+#endif
+#endif // USE_BUSY_WAITING
 }
 
 
 srt::sync::CTimer::~CTimer()
 {
+#ifdef SRT_TIMER_HAVE_TIMERFD
+    if (m_iTimerFd != -1)
+        ::close(m_iTimerFd);
+#endif
+}
+
+
+void srt::sync::CTimer::setPacing(EPacing mode, int spin_us)
+{
+    m_ePacing = mode;
+    if (mode == PACING_HYBRID)
+        m_tdSpinThreshold = microseconds_from(spin_us);
+    else if (mode != PACING_WAIT)
+        m_tdSpinThreshold = steady_clock::duration();
+
+    if (mode != PACING_TIMERFD)
+        return;
+
+#ifdef SRT_TIMER_HAVE_TIMERFD
+    m_iTimerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (m_iTimerFd == -1)
+    {
+        LOGC(inlog.Warn, log << "CTimer: timerfd_create failed, errno=" << errno << ", using the condition wait");
+        m_ePacing = PACING_WAIT;
+    }
+#else
+    LOGC(inlog.Warn, log << "CTimer: timerfd not supported on this platform, using the condition wait");
+    m_ePacing = PACING_WAIT;
+#endif
 }
 
 
@@ -199,37 +245,24 @@ bool srt::sync::CTimer::sleep_until(TimePoint<steady_clock> tp)
     m_tsSchedTime = tp;
     leaveCS(m_event.mutex());
 
-#if USE_BUSY_WAITING
-#if defined(_WIN32)
-    // 10 ms on Windows: bad accuracy of timers
-    const steady_clock::duration
-        td_threshold = milliseconds_from(10);
-#else
-    // 1 ms on non-Windows platforms
-    const steady_clock::duration
-        td_threshold = milliseconds_from(1);
-#endif
-#endif // USE_BUSY_WAITING
-
     TimePoint<steady_clock> cur_tp = steady_clock::now();
-    
-    while (cur_tp < m_tsSchedTime)
+
+    // Sleep until the spin threshold before the scheduled time...
+    while (m_ePacing != PACING_SPIN && cur_tp < m_tsSchedTime)
     {
-#if USE_BUSY_WAITING
-        steady_clock::duration td_wait = m_tsSchedTime - cur_tp;
-        if (td_wait <= 2 * td_threshold)
+        const steady_clock::time_point until = m_tsSchedTime - m_tdSpinThreshold;
+        if (until <= cur_tp)
             break;
 
-        td_wait -= td_threshold;
-        m_event.lock_wait_for(td_wait);
-#else
-        m_event.lock_wait_until(m_tsSchedTime);
-#endif // USE_BUSY_WAITING
+        if (m_iTimerFd != -1)
+            waitTimerFd(tp, until);
+        else
+            m_event.lock_wait_until(until);
 
         cur_tp = steady_clock::now();
     }
 
-#if USE_BUSY_WAITING
+    // ... then spin until the scheduled time.
     while (cur_tp < m_tsSchedTime)
     {
 #ifdef IA32
@@ -248,9 +281,38 @@ bool srt::sync::CTimer::sleep_until(TimePoint<steady_clock> tp)
 
         cur_tp = steady_clock::now();
     }
-#endif // USE_BUSY_WAITING
 
-    return cur_tp >= m_tsSchedTime;
+    // interrupt() moves the scheduled time to its call time.
+    return m_tsSchedTime == tp;
+}
+
+
+void srt::sync::CTimer::waitTimerFd(const steady_clock::time_point& tp, const steady_clock::time_point& until)
+{
+#ifdef SRT_TIMER_HAVE_TIMERFD
+    {
+        // Arming under the lock, so that the timer is either armed
+        // before interrupt() re-arms it, or interrupt() has already
+        // changed the scheduled time.
+        ScopedLock lck(m_event.mutex());
+        if (m_tsSchedTime != tp)
+            return;
+
+        const int64_t   ns = std::max<int64_t>(count_microseconds(until - steady_clock::now()) * 1000, 1);
+        itimerspec spec;
+        memset(&spec, 0, sizeof spec);
+        spec.it_value.tv_sec  = time_t(ns / 1000000000);
+        spec.it_value.tv_nsec = long(ns % 1000000000);
+        ::timerfd_settime(m_iTimerFd, 0, &spec, NULL);
+    }
+
+    // Interrupted by a signal or re-armed: the caller checks the time again.
+    uint64_t expirations;
+    const ssize_t rd SRT_ATR_UNUSED = ::read(m_iTimerFd, &expirations, sizeof expirations);
+#else
+    (void)tp;
+    m_event.lock_wait_until(until);
+#endif
 }
 
 
@@ -259,6 +321,17 @@ void srt::sync::CTimer::interrupt()
     UniqueLock lck(m_event.mutex());
     m_tsSchedTime = steady_clock::now();
     m_event.notify_all();
+
+#ifdef SRT_TIMER_HAVE_TIMERFD
+    if (m_iTimerFd != -1)
+    {
+        // Expire as soon as possible.
+        itimerspec spec;
+        memset(&spec, 0, sizeof spec);
+        spec.it_value.tv_nsec = 1;
+        ::timerfd_settime(m_iTimerFd, 0, &spec, NULL);
+    }
+#endif
 }
 
 
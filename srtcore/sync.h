@@ -826,7 +826,22 @@ public:
     CTimer();
     ~CTimer();
 
+    /// The way of waiting for the scheduled time (SRTO_PACINGMODE).
+    enum EPacing
+    {
+        PACING_WAIT    = 0, // Condition wait (spin for the last 1 ms if built with USE_BUSY_WAITING)
+        PACING_TIMERFD = 1, // Wait on a timerfd where available, otherwise as PACING_WAIT
+        PACING_HYBRID  = 2, // Condition wait until the spin threshold before the time, then spin
+        PACING_SPIN    = 3  // Spin all the time
+    };
+
 public:
+    /// Selects the way of waiting. Must be called before
+    /// the timer is used by any thread.
+    /// @param mode the way of waiting
+    /// @param spin_us time before the scheduled time to start spinning in PACING_HYBRID mode
+    void setPacing(EPacing mode, int spin_us);
+
     /// Causes the current thread to block until
     /// the specified time is reached.
     /// Sleep can be interrupted by calling interrupt()
@@ -834,7 +849,7 @@ public:
     /// @param tp target time to sleep until
     ///
     /// @return true  if the specified time was reached
-    ///         false should never happen
+    ///         false if the sleep was interrupted
     bool sleep_until(steady_clock::time_point tp);
 
     /// Resets target wait time and interrupts waiting
@@ -847,8 +862,13 @@ public:
     void tick();
 
 private:
+    void waitTimerFd(const steady_clock::time_point& tp, const steady_clock::time_point& until);
+
     CEvent m_event;
     steady_clock::time_point m_tsSchedTime;
+    EPacing                  m_ePacing;
+    steady_clock::duration   m_tdSpinThreshold; // Time before m_tsSchedTime to spin for
+    int                      m_iTimerFd;        // -1 if not in PACING_TIMERFD mode
 };
 
 
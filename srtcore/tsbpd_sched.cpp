@@ -0,0 +1,245 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+#include "platform_sys.h"
+
+#include "tsbpd_sched.h"
+#include "core.h"
+#include "threadname.h"
+#include "logging.h"
+#include "logger_defs.h"
+
+using namespace std;
+using namespace srt::sync;
+using namespace srt_logging;
+
+namespace srt
+{
+
+CTsbPdScheduler::CTsbPdScheduler()
+    : m_iThreads(0)
+    , m_bClosing(false)
+{
+    setupMutex(m_StartLock, "TsbPdSchedStart");
+}
+
+CTsbPdScheduler::~CTsbPdScheduler()
+{
+    stop();
+    releaseMutex(m_StartLock);
+}
+
+bool CTsbPdScheduler::add(CUDT* u)
+{
+    {
+        ScopedLock lk(m_StartLock);
+        if (m_Workers.empty())
+        {
+            const int nthreads = m_iThreads;
+            if (nthreads <= 0)
+                return false;
+
+            m_bClosing = false;
+            m_Workers.resize(nthreads);
+            for (int i = 0; i < nthreads; ++i)
+            {
+                Worker* w           = new Worker;
+                w->sched            = this;
+                w->current          = NULL;
+                w->currentSignalled = false;
+                setupCond(w->cond, "TsbPdSched");
+                setupCond(w->doneCond, "TsbPdSchedDone");
+                m_Workers[i] = w;
+            }
+
+            for (int i = 0; i < nthreads; ++i)
+            {
+                const string thname = "SRT:TsbPd:s" + Sprint(i);
+                if (!StartThread(m_Workers[i]->thread, CTsbPdScheduler::worker, m_Workers[i], thname))
+                {
+                    LOGC(tslog.Error, log << "TSBPD scheduler: failed to start thread #" << i);
+                    m_bClosing = true;
+                    break;
+                }
+            }
+
+            if (m_bClosing)
+            {
+                for (int i = 0; i < nthreads; ++i)
+                {
+                    Worker* w = m_Workers[i];
+                    CSync::lock_notify_one(w->cond, w->lock);
+                    if (w->thread.joinable())
+                        w->thread.join();
+                    releaseCond(w->cond);
+                    releaseCond(w->doneCond);
+                    delete w;
+                }
+                m_Workers.clear();
+                return false;
+            }
+
+            HLOGC(tslog.Debug, log << "TSBPD scheduler: started " << nthreads << " threads");
+        }
+    }
+
+    Worker&    w = workerOf(u);
+    ScopedLock lk(w.lock);
+    Entry&     e = w.sockets[u];
+    e.wakeup     = time_point();
+    e.ready      = true;
+    w.ready.push_back(u);
+    w.cond.notify_one();
+    return true;
+}
+
+void CTsbPdScheduler::wakeup(CUDT* u)
+{
+    Worker&    w = workerOf(u);
+    ScopedLock lk(w.lock);
+
+    if (w.current == u)
+    {
+        // Check it again when the current check is done.
+        w.currentSignalled = true;
+        return;
+    }
+
+    map<CUDT*, Entry>::iterator i = w.sockets.find(u);
+    if (i == w.sockets.end() || i->second.ready)
+        return;
+
+    Entry& e = i->second;
+    if (!is_zero(e.wakeup))
+    {
+        w.timers.erase(make_pair(e.wakeup, u));
+        e.wakeup = time_point();
+    }
+    e.ready = true;
+    w.ready.push_back(u);
+    w.cond.notify_one();
+}
+
+void CTsbPdScheduler::remove(CUDT* u)
+{
+    Worker&    w = workerOf(u);
+    UniqueLock lk(w.lock);
+
+    while (w.current == u)
+        w.doneCond.wait(lk);
+
+    map<CUDT*, Entry>::iterator i = w.sockets.find(u);
+    if (i == w.sockets.end())
+        return;
+
+    const Entry& e = i->second;
+    if (e.ready)
+        w.ready.erase(find(w.ready.begin(), w.ready.end(), u));
+    else if (!is_zero(e.wakeup))
+        w.timers.erase(make_pair(e.wakeup, u));
+    w.sockets.erase(i);
+}
+
+void CTsbPdScheduler::stop()
+{
+    ScopedLock lk(m_StartLock);
+
+    m_bClosing = true;
+    for (size_t i = 0; i < m_Workers.size(); ++i)
+    {
+        Worker* w = m_Workers[i];
+        CSync::lock_notify_one(w->cond, w->lock);
+        if (w->thread.joinable())
+            w->thread.join();
+        releaseCond(w->cond);
+        releaseCond(w->doneCond);
+        delete w;
+    }
+    m_Workers.clear();
+}
+
+CTsbPdScheduler::Worker& CTsbPdScheduler::workerOf(CUDT* u)
+{
+    // The sockets are only added with the threads running,
+    // so m_Workers is not empty here.
+    return *m_Workers[u->socketID() % m_Workers.size()];
+}
+
+void* CTsbPdScheduler::worker(void* param)
+{
+    Worker* w = (Worker*)param;
+
+    std::string thname;
+    ThreadName::get(thname);
+    THREAD_STATE_INIT(thname.c_str());
+
+    w->sched->worker_Run(*w);
+
+    THREAD_EXIT();
+    return NULL;
+}
+
+void CTsbPdScheduler::worker_Run(Worker& w)
+{
+    UniqueLock lk(w.lock);
+    while (!m_bClosing)
+    {
+        CUDT* u = NULL;
+        if (!w.ready.empty())
+        {
+            u = w.ready.front();
+            w.ready.pop_front();
+            w.sockets[u].ready = false;
+        }
+        else if (!w.timers.empty() && w.timers.begin()->first <= steady_clock::now())
+        {
+            u = w.timers.begin()->second;
+            w.timers.erase(w.timers.begin());
+            w.sockets[u].wakeup = time_point();
+        }
+        else
+        {
+            THREAD_PAUSED();
+            if (w.timers.empty())
+                w.cond.wait(lk);
+            else
+                w.cond.wait_until(lk, w.timers.begin()->first);
+            THREAD_RESUMED();
+            continue;
+        }
+
+        INCREMENT_THREAD_ITERATIONS();
+        w.current          = u;
+        w.currentSignalled = false;
+
+        time_point next_delivery;
+        {
+            InvertedLock unlk(w.lock);
+            next_delivery = u->tsbpdCheckShared();
+        }
+
+        w.current = NULL;
+        w.doneCond.notify_all();
+
+        // The socket can't be removed while being checked.
+        Entry& e = w.sockets[u];
+        if (w.currentSignalled)
+        {
+            e.ready = true;
+            w.ready.push_back(u);
+        }
+        else if (!is_zero(next_delivery))
+        {
+            e.wakeup = next_delivery;
+            w.timers.insert(make_pair(next_delivery, u));
+        }
+    }
+}
+
+} // namespace srt
@@ -0,0 +1,106 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+#ifndef INC_SRT_TSBPD_SCHED_H
+#define INC_SRT_TSBPD_SCHED_H
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "sync.h"
+
+namespace srt
+{
+
+class CUDT;
+
+/// @brief Shared TSBPD delivery scheduler.
+///
+/// Instead of running a TSBPD thread per receiving socket, the sockets
+/// can be driven by a small pool of threads shared by all sockets in the
+/// application (see srt_set_tsbpd_threads()). Every socket is assigned to
+/// one thread by its socket ID. The thread keeps the sockets ordered by
+/// the delivery time of the first packet in their receiver buffers and
+/// calls CUDT::tsbpdCheck() for each socket when its time comes, or when
+/// the socket has been signalled, just like the TSBPD thread does when
+/// waiting on CUDT::m_RcvTsbPdCond.
+class CTsbPdScheduler
+{
+public:
+    static const int MAX_THREADS = 64;
+
+    CTsbPdScheduler();
+    ~CTsbPdScheduler();
+
+    /// Set the number of threads. It applies when the threads are started,
+    /// that is, by the first socket added after construction or stop().
+    /// @param n number of threads, 0 to use a TSBPD thread per socket
+    void setThreads(int n) { m_iThreads = n; }
+    int  threads() const { return m_iThreads; }
+
+    /// Start driving the TSBPD of the socket, starting the threads if needed.
+    /// The socket is checked immediately.
+    /// @return false if the socket should use its own TSBPD thread,
+    /// because no shared threads are configured or they can't be started.
+    bool add(CUDT* u);
+
+    /// Check the socket again as soon as possible. Ignored if the
+    /// socket is not added. The equivalent of signalling m_RcvTsbPdCond.
+    void wakeup(CUDT* u);
+
+    /// Stop driving the TSBPD of the socket, waiting until its
+    /// check is finished if it's currently being done.
+    void remove(CUDT* u);
+
+    /// Stop the threads. The sockets still added are forgotten.
+    void stop();
+
+private:
+    typedef sync::steady_clock::time_point time_point;
+
+    struct Entry
+    {
+        time_point wakeup; // Position in Worker::timers, zero if not there
+        bool       ready;  // In Worker::ready
+    };
+
+    struct Worker
+    {
+        CTsbPdScheduler*                     sched;
+        sync::CThread                        thread;
+        sync::Mutex                          lock;
+        sync::Condition                      cond;     // Signalled when a socket gets ready or earlier
+        sync::Condition                      doneCond; // Signalled when a socket has been checked
+        std::map<CUDT*, Entry>               sockets;  // All sockets assigned to this worker
+        std::deque<CUDT*>                    ready;    // Signalled sockets to check as soon as possible
+        std::set<std::pair<time_point, CUDT*> > timers; // Sockets to check at a given time
+        CUDT*                                current;  // Socket being checked, if any
+        bool                                 currentSignalled;
+    };
+
+    static void* worker(void* param);
+    void         worker_Run(Worker& w);
+    Worker&      workerOf(CUDT* u);
+
+    sync::atomic<int>     m_iThreads;
+    sync::atomic<bool>    m_bClosing;
+    sync::Mutex           m_StartLock; // Protects starting and stopping the threads
+    std::vector<Worker*>  m_Workers;   // Not changed while any socket is added
+
+private:
+    CTsbPdScheduler(const CTsbPdScheduler&);
+    CTsbPdScheduler& operator=(const CTsbPdScheduler&);
+};
+
+} // namespace srt
+
+#endif
@@ -240,6 +240,7 @@ SRT_API void resetlogfa(const int* fara, size_t fara_size);
 SRT_API void setlogstream(std::ostream& stream);
 SRT_API void setloghandler(void* opaque, SRT_LOG_HANDLER_FN* handler);
 SRT_API void setlogflags(int flags);
+SRT_API int64_t getlogdropped();
 
 SRT_API bool setstreamid(SRTSOCKET u, const std::string& sid);
 SRT_API std::string getstreamid(SRTSOCKET u);
@@ -264,6 +265,7 @@ namespace UDT
     using srt::setlogstream;
     using srt::setloghandler;
     using srt::setlogflags;
+    using srt::getlogdropped;
     using srt::setstreamid;
     using srt::getstreamid;
 }
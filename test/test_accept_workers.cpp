@@ -0,0 +1,171 @@
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "access_control.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// Processing the conclusion handshakes for the listener by the
+// accept workers of the multiplexer (SRTO_ACCEPTWORKERS).
+class TestAcceptWorkers : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+
+        const int workers = 4;
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_ACCEPTWORKERS, &workers, sizeof workers), SRT_SUCCESS);
+        m_addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+    }
+
+    void teardown() override
+    {
+        for (size_t i = 0; i < m_callers.size(); ++i)
+            srt_close(m_callers[i]);
+        for (size_t i = 0; i < m_accepted.size(); ++i)
+            srt_close(m_accepted[i]);
+        srt_close(m_listen_sock);
+    }
+
+    void listen(int backlog)
+    {
+        ASSERT_NE(srt_bind(m_listen_sock, m_addr.get(), m_addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, backlog), SRT_ERROR);
+    }
+
+    SRTSOCKET createCaller()
+    {
+        const SRTSOCKET caller = srt_create_socket();
+        EXPECT_NE(caller, SRT_INVALID_SOCK);
+        m_callers.push_back(caller);
+        return caller;
+    }
+
+    // Connect all callers at once, each from its own thread,
+    // all bound to the same local port.
+    void connectAll(int nconn)
+    {
+        const sockaddr_any local = srt::CreateAddr("127.0.0.1", 5300, AF_INET);
+        for (int i = 0; i < nconn; ++i)
+        {
+            const SRTSOCKET caller = createCaller();
+            ASSERT_NE(srt_bind(caller, local.get(), local.size()), SRT_ERROR) << srt_getlasterror_str();
+        }
+
+        atomic<int>    connected(0);
+        vector<thread> connectors;
+        for (int i = 0; i < nconn; ++i)
+        {
+            connectors.push_back(thread([&, i] {
+                if (srt_connect(m_callers[i], m_addr.get(), m_addr.size()) != SRT_ERROR)
+                    ++connected;
+            }));
+        }
+
+        for (int i = 0; i < nconn; ++i)
+        {
+            sockaddr_any    peer;
+            const SRTSOCKET accepted = srt_accept(m_listen_sock, peer.get(), &peer.len);
+            ASSERT_NE(accepted, SRT_INVALID_SOCK) << srt_getlasterror_str();
+            m_accepted.push_back(accepted);
+        }
+
+        for (size_t i = 0; i < connectors.size(); ++i)
+            connectors[i].join();
+        EXPECT_EQ(connected, nconn);
+    }
+
+    SRTSOCKET         m_listen_sock;
+    sockaddr_any      m_addr;
+    vector<SRTSOCKET> m_callers;
+    vector<SRTSOCKET> m_accepted;
+};
+
+// Every caller connected at once gets its own accepted socket
+// and the data sent by it arrive there.
+TEST_F(TestAcceptWorkers, ConcurrentCallers)
+{
+    const int NCONN = 50;
+    listen(NCONN);
+    connectAll(NCONN);
+
+    int value = 0, optlen = sizeof value;
+    ASSERT_EQ(srt_getsockflag(m_accepted[0], SRTO_ACCEPTWORKERS, &value, &optlen), SRT_SUCCESS);
+    EXPECT_EQ(value, 4);
+
+    // The message sent by each caller carries the ID of the caller's
+    // socket, which the accepted socket knows as the peer's ID.
+    for (int i = 0; i < NCONN; ++i)
+    {
+        const string msg = to_string(m_callers[i]);
+        ASSERT_EQ(srt_sendmsg(m_callers[i], msg.data(), (int)msg.size(), -1, true), (int)msg.size());
+    }
+
+    vector<SRTSOCKET> peers;
+    for (int i = 0; i < NCONN; ++i)
+    {
+        char      buf[1500];
+        const int len = srt_recvmsg(m_accepted[i], buf, sizeof buf);
+        ASSERT_GT(len, 0) << srt_getlasterror_str();
+        peers.push_back(stoi(string(buf, len)));
+    }
+
+    sort(peers.begin(), peers.end());
+    vector<SRTSOCKET> callers = m_callers;
+    sort(callers.begin(), callers.end());
+    EXPECT_EQ(peers, callers);
+}
+
+#ifdef SRT_ENABLE_ENCRYPTION
+// The key material sent with the conclusion is processed
+// by the accept worker as well.
+TEST_F(TestAcceptWorkers, Encrypted)
+{
+    const char* passphrase = "accept-workers-test";
+    const int   passlen    = (int)strlen(passphrase);
+    ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_PASSPHRASE, passphrase, passlen), SRT_SUCCESS);
+    listen(1);
+
+    const SRTSOCKET caller = createCaller();
+    ASSERT_EQ(srt_setsockflag(caller, SRTO_PASSPHRASE, passphrase, passlen), SRT_SUCCESS);
+    ASSERT_NE(srt_connect(caller, m_addr.get(), m_addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+    sockaddr_any    peer;
+    const SRTSOCKET accepted = srt_accept(m_listen_sock, peer.get(), &peer.len);
+    ASSERT_NE(accepted, SRT_INVALID_SOCK);
+    m_accepted.push_back(accepted);
+
+    int state = 0, optlen = sizeof state;
+    ASSERT_EQ(srt_getsockflag(accepted, SRTO_KMSTATE, &state, &optlen), SRT_SUCCESS);
+    EXPECT_EQ(state, SRT_KM_S_SECURED);
+}
+#endif
+
+static int RejectingCallback(void*, SRTSOCKET ns, int, const sockaddr*, const char*)
+{
+    srt_setrejectreason(ns, SRT_REJX_FORBIDDEN);
+    return -1;
+}
+
+// The rejection by the listener callback, called by the
+// accept worker, is reported to the caller.
+TEST_F(TestAcceptWorkers, CallbackRejection)
+{
+    ASSERT_NE(srt_listen_callback(m_listen_sock, &RejectingCallback, NULL), -1);
+    listen(1);
+
+    const SRTSOCKET caller = createCaller();
+    EXPECT_EQ(srt_connect(caller, m_addr.get(), m_addr.size()), SRT_ERROR);
+    EXPECT_EQ(srt_getrejectreason(caller), SRT_REJX_FORBIDDEN);
+}
@@ -1,4 +1,5 @@
 #include <array>
+#include <atomic>
 #include <future>
 #include <thread>
 #include <chrono>
@@ -638,6 +639,166 @@ TEST(Bonding, InitialFailure)
 }
 
 
+// The broadcast group sends each message over all the links, storing the
+// payload once for the links without encryption, and copying it for the
+// encrypted ones. The receiver group gets every message once, intact.
+TEST(Bonding, BroadcastSharedPayload)
+{
+    using namespace std;
+    using namespace srt;
+
+    TestInit srtinit;
+    const char* passphrases[] = {"", "broadcast-shared-payload"};
+    for (size_t p = 0; p < sizeof passphrases / sizeof passphrases[0]; ++p)
+    {
+        const string passphrase = passphrases[p];
+        MAKE_UNIQUE_SOCK(lsn, "Listener", srt_create_socket());
+        MAKE_UNIQUE_SOCK(grp, "GrpCaller", srt_create_group(SRT_GTYPE_BROADCAST));
+
+        int allow = 1, latency = 20;
+        ASSERT_NE(srt_setsockflag(lsn, SRTO_GROUPCONNECT, &allow, sizeof allow), SRT_ERROR);
+        ASSERT_NE(srt_setsockflag(lsn, SRTO_LATENCY, &latency, sizeof latency), SRT_ERROR);
+        ASSERT_NE(srt_setsockflag(grp, SRTO_LATENCY, &latency, sizeof latency), SRT_ERROR);
+        if (!passphrase.empty())
+        {
+            ASSERT_NE(srt_setsockflag(lsn, SRTO_PASSPHRASE, passphrase.c_str(), (int)passphrase.size()), SRT_ERROR);
+            ASSERT_NE(srt_setsockflag(grp, SRTO_PASSPHRASE, passphrase.c_str(), (int)passphrase.size()), SRT_ERROR);
+        }
+
+        sockaddr_any sa = srt::CreateAddr("127.0.0.1", 5555, AF_INET);
+        ASSERT_NE(srt_bind(lsn, sa.get(), sa.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(lsn, 5), SRT_ERROR);
+
+        std::vector<SRT_SOCKGROUPCONFIG> targets;
+        for (int i = 0; i < 3; ++i)
+            targets.push_back(PrepareEndpoint("127.0.0.1", 5555));
+        ASSERT_NE(srt_connect_group(grp, targets.data(), (int)targets.size()), SRT_INVALID_SOCK);
+
+        sockaddr_any revsa;
+        const SRTSOCKET gs = srt_accept(lsn, revsa.get(), &revsa.len);
+        ASSERT_NE(gs, SRT_INVALID_SOCK);
+        const int timeout = 3000;
+        ASSERT_NE(srt_setsockflag(gs, SRTO_RCVTIMEO, &timeout, sizeof timeout), SRT_ERROR);
+
+        // Let all the links get connected on both sides.
+        for (int i = 0; i < 50; ++i)
+        {
+            int connected = 0;
+            const SRTSOCKET groups[] = {grp, gs};
+            for (size_t s = 0; s < 2; ++s)
+            {
+                SRT_SOCKGROUPDATA gdata[3];
+                size_t            gsize = 3;
+                if (srt_group_data(groups[s], gdata, &gsize) == 3)
+                {
+                    for (size_t g = 0; g < gsize; ++g)
+                        connected += gdata[g].sockstate == SRTS_CONNECTED;
+                }
+            }
+            if (connected == 6)
+                break;
+            this_thread::sleep_for(chrono::milliseconds(20));
+        }
+
+        // Every message is received before the next one is sent, as in a live stream.
+        for (int m = 0; m < 100; ++m)
+        {
+            const string msg = "MESSAGE " + to_string(m) + string(m % 1000, char('a' + m % 26));
+            ASSERT_EQ(srt_sendmsg2(grp, msg.data(), (int)msg.size(), NULL), (int)msg.size()) << srt_getlasterror_str();
+
+            char      outbuf[1500];
+            const int recvlen = srt_recvmsg2(gs, outbuf, sizeof outbuf, NULL);
+            ASSERT_GT(recvlen, 0) << "Message #" << m << ": " << srt_getlasterror_str();
+            EXPECT_EQ(string(outbuf, recvlen), msg);
+        }
+
+        srt_close(gs);
+    }
+}
+
+// Benchmark: 200 broadcast groups with 2 links each sending from their own
+// threads at once, while another thread keeps creating and closing sockets
+// (which needs the lock on the socket container).
+TEST(Bonding, DISABLED_BenchmarkConcurrentGroups)
+{
+    using namespace std;
+    using namespace srt;
+
+    const int NGROUPS = 200;
+    const int NMSGS   = 200;
+
+    TestInit srtinit;
+    MAKE_UNIQUE_SOCK(lsn, "Listener", srt_create_socket());
+    int allow = 1;
+    ASSERT_NE(srt_setsockflag(lsn, SRTO_GROUPCONNECT, &allow, sizeof allow), SRT_ERROR);
+    sockaddr_any sa = srt::CreateAddr("127.0.0.1", 5555, AF_INET);
+    ASSERT_NE(srt_bind(lsn, sa.get(), sa.size()), SRT_ERROR);
+    ASSERT_NE(srt_listen(lsn, NGROUPS), SRT_ERROR);
+
+    vector<SRTSOCKET> accepted;
+    thread            acceptor([&] {
+        for (int i = 0; i < NGROUPS; ++i)
+        {
+            sockaddr_any    revsa;
+            const SRTSOCKET gs = srt_accept(lsn, revsa.get(), &revsa.len);
+            if (gs == SRT_INVALID_SOCK)
+                break;
+            accepted.push_back(gs);
+        }
+    });
+
+    vector<SRTSOCKET> groups;
+    for (int i = 0; i < NGROUPS; ++i)
+    {
+        const SRTSOCKET grp = srt_create_group(SRT_GTYPE_BROADCAST);
+        ASSERT_NE(grp, SRT_INVALID_SOCK);
+        groups.push_back(grp);
+
+        SRT_SOCKGROUPCONFIG targets[2] = {PrepareEndpoint("127.0.0.1", 5555), PrepareEndpoint("127.0.0.1", 5555)};
+        ASSERT_NE(srt_connect_group(grp, targets, 2), SRT_INVALID_SOCK) << srt_getlasterror_str();
+    }
+    acceptor.join();
+    ASSERT_EQ(accepted.size(), size_t(NGROUPS));
+
+    atomic<bool> done(false);
+    atomic<int>  churned(0);
+    thread       churn([&] {
+        while (!done)
+        {
+            srt_close(srt_create_socket());
+            ++churned;
+        }
+    });
+
+    atomic<int>    sent(0);
+    vector<thread> senders;
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < NGROUPS; ++i)
+    {
+        senders.push_back(thread([&, i] {
+            char buf[1316] = {};
+            for (int m = 0; m < NMSGS; ++m)
+            {
+                if (srt_sendmsg2(groups[i], buf, sizeof buf, NULL) == int(sizeof buf))
+                    ++sent;
+            }
+        }));
+    }
+    for (size_t i = 0; i < senders.size(); ++i)
+        senders[i].join();
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    done = true;
+    churn.join();
+
+    cerr << NGROUPS << " groups sent " << sent << " messages in " << seconds << " s ("
+         << int64_t(sent / seconds) << "/s), " << churned << " sockets created and closed meanwhile\n";
+
+    for (size_t i = 0; i < groups.size(); ++i)
+        srt_close(groups[i]);
+    for (size_t i = 0; i < accepted.size(); ++i)
+        srt_close(accepted[i]);
+}
+
 
 // General idea:
 // This should try to connect to two nonexistent links,
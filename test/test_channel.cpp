@@ -0,0 +1,150 @@
+#include <future>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+#include "channel.h"
+
+using namespace std;
+using namespace srt;
+using namespace srt::sync;
+
+// Measures of the receiving side of CChannel: how many system calls are
+// spent per received packet and how quickly a waiting reader wakes up.
+// The measured values are reported; only the obviously wrong results fail.
+class TestChannel : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        sockaddr_any bind_addr(AF_INET);
+        bind_addr.hport(0);
+        inet_pton(AF_INET, "127.0.0.1", &bind_addr.sin.sin_addr);
+
+        m_rcv.open(bind_addr);
+        m_snd.open(bind_addr);
+        m_rcv.getSockAddr((m_rcv_addr));
+    }
+
+    void teardown() override
+    {
+        m_rcv.close();
+        m_snd.close();
+    }
+
+    void sendPacket(int32_t seqno)
+    {
+        CPacket pkt;
+        pkt.allocate(payload_size);
+        pkt.setLength(payload_size);
+        pkt.set_seqno(seqno);
+        ASSERT_EQ(m_snd.sendto(m_rcv_addr, (pkt), sockaddr_any()), int(CPacket::HDR_SIZE + payload_size));
+    }
+
+    EReadStatus receivePacket()
+    {
+        sockaddr_any addr(AF_INET);
+        CPacket      pkt;
+        pkt.allocate(payload_size);
+        return m_rcv.recvfrom((addr), (pkt));
+    }
+
+    static const size_t payload_size = 1316;
+
+    CChannel     m_rcv;
+    CChannel     m_snd;
+    sockaddr_any m_rcv_addr;
+};
+
+// A reader waiting with a long timeout must return early when interrupted.
+TEST_F(TestChannel, ReadInterrupt)
+{
+    if (!m_rcv.canInterruptRead())
+        GTEST_SKIP() << "Interrupting the read isn't supported on this platform";
+
+    m_rcv.setReadTimeout(seconds_from(5));
+
+    steady_clock::time_point woken;
+    auto reader = std::async(std::launch::async, [this, &woken]() {
+        const EReadStatus rst = receivePacket();
+        woken = steady_clock::now();
+        return rst;
+    });
+
+    srt::sync::this_thread::sleep_for(milliseconds_from(50));
+    const steady_clock::time_point interrupted = steady_clock::now();
+    m_rcv.interruptRead();
+
+    ASSERT_EQ(reader.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(reader.get(), RST_AGAIN);
+
+    const int64_t latency_us = count_microseconds(woken - interrupted);
+    cout << "[          ] Interrupt wake-up latency: " << latency_us << "us\n";
+    EXPECT_LT(latency_us, 1000000);
+}
+
+// Packets sent one by one to an idle reader: the wake-up latency is the time
+// from sending a packet until the reader returns it.
+TEST_F(TestChannel, WakeupLatency)
+{
+    m_rcv.setReadTimeout(seconds_from(1));
+
+    const int npackets = 100;
+    int64_t   sum_us = 0, max_us = 0;
+    for (int i = 0; i < npackets; ++i)
+    {
+        steady_clock::time_point received;
+        auto reader = std::async(std::launch::async, [this, &received]() {
+            EReadStatus rst;
+            do
+            {
+                rst = receivePacket();
+            } while (rst == RST_AGAIN);
+            received = steady_clock::now();
+            return rst;
+        });
+
+        // Give the reader time to enter the wait.
+        srt::sync::this_thread::sleep_for(milliseconds_from(2));
+        const steady_clock::time_point sent = steady_clock::now();
+        sendPacket(i);
+
+        ASSERT_EQ(reader.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        ASSERT_EQ(reader.get(), RST_OK);
+
+        const int64_t latency_us = count_microseconds(received - sent);
+        sum_us += latency_us;
+        max_us = std::max(max_us, latency_us);
+    }
+
+    cout << "[          ] Packet wake-up latency: avg " << (sum_us / npackets) << "us, max " << max_us << "us\n";
+}
+
+// A burst of packets read back to back: the number of system calls
+// per packet, including the waits.
+TEST_F(TestChannel, SyscallsPerPacket)
+{
+    m_rcv.setReadTimeout(seconds_from(1));
+
+    // Stay below the default UDP receiver buffer size.
+    const int npackets = 32;
+    for (int i = 0; i < npackets; ++i)
+        sendPacket(i);
+
+    const steady_clock::time_point deadline        = steady_clock::now() + seconds_from(5);
+    const int64_t                  syscalls_before = m_rcv.getRecvSyscalls();
+    int                            nreceived       = 0;
+    while (nreceived < npackets)
+    {
+        ASSERT_LT(steady_clock::now(), deadline) << "Received only " << nreceived << " packets";
+        const EReadStatus rst = receivePacket();
+        ASSERT_NE(rst, RST_ERROR);
+        if (rst == RST_OK)
+            ++nreceived;
+    }
+    const int64_t syscalls = m_rcv.getRecvSyscalls() - syscalls_before;
+
+    cout << "[          ] System calls per packet: " << (double(syscalls) / npackets) << "\n";
+    EXPECT_GE(syscalls, npackets);
+    EXPECT_LE(syscalls, 2 * npackets + 2);
+}
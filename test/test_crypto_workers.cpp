@@ -0,0 +1,145 @@
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+#ifdef SRT_ENABLE_ENCRYPTION
+
+// Encryption of the packets ahead of sending by the crypto
+// workers of the multiplexer (SRTO_CRYPTOWORKERS).
+class TestCryptoWorkers : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_caller_sock = srt_create_socket();
+        ASSERT_NE(m_caller_sock, SRT_INVALID_SOCK);
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+        m_accepted_sock = SRT_INVALID_SOCK;
+
+        const int   workers    = 2;
+        const char* passphrase = "crypto-workers-test";
+        const int   passlen    = (int)strlen(passphrase);
+        ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_CRYPTOWORKERS, &workers, sizeof workers), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_CRYPTOWORKERS, &workers, sizeof workers), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_PASSPHRASE, passphrase, passlen), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_PASSPHRASE, passphrase, passlen), SRT_SUCCESS);
+    }
+
+    void teardown() override
+    {
+        srt_close(m_caller_sock);
+        srt_close(m_accepted_sock);
+        srt_close(m_listen_sock);
+    }
+
+    void connect()
+    {
+        sockaddr_any addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, addr.get(), addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, 1), SRT_ERROR);
+        ASSERT_NE(srt_connect(m_caller_sock, addr.get(), addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+        sockaddr_any peer;
+        m_accepted_sock = srt_accept(m_listen_sock, peer.get(), &peer.len);
+        ASSERT_NE(m_accepted_sock, SRT_INVALID_SOCK);
+
+        int state = 0;
+        int optlen = sizeof state;
+        ASSERT_EQ(srt_getsockflag(m_accepted_sock, SRTO_KMSTATE, &state, &optlen), SRT_SUCCESS);
+        ASSERT_EQ(state, SRT_KM_S_SECURED);
+    }
+
+    static void fillPattern(vector<char>& w_buf, int msgindex)
+    {
+        for (size_t i = 0; i < w_buf.size(); ++i)
+            w_buf[i] = char(msgindex * 11 + i);
+    }
+
+    // Send the messages in the live mode and check that
+    // they are all received and decrypted correctly.
+    void sendAndVerifyLive(int nmsgs)
+    {
+        const int    len = 1316;
+        vector<char> buf(len);
+        for (int m = 0; m < nmsgs; ++m)
+        {
+            fillPattern((buf), m);
+            ASSERT_EQ(srt_sendmsg(m_caller_sock, &buf[0], len, -1, true), len) << srt_getlasterror_str();
+        }
+
+        vector<char> expected(len);
+        vector<char> rcvbuf(1500);
+        for (int m = 0; m < nmsgs; ++m)
+        {
+            ASSERT_EQ(srt_recvmsg(m_accepted_sock, &rcvbuf[0], (int)rcvbuf.size()), len) << "Message #" << m;
+            fillPattern((expected), m);
+            ASSERT_TRUE(equal(expected.begin(), expected.end(), rcvbuf.begin())) << "Message #" << m;
+        }
+    }
+
+    SRTSOCKET m_caller_sock;
+    SRTSOCKET m_listen_sock;
+    SRTSOCKET m_accepted_sock;
+};
+
+TEST_F(TestCryptoWorkers, LiveCTR)
+{
+    connect();
+    sendAndVerifyLive(200);
+}
+
+#ifdef ENABLE_AEAD_API_PREVIEW
+// AES-GCM authenticates the header with the timestamp,
+// which in the live mode is known before sending.
+TEST_F(TestCryptoWorkers, LiveGCM)
+{
+    const int gcm = 2;
+    if (srt_setsockflag(m_caller_sock, SRTO_CRYPTOMODE, &gcm, sizeof gcm) != SRT_SUCCESS)
+        GTEST_SKIP() << "AES-GCM not supported by the crypto library";
+    ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_CRYPTOMODE, &gcm, sizeof gcm), SRT_SUCCESS);
+
+    connect();
+    sendAndVerifyLive(200);
+}
+#endif
+
+// File/message mode: messages of many packets, scheduled
+// faster than they are sent.
+TEST_F(TestCryptoWorkers, FileMessage)
+{
+    const SRT_TRANSTYPE file = SRTT_FILE;
+    const bool          yes  = true;
+    ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_TRANSTYPE, &file, sizeof file), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_MESSAGEAPI, &yes, sizeof yes), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_TRANSTYPE, &file, sizeof file), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_MESSAGEAPI, &yes, sizeof yes), SRT_SUCCESS);
+    connect();
+
+    const int    len   = 100000;
+    const int    nmsgs = 20;
+    vector<char> buf(len);
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        fillPattern((buf), m);
+        ASSERT_EQ(srt_sendmsg(m_caller_sock, &buf[0], len, -1, true), len) << srt_getlasterror_str();
+    }
+
+    vector<char> expected(len);
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        ASSERT_EQ(srt_recvmsg(m_accepted_sock, &buf[0], len), len) << "Message #" << m;
+        fillPattern((expected), m);
+        ASSERT_TRUE(expected == buf) << "Message #" << m;
+    }
+}
+
+#endif // SRT_ENABLE_ENCRYPTION
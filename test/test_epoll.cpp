@@ -1,3 +1,4 @@
+#include <atomic>
 #include <iostream>
 #include <chrono>
 #include <future>
@@ -546,6 +547,139 @@ TEST(CEPoll, ThreadedUpdate)
 }
 
 
+// Many threads wait each on its own EID, and events are reported for
+// the sockets subscribed in one EID at a time. Only the thread waiting
+// for that EID should be woken up. Reports the wake-ups per event.
+TEST(CEPoll, WakeupsPerEvent)
+{
+    srt::TestInit srtinit;
+
+    const int nwaiters = 32;
+    const int nevents  = 200;
+
+    CEPoll epoll;
+    vector<int> eids;
+    for (int i = 0; i < nwaiters; ++i)
+    {
+        const int eid = epoll.create();
+        ASSERT_GE(eid, 0);
+        // The sockets are not used by CEPoll, so any ID will do.
+        const int events = SRT_EPOLL_IN | SRT_EPOLL_ET;
+        ASSERT_EQ(epoll.update_usock(eid, 1000 + i, &events), 0);
+        eids.push_back(eid);
+    }
+
+    std::atomic<int> delivered(0);
+    vector<thread> waiters;
+    for (int i = 0; i < nwaiters; ++i)
+    {
+        waiters.push_back(thread([&epoll, &delivered, &eids, i]() {
+            SRT_EPOLL_EVENT fds[1];
+            try
+            {
+                for (;;)
+                {
+                    if (epoll.uwait(eids[i], fds, 1, -1) == 1)
+                        ++delivered;
+                }
+            }
+            catch (CUDTException&)
+            {
+                // The EID has been released.
+            }
+        }));
+    }
+
+    // Let the threads enter the wait.
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    const int64_t wakeups_before = epoll.wakeups();
+    const auto    start          = chrono::steady_clock::now();
+    for (int n = 0; n < nevents; ++n)
+    {
+        set<int> target = { eids[n % nwaiters] };
+        const SRTSOCKET sock = 1000 + n % nwaiters;
+        epoll.update_events(sock, target, SRT_EPOLL_IN, false);
+        epoll.update_events(sock, target, SRT_EPOLL_IN, true);
+
+        const auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+        while (delivered < n + 1)
+        {
+            ASSERT_LT(chrono::steady_clock::now(), deadline) << "Event " << n << " not delivered";
+            this_thread::yield();
+        }
+    }
+    const auto    elapsed = chrono::steady_clock::now() - start;
+    const int64_t wakeups = epoll.wakeups() - wakeups_before;
+
+    cout << "[          ] " << nwaiters << " waiters, " << nevents << " events: "
+         << (double(wakeups) / nevents) << " wake-ups per event, "
+         << (chrono::duration_cast<chrono::microseconds>(elapsed).count() / nevents) << "us per event\n";
+
+    EXPECT_GE(wakeups, nevents);
+    // Only spurious wake-ups may come in addition to the one per event.
+    EXPECT_LT(wakeups, 2 * nevents);
+
+    for (size_t i = 0; i < eids.size(); ++i)
+        EXPECT_EQ(epoll.release(eids[i]), 0);
+
+    for (size_t i = 0; i < waiters.size(); ++i)
+        waiters[i].join();
+}
+
+
+// Several threads report events each for its own socket and EID, as the
+// queue workers do. Reports how often the updates contended for a lock.
+TEST(CEPoll, ParallelUpdates)
+{
+    srt::TestInit srtinit;
+
+    const int nthreads = 4;
+    const int nupdates = 20000;
+
+    CEPoll epoll;
+    vector<int> eids;
+    for (int i = 0; i < nthreads; ++i)
+    {
+        const int eid = epoll.create();
+        ASSERT_GE(eid, 0);
+        const int events = SRT_EPOLL_IN | SRT_EPOLL_OUT;
+        ASSERT_EQ(epoll.update_usock(eid, 1000 + i, &events), 0);
+        eids.push_back(eid);
+    }
+
+    int64_t updates_before, contended_before;
+    epoll.getLockStats((updates_before), (contended_before));
+
+    vector<thread> updaters;
+    for (int i = 0; i < nthreads; ++i)
+    {
+        updaters.push_back(thread([&epoll, &eids, i, nupdates]() {
+            set<int> target = { eids[i] };
+            for (int n = 0; n < nupdates; ++n)
+                epoll.update_events(1000 + i, target, SRT_EPOLL_IN, (n % 2) == 0);
+        }));
+    }
+
+    for (size_t i = 0; i < updaters.size(); ++i)
+        updaters[i].join();
+
+    int64_t updates, contended;
+    epoll.getLockStats((updates), (contended));
+    updates   -= updates_before;
+    contended -= contended_before;
+
+    cout << "[          ] " << nthreads << " threads, " << updates << " updates, "
+         << contended << " contended for the lock\n";
+
+    EXPECT_EQ(updates, int64_t(nthreads) * nupdates);
+    EXPECT_LE(contended, updates);
+
+    for (size_t i = 0; i < eids.size(); ++i)
+        EXPECT_EQ(epoll.release(eids[i]), 0);
+}
+
+
 class TestEPoll: public srt::Test
 {
 protected:
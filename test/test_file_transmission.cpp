@@ -210,3 +210,169 @@ TEST(Transmission, FileUpload)
     remove("file.target");
 
 }
+
+#ifndef _WIN32
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+    // Connects a pair of file transmission sockets over the loopback.
+    void ConnectFilePair(SRTSOCKET& w_caller, SRTSOCKET& w_accepted)
+    {
+        SRTSOCKET sock_lsn = srt_create_socket();
+        w_caller           = srt_create_socket();
+
+        const int tt = SRTT_FILE;
+        ASSERT_NE(srt_setsockflag(sock_lsn, SRTO_TRANSTYPE, &tt, sizeof tt), SRT_ERROR);
+        ASSERT_NE(srt_setsockflag(w_caller, SRTO_TRANSTYPE, &tt, sizeof tt), SRT_ERROR);
+
+        sockaddr_in sa = sockaddr_in();
+        sa.sin_family  = AF_INET;
+        sa.sin_port    = htons(5200);
+        ASSERT_EQ(inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr), 1);
+        ASSERT_NE(srt_bind(sock_lsn, (sockaddr*)&sa, sizeof sa), SRT_ERROR) << srt_getlasterror_str();
+        ASSERT_NE(srt_listen(sock_lsn, 1), SRT_ERROR);
+        ASSERT_NE(srt_connect(w_caller, (sockaddr*)&sa, sizeof sa), SRT_ERROR) << srt_getlasterror_str();
+
+        sockaddr_in remote;
+        int         len = sizeof remote;
+        w_accepted      = srt_accept(sock_lsn, (sockaddr*)&remote, &len);
+        ASSERT_NE(w_accepted, SRT_INVALID_SOCK);
+        srt_close(sock_lsn);
+    }
+
+    std::vector<char> RandomContents(size_t size)
+    {
+        std::mt19937      mtrd(size);
+        std::vector<char> data(size);
+        for (size_t i = 0; i < size; ++i)
+            data[i] = char(mtrd());
+        return data;
+    }
+
+    void WriteFile(const char* path, const std::vector<char>& data)
+    {
+        std::ofstream outfile(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        outfile.write(data.data(), data.size());
+    }
+
+    std::vector<char> ReadFile(const char* path)
+    {
+        std::ifstream     infile(path, std::ios::in | std::ios::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+        return data;
+    }
+}
+
+// A part of the file starting at an offset is sent with srt_sendfile_fd
+// and written at the same offset of the target file by srt_recvfile_fd.
+TEST(Transmission, FileDescriptorSendRecv)
+{
+    srt::TestInit srtinit;
+
+    SRTSOCKET caller = SRT_INVALID_SOCK, accepted = SRT_INVALID_SOCK;
+    ConnectFilePair((caller), (accepted));
+    ASSERT_NE(accepted, SRT_INVALID_SOCK);
+
+    // Not a multiple of the payload size, and longer than the sender buffer.
+    const int64_t           filesize = 30 * 1024 * 1024 + 333;
+    const int64_t           start    = 1000;
+    const std::vector<char> source   = RandomContents(filesize);
+    WriteFile("file.source", source);
+
+    const int srcfd = open("file.source", O_RDONLY);
+    ASSERT_NE(srcfd, -1);
+    const int tarfd = open("file.target", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_NE(tarfd, -1);
+
+    int64_t received = 0;
+    int64_t rcvoff   = start;
+    auto receiver = std::thread([&] {
+        received = srt_recvfile_fd(accepted, tarfd, &rcvoff, filesize - start, SRT_DEFAULT_RECVFILE_BLOCK);
+    });
+
+    int64_t sndoff = start;
+    EXPECT_EQ(srt_sendfile_fd(caller, srcfd, &sndoff, -1, SRT_DEFAULT_SENDFILE_BLOCK), filesize - start)
+        << srt_getlasterror_str();
+    EXPECT_EQ(sndoff, filesize);
+
+    receiver.join();
+    EXPECT_EQ(received, filesize - start) << srt_getlasterror_str();
+    EXPECT_EQ(rcvoff, filesize);
+
+    // The file positions of the descriptors are not used.
+    EXPECT_EQ(lseek(srcfd, 0, SEEK_CUR), 0);
+    EXPECT_EQ(lseek(tarfd, 0, SEEK_CUR), 0);
+
+    // Offset beyond the end of the file.
+    int64_t badoff = filesize + 1;
+    EXPECT_EQ(srt_sendfile_fd(caller, srcfd, &badoff, -1, SRT_DEFAULT_SENDFILE_BLOCK), SRT_ERROR);
+    EXPECT_EQ(srt_getlasterror(NULL), SRT_EINVRDOFF);
+
+    close(srcfd);
+    close(tarfd);
+    srt_close(caller);
+    srt_close(accepted);
+
+    const std::vector<char> target = ReadFile("file.target");
+    ASSERT_EQ(int64_t(target.size()), filesize);
+    EXPECT_TRUE(std::equal(source.begin() + start, source.end(), target.begin() + start));
+
+    remove("file.source");
+    remove("file.target");
+}
+
+// Benchmark: the throughput of srt_sendfile/srt_recvfile (C++ file streams)
+// against srt_sendfile_fd/srt_recvfile_fd over the loopback.
+TEST(Transmission, DISABLED_BenchmarkFileDescriptorVsStream)
+{
+    srt::TestInit srtinit;
+
+    const int64_t filesize = 512 * 1024 * 1024;
+    WriteFile("file.source", RandomContents(filesize));
+
+    for (int use_fd = 0; use_fd < 2; ++use_fd)
+    {
+        SRTSOCKET caller = SRT_INVALID_SOCK, accepted = SRT_INVALID_SOCK;
+        ConnectFilePair((caller), (accepted));
+        ASSERT_NE(accepted, SRT_INVALID_SOCK);
+
+        const int srcfd = open("file.source", O_RDONLY);
+        const int tarfd = open("file.target", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ASSERT_NE(srcfd, -1);
+        ASSERT_NE(tarfd, -1);
+
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        int64_t received = 0;
+        auto receiver = std::thread([&] {
+            int64_t offset = 0;
+            received = use_fd
+                ? srt_recvfile_fd(accepted, tarfd, &offset, filesize, SRT_DEFAULT_RECVFILE_BLOCK)
+                : srt_recvfile(accepted, "file.target", &offset, filesize, SRT_DEFAULT_RECVFILE_BLOCK);
+        });
+
+        int64_t offset = 0;
+        const int64_t sent = use_fd
+            ? srt_sendfile_fd(caller, srcfd, &offset, filesize, SRT_DEFAULT_SENDFILE_BLOCK)
+            : srt_sendfile(caller, "file.source", &offset, filesize, SRT_DEFAULT_SENDFILE_BLOCK);
+        receiver.join();
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        EXPECT_EQ(sent, filesize);
+        EXPECT_EQ(received, filesize);
+        std::cerr << (use_fd ? "fd (pread/pwritev): " : "fstream:            ") << (filesize / seconds / 1e6)
+                  << " MB/s\n";
+
+        close(srcfd);
+        close(tarfd);
+        srt_close(caller);
+        srt_close(accepted);
+    }
+
+    remove("file.source");
+    remove("file.target");
+}
+#endif
@@ -0,0 +1,161 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#ifdef SRT_ENABLE_ENCRYPTION
+#include "srt.h"
+#include "crypto.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+namespace
+{
+const unsigned char SALT_A[HAICRYPT_PBKDF2_SALT_LEN] = {1, 2, 3, 4, 5, 6, 7, 8};
+const unsigned char SALT_B[HAICRYPT_PBKDF2_SALT_LEN] = {1, 2, 3, 4, 5, 6, 7, 9};
+const char          PWD_A[]                          = "kek-cache-passphrase";
+const char          PWD_B[]                          = "kek-cache-passphrasf";
+} // namespace
+
+// The KEK is found only for the same passphrase, salt and key length.
+TEST(CKekCache, Lookup)
+{
+    CKekCache     cache;
+    unsigned char kek[16], found[16];
+    for (size_t i = 0; i < sizeof kek; ++i)
+        kek[i] = (unsigned char)(i * 7);
+
+    EXPECT_FALSE(cache.lookup(PWD_A, strlen(PWD_A), SALT_A, sizeof SALT_A, found, sizeof found));
+    cache.store(PWD_A, strlen(PWD_A), SALT_A, sizeof SALT_A, kek, sizeof kek);
+    EXPECT_EQ(cache.size(), 1U);
+
+    memset(found, 0, sizeof found);
+    ASSERT_TRUE(cache.lookup(PWD_A, strlen(PWD_A), SALT_A, sizeof SALT_A, found, sizeof found));
+    EXPECT_EQ(memcmp(found, kek, sizeof kek), 0);
+
+    EXPECT_FALSE(cache.lookup(PWD_B, strlen(PWD_B), SALT_A, sizeof SALT_A, found, sizeof found));
+    EXPECT_FALSE(cache.lookup(PWD_A, strlen(PWD_A), SALT_B, sizeof SALT_B, found, sizeof found));
+    EXPECT_FALSE(cache.lookup(PWD_A, strlen(PWD_A), SALT_A, sizeof SALT_A, found, 24));
+    EXPECT_EQ(cache.hits(), 1U);
+    EXPECT_EQ(cache.misses(), 4U);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_FALSE(cache.lookup(PWD_A, strlen(PWD_A), SALT_A, sizeof SALT_A, found, sizeof found));
+}
+
+// The oldest KEKs are removed above the capacity; no capacity, no cache.
+TEST(CKekCache, Capacity)
+{
+    CKekCache     cache;
+    unsigned char kek[16] = {0}, found[16];
+    unsigned char salt[HAICRYPT_PBKDF2_SALT_LEN] = {0};
+
+    cache.setCapacity(4);
+    for (unsigned char i = 0; i < 10; ++i)
+    {
+        salt[0] = kek[0] = i;
+        cache.store(PWD_A, strlen(PWD_A), salt, sizeof salt, kek, sizeof kek);
+    }
+    EXPECT_EQ(cache.size(), 4U);
+
+    salt[0] = 5;
+    EXPECT_FALSE(cache.lookup(PWD_A, strlen(PWD_A), salt, sizeof salt, found, sizeof found));
+    salt[0] = 6;
+    ASSERT_TRUE(cache.lookup(PWD_A, strlen(PWD_A), salt, sizeof salt, found, sizeof found));
+    EXPECT_EQ(found[0], 6);
+
+    cache.setCapacity(0);
+    EXPECT_EQ(cache.size(), 0U);
+    cache.store(PWD_A, strlen(PWD_A), salt, sizeof salt, kek, sizeof kek);
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+// The encrypted connections on loopback, connected one after another.
+class TestKekCache : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_PASSPHRASE, PWD_A, (int)strlen(PWD_A)), SRT_SUCCESS);
+        m_addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, m_addr.get(), m_addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, 1), SRT_ERROR);
+    }
+
+    void teardown() override
+    {
+        srt_close(m_listen_sock);
+        CKekCache::instance().setCapacity(CKekCache::DEF_CAPACITY);
+    }
+
+    // Connect, check that the connection is secured and close it.
+    void connectSecured(const char* passphrase)
+    {
+        const SRTSOCKET caller = srt_create_socket();
+        ASSERT_NE(caller, SRT_INVALID_SOCK);
+        ASSERT_EQ(srt_setsockflag(caller, SRTO_PASSPHRASE, passphrase, (int)strlen(passphrase)), SRT_SUCCESS);
+        ASSERT_NE(srt_connect(caller, m_addr.get(), m_addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+        sockaddr_any    peer;
+        const SRTSOCKET accepted = srt_accept(m_listen_sock, peer.get(), &peer.len);
+        ASSERT_NE(accepted, SRT_INVALID_SOCK);
+
+        int state = 0, optlen = sizeof state;
+        EXPECT_EQ(srt_getsockflag(accepted, SRTO_KMSTATE, &state, &optlen), SRT_SUCCESS);
+        EXPECT_EQ(state, SRT_KM_S_SECURED);
+        srt_close(caller);
+        srt_close(accepted);
+    }
+
+    SRTSOCKET    m_listen_sock;
+    sockaddr_any m_addr;
+};
+
+// The KEK derived for one context of the connection is
+// reused by the others using the same salt.
+TEST_F(TestKekCache, Connection)
+{
+    CKekCache&     cache = CKekCache::instance();
+    const uint64_t hits  = cache.hits();
+    connectSecured(PWD_A);
+    EXPECT_GT(cache.hits(), hits);
+}
+
+// A wrong passphrase is not accepted because of the cached KEK.
+TEST_F(TestKekCache, WrongPassphrase)
+{
+    connectSecured(PWD_A);
+
+    const SRTSOCKET caller = srt_create_socket();
+    ASSERT_EQ(srt_setsockflag(caller, SRTO_PASSPHRASE, PWD_B, (int)strlen(PWD_B)), SRT_SUCCESS);
+    EXPECT_EQ(srt_connect(caller, m_addr.get(), m_addr.size()), SRT_ERROR);
+    EXPECT_EQ(srt_getrejectreason(caller), SRT_REJ_BADSECRET);
+    srt_close(caller);
+}
+
+// Benchmark: the rate of encrypted handshakes with and without the cache.
+TEST_F(TestKekCache, DISABLED_BenchmarkHandshakeRate)
+{
+    const int NCONN = 500;
+    for (int cached = 0; cached < 2; ++cached)
+    {
+        CKekCache::instance().setCapacity(cached ? CKekCache::DEF_CAPACITY : 0);
+
+        const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < NCONN; ++i)
+            connectSecured(PWD_A);
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cerr << (cached ? "With KEK cache:    " : "Without KEK cache: ") << NCONN << " handshakes in " << seconds
+             << " s (" << int64_t(NCONN / seconds) << "/s)\n";
+    }
+}
+
+#endif
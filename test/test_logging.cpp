@@ -0,0 +1,249 @@
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+#include "logging.h"
+
+using namespace std;
+using namespace srt_logging;
+
+#if ENABLE_LOGGING
+
+// The asynchronous logging mode (SRT_LOGF_ASYNC), with a private
+// configuration, so that the global SRT logger is not affected.
+class TestLogAsync : public ::testing::Test
+{
+protected:
+    TestLogAsync()
+        : m_config(LogConfig::fa_bitset_t().set())
+        , m_logger(SRT_LOGFA_GENERAL, m_config, "TEST")
+        , m_bBlock(false)
+        , m_bBlocked(false)
+    {
+        m_config.max_level         = LogLevel::debug;
+        m_config.flags             = SRT_LOGF_ASYNC | SRT_LOGF_DISABLE_TIME | SRT_LOGF_DISABLE_THREADNAME
+                                   | SRT_LOGF_DISABLE_SEVERITY | SRT_LOGF_DISABLE_EOL;
+        m_config.loghandler_fn     = &TestLogAsync::handler;
+        m_config.loghandler_opaque = this;
+    }
+
+    ~TestLogAsync() { m_config.async.stop(); }
+
+    static void handler(void* opaque, int, const char*, int, const char* area, const char* message)
+    {
+        TestLogAsync* self = (TestLogAsync*)opaque;
+        unique_lock<mutex> lk(self->m_lock);
+        self->m_threads.insert(this_thread::get_id());
+        if (string(area) == "LogAsyncWriter")
+        {
+            self->m_reports.push_back(message);
+            return;
+        }
+        self->m_lines.push_back(message);
+
+        self->m_bBlocked = self->m_bBlock;
+        self->m_cond.notify_all();
+        while (self->m_bBlock)
+            self->m_cond.wait(lk);
+    }
+
+    LogConfig          m_config;
+    Logger             m_logger;
+    mutex              m_lock;
+    condition_variable m_cond;
+    bool               m_bBlock;
+    bool               m_bBlocked;
+    vector<string>     m_lines;
+    vector<string>     m_reports;
+    set<thread::id>    m_threads;
+};
+
+// The lines from several threads are all passed to the handler by one
+// background thread, in order for every logging thread.
+TEST_F(TestLogAsync, WrittenByBackgroundThread)
+{
+    const int NTHREADS = 4;
+    const int NLINES   = 100;
+
+    vector<thread> loggers;
+    for (int t = 0; t < NTHREADS; ++t)
+    {
+        loggers.push_back(thread([this, t] {
+            for (int i = 0; i < NLINES; ++i)
+            {
+                LOGC(m_logger.Note, log << "T" << t << " L" << i);
+                if (i % 50 == 0)
+                    this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        }));
+    }
+    for (size_t t = 0; t < loggers.size(); ++t)
+        loggers[t].join();
+
+    m_config.async.stop();
+
+    ASSERT_EQ(m_lines.size(), size_t(NTHREADS * NLINES));
+    EXPECT_EQ(m_config.async.dropped(), 0);
+    EXPECT_TRUE(m_reports.empty());
+    ASSERT_EQ(m_threads.size(), 1u);
+    EXPECT_EQ(m_threads.count(this_thread::get_id()), 0u);
+    for (size_t t = 0; t < loggers.size(); ++t)
+        EXPECT_EQ(m_threads.count(loggers[t].get_id()), 0u);
+
+    vector<int> next(NTHREADS, 0);
+    for (size_t i = 0; i < m_lines.size(); ++i)
+    {
+        int t = -1, l = -1;
+        ASSERT_EQ(sscanf(m_lines[i].c_str(), ": T%d L%d", &t, &l), 2) << m_lines[i];
+        ASSERT_TRUE(t >= 0 && t < NTHREADS);
+        EXPECT_EQ(l, next[t]) << "Line out of order for thread " << t;
+        next[t] = l + 1;
+    }
+}
+
+// With the output stalled, the lines are dropped and counted
+// rather than blocking the logging thread.
+TEST_F(TestLogAsync, DropsWhenOutputStalled)
+{
+    {
+        lock_guard<mutex> lk(m_lock);
+        m_bBlock = true;
+    }
+    LOGC(m_logger.Warn, log << "first");
+    {
+        unique_lock<mutex> lk(m_lock);
+        ASSERT_TRUE(m_cond.wait_for(lk, chrono::seconds(5), [this] { return m_bBlocked; }));
+    }
+
+    const int NLINES = 3 * LogAsyncWriter::RING_SIZE;
+    for (int i = 0; i < NLINES; ++i)
+        LOGC(m_logger.Warn, log << "line " << i);
+
+    const int64_t dropped = m_config.async.dropped();
+    EXPECT_GE(dropped, NLINES - int(LogAsyncWriter::RING_SIZE));
+
+    {
+        lock_guard<mutex> lk(m_lock);
+        m_bBlock = false;
+        m_cond.notify_all();
+    }
+    m_config.async.stop();
+
+    EXPECT_EQ(int64_t(m_lines.size()) + dropped, NLINES + 1);
+    ASSERT_EQ(m_reports.size(), 1u);
+    EXPECT_NE(m_reports[0].find(Sprint(dropped)), string::npos) << m_reports[0];
+}
+
+// The binary log format (SRT_LOGF_BINARY), written to a string stream.
+class TestLogBinary : public ::testing::Test
+{
+protected:
+    TestLogBinary()
+        : m_config(LogConfig::fa_bitset_t().set())
+        , m_logger(SRT_LOGFA_GENERAL, m_config, "TEST")
+    {
+        m_config.max_level  = LogLevel::debug;
+        m_config.flags      = SRT_LOGF_BINARY;
+        m_config.log_stream = &m_out;
+    }
+
+    struct Record
+    {
+        char   type;
+        string payload;
+    };
+
+    // Split the log into records, after checking the file header.
+    vector<Record> records()
+    {
+        const string log = m_out.str();
+        vector<Record> out;
+        EXPECT_GE(log.size(), sizeof binlog::MAGIC + sizeof(uint32_t));
+        EXPECT_EQ(log.compare(0, sizeof binlog::MAGIC, binlog::MAGIC, sizeof binlog::MAGIC), 0);
+        uint32_t bom;
+        memcpy(&bom, log.data() + sizeof binlog::MAGIC, sizeof bom);
+        EXPECT_EQ(bom, binlog::BYTE_ORDER_MARK);
+
+        size_t pos = sizeof binlog::MAGIC + sizeof bom;
+        while (pos + sizeof(uint32_t) <= log.size())
+        {
+            uint32_t len;
+            memcpy(&len, log.data() + pos, sizeof len);
+            pos += sizeof len;
+            EXPECT_LE(pos + len, log.size());
+            if (len == 0 || pos + len > log.size())
+                break;
+            Record r;
+            r.type    = log[pos];
+            r.payload = log.substr(pos + 1, len - 1);
+            out.push_back(r);
+            pos += len;
+        }
+        EXPECT_EQ(pos, log.size());
+        return out;
+    }
+
+    LogConfig          m_config;
+    Logger             m_logger;
+    ostringstream      m_out;
+};
+
+// The arguments are recorded as raw values, and the call site
+// is described only before its first line.
+TEST_F(TestLogBinary, RecordsArguments)
+{
+    for (int i = 0; i < 2; ++i)
+        LOGC(m_logger.Note, log << "value " << (i + 41) << " hex " << hex << 255u << true);
+
+    const vector<Record> recs = records();
+    ASSERT_EQ(recs.size(), 3u);
+    EXPECT_EQ(recs[0].type, char(binlog::REC_SITE));
+    EXPECT_NE(recs[0].payload.find("test_logging.cpp"), string::npos);
+    EXPECT_NE(recs[0].payload.find("TEST"), string::npos);
+
+    uint32_t site;
+    memcpy(&site, recs[0].payload.data(), sizeof site);
+    for (int i = 0; i < 2; ++i)
+    {
+        const Record& r = recs[1 + i];
+        ASSERT_EQ(r.type, char(binlog::REC_LINE));
+        uint32_t line_site;
+        memcpy(&line_site, r.payload.data(), sizeof line_site);
+        EXPECT_EQ(line_site, site);
+
+        // Skip the time and the thread name to the arguments.
+        size_t pos = sizeof line_site + sizeof(int64_t);
+        uint32_t namelen;
+        memcpy(&namelen, r.payload.data() + pos, sizeof namelen);
+        pos += sizeof namelen + namelen;
+
+        string expected;
+        binlog::putArg((expected), "value ");
+        binlog::putArg((expected), i + 41);
+        binlog::putArg((expected), " hex ");
+        binlog::putArg((expected), std::hex);
+        binlog::putArg((expected), 255u);
+        binlog::putArg((expected), true);
+        EXPECT_EQ(r.payload.substr(pos), expected);
+    }
+}
+
+// The lines formatted already are recorded as text.
+TEST_F(TestLogBinary, TextRecord)
+{
+    m_config.flags |= SRT_LOGF_DISABLE_TIME | SRT_LOGF_DISABLE_THREADNAME | SRT_LOGF_DISABLE_SEVERITY;
+    LOGF(m_logger.Note, "formatted %d", 7);
+
+    const vector<Record> recs = records();
+    ASSERT_EQ(recs.size(), 1u);
+    EXPECT_EQ(recs[0].type, char(binlog::REC_TEXT));
+    EXPECT_NE(recs[0].payload.find("formatted 7"), string::npos);
+}
+
+#endif
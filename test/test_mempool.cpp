@@ -0,0 +1,152 @@
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+#include "mempool.h"
+#include "queue.h"
+#include "buffer_snd.h"
+
+using namespace std;
+using namespace srt;
+
+// Each test uses its own slot size, so that the pools are not shared
+// with the sockets created by the other tests in the same process.
+
+static CPacketSlotPool::Stats findStats(size_t slot_size)
+{
+    vector<CPacketSlotPool::Stats> all;
+    CPacketSlotPool::getStats((all));
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        if (all[i].slotSize == slot_size)
+            return all[i];
+    }
+    CPacketSlotPool::Stats none = CPacketSlotPool::Stats();
+    return none;
+}
+
+/// The slots are aligned to the cache line and do not overlap.
+TEST(CPacketSlotPool, SlotsDoNotOverlap)
+{
+    CPacketSlotPool& pool = CPacketSlotPool::instance(3000);
+    EXPECT_EQ(pool.slotSize(), 3008u);
+    EXPECT_EQ(&pool, &CPacketSlotPool::instance(3001));
+
+    const int nslots = 100;
+    vector<char*> slots(nslots);
+    ASSERT_TRUE(pool.allocate(&slots[0], nslots));
+    EXPECT_EQ(pool.stats().slotsUsed, nslots);
+
+    for (int i = 0; i < nslots; ++i)
+    {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(slots[i]) % 64, 0u);
+        memset(slots[i], i, pool.slotSize());
+    }
+
+    sort(slots.begin(), slots.end());
+    for (int i = 1; i < nslots; ++i)
+        EXPECT_GE(size_t(slots[i] - slots[i - 1]), pool.slotSize());
+
+    pool.release(&slots[0], nslots);
+    EXPECT_EQ(pool.stats().slotsUsed, 0);
+}
+
+/// The pool grows by whole slabs and keeps them after the slots are released.
+TEST(CPacketSlotPool, GrowsBySlabs)
+{
+    CPacketSlotPool& pool = CPacketSlotPool::instance(4000);
+
+    const int nslots = 1000; // more than one 2MB slab holds
+    vector<char*> slots(nslots);
+    ASSERT_TRUE(pool.allocate(&slots[0], nslots));
+
+    const CPacketSlotPool::Stats s = pool.stats();
+    EXPECT_GE(s.slabs, 2);
+    EXPECT_GE(s.slotsTotal, nslots);
+    EXPECT_EQ(s.slotsUsed, nslots);
+    EXPECT_EQ(s.slotsUsedMax, nslots);
+    EXPECT_EQ(s.bytesTotal, int64_t(s.slabs) * 2 * 1024 * 1024);
+    EXPECT_LE(s.bytesHugePage, s.bytesTotal);
+
+    pool.release(&slots[0], nslots);
+    ASSERT_TRUE(pool.allocate(&slots[0], nslots));
+    EXPECT_EQ(pool.stats().slabs, s.slabs);
+    pool.release(&slots[0], nslots);
+
+    const CPacketSlotPool::Stats listed = findStats(pool.slotSize());
+    EXPECT_EQ(listed.slabs, s.slabs);
+    EXPECT_EQ(listed.slotsUsed, 0);
+    EXPECT_EQ(listed.slotsUsedMax, nslots);
+}
+
+/// The unit queue and the sender buffer take their payload buffers from
+/// the pool of their packet size and return them when destroyed.
+TEST(CPacketSlotPool, SharedByUnitQueueAndSndBuffer)
+{
+    srt::TestInit srtinit;
+    const int payload = 5000;
+    CPacketSlotPool& pool = CPacketSlotPool::instance(payload);
+
+    CUnitQueue* units = new CUnitQueue(64, payload);
+    EXPECT_EQ(pool.stats().slotsUsed, 64);
+
+    CSndBuffer* sndbuf = new CSndBuffer(AF_INET, 32, payload, 0);
+    EXPECT_EQ(pool.stats().slotsUsed, 64 + 32);
+
+    delete units;
+    delete sndbuf;
+    EXPECT_EQ(pool.stats().slotsUsed, 0);
+}
+
+/// The payload shared by the sender buffers takes one slot, while the
+/// blocks referencing it give their own slots back to the pool.
+/// (The shared payloads always use the pool of the default payload size,
+/// which is used by the sockets as well, so only the difference is checked.)
+TEST(CPacketSlotPool, SharedPayload)
+{
+    srt::TestInit srtinit;
+    CPacketSlotPool& pool = CPacketSlotPool::instance(SRT_LIVE_MAX_PLSIZE);
+    const int        base = pool.stats().slotsUsed;
+
+    vector<CSndBuffer*> sndbufs;
+    for (int i = 0; i < 3; ++i)
+        sndbufs.push_back(new CSndBuffer(AF_INET, 32, SRT_LIVE_MAX_PLSIZE, 0));
+    EXPECT_EQ(pool.stats().slotsUsed, base + 3 * 32);
+
+    const string       data(1000, 'x');
+    CSndSharedPayload* shared = CSndSharedPayload::create(data.data(), (int)data.size());
+    ASSERT_NE(shared, (CSndSharedPayload*)NULL);
+    EXPECT_EQ(CSndSharedPayload::create(data.data(), SRT_LIVE_MAX_PLSIZE + 1), (CSndSharedPayload*)NULL);
+
+    for (size_t i = 0; i < sndbufs.size(); ++i)
+    {
+        SRT_MSGCTRL mc = srt_msgctrl_default;
+        mc.pktseq      = 1000;
+        ASSERT_TRUE(sndbufs[i]->addShared(*shared, (mc)));
+        EXPECT_EQ(mc.pktseq, 1001); // The next packet's
+    }
+    shared->release(); // Held by the sender buffers now
+    EXPECT_EQ(pool.stats().slotsUsed, base + 3 * 31 + 1);
+
+    for (size_t i = 0; i < sndbufs.size(); ++i)
+    {
+        CPacket                        packet;
+        sync::steady_clock::time_point origin;
+        int                            seqnoinc = 0;
+        bool                           encrypted = false;
+        ASSERT_EQ(sndbufs[i]->readData((packet), (origin), 0, (seqnoinc), (encrypted)), (int)data.size());
+        EXPECT_EQ(packet.seqno(), 1000);
+        EXPECT_EQ(string(packet.data(), packet.getLength()), data);
+    }
+
+    // A copied payload takes a slot again for the block.
+    SRT_MSGCTRL mc = srt_msgctrl_default;
+    mc.pktseq      = 1001;
+    sndbufs[0]->addBuffer(data.data(), (int)data.size(), (mc));
+    EXPECT_EQ(pool.stats().slotsUsed, base + 3 * 31 + 1);
+
+    for (size_t i = 0; i < sndbufs.size(); ++i)
+        delete sndbufs[i];
+    EXPECT_EQ(pool.stats().slotsUsed, base);
+}
@@ -0,0 +1,102 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// The connection timers (ACK, NAK, EXP, keepalive) checked by the
+// receiver queue when their deadlines come, also with no packets.
+class TestRcvTimers : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_caller_sock = srt_create_socket();
+        ASSERT_NE(m_caller_sock, SRT_INVALID_SOCK);
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+        m_accepted_sock = SRT_INVALID_SOCK;
+    }
+
+    void teardown() override
+    {
+        srt_close(m_caller_sock);
+        srt_close(m_accepted_sock);
+        srt_close(m_listen_sock);
+    }
+
+    void connect()
+    {
+        sockaddr_any addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, addr.get(), addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, 1), SRT_ERROR);
+        ASSERT_NE(srt_connect(m_caller_sock, addr.get(), addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+        sockaddr_any peer;
+        m_accepted_sock = srt_accept(m_listen_sock, peer.get(), &peer.len);
+        ASSERT_NE(m_accepted_sock, SRT_INVALID_SOCK);
+    }
+
+    void sendAndReceive(int nmsgs)
+    {
+        const int    len = 1316;
+        vector<char> buf(len);
+        for (int m = 0; m < nmsgs; ++m)
+            ASSERT_EQ(srt_sendmsg(m_caller_sock, &buf[0], len, -1, true), len) << srt_getlasterror_str();
+
+        vector<char> rcvbuf(1500);
+        for (int m = 0; m < nmsgs; ++m)
+            ASSERT_EQ(srt_recvmsg(m_accepted_sock, &rcvbuf[0], (int)rcvbuf.size()), len) << "Message #" << m;
+    }
+
+    SRTSOCKET m_caller_sock;
+    SRTSOCKET m_listen_sock;
+    SRTSOCKET m_accepted_sock;
+};
+
+// An idle connection is kept alive by the keepalive timers
+// for longer than the peer idle timeout.
+TEST_F(TestRcvTimers, IdleKeepalive)
+{
+    const int peer_idle_ms = 1500;
+    ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_PEERIDLETIMEO, &peer_idle_ms, sizeof peer_idle_ms), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_PEERIDLETIMEO, &peer_idle_ms, sizeof peer_idle_ms), SRT_SUCCESS);
+    connect();
+
+    this_thread::sleep_for(chrono::milliseconds(3 * peer_idle_ms));
+
+    EXPECT_EQ(srt_getsockstate(m_caller_sock), SRTS_CONNECTED);
+    EXPECT_EQ(srt_getsockstate(m_accepted_sock), SRTS_CONNECTED);
+    sendAndReceive(10);
+}
+
+// The data sent after a period of idleness is acknowledged,
+// so the sender buffer gets empty.
+TEST_F(TestRcvTimers, AckAfterIdle)
+{
+    connect();
+    sendAndReceive(10);
+
+    this_thread::sleep_for(chrono::milliseconds(500));
+    sendAndReceive(10);
+
+    size_t blocks = 1;
+    for (int i = 0; i < 100 && blocks != 0; ++i)
+    {
+        size_t bytes = 0;
+        ASSERT_EQ(srt_getsndbuffer(m_caller_sock, &blocks, &bytes), 0);
+        if (blocks != 0)
+            this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    EXPECT_EQ(blocks, 0u) << "Sent data not acknowledged";
+
+    SRT_TRACEBSTATS stats;
+    ASSERT_EQ(srt_bstats(m_accepted_sock, &stats, 0), 0);
+    EXPECT_GT(stats.pktSentACKTotal, 0);
+}
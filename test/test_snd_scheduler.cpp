@@ -0,0 +1,202 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// Many sockets sharing one multiplexer, so that their sending is
+// scheduled by the same CSndUList, fed from several application threads.
+class TestSndScheduler : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+    }
+
+    void teardown() override
+    {
+        for (size_t i = 0; i < m_callers.size(); ++i)
+            srt_close(m_callers[i]);
+        for (size_t i = 0; i < m_accepted.size(); ++i)
+            srt_close(m_accepted[i]);
+        srt_close(m_listen_sock);
+    }
+
+    void setMode(SRTSOCKET s, bool live)
+    {
+        const SRT_TRANSTYPE type = live ? SRTT_LIVE : SRTT_FILE;
+        const bool          yes  = true;
+        ASSERT_EQ(srt_setsockflag(s, SRTO_TRANSTYPE, &type, sizeof type), SRT_SUCCESS);
+        if (!live)
+        {
+            ASSERT_EQ(srt_setsockflag(s, SRTO_MESSAGEAPI, &yes, sizeof yes), SRT_SUCCESS);
+        }
+    }
+
+    // Connect @a nconn callers, all bound to the same local port.
+    void connect(int nconn, bool live)
+    {
+        setMode(m_listen_sock, live);
+        sockaddr_any addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, addr.get(), addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, nconn), SRT_ERROR);
+
+        const sockaddr_any local = srt::CreateAddr("127.0.0.1", 5300, AF_INET);
+        for (int i = 0; i < nconn; ++i)
+        {
+            const SRTSOCKET caller = srt_create_socket();
+            ASSERT_NE(caller, SRT_INVALID_SOCK);
+            m_callers.push_back(caller);
+            setMode(caller, live);
+            ASSERT_NE(srt_bind(caller, local.get(), local.size()), SRT_ERROR) << srt_getlasterror_str();
+            ASSERT_NE(srt_connect(caller, addr.get(), addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+            sockaddr_any peer;
+            const SRTSOCKET accepted = srt_accept(m_listen_sock, peer.get(), &peer.len);
+            ASSERT_NE(accepted, SRT_INVALID_SOCK);
+            m_accepted.push_back(accepted);
+        }
+    }
+
+    static void fillPattern(vector<char>& w_buf, int conn, int msgindex)
+    {
+        for (size_t i = 0; i < w_buf.size(); ++i)
+            w_buf[i] = char(conn * 13 + msgindex * 7 + i);
+    }
+
+    SRTSOCKET         m_listen_sock;
+    vector<SRTSOCKET> m_callers;
+    vector<SRTSOCKET> m_accepted;
+};
+
+// The messages sent concurrently from several threads to sockets
+// sharing the sender queue are all delivered in order.
+TEST_F(TestSndScheduler, ConcurrentSenders)
+{
+    const int NCONN    = 20;
+    const int NTHREADS = 4;
+    const int NMSGS    = 100;
+    const int LEN      = 1316;
+    connect(NCONN, false);
+
+    vector<thread> senders;
+    for (int t = 0; t < NTHREADS; ++t)
+    {
+        senders.push_back(thread([&, t] {
+            vector<char> buf(LEN);
+            for (int m = 0; m < NMSGS; ++m)
+            {
+                for (int c = t; c < NCONN; c += NTHREADS)
+                {
+                    fillPattern((buf), c, m);
+                    EXPECT_EQ(srt_sendmsg(m_callers[c], &buf[0], LEN, -1, true), LEN) << srt_getlasterror_str();
+                }
+            }
+        }));
+    }
+
+    vector<char> rcvbuf(LEN);
+    vector<char> expected(LEN);
+    for (int c = 0; c < NCONN; ++c)
+    {
+        for (int m = 0; m < NMSGS; ++m)
+        {
+            ASSERT_EQ(srt_recvmsg(m_accepted[c], &rcvbuf[0], LEN), LEN) << "Connection " << c << " message #" << m;
+            fillPattern((expected), c, m);
+            ASSERT_TRUE(expected == rcvbuf) << "Connection " << c << " message #" << m;
+        }
+    }
+
+    for (size_t t = 0; t < senders.size(); ++t)
+        senders[t].join();
+}
+
+// Benchmark: 1000 live sockets sending 10 Mbps each over one multiplexer.
+// Reports the rate actually achieved and the packets dropped as too late.
+TEST_F(TestSndScheduler, DISABLED_Benchmark1kSockets10Mbps)
+{
+    const int    NCONN      = 1000;
+    const int    NTHREADS   = 8;
+    const int    LEN        = 1316;
+    const int    DURATION_S = 10;
+    const double RATE_BPS   = 10e6;
+
+    ASSERT_EQ(srt_set_tsbpd_threads(4), 0);
+    connect(NCONN, true);
+
+    const chrono::nanoseconds period(int64_t(LEN * 8 * 1e9 / RATE_BPS));
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    const chrono::steady_clock::time_point end   = start + chrono::seconds(DURATION_S);
+
+    vector<thread> senders;
+    for (int t = 0; t < NTHREADS; ++t)
+    {
+        senders.push_back(thread([&, t] {
+            vector<char> buf(LEN);
+            for (chrono::steady_clock::time_point next = start; next < end; next += period)
+            {
+                this_thread::sleep_until(next);
+                for (int c = t; c < NCONN; c += NTHREADS)
+                    srt_sendmsg(m_callers[c], &buf[0], LEN, -1, true);
+            }
+        }));
+    }
+
+    const int eid = srt_epoll_create();
+    ASSERT_GE(eid, 0);
+    const bool no = false;
+    for (int c = 0; c < NCONN; ++c)
+    {
+        ASSERT_EQ(srt_setsockflag(m_accepted[c], SRTO_RCVSYN, &no, sizeof no), SRT_SUCCESS);
+        const int events = SRT_EPOLL_IN;
+        ASSERT_EQ(srt_epoll_add_usock(eid, m_accepted[c], &events), SRT_SUCCESS);
+    }
+
+    vector<char>      rcvbuf(1500);
+    vector<SRTSOCKET> ready(NCONN);
+    int64_t           received = 0;
+    while (chrono::steady_clock::now() < end + chrono::seconds(1))
+    {
+        int       rlen = NCONN;
+        const int n    = srt_epoll_wait(eid, &ready[0], &rlen, NULL, NULL, 100, NULL, NULL, NULL, NULL);
+        for (int i = 0; i < n && i < rlen; ++i)
+        {
+            while (srt_recvmsg(ready[i], &rcvbuf[0], (int)rcvbuf.size()) > 0)
+                ++received;
+        }
+    }
+
+    for (size_t t = 0; t < senders.size(); ++t)
+        senders[t].join();
+    srt_epoll_release(eid);
+
+    int64_t sent = 0, snd_dropped = 0, rcv_dropped = 0;
+    for (int c = 0; c < NCONN; ++c)
+    {
+        SRT_TRACEBSTATS stats;
+        if (srt_bstats(m_callers[c], &stats, 0) == 0)
+        {
+            sent += stats.pktSentUniqueTotal;
+            snd_dropped += stats.pktSndDropTotal;
+        }
+        if (srt_bstats(m_accepted[c], &stats, 0) == 0)
+            rcv_dropped += stats.pktRcvDropTotal;
+    }
+
+    const double expected = double(NCONN) * DURATION_S * RATE_BPS / (LEN * 8);
+    cerr << "Sockets: " << NCONN << " at " << RATE_BPS / 1e6 << " Mbps for " << DURATION_S << " s\n";
+    cerr << "Packets expected: " << int64_t(expected) << " sent: " << sent << " received: " << received << "\n";
+    cerr << "Achieved: " << (sent * LEN * 8 / DURATION_S / 1e6) << " Mbps total\n";
+    cerr << "Dropped: sender " << snd_dropped << " receiver " << rcv_dropped << "\n";
+
+    srt_set_tsbpd_threads(0);
+}
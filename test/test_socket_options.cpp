@@ -14,6 +14,7 @@
 #include <future>
 #include <thread>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include "test_env.h"
 
@@ -324,6 +325,7 @@ const OptionTestEntry g_test_matrix_options[] =
     { SRTO_GROUPMINSTABLETIMEO, "SRTO_GROUPMINSTABLETIMEO", RestrictionType::PRE, sizeof(int),       60,       5000,       60,        70, {0, -1, 50, 5001},           O | W | G | O | D | I | M },
 #endif
     //SRTO_GROUPTYPE
+    { SRTO_INDUCTIONRATE, "SRTO_INDUCTIONRATE", RestrictionType::PRE,     sizeof(int),                 0,   1000000,        0,          100, {-1, 1000001},          R | W | O | S | O | O | O },
     //SRTO_INPUTBW
     //SRTO_IPTOS
     //SRTO_IPTTL
@@ -345,6 +347,9 @@ const OptionTestEntry g_test_matrix_options[] =
     { SRTO_MSS,                     "SRTO_MSS", RestrictionType::PREBIND, sizeof(int),                76,     65536,     1500,        1400,    {-1, 0, 75},            R | W | G | S | D | O | O },
     { SRTO_NAKREPORT,         "SRTO_NAKREPORT", RestrictionType::PRE,    sizeof(bool),             false,      true,     true,        false,     {},                   R | W | G | S | D | O | M },
     { SRTO_OHEADBW,             "SRTO_OHEADBW", RestrictionType::POST,    sizeof(int),                 5,        100,       25,          20, {-1, 0, 4, 101},          R | W | G | S | D | O | O },
+    { SRTO_PACINGMODE,       "SRTO_PACINGMODE", RestrictionType::PREBIND, sizeof(int),                 0,          3,        0,           2, {-1, 4},                R | W | G | S | D | O | O },
+    { SRTO_PACINGSPIN,       "SRTO_PACINGSPIN", RestrictionType::PREBIND, sizeof(int),                 0,     100000,     1000,         200, {-1, 100001},           R | W | G | S | D | O | O },
+    { SRTO_PACINGTRAIN,     "SRTO_PACINGTRAIN", RestrictionType::PRE,     sizeof(int),                 1,         64,        1,          16, {-1, 0, 65},            R | W | G | S | D | O | O },
     //SRTO_PACKETFILTER
     //SRTO_PASSPHRASE
     { SRTO_PAYLOADSIZE,     "SRTO_PAYLOADSIZE", RestrictionType::PRE,     sizeof(int),                 0,      1456,      1316,        1400,   {-1, 1500},             O | W | G | S | D | O | O },
@@ -358,6 +363,9 @@ const OptionTestEntry g_test_matrix_options[] =
     { SRTO_RCVLATENCY,       "SRTO_RCVLATENCY", RestrictionType::PRE,     sizeof(int),                 0, INT32_MAX, 120, 1100, {-1},                                  R | W | G | S | D | O | O },
     //SRTO_RCVSYN
     { SRTO_RCVTIMEO,           "SRTO_RCVTIMEO", RestrictionType::POST,    sizeof(int),                -1, INT32_MAX,  -1, 2000, {-2},                                  R | W | G | S | O | I | O },
+    { SRTO_RCVWORKERS,    "SRTO_RCVWORKERS", RestrictionType::PREBIND,   sizeof(int),                1,        16,        1,           4, {-1, 0, 17},             R | W | G | S | D | O | O },
+    { SRTO_CRYPTOWORKERS, "SRTO_CRYPTOWORKERS", RestrictionType::PREBIND, sizeof(int),                0,        16,        0,           4, {-1, 17},                R | W | G | S | D | O | O },
+    { SRTO_ACCEPTWORKERS, "SRTO_ACCEPTWORKERS", RestrictionType::PREBIND, sizeof(int),                0,        16,        0,           4, {-1, 17},                R | W | G | S | D | O | O },
     //SRTO_RENDEZVOUS
     { SRTO_RETRANSMITALGO, "SRTO_RETRANSMITALGO", RestrictionType::PRE,   sizeof(int),                 0,         1,   1,    0, {-1, 2},                               R | W | G | S | D | O | O },
     //SRTO_REUSEADDR
@@ -373,6 +381,8 @@ const OptionTestEntry g_test_matrix_options[] =
     { SRTO_TLPKTDROP,        "SRTO_TLPKTDROP",  RestrictionType::PRE,    sizeof(bool),             false,      true,     true, false, {},                              R | W | G | S | D | O | O },
     //SRTO_TRANSTYPE
     //SRTO_TSBPDMODE
+    { SRTO_UDP_RCVBATCH,  "SRTO_UDP_RCVBATCH", RestrictionType::PREBIND, sizeof(int),                1,        64,        1,          16, {-1, 0, 65},             R | W | G | S | D | O | O },
+    { SRTO_UDP_SNDBATCH,  "SRTO_UDP_SNDBATCH", RestrictionType::PREBIND, sizeof(int),                1,        64,        1,          16, {-1, 0, 65},             R | W | G | S | D | O | O },
     //SRTO_UDP_RCVBUF
     //SRTO_UDP_SNDBUF
     //SRTO_VERSION
@@ -989,6 +999,289 @@ TEST_F(TestSocketOptions, LossMaxTTL)
     ASSERT_NE(srt_close(accepted_sock), SRT_ERROR);
 }
 
+// Checks that the data are delivered when the listener's multiplexer
+// retrieves multiple UDP packets per system call (SRTO_UDP_RCVBATCH),
+// and that the multiplexer statistics reflect that.
+TEST_F(TestSocketOptions, UDPRcvBatch)
+{
+    const int batch = 16;
+    ASSERT_EQ(srt_setsockopt(m_listen_sock, 0, SRTO_UDP_RCVBATCH, &batch, sizeof batch), SRT_SUCCESS);
+
+    StartListener();
+    const SRTSOCKET accepted_sock = EstablishConnection();
+
+    int opt_val = 0;
+    int opt_len = sizeof opt_val;
+    ASSERT_EQ(srt_getsockopt(accepted_sock, 0, SRTO_UDP_RCVBATCH, &opt_val, &opt_len), SRT_SUCCESS);
+    EXPECT_EQ(opt_val, batch) << "Wrong SRTO_UDP_RCVBATCH value on the accepted socket";
+
+    const int nmsgs = 100;
+    char buffer[1316] = {};
+    for (int i = 0; i < nmsgs; ++i)
+    {
+        buffer[0] = char(i);
+        ASSERT_EQ(srt_sendmsg(m_caller_sock, buffer, sizeof buffer, -1, true), int(sizeof buffer));
+    }
+
+    for (int i = 0; i < nmsgs; ++i)
+    {
+        ASSERT_EQ(srt_recvmsg(accepted_sock, buffer, sizeof buffer), int(sizeof buffer));
+        EXPECT_EQ(buffer[0], char(i));
+    }
+
+    SRT_TRACEBSTATS stats;
+    EXPECT_EQ(srt_bstats(accepted_sock, &stats, 0), SRT_SUCCESS);
+    EXPECT_GE(stats.pktMuxRecvTotal, nmsgs);
+    EXPECT_GE(stats.pktMuxRecvTotal, stats.muxRecvCallsTotal);
+    EXPECT_GE(stats.pktMuxRecvBatchMax, 1);
+    EXPECT_LE(stats.pktMuxRecvBatchMax, batch);
+
+    ASSERT_NE(srt_close(accepted_sock), SRT_ERROR);
+}
+
+// Checks that the data are delivered to several sockets accepted by a
+// listener whose multiplexer processes the packets in multiple threads
+// (SRTO_RCVWORKERS). The consecutive socket IDs of the accepted sockets
+// make them distributed over different threads.
+TEST_F(TestSocketOptions, RcvWorkers)
+{
+    const int workers = 4;
+    ASSERT_EQ(srt_setsockopt(m_listen_sock, 0, SRTO_RCVWORKERS, &workers, sizeof workers), SRT_SUCCESS);
+
+    StartListener();
+
+    vector<SRTSOCKET> callers(1, m_caller_sock);
+    vector<SRTSOCKET> accepted(1, EstablishConnection());
+    for (int i = 1; i < workers; ++i)
+    {
+        const int yes = 1;
+        m_caller_sock = srt_create_socket();
+        ASSERT_NE(m_caller_sock, SRT_INVALID_SOCK) << srt_getlasterror_str();
+        ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_RCVSYN, &yes, sizeof yes), SRT_SUCCESS);
+        callers.push_back(m_caller_sock);
+        accepted.push_back(EstablishConnection());
+    }
+
+    int opt_val = 0;
+    int opt_len = sizeof opt_val;
+    ASSERT_EQ(srt_getsockopt(accepted[0], 0, SRTO_RCVWORKERS, &opt_val, &opt_len), SRT_SUCCESS);
+    EXPECT_EQ(opt_val, workers) << "Wrong SRTO_RCVWORKERS value on the accepted socket";
+
+    const int nmsgs = 100;
+    char buffer[1316] = {};
+    for (int i = 0; i < nmsgs; ++i)
+    {
+        for (size_t c = 0; c < callers.size(); ++c)
+        {
+            buffer[0] = char(i);
+            buffer[1] = char(c);
+            ASSERT_EQ(srt_sendmsg(callers[c], buffer, sizeof buffer, -1, true), int(sizeof buffer));
+        }
+    }
+
+    for (size_t c = 0; c < accepted.size(); ++c)
+    {
+        for (int i = 0; i < nmsgs; ++i)
+        {
+            ASSERT_EQ(srt_recvmsg(accepted[c], buffer, sizeof buffer), int(sizeof buffer));
+            EXPECT_EQ(buffer[0], char(i));
+            EXPECT_EQ(buffer[1], char(c));
+        }
+    }
+
+    for (size_t c = 0; c < accepted.size(); ++c)
+        ASSERT_NE(srt_close(accepted[c]), SRT_ERROR);
+    // The last caller is closed by the fixture.
+    for (size_t c = 0; c + 1 < callers.size(); ++c)
+        ASSERT_NE(srt_close(callers[c]), SRT_ERROR);
+}
+
+// Checks that the data are delivered when the caller's multiplexer
+// sends multiple UDP packets per system call (SRTO_UDP_SNDBATCH).
+TEST_F(TestSocketOptions, UDPSndBatch)
+{
+    const int batch = 16;
+    ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_UDP_SNDBATCH, &batch, sizeof batch), SRT_SUCCESS);
+
+    StartListener();
+    const SRTSOCKET accepted_sock = EstablishConnection();
+
+    int opt_val = 0;
+    int opt_len = sizeof opt_val;
+    ASSERT_EQ(srt_getsockopt(m_caller_sock, 0, SRTO_UDP_SNDBATCH, &opt_val, &opt_len), SRT_SUCCESS);
+    EXPECT_EQ(opt_val, batch) << "Wrong SRTO_UDP_SNDBATCH value on the caller socket";
+
+    const int nmsgs = 100;
+    char buffer[1316] = {};
+    for (int i = 0; i < nmsgs; ++i)
+    {
+        buffer[0] = char(i);
+        ASSERT_EQ(srt_sendmsg(m_caller_sock, buffer, sizeof buffer, -1, true), int(sizeof buffer));
+    }
+
+    for (int i = 0; i < nmsgs; ++i)
+    {
+        ASSERT_EQ(srt_recvmsg(accepted_sock, buffer, sizeof buffer), int(sizeof buffer));
+        EXPECT_EQ(buffer[0], char(i));
+    }
+
+    SRT_TRACEBSTATS stats;
+    EXPECT_EQ(srt_bstats(m_caller_sock, &stats, 0), SRT_SUCCESS);
+    EXPECT_GE(stats.pktMuxSentTotal, nmsgs);
+    EXPECT_GE(stats.pktMuxSentTotal, stats.muxSendCallsTotal);
+    EXPECT_GE(stats.pktMuxSendBatchMax, 1);
+    EXPECT_LE(stats.pktMuxSendBatchMax, batch);
+
+    ASSERT_NE(srt_close(accepted_sock), SRT_ERROR);
+}
+
+
+// Sending with the sender worker of the caller's multiplexer
+// waiting for the sending time in the given SRTO_PACINGMODE.
+class TestPacingMode: public TestSocketOptions
+{
+protected:
+    void sendPaced(int mode)
+    {
+        const int spin = 200;
+        ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_PACINGMODE, &mode, sizeof mode), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_PACINGSPIN, &spin, sizeof spin), SRT_SUCCESS);
+
+        // About 1.4 ms per packet, so that the worker sleeps between packets.
+        const int64_t maxbw = 1000000;
+        ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_MAXBW, &maxbw, sizeof maxbw), SRT_SUCCESS);
+
+        StartListener();
+        const SRTSOCKET accepted_sock = EstablishConnection();
+
+        int opt_val = -1;
+        int opt_len = sizeof opt_val;
+        ASSERT_EQ(srt_getsockopt(m_caller_sock, 0, SRTO_PACINGMODE, &opt_val, &opt_len), SRT_SUCCESS);
+        EXPECT_EQ(opt_val, mode) << "Wrong SRTO_PACINGMODE value on the caller socket";
+
+        const int nmsgs = 50;
+        char buffer[1316] = {};
+        for (int i = 0; i < nmsgs; ++i)
+        {
+            buffer[0] = char(i);
+            ASSERT_EQ(srt_sendmsg(m_caller_sock, buffer, sizeof buffer, -1, true), int(sizeof buffer));
+        }
+
+        for (int i = 0; i < nmsgs; ++i)
+        {
+            ASSERT_EQ(srt_recvmsg(accepted_sock, buffer, sizeof buffer), int(sizeof buffer));
+            EXPECT_EQ(buffer[0], char(i));
+        }
+
+        SRT_TRACEBSTATS stats;
+        EXPECT_EQ(srt_bstats(m_caller_sock, &stats, 0), SRT_SUCCESS);
+        int64_t wakeups = 0;
+        for (int i = 0; i < SRT_PACING_HIST_SIZE; ++i)
+        {
+            EXPECT_GE(stats.muxPacingLateHist[i], 0);
+            wakeups += stats.muxPacingLateHist[i];
+        }
+        EXPECT_GT(wakeups, 0) << "No paced wake-ups recorded";
+        EXPECT_LE(wakeups, stats.pktMuxSentTotal);
+
+        ASSERT_NE(srt_close(accepted_sock), SRT_ERROR);
+    }
+};
+
+TEST_F(TestPacingMode, Wait)
+{
+    sendPaced(SRT_PACING_WAIT);
+}
+
+TEST_F(TestPacingMode, TimerFd)
+{
+    sendPaced(SRT_PACING_TIMERFD);
+}
+
+TEST_F(TestPacingMode, Hybrid)
+{
+    sendPaced(SRT_PACING_HYBRID);
+}
+
+TEST_F(TestPacingMode, Spin)
+{
+    sendPaced(SRT_PACING_SPIN);
+}
+
+// Sending packet trains (SRTO_PACINGTRAIN) needs fewer wake-ups
+// of the sender worker, but doesn't exceed SRTO_MAXBW.
+TEST_F(TestSocketOptions, PacingTrain)
+{
+    // About 27 us per packet, so up to 3 packets per train.
+    const int64_t maxbw = 50000000;
+    const int     train = 16;
+
+    // Sends a burst of messages and returns the number of wake-ups
+    // of the sender worker of the caller's multiplexer.
+    auto sendBurst = [maxbw](SRTSOCKET caller, SRTSOCKET accepted) -> int64_t
+    {
+        // Let the RTT be measured.
+        this_thread::sleep_for(chrono::milliseconds(100));
+
+        const int nmsgs = 2000;
+        char buffer[1316] = {};
+        const auto start = chrono::steady_clock::now();
+        for (int i = 0; i < nmsgs; ++i)
+        {
+            buffer[0] = char(i);
+            EXPECT_EQ(srt_sendmsg(caller, buffer, sizeof buffer, -1, true), int(sizeof buffer));
+        }
+
+        SRT_TRACEBSTATS stats;
+        for (int i = 0; i < 200; ++i)
+        {
+            EXPECT_EQ(srt_bstats(accepted, &stats, 0), SRT_SUCCESS);
+            if (stats.pktRecvTotal >= nmsgs)
+                break;
+            this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        const auto elapsed = chrono::steady_clock::now() - start;
+        EXPECT_GE(stats.pktRecvTotal, nmsgs);
+
+        // Not faster than SRTO_MAXBW allows, with some tolerance.
+        const double bytes = double(stats.byteRecvTotal) + stats.pktRecvTotal * 44.0;
+        EXPECT_GE(chrono::duration<double>(elapsed).count(), 0.8 * bytes / maxbw);
+
+        for (int i = 0; i < nmsgs; ++i)
+        {
+            EXPECT_EQ(srt_recvmsg(accepted, buffer, sizeof buffer), int(sizeof buffer));
+            EXPECT_EQ(buffer[0], char(i));
+        }
+
+        EXPECT_EQ(srt_bstats(caller, &stats, 0), SRT_SUCCESS);
+        int64_t wakeups = 0;
+        for (int i = 0; i < SRT_PACING_HIST_SIZE; ++i)
+            wakeups += stats.muxPacingLateHist[i];
+        return wakeups;
+    };
+
+    // The other caller uses its own multiplexer and sends packet by packet.
+    const SRTSOCKET single_caller = srt_create_socket();
+    ASSERT_NE(single_caller, SRT_INVALID_SOCK);
+    ASSERT_EQ(srt_setsockopt(single_caller, 0, SRTO_MAXBW, &maxbw, sizeof maxbw), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_MAXBW, &maxbw, sizeof maxbw), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockopt(m_caller_sock, 0, SRTO_PACINGTRAIN, &train, sizeof train), SRT_SUCCESS);
+
+    StartListener();
+    const SRTSOCKET accepted_sock = EstablishConnection();
+    ASSERT_EQ(srt_connect(single_caller, (const sockaddr*)&m_sa, sizeof m_sa), SRT_SUCCESS);
+    const SRTSOCKET single_accepted = srt_accept(m_listen_sock, NULL, NULL);
+    ASSERT_NE(single_accepted, SRT_INVALID_SOCK);
+
+    const int64_t wakeups_single = sendBurst(single_caller, single_accepted);
+    const int64_t wakeups_train  = sendBurst(m_caller_sock, accepted_sock);
+    EXPECT_LT(wakeups_train, wakeups_single) << "Packets not sent in trains";
+
+    ASSERT_NE(srt_close(single_accepted), SRT_ERROR);
+    ASSERT_NE(srt_close(single_caller), SRT_ERROR);
+    ASSERT_NE(srt_close(accepted_sock), SRT_ERROR);
+}
+
 
 // Try to set/get SRTO_MININPUTBW with wrong optlen
 TEST_F(TestSocketOptions, MinInputBWWrongLen)
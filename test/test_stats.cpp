@@ -0,0 +1,228 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// The connection statistics (srt_bstats), counted without a lock
+// by the threads handling the connection.
+class TestStats : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+    }
+
+    void teardown() override
+    {
+        for (size_t i = 0; i < m_callers.size(); ++i)
+            srt_close(m_callers[i]);
+        for (size_t i = 0; i < m_accepted.size(); ++i)
+            srt_close(m_accepted[i]);
+        srt_close(m_listen_sock);
+    }
+
+    static void setFileMode(SRTSOCKET s)
+    {
+        const SRT_TRANSTYPE type = SRTT_FILE;
+        const bool          yes  = true;
+        ASSERT_EQ(srt_setsockflag(s, SRTO_TRANSTYPE, &type, sizeof type), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(s, SRTO_MESSAGEAPI, &yes, sizeof yes), SRT_SUCCESS);
+    }
+
+    void connect(int nconn)
+    {
+        setFileMode(m_listen_sock);
+        sockaddr_any addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, addr.get(), addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, nconn), SRT_ERROR);
+
+        for (int i = 0; i < nconn; ++i)
+        {
+            const SRTSOCKET caller = srt_create_socket();
+            ASSERT_NE(caller, SRT_INVALID_SOCK);
+            m_callers.push_back(caller);
+            setFileMode(caller);
+            ASSERT_NE(srt_connect(caller, addr.get(), addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+            sockaddr_any peer;
+            const SRTSOCKET accepted = srt_accept(m_listen_sock, peer.get(), &peer.len);
+            ASSERT_NE(accepted, SRT_INVALID_SOCK);
+            m_accepted.push_back(accepted);
+        }
+    }
+
+    void transfer(int conn, int nmsgs)
+    {
+        const int    len = 1316;
+        vector<char> buf(len);
+        for (int m = 0; m < nmsgs; ++m)
+            ASSERT_EQ(srt_sendmsg(m_callers[conn], &buf[0], len, -1, true), len) << srt_getlasterror_str();
+        for (int m = 0; m < nmsgs; ++m)
+            ASSERT_EQ(srt_recvmsg(m_accepted[conn], &buf[0], len), len) << "Message #" << m;
+    }
+
+    SRTSOCKET         m_listen_sock;
+    vector<SRTSOCKET> m_callers;
+    vector<SRTSOCKET> m_accepted;
+};
+
+// Clearing the statistics starts a new trace period, keeping the totals.
+TEST_F(TestStats, TraceAndTotal)
+{
+    connect(1);
+    transfer(0, 10);
+
+    SRT_TRACEBSTATS snd, rcv;
+    ASSERT_EQ(srt_bstats(m_callers[0], &snd, 1), 0);
+    ASSERT_EQ(srt_bstats(m_accepted[0], &rcv, 1), 0);
+    EXPECT_EQ(snd.pktSentUnique, 10);
+    EXPECT_EQ(snd.pktSentUniqueTotal, 10);
+    EXPECT_EQ(snd.byteSentUnique, snd.byteSentUniqueTotal);
+    EXPECT_EQ(rcv.pktRecvUnique, 10);
+    EXPECT_EQ(rcv.pktRecvUniqueTotal, 10);
+
+    transfer(0, 5);
+
+    ASSERT_EQ(srt_bstats(m_callers[0], &snd, 0), 0);
+    ASSERT_EQ(srt_bstats(m_accepted[0], &rcv, 0), 0);
+    EXPECT_EQ(snd.pktSentUnique, 5);
+    EXPECT_EQ(snd.pktSentUniqueTotal, 15);
+    EXPECT_EQ(snd.byteSentUnique * 3, snd.byteSentUniqueTotal);
+    EXPECT_EQ(rcv.pktRecvUnique, 5);
+    EXPECT_EQ(rcv.pktRecvUniqueTotal, 15);
+}
+
+// Nothing counted while the statistics are read and cleared
+// is lost: the traces read add up to the total.
+TEST_F(TestStats, ConcurrentClear)
+{
+    connect(1);
+
+    atomic<bool>    done(false);
+    int64_t         snd_traces = 0, rcv_traces = 0;
+    SRT_TRACEBSTATS snd, rcv;
+    thread poller([&] {
+        while (!done)
+        {
+            if (srt_bstats(m_callers[0], &snd, 1) == 0)
+                snd_traces += snd.pktSentUnique;
+            if (srt_bstats(m_accepted[0], &rcv, 1) == 0)
+                rcv_traces += rcv.pktRecvUnique;
+        }
+    });
+
+    transfer(0, 2000);
+    done = true;
+    poller.join();
+
+    ASSERT_EQ(srt_bstats(m_callers[0], &snd, 1), 0);
+    ASSERT_EQ(srt_bstats(m_accepted[0], &rcv, 1), 0);
+    EXPECT_EQ(snd.pktSentUniqueTotal, 2000);
+    EXPECT_EQ(snd_traces + snd.pktSentUnique, snd.pktSentUniqueTotal);
+    EXPECT_EQ(rcv.pktRecvUniqueTotal, 2000);
+    EXPECT_EQ(rcv_traces + rcv.pktRecvUnique, rcv.pktRecvUniqueTotal);
+}
+
+// The statistics of the multiplexer workers, counted for all the
+// sockets bound to it.
+TEST_F(TestStats, MuxStats)
+{
+    SRT_MUXSTATS mux;
+    EXPECT_EQ(srt_muxstats(m_listen_sock, &mux), SRT_ERROR);
+    EXPECT_EQ(srt_getlasterror(NULL), SRT_EUNBOUNDSOCK);
+
+    connect(1);
+    transfer(0, 100);
+
+    ASSERT_EQ(srt_muxstats(m_callers[0], &mux), 0);
+    EXPECT_GE(mux.pktSent, 100);
+    EXPECT_GT(mux.sndCalls, 0);
+    EXPECT_GT(mux.sndIterations, 0);
+    EXPECT_GT(mux.sndWakeups, 0);
+    EXPECT_GE(mux.sndListLength, 0);
+
+    ASSERT_EQ(srt_muxstats(m_accepted[0], &mux), 0);
+    EXPECT_EQ(mux.muxPort, 5200);
+    EXPECT_GE(mux.pktRecv, 100);
+    EXPECT_GT(mux.rcvCalls, 0);
+    EXPECT_GE(mux.rcvSyscalls, mux.rcvCalls);
+    EXPECT_GE(mux.rcvIterations, mux.rcvCalls);
+    EXPECT_GT(mux.rcvUnitsTotal, 0);
+    EXPECT_LE(mux.rcvUnitsFree, mux.rcvUnitsTotal);
+
+    SRT_MUXSTATS listener_mux;
+    ASSERT_EQ(srt_muxstats(m_listen_sock, &listener_mux), 0);
+    EXPECT_EQ(listener_mux.muxID, mux.muxID);
+}
+
+// Benchmark: the transfer rate of many connections, with and without
+// another thread polling the statistics of all of them in a loop.
+TEST_F(TestStats, DISABLED_BenchmarkPollingContention)
+{
+    const int NCONN      = 100;
+    const int NMSGS      = 2000;
+    const int LEN        = 1316;
+    connect(NCONN);
+
+    for (int polling = 0; polling < 2; ++polling)
+    {
+        atomic<bool>    done(false);
+        atomic<int64_t> polls(0);
+        thread          poller;
+        if (polling)
+        {
+            poller = thread([&] {
+                SRT_TRACEBSTATS perf;
+                while (!done)
+                {
+                    for (int c = 0; c < NCONN; ++c)
+                    {
+                        srt_bstats(m_callers[c], &perf, 1);
+                        srt_bstats(m_accepted[c], &perf, 1);
+                    }
+                    polls += 2 * NCONN;
+                }
+            });
+        }
+
+        const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int c = 0; c < NCONN; ++c)
+        {
+            workers.push_back(thread([&, c] {
+                vector<char> buf(LEN);
+                for (int m = 0; m < NMSGS; ++m)
+                    srt_sendmsg(m_callers[c], &buf[0], LEN, -1, true);
+            }));
+            workers.push_back(thread([&, c] {
+                vector<char> buf(LEN);
+                for (int m = 0; m < NMSGS; ++m)
+                    srt_recvmsg(m_accepted[c], &buf[0], LEN);
+            }));
+        }
+        for (size_t i = 0; i < workers.size(); ++i)
+            workers[i].join();
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        done = true;
+        if (poller.joinable())
+            poller.join();
+
+        cerr << (polling ? "With polling:    " : "Without polling: ") << (double(NCONN) * NMSGS * LEN * 8 / seconds / 1e6)
+             << " Mbps total";
+        if (polling)
+            cerr << ", " << int64_t(polls / seconds) << " srt_bstats calls/s";
+        cerr << "\n";
+    }
+}
@@ -0,0 +1,161 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#ifdef _WIN32
+#define INC_SRT_WIN_WINTIME // exclude gettimeofday from srt headers
+#else
+typedef int SOCKET;
+#define INVALID_SOCKET ((SOCKET)-1)
+#define closesocket close
+#endif
+
+#include "platform_sys.h"
+#include "srt.h"
+#include "common.h"
+#include "handshake.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// The reference vectors of SipHash-2-4: key 00..0f, message 00..(len-1).
+TEST(CSipHash, ReferenceVectors)
+{
+    unsigned char key[CSipHash::KEY_SIZE];
+    unsigned char msg[15];
+    for (size_t i = 0; i < sizeof key; ++i)
+        key[i] = (unsigned char)i;
+    for (size_t i = 0; i < sizeof msg; ++i)
+        msg[i] = (unsigned char)i;
+
+    EXPECT_EQ(CSipHash::compute(key, msg, 0), 0x726fdb47dd0e0e31ULL);
+    EXPECT_EQ(CSipHash::compute(key, msg, 8), 0x93f5f5799a932462ULL);
+    EXPECT_EQ(CSipHash::compute(key, msg, 15), 0xa129ca6149be45e5ULL);
+}
+
+// The induction requests (the first handshake of a caller) sent to a
+// listener directly over UDP, the way a flood of reconnecting callers does.
+class TestSynCookie : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+        m_udp_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        ASSERT_NE(m_udp_sock, INVALID_SOCKET);
+
+        const sockaddr_any local = srt::CreateAddr("127.0.0.1", 0, AF_INET);
+        ASSERT_NE(::bind(m_udp_sock, local.get(), local.size()), -1);
+#ifdef _WIN32
+        DWORD timeout_ms = 200;
+#else
+        timeval timeout_ms = {0, 200000};
+#endif
+        ASSERT_NE(setsockopt(m_udp_sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout_ms, sizeof timeout_ms), -1);
+    }
+
+    void teardown() override
+    {
+        srt_close(m_listen_sock);
+        closesocket(m_udp_sock);
+    }
+
+    void listen(int induction_rate)
+    {
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_INDUCTIONRATE, &induction_rate, sizeof induction_rate), SRT_SUCCESS);
+        m_addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, m_addr.get(), m_addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, 1), SRT_ERROR);
+    }
+
+    void sendInductions(int n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            CHandShake hs;
+            hs.m_iVersion        = 4;
+            hs.m_iType           = UDT_DGRAM;
+            hs.m_iISN            = 1000;
+            hs.m_iMSS            = 1500;
+            hs.m_iFlightFlagSize = 8192;
+            hs.m_iReqType        = URQ_INDUCTION;
+            hs.m_iID             = 1000 + i;
+
+            // Control packet header (UMSG_HANDSHAKE to socket 0), then the handshake,
+            // all in the network byte order.
+            uint32_t words[4 + CHandShake::m_iContentSize / 4] = {0x80000000, 0, 0, 0};
+            size_t   size = CHandShake::m_iContentSize;
+            hs.store_to((char*)&words[4], (size));
+            for (size_t w = 0; w < sizeof words / sizeof words[0]; ++w)
+                words[w] = htonl(words[w]);
+
+            ASSERT_EQ(::sendto(m_udp_sock, (const char*)words, sizeof words, 0, m_addr.get(), m_addr.size()),
+                      int(sizeof words));
+        }
+    }
+
+    // Count the responses until none comes for 200 ms.
+    int receiveResponses()
+    {
+        int  count = 0;
+        char buf[1500];
+        while (::recv(m_udp_sock, buf, sizeof buf, 0) > 0)
+            ++count;
+        return count;
+    }
+
+    SRTSOCKET    m_listen_sock;
+    SOCKET       m_udp_sock;
+    sockaddr_any m_addr;
+};
+
+TEST_F(TestSynCookie, Unlimited)
+{
+    listen(0);
+    sendInductions(100);
+    EXPECT_EQ(receiveResponses(), 100);
+}
+
+// Within a second, only as many requests as the rate are responded.
+TEST_F(TestSynCookie, RateLimit)
+{
+    listen(20);
+    sendInductions(100);
+    const int responses = receiveResponses();
+    EXPECT_GE(responses, 20);
+    EXPECT_LE(responses, 25);
+}
+
+// Benchmark: the rate of handling the induction requests by the listener.
+TEST_F(TestSynCookie, DISABLED_BenchmarkInductionRate)
+{
+    const int NREQ = 200000;
+    listen(0);
+
+    atomic<bool> done(false);
+    atomic<int>  responses(0);
+    thread       receiver([&] {
+        char buf[1500];
+        while (!done)
+        {
+            if (::recv(m_udp_sock, buf, sizeof buf, 0) > 0)
+                ++responses;
+        }
+    });
+
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    sendInductions(NREQ);
+    this_thread::sleep_for(chrono::milliseconds(200));
+    done = true;
+    receiver.join();
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() - 0.2;
+
+    cerr << "Induction requests sent: " << NREQ << " responded: " << responses << " in " << seconds << " s ("
+         << int64_t(responses / seconds) << "/s)\n";
+}
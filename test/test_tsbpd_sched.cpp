@@ -0,0 +1,186 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <dirent.h>
+#include <fstream>
+#endif
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// Delivery of the received packets by the TSBPD threads shared
+// by all sockets (srt_set_tsbpd_threads()).
+class TestTsbPdScheduler : public srt::Test
+{
+protected:
+    static const int NCONN   = 4;
+    static const int LATENCY = 120; // ms
+
+    void setup() override
+    {
+        ASSERT_EQ(srt_set_tsbpd_threads(2), 0);
+
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+        const int latency = LATENCY;
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_RCVLATENCY, &latency, sizeof latency), SRT_SUCCESS);
+
+        sockaddr_any addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, addr.get(), addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, NCONN), SRT_ERROR);
+
+        for (int i = 0; i < NCONN; ++i)
+        {
+            const SRTSOCKET caller = srt_create_socket();
+            ASSERT_NE(caller, SRT_INVALID_SOCK);
+            m_callers.push_back(caller);
+            ASSERT_NE(srt_connect(caller, addr.get(), addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+            sockaddr_any peer;
+            const SRTSOCKET accepted = srt_accept(m_listen_sock, peer.get(), &peer.len);
+            ASSERT_NE(accepted, SRT_INVALID_SOCK);
+            m_accepted.push_back(accepted);
+        }
+    }
+
+    void teardown() override
+    {
+        for (size_t i = 0; i < m_callers.size(); ++i)
+            srt_close(m_callers[i]);
+        for (size_t i = 0; i < m_accepted.size(); ++i)
+            srt_close(m_accepted[i]);
+        srt_close(m_listen_sock);
+        srt_set_tsbpd_threads(0);
+    }
+
+#ifdef __linux__
+    // Count the threads of this process with the name starting with @a prefix.
+    static int countThreads(const string& prefix)
+    {
+        int  count = 0;
+        DIR* dir   = opendir("/proc/self/task");
+        if (!dir)
+            return -1;
+        while (dirent* ent = readdir(dir))
+        {
+            if (ent->d_name[0] == '.')
+                continue;
+            ifstream comm((string("/proc/self/task/") + ent->d_name + "/comm").c_str());
+            string   name;
+            getline(comm, name);
+            if (name.compare(0, prefix.size(), prefix) == 0)
+                ++count;
+        }
+        closedir(dir);
+        return count;
+    }
+#endif
+
+    static void fillPattern(vector<char>& w_buf, int conn, int msgindex)
+    {
+        for (size_t i = 0; i < w_buf.size(); ++i)
+            w_buf[i] = char(conn * 31 + msgindex * 7 + i);
+    }
+
+    SRTSOCKET         m_listen_sock;
+    vector<SRTSOCKET> m_callers;
+    vector<SRTSOCKET> m_accepted;
+};
+
+// The messages are delivered in order, not earlier than at their
+// TSBPD time, both to the blocking and to the non-blocking readers.
+TEST_F(TestTsbPdScheduler, LiveDelivery)
+{
+    // The first connection is read in the blocking mode, others with epoll.
+    const bool no = false;
+    const int  eid = srt_epoll_create();
+    ASSERT_GE(eid, 0);
+    for (int c = 1; c < NCONN; ++c)
+    {
+        ASSERT_EQ(srt_setsockflag(m_accepted[c], SRTO_RCVSYN, &no, sizeof no), SRT_SUCCESS);
+        const int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+        ASSERT_EQ(srt_epoll_add_usock(eid, m_accepted[c], &events), SRT_SUCCESS);
+    }
+
+    const int    nmsgs = 30;
+    const int    len   = 1000;
+    vector<char>    buf(len);
+    vector<int64_t> sent_time(nmsgs);
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        sent_time[m] = srt_time_now();
+        for (int c = 0; c < NCONN; ++c)
+        {
+            fillPattern((buf), c, m);
+            ASSERT_EQ(srt_sendmsg(m_callers[c], &buf[0], len, -1, true), len) << srt_getlasterror_str();
+        }
+    }
+
+    vector<char> rcvbuf(1500);
+    vector<char> expected(len);
+    vector<int>  received(NCONN, 0);
+
+    // Blocking reader.
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        SRT_MSGCTRL mc = srt_msgctrl_default;
+        ASSERT_EQ(srt_recvmsg2(m_accepted[0], &rcvbuf[0], (int)rcvbuf.size(), &mc), len) << srt_getlasterror_str();
+        EXPECT_GE(srt_time_now() - sent_time[m], (LATENCY - 10) * 1000) << "Message #" << m << " delivered too early";
+        fillPattern((expected), 0, m);
+        ASSERT_TRUE(equal(expected.begin(), expected.end(), rcvbuf.begin())) << "Message #" << m;
+    }
+    received[0] = nmsgs;
+
+    // The threads are started when the first packet is received.
+#ifdef __linux__
+    EXPECT_EQ(countThreads("SRT:TsbPd:s"), 2);
+    EXPECT_EQ(countThreads("SRT:TsbPd"), 2) << "No per-socket TSBPD thread expected";
+#endif
+
+    // Non-blocking readers.
+    int total = nmsgs;
+    while (total < nmsgs * NCONN)
+    {
+        SRT_EPOLL_EVENT ready[NCONN];
+        const int       nready = srt_epoll_uwait(eid, ready, NCONN, 3000);
+        ASSERT_GT(nready, 0) << "Messages not delivered in time";
+        for (int i = 0; i < nready; ++i)
+        {
+            int c = 1;
+            while (m_accepted[c] != ready[i].fd)
+                ++c;
+
+            for (;;)
+            {
+                SRT_MSGCTRL mc = srt_msgctrl_default;
+                const int   st = srt_recvmsg2(ready[i].fd, &rcvbuf[0], (int)rcvbuf.size(), &mc);
+                if (st == SRT_ERROR)
+                {
+                    ASSERT_EQ(srt_getlasterror(NULL), SRT_EASYNCRCV);
+                    break;
+                }
+                ASSERT_EQ(st, len);
+                EXPECT_GE(srt_time_now() - sent_time[received[c]], (LATENCY - 10) * 1000) << "Message #" << received[c] << " delivered too early";
+                fillPattern((expected), c, received[c]);
+                ASSERT_TRUE(equal(expected.begin(), expected.end(), rcvbuf.begin())) << "Message #" << received[c];
+                ++received[c];
+                ++total;
+            }
+        }
+    }
+
+    srt_epoll_release(eid);
+}
+
+TEST(TsbPdScheduler, InvalidThreads)
+{
+    EXPECT_EQ(srt_set_tsbpd_threads(-1), SRT_ERROR);
+    EXPECT_EQ(srt_set_tsbpd_threads(65), SRT_ERROR);
+    EXPECT_EQ(srt_set_tsbpd_threads(0), 0);
+}
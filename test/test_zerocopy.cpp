@@ -0,0 +1,252 @@
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_env.h"
+
+#include "srt.h"
+#include "netinet_any.h"
+
+using namespace std;
+using namespace srt;
+
+// Sending and receiving without copying the payload between
+// the application buffers and the SRT buffers.
+class TestZeroCopy : public srt::Test
+{
+protected:
+    void setup() override
+    {
+        m_caller_sock = srt_create_socket();
+        ASSERT_NE(m_caller_sock, SRT_INVALID_SOCK);
+        m_listen_sock = srt_create_socket();
+        ASSERT_NE(m_listen_sock, SRT_INVALID_SOCK);
+        m_accepted_sock = SRT_INVALID_SOCK;
+    }
+
+    void teardown() override
+    {
+        srt_close(m_caller_sock);
+        srt_close(m_accepted_sock);
+        srt_close(m_listen_sock);
+    }
+
+    void setFileMessageMode()
+    {
+        const SRT_TRANSTYPE file = SRTT_FILE;
+        const bool          yes  = true;
+        ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_TRANSTYPE, &file, sizeof file), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_MESSAGEAPI, &yes, sizeof yes), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_TRANSTYPE, &file, sizeof file), SRT_SUCCESS);
+        ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_MESSAGEAPI, &yes, sizeof yes), SRT_SUCCESS);
+    }
+
+    void connect()
+    {
+        sockaddr_any addr = srt::CreateAddr("127.0.0.1", 5200, AF_INET);
+        ASSERT_NE(srt_bind(m_listen_sock, addr.get(), addr.size()), SRT_ERROR);
+        ASSERT_NE(srt_listen(m_listen_sock, 1), SRT_ERROR);
+        ASSERT_NE(srt_connect(m_caller_sock, addr.get(), addr.size()), SRT_ERROR) << srt_getlasterror_str();
+
+        sockaddr_any peer;
+        m_accepted_sock = srt_accept(m_listen_sock, peer.get(), &peer.len);
+        ASSERT_NE(m_accepted_sock, SRT_INVALID_SOCK);
+    }
+
+    // The payload of the message is a byte pattern depending on the
+    // message index, so that it can be verified without keeping a copy.
+    static char patternByte(int msgindex, int offset) { return char(msgindex * 7 + offset); }
+
+    struct Filler
+    {
+        int         msgindex;
+        int         fail_at_call; // -1: never fail
+        int         calls;
+        vector<int> offsets;
+        vector<int> sizes;
+
+        explicit Filler(int m, int fail_at = -1)
+            : msgindex(m)
+            , fail_at_call(fail_at)
+            , calls(0)
+        {
+        }
+    };
+
+    static int fillPattern(void* opaque, char* block, int offset, int size)
+    {
+        Filler* f = static_cast<Filler*>(opaque);
+        if (f->calls++ == f->fail_at_call)
+            return -1;
+        f->offsets.push_back(offset);
+        f->sizes.push_back(size);
+        for (int i = 0; i < size; ++i)
+            block[i] = patternByte(f->msgindex, offset + i);
+        return 0;
+    }
+
+    static void expectPattern(const char* data, int len, int msgindex)
+    {
+        for (int i = 0; i < len; ++i)
+        {
+            if (data[i] != patternByte(msgindex, i))
+            {
+                ADD_FAILURE() << "Message #" << msgindex << ": wrong byte at offset " << i;
+                return;
+            }
+        }
+    }
+
+    SRTSOCKET m_caller_sock;
+    SRTSOCKET m_listen_sock;
+    SRTSOCKET m_accepted_sock;
+};
+
+// Live mode: each message fits in a single packet, so the callback
+// is called once per message for the whole payload.
+TEST_F(TestZeroCopy, SendFillLive)
+{
+    connect();
+
+    const int len = 1316;
+    const int nmsgs = 50;
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        Filler f(m);
+        ASSERT_EQ(srt_sendmsg_fill(m_caller_sock, len, &fillPattern, &f, NULL), len) << srt_getlasterror_str();
+        ASSERT_EQ(f.calls, 1);
+        EXPECT_EQ(f.offsets[0], 0);
+        EXPECT_EQ(f.sizes[0], len);
+    }
+
+    vector<char> buf(1500);
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        ASSERT_EQ(srt_recvmsg(m_accepted_sock, &buf[0], (int)buf.size()), len);
+        expectPattern(&buf[0], len, m);
+    }
+}
+
+// File/message mode: a message spans several packets and the callback
+// fills consecutive parts of it.
+TEST_F(TestZeroCopy, SendFillMessage)
+{
+    setFileMessageMode();
+    connect();
+
+    const int len = 10000;
+    Filler f(3);
+    ASSERT_EQ(srt_sendmsg_fill(m_caller_sock, len, &fillPattern, &f, NULL), len) << srt_getlasterror_str();
+    ASSERT_GT(f.calls, 1);
+    int expected_offset = 0;
+    for (size_t i = 0; i < f.offsets.size(); ++i)
+    {
+        EXPECT_EQ(f.offsets[i], expected_offset);
+        expected_offset += f.sizes[i];
+    }
+    EXPECT_EQ(expected_offset, len);
+
+    vector<char> buf(len);
+    ASSERT_EQ(srt_recvmsg(m_accepted_sock, &buf[0], len), len);
+    expectPattern(&buf[0], len, 3);
+}
+
+// A message whose filling failed is not sent at all,
+// and the next message is sent normally.
+TEST_F(TestZeroCopy, SendFillCancel)
+{
+    setFileMessageMode();
+    connect();
+
+    const int len = 5000;
+    Filler failing(1, 2);
+    EXPECT_EQ(srt_sendmsg_fill(m_caller_sock, len, &fillPattern, &failing, NULL), SRT_ERROR);
+    EXPECT_EQ(srt_getlasterror(NULL), SRT_EINVPARAM);
+
+    EXPECT_EQ(srt_sendmsg_fill(m_caller_sock, len, NULL, NULL, NULL), SRT_ERROR);
+
+    SRT_MSGCTRL mc = srt_msgctrl_default;
+    Filler      f(2);
+    ASSERT_EQ(srt_sendmsg_fill(m_caller_sock, len, &fillPattern, &f, &mc), len) << srt_getlasterror_str();
+    EXPECT_EQ(mc.msgno, 1) << "The cancelled message must not take a message number";
+
+    vector<char> buf(len);
+    ASSERT_EQ(srt_recvmsg2(m_accepted_sock, &buf[0], len, &mc), len);
+    EXPECT_EQ(mc.msgno, 1);
+    expectPattern(&buf[0], len, 2);
+}
+
+namespace
+{
+struct Viewer
+{
+    vector<char> message;
+    vector<int>  offsets;
+
+    static void collect(void* opaque, const char* data, int offset, int size)
+    {
+        Viewer* v = static_cast<Viewer*>(opaque);
+        v->offsets.push_back(offset);
+        v->message.insert(v->message.end(), data, data + size);
+    }
+};
+} // namespace
+
+// Live mode: the single packet of each message is passed to the callback.
+TEST_F(TestZeroCopy, RecvViewLive)
+{
+    connect();
+
+    const int len = 1316;
+    const int nmsgs = 50;
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        Filler f(m);
+        ASSERT_EQ(srt_sendmsg_fill(m_caller_sock, len, &fillPattern, &f, NULL), len) << srt_getlasterror_str();
+    }
+
+    for (int m = 0; m < nmsgs; ++m)
+    {
+        Viewer v;
+        ASSERT_EQ(srt_recvmsg_view(m_accepted_sock, &Viewer::collect, &v, NULL), len) << srt_getlasterror_str();
+        ASSERT_EQ(v.offsets.size(), 1u);
+        ASSERT_EQ(v.message.size(), size_t(len));
+        expectPattern(&v.message[0], len, m);
+    }
+
+    EXPECT_EQ(srt_recvmsg_view(m_accepted_sock, NULL, NULL, NULL), SRT_ERROR);
+    EXPECT_EQ(srt_getlasterror(NULL), SRT_EINVPARAM);
+}
+
+// File/message mode: the packets of a message are passed in order.
+TEST_F(TestZeroCopy, RecvViewMessage)
+{
+    setFileMessageMode();
+    connect();
+
+    const int   len = 10000;
+    SRT_MSGCTRL mc  = srt_msgctrl_default;
+    Filler      f(5);
+    ASSERT_EQ(srt_sendmsg_fill(m_caller_sock, len, &fillPattern, &f, &mc), len) << srt_getlasterror_str();
+    const int msgno = mc.msgno;
+
+    Viewer v;
+    mc = srt_msgctrl_default;
+    ASSERT_EQ(srt_recvmsg_view(m_accepted_sock, &Viewer::collect, &v, &mc), len) << srt_getlasterror_str();
+    EXPECT_EQ(mc.msgno, msgno);
+    EXPECT_EQ(v.offsets.size(), f.offsets.size());
+    EXPECT_EQ(v.offsets, f.offsets);
+    ASSERT_EQ(v.message.size(), size_t(len));
+    expectPattern(&v.message[0], len, 5);
+}
+
+// In the stream mode there are no messages to view.
+TEST_F(TestZeroCopy, RecvViewStream)
+{
+    const SRT_TRANSTYPE file = SRTT_FILE;
+    ASSERT_EQ(srt_setsockflag(m_caller_sock, SRTO_TRANSTYPE, &file, sizeof file), SRT_SUCCESS);
+    ASSERT_EQ(srt_setsockflag(m_listen_sock, SRTO_TRANSTYPE, &file, sizeof file), SRT_SUCCESS);
+    connect();
+
+    Viewer v;
+    EXPECT_EQ(srt_recvmsg_view(m_accepted_sock, &Viewer::collect, &v, NULL), SRT_ERROR);
+    EXPECT_EQ(srt_getlasterror(NULL), SRT_EINVALBUFFERAPI);
+}
@@ -0,0 +1,347 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2026 Haivision Systems Inc.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ */
+
+// Load test of accepting connections: a crowd of callers connect
+// to the listener at once, then disconnect and reconnect again, the given
+// number of rounds. Meanwhile a probe connection, established before, sends
+// a message every 10 ms, stamped with the time of sending, and the greatest
+// delay of these messages in every round shows how much the data of the
+// established connections are held up by the processing of the handshakes
+// (compare with and without SRTO_ACCEPTWORKERS).
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define REQUIRE_CXX11 1
+
+#include "apputil.hpp"  // CreateAddr, ProcessOptions
+#include "logsupport.hpp"
+
+#include <srt.h>
+
+using namespace std;
+using srt::sockaddr_any;
+
+namespace
+{
+
+typedef chrono::steady_clock Clock;
+
+struct Config
+{
+    int    callers;
+    int    rounds;
+    int    workers;
+    int    port;
+    string passphrase;
+};
+
+int64_t NowUs()
+{
+    return chrono::duration_cast<chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+double SecondsSince(Clock::time_point start)
+{
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+bool Configure(SRTSOCKET s, const Config& cfg)
+{
+    const SRT_TRANSTYPE type = SRTT_FILE;
+    const bool          yes  = true;
+    if (srt_setsockflag(s, SRTO_TRANSTYPE, &type, sizeof type) == SRT_ERROR
+        || srt_setsockflag(s, SRTO_MESSAGEAPI, &yes, sizeof yes) == SRT_ERROR)
+        return false;
+
+    if (!cfg.passphrase.empty()
+        && srt_setsockflag(s, SRTO_PASSPHRASE, cfg.passphrase.c_str(), (int)cfg.passphrase.size()) == SRT_ERROR)
+        return false;
+
+    return true;
+}
+
+// The connections accepted by the listener while the test is running.
+class Acceptor
+{
+    SRTSOCKET         m_listener;
+    thread            m_thread;
+    mutex             m_lock;
+    vector<SRTSOCKET> m_accepted;
+
+public:
+    Acceptor(SRTSOCKET listener) : m_listener(listener)
+    {
+        m_thread = thread([this] {
+            for (;;)
+            {
+                sockaddr_any    peer;
+                const SRTSOCKET s = srt_accept(m_listener, peer.get(), &peer.len);
+                if (s == SRT_INVALID_SOCK)
+                    break; // The listener was closed
+                lock_guard<mutex> lk(m_lock);
+                m_accepted.push_back(s);
+            }
+        });
+    }
+
+    // The listener must be closed before.
+    ~Acceptor() { m_thread.join(); }
+
+    size_t count()
+    {
+        lock_guard<mutex> lk(m_lock);
+        return m_accepted.size();
+    }
+
+    void closeAll()
+    {
+        lock_guard<mutex> lk(m_lock);
+        for (size_t i = 0; i < m_accepted.size(); ++i)
+            srt_close(m_accepted[i]);
+        m_accepted.clear();
+    }
+};
+
+// The connection sending the time-stamped messages.
+class Probe
+{
+    SRTSOCKET        m_caller;
+    SRTSOCKET        m_accepted;
+    atomic<bool>     m_done;
+    atomic<int64_t>  m_maxDelay;
+    atomic<int64_t>  m_received;
+    thread           m_sender;
+    thread           m_receiver;
+
+public:
+    Probe()
+        : m_caller(SRT_INVALID_SOCK)
+        , m_accepted(SRT_INVALID_SOCK)
+        , m_done(false)
+        , m_maxDelay(0)
+        , m_received(0)
+    {
+    }
+
+    bool connect(SRTSOCKET listener, const sockaddr_any& addr, const Config& cfg)
+    {
+        m_caller = srt_create_socket();
+        if (!Configure(m_caller, cfg) || srt_connect(m_caller, addr.get(), addr.size()) == SRT_ERROR)
+            return false;
+
+        sockaddr_any peer;
+        m_accepted = srt_accept(listener, peer.get(), &peer.len);
+        return m_accepted != SRT_INVALID_SOCK;
+    }
+
+    void start()
+    {
+        m_sender = thread([this] {
+            while (!m_done)
+            {
+                const int64_t stamp = NowUs();
+                srt_sendmsg(m_caller, (const char*)&stamp, sizeof stamp, -1, true);
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+        });
+
+        m_receiver = thread([this] {
+            int64_t stamp;
+            while (srt_recvmsg(m_accepted, (char*)&stamp, sizeof stamp) == (int)sizeof stamp)
+            {
+                const int64_t delay = NowUs() - stamp;
+                int64_t       prev  = m_maxDelay;
+                while (delay > prev && !m_maxDelay.compare_exchange_weak(prev, delay))
+                {
+                }
+                ++m_received;
+            }
+        });
+    }
+
+    void stop()
+    {
+        m_done = true;
+        if (m_sender.joinable())
+            m_sender.join();
+        srt_close(m_caller);
+        srt_close(m_accepted);
+        if (m_receiver.joinable())
+            m_receiver.join();
+    }
+
+    // The greatest delay [us] and the number of messages since the last call.
+    void collect(int64_t& w_maxdelay, int64_t& w_received)
+    {
+        w_maxdelay = m_maxDelay.exchange(0);
+        w_received = m_received.exchange(0);
+    }
+};
+
+// Connect all callers at once and wait until they are all connected
+// (or failed), and then until they are all accepted.
+void RunRound(int round, const Config& cfg, const sockaddr_any& addr, Acceptor& acceptor, Probe& probe)
+{
+    const sockaddr_any local = CreateAddr("127.0.0.1", cfg.port + 1, AF_INET);
+    const int          eid   = srt_epoll_create();
+    const bool         no    = false;
+
+    vector<SRTSOCKET> callers;
+    for (int i = 0; i < cfg.callers; ++i)
+    {
+        const SRTSOCKET s = srt_create_socket();
+        if (!Configure(s, cfg) || srt_setsockflag(s, SRTO_RCVSYN, &no, sizeof no) == SRT_ERROR
+            || srt_bind(s, local.get(), local.size()) == SRT_ERROR)
+        {
+            cerr << "ERROR: can't set up a caller: " << srt_getlasterror_str() << endl;
+            srt_close(s);
+            continue;
+        }
+        const int events = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+        srt_epoll_add_usock(eid, s, &events);
+        callers.push_back(s);
+    }
+
+    int64_t maxdelay, received;
+    probe.collect((maxdelay), (received));
+
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < callers.size(); ++i)
+        srt_connect(callers[i], addr.get(), addr.size());
+
+    size_t            connected = 0, failed = 0;
+    vector<SRTSOCKET> ready(callers.size());
+    while (connected + failed < callers.size())
+    {
+        int       wlen = (int)ready.size();
+        const int n    = srt_epoll_wait(eid, NULL, NULL, &ready[0], &wlen, 1000, NULL, NULL, NULL, NULL);
+        if (n <= 0)
+        {
+            if (SecondsSince(start) > 30)
+                break;
+            continue;
+        }
+
+        for (int i = 0; i < wlen; ++i)
+        {
+            if (srt_getsockstate(ready[i]) == SRTS_CONNECTED)
+                ++connected;
+            else
+                ++failed;
+            srt_epoll_remove_usock(eid, ready[i]);
+        }
+    }
+    const double connect_time = SecondsSince(start);
+
+    while (acceptor.count() < connected && SecondsSince(start) < 30)
+        this_thread::sleep_for(chrono::milliseconds(1));
+    const double accept_time = SecondsSince(start);
+    const size_t accepted    = acceptor.count();
+
+    probe.collect((maxdelay), (received));
+
+    cout << "Round " << round << ": " << connected << " connected, " << failed << " failed in " << connect_time
+         << " s, " << accepted << " accepted in " << accept_time << " s; probe: " << received
+         << " messages, max delay " << (maxdelay / 1000.0) << " ms" << endl;
+
+    for (size_t i = 0; i < callers.size(); ++i)
+        srt_close(callers[i]);
+    acceptor.closeAll();
+    srt_epoll_release(eid);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    OptionName
+        o_callers    = {"n", "callers"},
+        o_rounds     = {"r", "rounds"},
+        o_workers    = {"w", "acceptworkers"},
+        o_port       = {"p", "port"},
+        o_passphrase = {"s", "passphrase"},
+        o_loglevel   = {"ll", "loglevel"},
+        o_help       = {"h", "help"};
+
+    vector<OptionScheme> optargs = {
+        { o_callers,    OptionScheme::ARG_ONE },
+        { o_rounds,     OptionScheme::ARG_ONE },
+        { o_workers,    OptionScheme::ARG_ONE },
+        { o_port,       OptionScheme::ARG_ONE },
+        { o_passphrase, OptionScheme::ARG_ONE },
+        { o_loglevel,   OptionScheme::ARG_ONE }
+    };
+    options_t params = ProcessOptions(argv, argc, optargs);
+
+    if (OptionPresent(params, o_help) || !params[""].empty())
+    {
+        cerr << "Usage: " << argv[0] << " [options]\n";
+        cerr << "Options:\n";
+        cerr << "\t-n  <callers=1000> .  .  .  .  .  Number of callers connecting at once\n";
+        cerr << "\t-r  <rounds=2>  .  .  .  .  .  .  Number of times they connect\n";
+        cerr << "\t-w  <acceptworkers=0>  .  .  .  .  SRTO_ACCEPTWORKERS of the listener\n";
+        cerr << "\t-p  <port=5000> .  .  .  .  .  .  Listener port (the callers use port+1)\n";
+        cerr << "\t-s  <passphrase>   .  .  .  .  .  Encrypt the connections\n";
+        cerr << "\t-ll <level=error>  .  .  .  .  .  Log level for SRT\n";
+        return 1;
+    }
+
+    Config cfg;
+    cfg.callers    = Option<OutNumber>(params, "1000", o_callers);
+    cfg.rounds     = Option<OutNumber>(params, "2", o_rounds);
+    cfg.workers    = Option<OutNumber>(params, "0", o_workers);
+    cfg.port       = Option<OutNumber>(params, "5000", o_port);
+    cfg.passphrase = Option<OutString>(params, "", o_passphrase);
+
+    srt_startup();
+    srt_setloglevel(SrtParseLogLevel(Option<OutString>(params, "error", o_loglevel)));
+
+    const sockaddr_any addr     = CreateAddr("127.0.0.1", cfg.port, AF_INET);
+    const SRTSOCKET    listener = srt_create_socket();
+    if (!Configure(listener, cfg)
+        || srt_setsockflag(listener, SRTO_ACCEPTWORKERS, &cfg.workers, sizeof cfg.workers) == SRT_ERROR
+        || srt_bind(listener, addr.get(), addr.size()) == SRT_ERROR || srt_listen(listener, cfg.callers + 1) == SRT_ERROR)
+    {
+        cerr << "ERROR: can't set up the listener: " << srt_getlasterror_str() << endl;
+        return 1;
+    }
+
+    Probe probe;
+    if (!probe.connect(listener, addr, cfg))
+    {
+        cerr << "ERROR: can't connect the probe: " << srt_getlasterror_str() << endl;
+        return 1;
+    }
+    probe.start();
+
+    cout << "Callers: " << cfg.callers << " accept workers: " << cfg.workers
+         << (cfg.passphrase.empty() ? "" : " encrypted") << endl;
+    {
+        Acceptor acceptor(listener);
+        for (int r = 1; r <= cfg.rounds; ++r)
+        {
+            RunRound(r, cfg, addr, acceptor, probe);
+            // Let the closed sockets be collected before reconnecting.
+            this_thread::sleep_for(chrono::seconds(1));
+        }
+        srt_close(listener);
+    }
+
+    probe.stop();
+    srt_cleanup();
+    return 0;
+}